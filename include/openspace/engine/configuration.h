@@ -68,6 +68,7 @@ struct Configuration {
     DocumentationInfo documentation;
 
     bool useMultithreadedInitialization = false;
+    bool useDeltaSynchronization = false;
 
     struct LoadingScreen {
         bool isShowingMessages = true;
@@ -53,6 +53,7 @@ class ParallelPeer;
 class RenderEngine;
 class Scene;
 class SyncEngine;
+class ThreadPool;
 class TimeManager;
 class VirtualPropertyManager;
 class WindowWrapper;
@@ -145,6 +146,14 @@ public:
     scripting::ScriptScheduler& scriptScheduler();
     VirtualPropertyManager& virtualPropertyManager();
 
+    /**
+     * Returns the pool that is shared by all parallel computations of the engine and the
+     * modules, such as the scene update, or <code>nullptr</code> if there is only a
+     * single hardware thread. The calling thread is expected to take part in the work
+     * through parallelFor, so the pool has one thread less than the hardware has.
+     */
+    ThreadPool* computePool();
+
 
     // This method is only to be called from Modules
     enum class CallbackOption {
@@ -208,6 +217,8 @@ private:
     std::unique_ptr<Configuration> _configuration;
 
     // Components
+    // The compute pool is shared by all scenes and modules and has to outlive them
+    std::unique_ptr<ThreadPool> _computePool;
     std::unique_ptr<Scene> _scene;
     std::unique_ptr<AssetManager> _assetManager;
     std::unique_ptr<Dashboard> _dashboard;
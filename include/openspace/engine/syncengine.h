@@ -28,6 +28,7 @@
 #include <openspace/util/syncbuffer.h>
 
 #include <ghoul/misc/boolean.h>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -50,8 +51,9 @@ public:
     SyncEngine(unsigned int syncBufferSize);
 
     /**
-     * Encodes all added Syncables in the injected <code>SyncBuffer</code>.
-     * This method is only called on the SGCT master node
+     * Encodes all added Syncables in the injected <code>SyncBuffer</code>. If delta
+     * encoding is enabled, only the Syncables that are dirty are encoded, each preceded
+     * by its index. This method is only called on the SGCT master node
      */
     void encodeSyncables();
 
@@ -93,6 +95,19 @@ public:
     */
     void removeSyncables(const std::vector<Syncable*>& syncables);
 
+    /**
+     * Enables or disables the delta encoding, in which only the Syncables that have
+     * changed since the previous frame are transmitted. All nodes of the cluster have to
+     * use the same setting
+     */
+    void setDeltaEncoding(bool enabled);
+
+    /**
+     * Returns the number of bytes that were transmitted by the last call to
+     * #encodeSyncables
+     */
+    size_t encodedSize() const;
+
 private:
     /**
      * Vector of Syncables. The vectors ensures consistent encode/decode order
@@ -103,6 +118,13 @@ private:
      * Databuffer used in encoding/decoding
      */
     SyncBuffer _syncBuffer;
+
+    bool _useDeltaEncoding = false;
+
+    /// The indices of the dirty Syncables; kept as a member to reuse its storage
+    std::vector<uint16_t> _dirtySyncables;
+
+    size_t _encodedSize = 0;
 };
 
 } // namespace openspace
@@ -48,6 +48,12 @@ public:
     };
 
     void updateCamera(Camera& camera);
+
+    /**
+     * Updates the \p camera to the keyframes at the application time \p now, which is
+     * provided by the WindowWrapper in the overload without this parameter.
+     */
+    void updateCamera(Camera& camera, double now);
     Timeline<CameraPose>& timeline();
 
     void addKeyframe(double timestamp, KeyframeNavigator::CameraPose pose);
@@ -55,8 +61,33 @@ public:
     void clearKeyframes();
     size_t nKeyframes() const;
 
+    /**
+     * If prediction is enabled and no keyframe after the current time has arrived yet,
+     * the camera keeps moving with the velocity between the last two keyframes instead
+     * of stopping. Once the next keyframe arrives, the difference between the predicted
+     * and the actual camera is blended out smoothly.
+     */
+    void setPredictionEnabled(bool enabled);
+    bool isPredictionEnabled() const;
+
 private:
     Timeline<CameraPose> _cameraPoseTimeline;
+
+    bool _isPredictionEnabled = false;
+
+    // Whether the last camera update was extrapolated and from which keyframe
+    bool _wasPredicting = false;
+    double _predictionKeyframeTimestamp = 0.0;
+
+    // The camera of the last update, which is needed to compute the prediction error
+    glm::dvec3 _lastPosition = glm::dvec3(0.0);
+    glm::dquat _lastRotation = glm::dquat(1.0, 0.0, 0.0, 0.0);
+
+    // The prediction error that is currently blended out
+    bool _isCorrecting = false;
+    double _correctionStartTime = 0.0;
+    glm::dvec3 _positionCorrection = glm::dvec3(0.0);
+    glm::dquat _rotationCorrection = glm::dquat(1.0, 0.0, 0.0, 0.0);
 };
 
 } // namespace openspace::interaction
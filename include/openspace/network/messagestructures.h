@@ -35,9 +35,37 @@ namespace openspace::datamessagestructures {
 enum class Type : uint32_t {
     CameraData = 0,
     TimelineData,
-    ScriptData
+    ScriptData,
+    Batch
 };
 
+/**
+ * The version of the layout of the data messages, which is part of every Batch. It has
+ * to be increased whenever the serialized layout of any of the messages changes.
+ */
+constexpr const uint32_t DataFormatVersion = 1;
+
+namespace detail {
+    template <typename T>
+    void write(char*& destination, const T& value) {
+        memcpy(destination, &value, sizeof(T));
+        destination += sizeof(T);
+    }
+
+    template <typename T>
+    void read(const char*& source, T& value) {
+        memcpy(&value, source, sizeof(T));
+        source += sizeof(T);
+    }
+} // namespace detail
+
+/*
+ * All messages are serialized field by field without any padding. serialize appends the
+ * message to the passed buffer, growing it only once, and deserialize reads the message
+ * in place from the received data of the passed size and returns the offset behind the
+ * message, or 0 if the message does not fit into the received data.
+ */
+
 struct CameraKeyframe {
     CameraKeyframe() {}
     CameraKeyframe(const std::vector<char> &buffer) {
@@ -52,95 +80,60 @@ struct CameraKeyframe {
 
     double _timestamp;
 
+    size_t serializedSize() const {
+        return sizeof(_position) + sizeof(_rotation) + sizeof(_followNodeRotation) +
+            sizeof(int32_t) + _focusNode.size() + sizeof(_scale) + sizeof(_timestamp);
+    }
+
     void serialize(std::vector<char> &buffer) const {
-        // Add position
-        buffer.insert(
-            buffer.end(),
-            reinterpret_cast<const char*>(&_position),
-            reinterpret_cast<const char*>(&_position) + sizeof(_position)
-        );
+        const size_t offset = buffer.size();
+        buffer.resize(offset + serializedSize());
+        char* p = buffer.data() + offset;
 
-        // Add orientation
-        buffer.insert(
-            buffer.end(),
-            reinterpret_cast<const char*>(&_rotation),
-            reinterpret_cast<const char*>(&_rotation) + sizeof(_rotation)
-        );
+        detail::write(p, _position);
+        detail::write(p, _rotation);
+        detail::write(p, _followNodeRotation);
 
-        // Follow focus node rotation?
-        buffer.insert(
-            buffer.end(),
-            reinterpret_cast<const char*>(&_followNodeRotation),
-            reinterpret_cast<const char*>(&_followNodeRotation) +
-                sizeof(_followNodeRotation)
-        );
+        const int32_t nodeNameLength = static_cast<int32_t>(_focusNode.size());
+        detail::write(p, nodeNameLength);
+        memcpy(p, _focusNode.data(), nodeNameLength);
+        p += nodeNameLength;
 
-        int nodeNameLength = static_cast<int>(_focusNode.size());
+        detail::write(p, _scale);
+        detail::write(p, _timestamp);
+    };
 
-        // Add focus node
-        buffer.insert(
-            buffer.end(),
-            reinterpret_cast<const char*>(&nodeNameLength),
-            reinterpret_cast<const char*>(&nodeNameLength) + sizeof(nodeNameLength)
-        );
-        buffer.insert(
-            buffer.end(),
-            _focusNode.data(),
-            _focusNode.data() + nodeNameLength
-        );
+    size_t deserialize(const char* data, size_t size, size_t offset = 0) {
+        constexpr const size_t FixedSize = sizeof(_position) + sizeof(_rotation) +
+            sizeof(_followNodeRotation) + sizeof(int32_t) + sizeof(_scale) +
+            sizeof(_timestamp);
+        if (offset > size || size - offset < FixedSize) {
+            return 0;
+        }
+        const char* p = data + offset;
+
+        detail::read(p, _position);
+        detail::read(p, _rotation);
+        detail::read(p, _followNodeRotation);
+
+        int32_t nodeNameLength;
+        detail::read(p, nodeNameLength);
+        if (nodeNameLength < 0 ||
+            static_cast<size_t>(nodeNameLength) > size - offset - FixedSize)
+        {
+            return 0;
+        }
+        _focusNode.assign(p, nodeNameLength);
+        p += nodeNameLength;
 
-        buffer.insert(
-            buffer.end(),
-            reinterpret_cast<const char*>(&_scale),
-            reinterpret_cast<const char*>(&_scale) + sizeof(_scale)
-        );
+        detail::read(p, _scale);
+        detail::read(p, _timestamp);
 
-        // Add timestamp
-        buffer.insert(
-            buffer.end(),
-            reinterpret_cast<const char*>(&_timestamp),
-            reinterpret_cast<const char*>(&_timestamp) + sizeof(_timestamp)
-        );
+        return p - data;
     };
 
     size_t deserialize(const std::vector<char> &buffer, size_t offset = 0) {
-        int size = 0;
-
-        // Position
-        size = sizeof(_position);
-        memcpy(&_position, buffer.data() + offset, size);
-        offset += size;
-
-        // Orientation
-        size = sizeof(_rotation);
-        memcpy(&_rotation, buffer.data() + offset, size);
-        offset += size;
-
-        // Follow focus node rotation?
-        size = sizeof(_followNodeRotation);
-        memcpy(&_followNodeRotation, buffer.data() + offset, size);
-        offset += size;
-
-        // Focus node
-        int nodeNameLength;
-        size = sizeof(int);
-        memcpy(&nodeNameLength, buffer.data() + offset, size);
-        offset += size;
-        size = nodeNameLength;
-        _focusNode = std::string(buffer.data() + offset, buffer.data() + offset + size);
-        offset += size;
-
-        // Scale
-        size = sizeof(_scale);
-        memcpy(&_scale, buffer.data() + offset, size);
-        offset += size;
-
-        // Timestamp
-        size = sizeof(_timestamp);
-        memcpy(&_timestamp, buffer.data() + offset, size);
-        offset += size;
-
-        return offset;
+        return deserialize(buffer.data(), buffer.size(), offset);
     };
 };
 
@@ -156,18 +149,40 @@ struct TimeKeyframe {
     bool _requiresTimeJump;
     double _timestamp;
 
+    static constexpr size_t serializedSize() {
+        return 3 * sizeof(double) + 2 * sizeof(bool);
+    }
+
+    void serialize(char*& destination) const {
+        detail::write(destination, _time);
+        detail::write(destination, _dt);
+        detail::write(destination, _paused);
+        detail::write(destination, _requiresTimeJump);
+        detail::write(destination, _timestamp);
+    }
+
     void serialize(std::vector<char> &buffer) const {
-        buffer.insert(
-            buffer.end(),
-            reinterpret_cast<const char*>(this),
-            reinterpret_cast<const char*>(this) + sizeof(TimeKeyframe)
-        );
+        const size_t offset = buffer.size();
+        buffer.resize(offset + serializedSize());
+        char* p = buffer.data() + offset;
+        serialize(p);
     };
 
-    size_t deserialize(const std::vector<char> &buffer, size_t offset = 0){
-        *this = *reinterpret_cast<const TimeKeyframe*>(buffer.data() + offset);
-        offset += sizeof(TimeKeyframe);
-        return offset;
+    size_t deserialize(const char* data, size_t size, size_t offset = 0) {
+        if (offset > size || size - offset < serializedSize()) {
+            return 0;
+        }
+        const char* p = data + offset;
+        detail::read(p, _time);
+        detail::read(p, _dt);
+        detail::read(p, _paused);
+        detail::read(p, _requiresTimeJump);
+        detail::read(p, _timestamp);
+        return p - data;
+    };
+
+    size_t deserialize(const std::vector<char> &buffer, size_t offset = 0) {
+        return deserialize(buffer.data(), buffer.size(), offset);
     };
 };
 
@@ -180,42 +195,50 @@ struct TimeTimeline {
     bool _clear = true;
     std::vector<TimeKeyframe> _keyframes;
 
-    void serialize(std::vector<char> &buffer) const {
-        buffer.insert(
-            buffer.end(),
-            reinterpret_cast<const char*>(&_clear),
-            reinterpret_cast<const char*>(&_clear) + sizeof(bool)
-        );
+    size_t serializedSize() const {
+        return sizeof(bool) + sizeof(int64_t) +
+            _keyframes.size() * TimeKeyframe::serializedSize();
+    }
 
-        int64_t nKeyframes = _keyframes.size();
-        buffer.insert(
-            buffer.end(),
-            reinterpret_cast<const char*>(&nKeyframes),
-            reinterpret_cast<const char*>(&nKeyframes) + sizeof(int64_t)
-        );
-        for (const auto k : _keyframes) {
-            k.serialize(buffer);
+    void serialize(std::vector<char> &buffer) const {
+        const size_t offset = buffer.size();
+        buffer.resize(offset + serializedSize());
+        char* p = buffer.data() + offset;
+
+        detail::write(p, _clear);
+        const int64_t nKeyframes = _keyframes.size();
+        detail::write(p, nKeyframes);
+        for (const TimeKeyframe& k : _keyframes) {
+            k.serialize(p);
         }
     };
 
-    size_t deserialize(const std::vector<char> &buffer, size_t offset = 0) {
-        int size = 0;
-
-        size = sizeof(_clear);
-        memcpy(&_clear, buffer.data() + offset, size);
-        offset += size;
-
-        int64_t nKeyframes = _keyframes.size();
-        size = sizeof(nKeyframes);
-        memcpy(&nKeyframes, buffer.data() + offset, size);
-        offset += size;
+    size_t deserialize(const char* data, size_t size, size_t offset = 0) {
+        if (offset > size || size - offset < sizeof(bool) + sizeof(int64_t)) {
+            return 0;
+        }
+        const char* p = data + offset;
+        detail::read(p, _clear);
+        int64_t nKeyframes;
+        detail::read(p, nKeyframes);
+        offset = p - data;
+
+        // Check the number of keyframes before allocating memory for them
+        const size_t maxKeyframes = (size - offset) / TimeKeyframe::serializedSize();
+        if (nKeyframes < 0 || static_cast<uint64_t>(nKeyframes) > maxKeyframes) {
+            return 0;
+        }
 
         _keyframes.resize(nKeyframes);
-        for (auto& k : _keyframes) {
-            offset = k.deserialize(buffer, offset);
+        for (TimeKeyframe& k : _keyframes) {
+            offset = k.deserialize(data, size, offset);
         }
         return offset;
     };
+
+    size_t deserialize(const std::vector<char> &buffer, size_t offset = 0) {
+        return deserialize(buffer.data(), buffer.size(), offset);
+    };
 };
 
 struct ScriptMessage {
@@ -226,15 +249,114 @@ struct ScriptMessage {
 
     std::string _script;
 
+    size_t serializedSize() const {
+        return _script.size();
+    }
+
     void serialize(std::vector<char> &buffer) const {
         buffer.insert(buffer.end(), _script.begin(), _script.end());
     };
 
+    void deserialize(const char* data, size_t size) {
+        _script.assign(data, size);
+    };
+
     void deserialize(const std::vector<char> &buffer) {
-        _script.assign(buffer.begin(), buffer.end());
+        deserialize(buffer.data(), buffer.size());
     };
 };
 
-} // namespace openspace::messagestructures
+/**
+ * Collects multiple messages into a single buffer, so that they can be sent to all peers
+ * as one data message. The buffer starts with the DataFormatVersion and the number of
+ * messages, followed by the type, size, and serialized content of each message. Calling
+ * #clear keeps the allocated memory, so a batch can be reused every frame without
+ * allocations.
+ */
+class Batch {
+public:
+    Batch() {
+        clear();
+    }
+
+    void clear() {
+        _buffer.resize(HeaderSize);
+        char* p = _buffer.data();
+        detail::write(p, DataFormatVersion);
+        detail::write(p, uint32_t(0));
+        _nMessages = 0;
+    }
+
+    template <typename T>
+    void add(Type type, const T& message) {
+        const size_t offset = _buffer.size();
+        _buffer.resize(offset + 2 * sizeof(uint32_t));
+        message.serialize(_buffer);
+
+        char* p = _buffer.data() + offset;
+        detail::write(p, type);
+        const uint32_t size = static_cast<uint32_t>(
+            _buffer.size() - offset - 2 * sizeof(uint32_t)
+        );
+        detail::write(p, size);
+
+        ++_nMessages;
+        p = _buffer.data() + sizeof(uint32_t);
+        detail::write(p, _nMessages);
+    }
+
+    bool empty() const {
+        return _nMessages == 0;
+    }
+
+    const std::vector<char>& buffer() const {
+        return _buffer;
+    }
+
+    /**
+     * Calls \p callback with the type, the data and the size of each message in the
+     * batch \p data of \p size bytes. Returns \c false if the batch was written with a
+     * different DataFormatVersion or is truncated.
+     */
+    template <typename Func>
+    static bool forEach(const char* data, size_t size, Func callback) {
+        if (size < HeaderSize) {
+            return false;
+        }
+        const char* p = data;
+        uint32_t version;
+        detail::read(p, version);
+        if (version != DataFormatVersion) {
+            return false;
+        }
+        uint32_t nMessages;
+        detail::read(p, nMessages);
+
+        const char* end = data + size;
+        for (uint32_t i = 0; i < nMessages; ++i) {
+            if (end - p < static_cast<ptrdiff_t>(2 * sizeof(uint32_t))) {
+                return false;
+            }
+            Type type;
+            detail::read(p, type);
+            uint32_t messageSize;
+            detail::read(p, messageSize);
+            if (static_cast<size_t>(end - p) < messageSize) {
+                return false;
+            }
+            callback(type, p, messageSize);
+            p += messageSize;
+        }
+        return true;
+    }
+
+private:
+    static constexpr const size_t HeaderSize = 2 * sizeof(uint32_t);
+
+    std::vector<char> _buffer;
+    uint32_t _nMessages = 0;
+};
+
+} // namespace openspace::datamessagestructures
 
 #endif // __OPENSPACE_CORE___MESSAGESTRUCTURES___H__
@@ -28,6 +28,7 @@
 #include <openspace/network/messagestructures.h>
 #include <ghoul/io/socket/tcpsocket.h>
 #include <ghoul/misc/exception.h>
+#include <utility>
 #include <vector>
 
 namespace openspace {
@@ -78,13 +79,32 @@ public:
 
     bool isConnectedOrConnecting() const;
     void sendDataMessage(const ParallelConnection::DataMessage& dataMessage);
+
+    /**
+     * Sends a data message of the provided \p type and \p timestamp whose content are
+     * the \p size bytes pointed to by \p data, without copying them first
+     */
+    void sendDataMessage(datamessagestructures::Type type, double timestamp,
+        const char* data, size_t size);
+
     bool sendMessage(const ParallelConnection::Message& message);
     void disconnect();
     ghoul::io::TcpSocket* socket();
 
     ParallelConnection::Message receiveMessage();
 
+    /**
+     * Reads the message header of HeaderSize bytes pointed to by \p header and returns
+     * the type and the size of the message content that follows it. Throws a
+     * ConnectionLostError if the header is malformed or if it was written with a
+     * different ProtocolVersion, which would make the content unreadable
+     */
+    static std::pair<MessageType, size_t> readHeader(const char* header);
+
     static const unsigned int ProtocolVersion;
+
+    /// 'OS', protocol version, message type, and message size
+    static constexpr const size_t HeaderSize = 2 * sizeof(char) + 3 * sizeof(uint32_t);
 private:
     std::unique_ptr<ghoul::io::TcpSocket> _socket;
 };
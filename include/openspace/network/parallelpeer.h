@@ -33,6 +33,7 @@
 
 #include <openspace/network/parallelconnection.h>
 #include <openspace/properties/stringproperty.h>
+#include <openspace/properties/scalar/boolproperty.h>
 #include <openspace/properties/scalar/floatproperty.h>
 #include <ghoul/designpattern/event.h>
 #include <atomic>
@@ -77,19 +78,24 @@ public:
     ghoul::Event<>& connectionEvent();
 
 private:
-    void queueInMessage(const ParallelConnection::Message& message);
+    void queueInMessage(ParallelConnection::Message message);
 
     void sendAuthentication();
     void handleCommunication();
 
     void handleMessage(const ParallelConnection::Message&);
     void dataMessageReceived(const std::vector<char>& message);
+    void handleDataMessage(datamessagestructures::Type type, double timestamp,
+        const char* data, size_t size);
     void connectionStatusMessageReceived(const std::vector<char>& message);
     void nConnectionsMessageReceived(const std::vector<char>& message);
 
     void sendCameraKeyframe();
     void sendTimeTimeline();
 
+    /// Sends all messages that were added to the #_sendBatch in a single data message
+    void sendBatch();
+
     void setStatus(ParallelConnection::Status status);
     void setHostName(const std::string& hostName);
     void setNConnections(size_t nConnections);
@@ -108,6 +114,7 @@ private:
     properties::FloatProperty _bufferTime;
     properties::FloatProperty _timeKeyframeInterval;
     properties::FloatProperty _cameraKeyframeInterval;
+    properties::BoolProperty _predictCameraKeyframes;
 
     double _lastTimeKeyframeTimestamp = 0.0;
     double _lastCameraKeyframeTimestamp = 0.0;
@@ -123,6 +130,12 @@ private:
     std::deque<ParallelConnection::Message> _receiveBuffer;
     std::mutex _receiveBufferMutex;
 
+    // The messages that are sent in the current frame. They are written directly into
+    // this reused buffer to avoid allocating a buffer for each message
+    datamessagestructures::Batch _sendBatch;
+    datamessagestructures::CameraKeyframe _cameraKeyframe;
+    datamessagestructures::TimeTimeline _timeline;
+
     std::atomic<bool> _timeJumped;
     std::atomic<bool> _timeTimelineChanged;
     std::mutex _latencyMutex;
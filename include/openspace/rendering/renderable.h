@@ -77,6 +77,12 @@ public:
 
     virtual void render(const RenderData& data, RendererTasks& rendererTask);
     virtual void update(const UpdateData& data);
+
+    // Returns whether #update can be called from a worker thread concurrently with the
+    // updates of other scene graph nodes. This is false by default, as most renderables
+    // use OpenGL or other shared state in their update; renderables whose update only
+    // touches their own members can opt in to the concurrent update
+    virtual bool supportsConcurrentUpdate() const;
     virtual SurfacePositionHandle calculateSurfacePositionHandle(
                                                 const glm::dvec3& targetModelSpace) const;
 
@@ -48,6 +48,11 @@ public:
 
     virtual bool initialize();
 
+    // Returns whether #update can be called concurrently with the updates of other scene
+    // graph nodes. Implementations that access shared state, such as SPICE, a Lua state,
+    // or other scene graph nodes, have to return false, which is the default
+    virtual bool supportsConcurrentUpdate() const;
+
     const glm::dmat3& matrix() const;
     virtual glm::dmat3 matrix(const UpdateData& time) const = 0;
     void update(const UpdateData& data);
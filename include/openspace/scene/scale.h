@@ -48,6 +48,11 @@ public:
 
     virtual bool initialize();
 
+    // Returns whether #update can be called concurrently with the updates of other scene
+    // graph nodes. Implementations that access shared state, such as SPICE, a Lua state,
+    // or other scene graph nodes, have to return false, which is the default
+    virtual bool supportsConcurrentUpdate() const;
+
     double scaleValue() const;
     virtual double scaleValue(const UpdateData& data) const = 0;
     virtual void update(const UpdateData& data);
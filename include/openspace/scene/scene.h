@@ -31,6 +31,8 @@
 #include <openspace/scene/scenelicense.h>
 #include <ghoul/misc/easing.h>
 #include <ghoul/misc/exception.h>
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <set>
 #include <unordered_map>
@@ -45,6 +47,7 @@ namespace documentation { struct Documentation; }
 namespace scripting { struct LuaLibrary; }
 
 class SceneInitializer;
+class ThreadPool;
 
 // Notifications:
 // SceneGraphFinishedLoading
@@ -92,11 +95,27 @@ public:
      */
     Camera* camera() const;
 
+    /**
+     * Sets the ThreadPool that is used to update independent SceneGraphNode%s
+     * concurrently. If \p pool is <code>nullptr</code>, which is the default, all nodes
+     * are updated on the calling thread. The \p pool is not owned by the Scene and has to
+     * outlive it.
+     */
+    void setUpdatePool(ThreadPool* pool);
+
     /**
      * Updates all SceneGraphNodes relative positions
      */
     void update(const UpdateData& data);
 
+    /**
+     * Returns the number of SceneGraphNode%s that had to recompute their world
+     * transformation in the last call to #update. All other nodes reused their cached
+     * world transformation, as neither their local transformation nor their parent's
+     * world transformation changed
+     */
+    size_t nRecomputedWorldTransforms() const;
+
     /**
      * Render visible SceneGraphNodes using the provided camera.
      */
@@ -227,8 +246,27 @@ private:
 
     void sortTopologically();
 
+    /// Updates the nodes of a single UpdateLevel, using the #_updatePool if available
+    void updateLevel(const UpdateData& data, size_t level);
+
+    /**
+     * All nodes of a level only depend on nodes of previous levels, so the nodes of a
+     * single level can be updated independently of each other.
+     */
+    struct UpdateLevel {
+        /// Nodes whose transformations and Renderable can be updated concurrently
+        std::vector<SceneGraphNode*> concurrentNodes;
+        /// Nodes for which only the transformations can be updated concurrently
+        std::vector<SceneGraphNode*> concurrentTransformNodes;
+        /// Nodes that have to be updated on the calling thread
+        std::vector<SceneGraphNode*> serialNodes;
+    };
+
     std::unique_ptr<Camera> _camera;
     std::vector<SceneGraphNode*> _topologicallySortedNodes;
+    std::vector<UpdateLevel> _updateLevels;
+    ThreadPool* _updatePool = nullptr;
+    std::atomic<size_t> _nRecomputedWorldTransforms = 0;
     std::vector<SceneGraphNode*> _circularNodes;
     std::unordered_map<std::string, SceneGraphNode*> _nodesByIdentifier;
     bool _dirtyNodeRegistry = false;
@@ -30,6 +30,7 @@
 #include <ghoul/glm.h>
 #include <ghoul/misc/boolean.h>
 #include <atomic>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <vector>
@@ -93,6 +94,31 @@ public:
     void traversePreOrder(const std::function<void(SceneGraphNode*)>& fn);
     void traversePostOrder(const std::function<void(SceneGraphNode*)>& fn);
     void update(const UpdateData& data);
+
+    /**
+     * Updates the translation, rotation, and scale of this node and recomputes the
+     * cached world transformation. Requires the parent to be updated already. If the
+     * node is not initialized or outside of its TimeFrame, only the cached world
+     * transformation is recomputed from the unchanged local transformation.
+     * #update is equivalent to calling this function followed by #updateRenderable.
+     */
+    void updateTransform(const UpdateData& data);
+
+    /// Updates the Renderable of this node; requires #updateTransform to be called first
+    void updateRenderable(const UpdateData& data);
+
+    /**
+     * Returns whether the last call to #updateTransform had to recompute the world
+     * transformation, which is only the case if the local transformation or the world
+     * transformation of the parent have changed since the previous call
+     */
+    bool hasRecomputedWorldTransform() const;
+
+    /// Returns whether #updateTransform can run concurrently with other nodes' updates
+    bool supportsConcurrentTransformUpdate() const;
+
+    /// Returns whether #updateRenderable can run concurrently with other nodes' updates
+    bool supportsConcurrentRenderableUpdate() const;
     void render(const RenderData& data, RendererTasks& tasks);
     void updateCamera(Camera* camera) const;
 
@@ -145,9 +171,13 @@ public:
     static documentation::Documentation Documentation();
 
 private:
-    glm::dvec3 calculateWorldPosition() const;
-    glm::dmat3 calculateWorldRotation() const;
-    double calculateWorldScale() const;
+    bool isUpdateActive(const UpdateData& data) const;
+
+    /**
+     * Recomputes the cached world transformation if it is out of date and returns
+     * whether a recomputation was necessary. Requires the parent to be updated already
+     */
+    bool updateWorldTransform();
 
     std::atomic<State> _state = State::Loaded;
     std::vector<std::unique_ptr<SceneGraphNode>> _children;
@@ -183,6 +213,17 @@ private:
     glm::dmat4 _modelTransformCached;
     glm::dmat4 _inverseModelTransformCached;
 
+    // The local transformation and the parent's version that the cached world
+    // transformation was computed from. The version is incremented whenever the world
+    // transformation changes, which lets the children detect a change of their parent
+    glm::dvec3 _localPositionCached = glm::dvec3(0.0);
+    glm::dmat3 _localRotationCached = glm::dmat3(1.0);
+    double _localScaleCached = 1.0;
+    uint64_t _worldTransformVersion = 0;
+    uint64_t _parentWorldTransformVersion = 0;
+    bool _isWorldTransformDirty = true;
+    bool _hasRecomputedWorldTransform = false;
+
 #ifdef Debugging_Core_SceneGraphNode_Indices
     int index = 0;
     static int nextIndex;
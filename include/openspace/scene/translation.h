@@ -49,11 +49,24 @@ public:
     virtual ~Translation() = default;
     virtual bool initialize();
 
+    // Returns whether #update can be called concurrently with the updates of other scene
+    // graph nodes. Implementations that access shared state, such as SPICE, a Lua state,
+    // or other scene graph nodes, have to return false, which is the default. If true,
+    // #position has to be callable concurrently for different times once it has been
+    // evaluated a first time, as trails use this to sample their orbit in parallel
+    virtual bool supportsConcurrentUpdate() const;
+
     glm::dvec3 position() const;
     void update(const UpdateData& data);
 
     virtual glm::dvec3 position(const UpdateData& data) const = 0;
 
+    // Computes the positions for \p nTimes ephemeris times at once and stores them in
+    // \p positions. The default implementation calls #position for each time, but
+    // subclasses can override this to amortize lookups across the entire batch
+    virtual void positions(const double* times, size_t nTimes,
+        glm::dvec3* positions) const;
+
     // Registers a callback that gets called when a significant change has been made that
     // invalidates potentially stored points, for example in trails
     void onParameterChange(std::function<void()> callback);
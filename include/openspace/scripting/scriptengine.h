@@ -77,6 +77,7 @@ public:
     bool writeLog(const std::string& script);
 
     virtual void preSync(bool isMaster) override;
+    virtual bool isDirty() const override;
     virtual void encode(SyncBuffer* syncBuffer) override;
     virtual void decode(SyncBuffer* syncBuffer) override;
     virtual void postSync(bool isMaster) override;
@@ -25,26 +25,57 @@
 #ifndef __OPENSPACE_CORE___CONCURRENT_QUEUE___H__
 #define __OPENSPACE_CORE___CONCURRENT_QUEUE___H__
 
+#include <openspace/util/lockfreeringbuffer.h>
+
+#include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <mutex>
 #include <queue>
+#include <vector>
 
 namespace openspace {
 
+enum class ConcurrentQueueType {
+    /// Unbounded queue where every operation takes a mutex
+    Locking = 0,
+    /// Queue based on a lock-free ring buffer of a fixed capacity. Items that are pushed
+    /// while the ring buffer is full are stored in a mutex-protected overflow list, so
+    /// pushing never blocks. Popping from an empty queue yields the calling thread
+    /// until an item arrives
+    LockFree
+};
+
 /**
- * Templated thread-safe queue based on std::thread and std::queue
+ * Templated thread-safe queue. The underlying implementation is selected by the
+ * \p Type parameter; see ConcurrentQueueType for the differences.
  */
-template <typename T>
+template <typename T, ConcurrentQueueType Type = ConcurrentQueueType::Locking>
 class ConcurrentQueue {
 public:
     T pop();
 
     void pop(T& item);
 
+    /**
+     * Removes the first item without blocking.
+     * \returns <code>true</code> if an item was moved into \p item, <code>false</code>
+     *          if the queue was empty
+     */
+    bool tryPop(T& item);
+
+    /**
+     * Moves all items that are currently in the queue to the end of \p items.
+     * \returns the number of items that were added to \p items
+     */
+    size_t popAll(std::vector<T>& items);
+
     void push(const T& item);
 
     void push(T&& item);
 
+    void pushBulk(std::vector<T> items);
+
     size_t size() const;
 
     bool empty() const;
@@ -52,7 +83,48 @@ public:
 private:
     std::queue<T> _queue;
     mutable std::mutex _mutex;
-    mutable std::condition_variable _cond;
+    std::condition_variable _cond;
+};
+
+template <typename T>
+class ConcurrentQueue<T, ConcurrentQueueType::LockFree> {
+public:
+    /// The number of items that the lock-free ring buffer holds. This is not an upper
+    /// bound for the size of the queue, but pushing beyond it takes a lock
+    static constexpr const size_t DefaultCapacity = 1024;
+
+    explicit ConcurrentQueue(size_t capacity = DefaultCapacity);
+
+    T pop();
+
+    void pop(T& item);
+
+    bool tryPop(T& item);
+
+    size_t popAll(std::vector<T>& items);
+
+    void push(const T& item);
+
+    void push(T&& item);
+
+    void pushBulk(std::vector<T> items);
+
+    /**
+     * Returns the number of items in the queue. As other threads might push or pop
+     * concurrently, this is only a snapshot.
+     */
+    size_t size() const;
+
+    bool empty() const;
+
+private:
+    LockFreeRingBuffer<T> _buffer;
+
+    // Items that did not fit into the ring buffer. While it is not empty, new items are
+    // added to it as well, so that they are not popped before the older ones
+    std::deque<T> _overflow;
+    mutable std::mutex _overflowMutex;
+    std::atomic<size_t> _nOverflowItems = { 0 };
 };
 
 } // namespace openspace
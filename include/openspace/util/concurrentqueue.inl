@@ -22,58 +22,197 @@
  * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
  ****************************************************************************************/
 
+#include <algorithm>
+#include <iterator>
+#include <thread>
+
 namespace openspace {
 
-template <typename T>
-T ConcurrentQueue<T>::pop() {
+template <typename T, ConcurrentQueueType Type>
+T ConcurrentQueue<T, Type>::pop() {
     std::unique_lock<std::mutex> mlock(_mutex);
     while (_queue.empty()) {
         _cond.wait(mlock);
     }
-    auto item = _queue.front();
+    auto item = std::move(_queue.front());
     _queue.pop();
     return item;
 }
 
-template <typename T>
-void ConcurrentQueue<T>::pop(T& item) {
+template <typename T, ConcurrentQueueType Type>
+void ConcurrentQueue<T, Type>::pop(T& item) {
     std::unique_lock<std::mutex> mlock(_mutex);
     while (_queue.empty()) {
         _cond.wait(mlock);
     }
-    item = _queue.front();
+    item = std::move(_queue.front());
     _queue.pop();
 }
 
-template <typename T>
-void ConcurrentQueue<T>::push(const T& item) {
+template <typename T, ConcurrentQueueType Type>
+bool ConcurrentQueue<T, Type>::tryPop(T& item) {
+    std::lock_guard<std::mutex> mlock(_mutex);
+    if (_queue.empty()) {
+        return false;
+    }
+    item = std::move(_queue.front());
+    _queue.pop();
+    return true;
+}
+
+template <typename T, ConcurrentQueueType Type>
+size_t ConcurrentQueue<T, Type>::popAll(std::vector<T>& items) {
+    std::queue<T> queue;
+    {
+        std::lock_guard<std::mutex> mlock(_mutex);
+        std::swap(queue, _queue);
+    }
+    const size_t nItems = queue.size();
+    items.reserve(items.size() + nItems);
+    while (!queue.empty()) {
+        items.push_back(std::move(queue.front()));
+        queue.pop();
+    }
+    return nItems;
+}
+
+template <typename T, ConcurrentQueueType Type>
+void ConcurrentQueue<T, Type>::push(const T& item) {
     std::unique_lock<std::mutex> mlock(_mutex);
     _queue.push(item);
     mlock.unlock();
     _cond.notify_one();
 }
 
-template <typename T>
-void ConcurrentQueue<T>::push(T&& item) {
+template <typename T, ConcurrentQueueType Type>
+void ConcurrentQueue<T, Type>::push(T&& item) {
     std::unique_lock<std::mutex> mlock(_mutex);
     _queue.push(std::move(item));
     mlock.unlock();
     _cond.notify_one();
 }
 
-template <typename T>
-size_t ConcurrentQueue<T>::size() const {
+template <typename T, ConcurrentQueueType Type>
+void ConcurrentQueue<T, Type>::pushBulk(std::vector<T> items) {
     std::unique_lock<std::mutex> mlock(_mutex);
-    size_t s = _queue.size();
+    for (T& item : items) {
+        _queue.push(std::move(item));
+    }
     mlock.unlock();
-    _cond.notify_one();
-    return s;
+    _cond.notify_all();
 }
 
-template <typename T>
-bool ConcurrentQueue<T>::empty() const {
+template <typename T, ConcurrentQueueType Type>
+size_t ConcurrentQueue<T, Type>::size() const {
+    std::lock_guard<std::mutex> mlock(_mutex);
+    return _queue.size();
+}
+
+template <typename T, ConcurrentQueueType Type>
+bool ConcurrentQueue<T, Type>::empty() const {
     return size() == 0;
 }
 
+template <typename T>
+ConcurrentQueue<T, ConcurrentQueueType::LockFree>::ConcurrentQueue(size_t capacity)
+    : _buffer(capacity)
+{}
+
+template <typename T>
+T ConcurrentQueue<T, ConcurrentQueueType::LockFree>::pop() {
+    T item;
+    pop(item);
+    return item;
+}
+
+template <typename T>
+void ConcurrentQueue<T, ConcurrentQueueType::LockFree>::pop(T& item) {
+    while (!tryPop(item)) {
+        std::this_thread::yield();
+    }
+}
+
+template <typename T>
+bool ConcurrentQueue<T, ConcurrentQueueType::LockFree>::tryPop(T& item) {
+    // The items in the ring buffer are always older than the ones in the overflow list
+    if (_buffer.tryPop(item)) {
+        return true;
+    }
+    if (_nOverflowItems.load() == 0) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(_overflowMutex);
+    if (_overflow.empty()) {
+        return false;
+    }
+    item = std::move(_overflow.front());
+    _overflow.pop_front();
+    --_nOverflowItems;
+    return true;
+}
+
+template <typename T>
+size_t ConcurrentQueue<T, ConcurrentQueueType::LockFree>::popAll(std::vector<T>& items)
+{
+    // Only the items that are in the queue when we start are taken, so that producers
+    // that keep pushing concurrently cannot keep us here indefinitely
+    const size_t nAvailable = _buffer.sizeApprox();
+    items.reserve(items.size() + nAvailable);
+
+    size_t nItems = 0;
+    T item;
+    while (nItems < nAvailable && _buffer.tryPop(item)) {
+        items.push_back(std::move(item));
+        ++nItems;
+    }
+
+    if (_nOverflowItems.load() > 0) {
+        std::deque<T> overflow;
+        {
+            std::lock_guard<std::mutex> lock(_overflowMutex);
+            std::swap(overflow, _overflow);
+            _nOverflowItems = 0;
+        }
+        nItems += overflow.size();
+        std::move(overflow.begin(), overflow.end(), std::back_inserter(items));
+    }
+    return nItems;
+}
+
+template <typename T>
+void ConcurrentQueue<T, ConcurrentQueueType::LockFree>::push(const T& item) {
+    push(T(item));
+}
+
+template <typename T>
+void ConcurrentQueue<T, ConcurrentQueueType::LockFree>::push(T&& item) {
+    if (_nOverflowItems.load() == 0 && _buffer.tryPush(std::move(item))) {
+        return;
+    }
+
+    // The ring buffer is full (or was full before), so a consumer is lagging behind.
+    // Rather than stalling the producer, the item is kept until the consumer catches up
+    std::lock_guard<std::mutex> lock(_overflowMutex);
+    _overflow.push_back(std::move(item));
+    ++_nOverflowItems;
+}
+
+template <typename T>
+void ConcurrentQueue<T, ConcurrentQueueType::LockFree>::pushBulk(std::vector<T> items) {
+    for (T& item : items) {
+        push(std::move(item));
+    }
+}
+
+template <typename T>
+size_t ConcurrentQueue<T, ConcurrentQueueType::LockFree>::size() const {
+    return _buffer.sizeApprox() + _nOverflowItems.load();
+}
+
+template <typename T>
+bool ConcurrentQueue<T, ConcurrentQueueType::LockFree>::empty() const {
+    return size() == 0;
+}
 
 } // namespace openspace
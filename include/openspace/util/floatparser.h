@@ -0,0 +1,74 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2018                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___FLOATPARSER___H__
+#define __OPENSPACE_CORE___FLOATPARSER___H__
+
+#include <cstddef>
+#include <vector>
+
+namespace openspace {
+
+/**
+ * Returns the first character in the range [\p first, \p last) that is not a space, a
+ * tab, or a carriage return. Newlines are not skipped, so that the function can be used
+ * within a line.
+ */
+const char* skipBlanks(const char* first, const char* last);
+
+/**
+ * Parses a decimal floating point number with an optional sign, fraction, and exponent
+ * from the beginning of the range [\p first, \p last). In contrast to streams and
+ * <code>strtof</code> the parsing is independent of the locale and does not allocate
+ * memory. Hexadecimal numbers, infinities, and NaNs are not supported.
+ *
+ * \return A pointer to the first character after the number, or \p first if the range
+ *         does not start with a number, in which case \p value is not modified
+ */
+const char* parseFloat(const char* first, const char* last, float& value);
+
+/**
+ * Parses up to \p nValues numbers that are separated by blanks from the range [\p first,
+ * \p last), which should not contain a newline. Parsing stops at the first token that is
+ * not a number.
+ *
+ * \return The number of values that were written to \p values
+ */
+size_t parseFloats(const char* first, const char* last, float* values, size_t nValues);
+
+/**
+ * Parses the lines in the range [\p first, \p last) as records of \p nValuesPerLine
+ * numbers each and appends them to \p result. Empty lines and lines starting with a
+ * <code>#</code> are skipped, missing values are set to 0, and anything following the
+ * values of a line, such as comments or labels, is ignored. \p result is grown once
+ * for the number of lines in the range before parsing.
+ *
+ * \return The number of records that were appended to \p result
+ */
+size_t parseFloatBlock(const char* first, const char* last, size_t nValuesPerLine,
+    std::vector<float>& result);
+
+} // namespace openspace
+
+#endif // __OPENSPACE_CORE___FLOATPARSER___H__
@@ -25,6 +25,7 @@
 #ifndef __OPENSPACE_CORE___HISTOGRAM___H__
 #define __OPENSPACE_CORE___HISTOGRAM___H__
 
+#include <cstdint>
 #include <vector>
 
 namespace openspace {
@@ -55,6 +56,17 @@ public:
      */
     bool add(float value, float repeat = 1.0f);
     bool add(const Histogram& histogram);
+
+    /**
+     * Adds an integer number of values to the bin with the given index. The sum is
+     * computed exactly and rounded once, so large counts keep the precision of the bin.
+     *
+     * @param binIndex The index of the bin, in [0, numBins - 1]
+     * @param count The number of values to add to the bin
+     *
+     * @return Returns true if succesful insertion, otherwise return false
+     */
+    bool addToBin(int binIndex, uint64_t count);
     bool addRectangle(float lowBin, float highBin, float value);
 
     float interpolate(float bin) const;
@@ -0,0 +1,99 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2018                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___LOCK_FREE_RING_BUFFER___H__
+#define __OPENSPACE_CORE___LOCK_FREE_RING_BUFFER___H__
+
+#include <atomic>
+#include <memory>
+#include <type_traits>
+
+namespace openspace {
+
+/**
+ * Bounded multi-producer/multi-consumer queue that does not take any locks. The storage
+ * is a ring of cells that each carry a sequence number that tells producers and
+ * consumers whether the cell is ready to be written or read. The capacity is fixed at
+ * construction and rounded up to the next power of two. If the buffer is full, the
+ * <code>tryPush</code> methods fail instead of blocking and it is up to the caller to
+ * handle the overflow.
+ * Implementation based on
+ * http://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+ */
+template <typename T>
+class LockFreeRingBuffer {
+public:
+    explicit LockFreeRingBuffer(size_t capacity);
+    ~LockFreeRingBuffer();
+
+    LockFreeRingBuffer(const LockFreeRingBuffer&) = delete;
+    LockFreeRingBuffer& operator=(const LockFreeRingBuffer&) = delete;
+
+    /**
+     * Tries to add the \p item to the end of the buffer.
+     * \returns <code>true</code> if the item was added, <code>false</code> if the buffer
+     *          was full. In the latter case, \p item is left untouched
+     */
+    bool tryPush(T&& item);
+    bool tryPush(const T& item);
+
+    /**
+     * Tries to remove the first item from the buffer and move it into \p item.
+     * \returns <code>true</code> if an item was removed, <code>false</code> if the
+     *          buffer was empty
+     */
+    bool tryPop(T& item);
+
+    size_t capacity() const;
+
+    /**
+     * Returns the number of items in the buffer. As other threads might push or pop
+     * concurrently, this value is only a snapshot and might already be outdated when it
+     * is returned.
+     */
+    size_t sizeApprox() const;
+
+private:
+    template <typename U>
+    bool emplace(U&& item);
+
+    struct Cell {
+        std::atomic<size_t> sequence;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+    };
+
+    // Producers and consumers are kept on separate cache lines to avoid false sharing
+    static constexpr const size_t CacheLineSize = 64;
+
+    std::unique_ptr<Cell[]> _cells;
+    size_t _mask;
+    alignas(CacheLineSize) std::atomic<size_t> _enqueuePosition;
+    alignas(CacheLineSize) std::atomic<size_t> _dequeuePosition;
+};
+
+} // namespace openspace
+
+#include "lockfreeringbuffer.inl"
+
+#endif // __OPENSPACE_CORE___LOCK_FREE_RING_BUFFER___H__
@@ -0,0 +1,150 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2018                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <ghoul/misc/assert.h>
+
+namespace openspace {
+
+template <typename T>
+LockFreeRingBuffer<T>::LockFreeRingBuffer(size_t capacity)
+    : _enqueuePosition(0)
+    , _dequeuePosition(0)
+{
+    ghoul_assert(capacity > 0, "Capacity must be positive");
+
+    // Round up to the next power of two so that we can use a mask instead of modulo
+    size_t size = 1;
+    while (size < capacity) {
+        size <<= 1;
+    }
+
+    _cells = std::make_unique<Cell[]>(size);
+    _mask = size - 1;
+    for (size_t i = 0; i < size; ++i) {
+        _cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+template <typename T>
+LockFreeRingBuffer<T>::~LockFreeRingBuffer() {
+    // Destroy the items that are still stored in the buffer
+    T item;
+    while (tryPop(item)) {}
+}
+
+template <typename T>
+bool LockFreeRingBuffer<T>::tryPush(T&& item) {
+    return emplace(std::move(item));
+}
+
+template <typename T>
+bool LockFreeRingBuffer<T>::tryPush(const T& item) {
+    return emplace(item);
+}
+
+template <typename T>
+template <typename U>
+bool LockFreeRingBuffer<T>::emplace(U&& item) {
+    size_t pos = _enqueuePosition.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true) {
+        cell = &_cells[pos & _mask];
+        const size_t seq = cell->sequence.load(std::memory_order_acquire);
+        const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            // The cell is free; try to claim it
+            if (_enqueuePosition.compare_exchange_weak(
+                    pos,
+                    pos + 1,
+                    std::memory_order_relaxed
+                ))
+            {
+                break;
+            }
+        }
+        else if (diff < 0) {
+            // The cell still holds an item from the previous lap, so we are full
+            return false;
+        }
+        else {
+            // Another producer claimed this cell before us
+            pos = _enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    new (&cell->storage) T(std::forward<U>(item));
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+bool LockFreeRingBuffer<T>::tryPop(T& item) {
+    size_t pos = _dequeuePosition.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true) {
+        cell = &_cells[pos & _mask];
+        const size_t seq = cell->sequence.load(std::memory_order_acquire);
+        const intptr_t diff =
+            static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+        if (diff == 0) {
+            // The cell contains an item; try to claim it
+            if (_dequeuePosition.compare_exchange_weak(
+                    pos,
+                    pos + 1,
+                    std::memory_order_relaxed
+                ))
+            {
+                break;
+            }
+        }
+        else if (diff < 0) {
+            // The cell has not been written to yet, so we are empty
+            return false;
+        }
+        else {
+            // Another consumer claimed this cell before us
+            pos = _dequeuePosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    T* stored = reinterpret_cast<T*>(&cell->storage);
+    item = std::move(*stored);
+    stored->~T();
+    cell->sequence.store(pos + _mask + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+size_t LockFreeRingBuffer<T>::capacity() const {
+    return _mask + 1;
+}
+
+template <typename T>
+size_t LockFreeRingBuffer<T>::sizeApprox() const {
+    const size_t enqueue = _enqueuePosition.load(std::memory_order_relaxed);
+    const size_t dequeue = _dequeuePosition.load(std::memory_order_relaxed);
+    return enqueue > dequeue ? enqueue - dequeue : 0;
+}
+
+} // namespace openspace
@@ -0,0 +1,92 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2018                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___MEMORY_MAPPED_FILE___H__
+#define __OPENSPACE_CORE___MEMORY_MAPPED_FILE___H__
+
+#include <cstddef>
+#include <string>
+
+namespace openspace {
+
+/**
+ * A read-only view of a file that is mapped into the address space of the process. The
+ * contents of the file are paged in by the operating system on demand, so opening even
+ * very large files is cheap and only the accessed parts occupy memory.
+ */
+class MemoryMappedFile {
+public:
+    MemoryMappedFile() = default;
+
+    /**
+     * Maps the file at \p path into memory.
+     * \throw ghoul::RuntimeError If the file does not exist or cannot be mapped
+     */
+    explicit MemoryMappedFile(const std::string& path);
+    ~MemoryMappedFile();
+
+    MemoryMappedFile(MemoryMappedFile&& other) noexcept;
+    MemoryMappedFile& operator=(MemoryMappedFile&& other) noexcept;
+
+    MemoryMappedFile(const MemoryMappedFile&) = delete;
+    MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+    /**
+     * Maps the file at \p path into memory, replacing any previously mapped file. This
+     * can also be used to remap a file that has grown since it was mapped.
+     * \throw ghoul::RuntimeError If the file does not exist or cannot be mapped
+     */
+    void open(const std::string& path);
+
+    void close();
+
+    bool isOpen() const;
+
+    /**
+     * Returns the pointer to the first byte of the file. Empty files are not mapped and
+     * return <code>nullptr</code>.
+     */
+    const char* data() const;
+
+    size_t size() const;
+
+    const std::string& path() const;
+
+private:
+    std::string _path;
+    const char* _data = nullptr;
+    size_t _size = 0;
+    bool _isOpen = false;
+
+#ifdef WIN32
+    void* _fileHandle = nullptr;
+    void* _mappingHandle = nullptr;
+#else // WIN32
+    int _fileDescriptor = -1;
+#endif // WIN32
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_CORE___MEMORY_MAPPED_FILE___H__
@@ -541,6 +541,37 @@ public:
         const std::string& observer, const std::string& referenceFrame,
         AberrationCorrection aberrationCorrection, double ephemerisTime) const;
 
+    /**
+     * Computes the positions of a \p target body relative to an \p observer in a
+     * specific \p referenceFrame for a whole series of \p ephemerisTimes. The result is
+     * identical to calling #targetPosition for each time, but the NAIF ids of the
+     * \p target and \p observer are resolved only once and the SPK coverage is checked
+     * against the cached ids, which makes this method considerably faster for large
+     * numbers of queries, for example when sampling trails.
+     *
+     * \param target The target body name or the target body's NAIF ID
+     * \param observer The observing body name or the observing body's NAIF ID
+     * \param referenceFrame The reference frame of the output position vectors
+     * \param aberrationCorrection The aberration correction used for the position
+     *        calculation
+     * \param ephemerisTimes The times at which the positions are to be queried
+     * \param nTimes The number of values in \p ephemerisTimes
+     * \param positions The destination for the positions. Has to have space for at least
+     *        \p nTimes values
+     *
+     * \throw SpiceException Under the same conditions as #targetPosition
+     * \pre \p target must not be empty.
+     * \pre \p observer must not be empty.
+     * \pre \p referenceFrame must not be empty.
+     * \pre \p ephemerisTimes must not be nullptr if \p nTimes is not 0
+     * \pre \p positions must not be nullptr if \p nTimes is not 0
+     *
+     * \sa http://naif.jpl.nasa.gov/pub/naif/toolkit_docs/C/cspice/spkezp_c.html
+     */
+    void targetPositions(const std::string& target, const std::string& observer,
+        const std::string& referenceFrame, AberrationCorrection aberrationCorrection,
+        const double* ephemerisTimes, size_t nTimes, glm::dvec3* positions) const;
+
     /**
      * This method returns the transformation matrix that defines the transformation from
      * the reference frame \p from to the reference frame \p to. As both reference frames
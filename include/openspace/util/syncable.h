@@ -44,6 +44,15 @@ protected:
     friend class SyncEngine;
 
     virtual void preSync(bool /*isMaster*/) {};
+
+    /**
+     * Returns whether the synchronized data has changed since the last call to #encode.
+     * If the SyncEngine uses delta encoding, Syncables that have not changed are neither
+     * encoded nor decoded in a frame. The default implementation always returns
+     * \c true
+     */
+    virtual bool isDirty() const { return true; };
+
     virtual void encode(SyncBuffer* /*syncBuffer*/) = 0;
     virtual void decode(SyncBuffer* /*syncBuffer*/) = 0;
     virtual void postSync(bool /*isMaster*/) {};
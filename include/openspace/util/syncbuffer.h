@@ -26,6 +26,7 @@
 #define __OPENSPACE_CORE___SYNCBUFFER___H__
 
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace sgct {
@@ -60,6 +61,9 @@ public:
 
     void read();
 
+    /// Returns the number of bytes that have been encoded since the last #write
+    size_t encodedSize() const;
+
 private:
     size_t _n;
     size_t _encodeOffset = 0;
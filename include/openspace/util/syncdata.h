@@ -27,6 +27,7 @@
 
 #include <openspace/util/syncable.h>
 
+#include <array>
 #include <mutex>
 
 namespace openspace {
@@ -76,13 +77,19 @@ public:
     const T& data() const;
 
 protected:
+    virtual bool isDirty() const override;
     virtual void encode(SyncBuffer* syncBuffer) override;
     virtual void decode(SyncBuffer* syncBuffer) override;
     virtual void postSync(bool isMaster) override;
 
     T _data;
     T _doubleBufferedData;
-    std::mutex _mutex;
+    mutable std::mutex _mutex;
+
+    // The bytes of the last encoded value. They are compared bytewise as T does not
+    // need to be equality comparable and the value is transferred bytewise anyway
+    std::array<char, sizeof(T)> _encodedData;
+    bool _hasEncoded = false;
 };
 
 } // namespace openspace
@@ -24,6 +24,8 @@
 
 #include <openspace/util/syncbuffer.h>
 
+#include <cstring>
+
 namespace openspace {
 
 template<class T>
@@ -58,10 +60,18 @@ const T& SyncData<T>::data() const {
     return _data;
 }
 
+template<class T>
+bool SyncData<T>::isDirty() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return !_hasEncoded || memcmp(_encodedData.data(), &_data, sizeof(T)) != 0;
+}
+
 template<class T>
 void SyncData<T>::encode(SyncBuffer* syncBuffer) {
     _mutex.lock();
     syncBuffer->encode(_data);
+    memcpy(_encodedData.data(), &_data, sizeof(T));
+    _hasEncoded = true;
     _mutex.unlock();
 }
 
@@ -25,50 +25,160 @@
 #ifndef __OPENSPACE_CORE___THREAD_POOL___H__
 #define __OPENSPACE_CORE___THREAD_POOL___H__
 
+#include <openspace/util/lockfreeringbuffer.h>
+
+#include <atomic>
 #include <condition_variable>
+#include <cstddef>
+#include <deque>
 #include <functional>
+#include <memory>
 #include <mutex>
-#include <queue>
 #include <thread>
+#include <type_traits>
 #include <vector>
 
-// Implementation based on http://progsch.net/wordpress/?p=81
-
 namespace openspace {
 
-class ThreadPool;
-
-class Worker {
+/**
+ * A work-stealing thread pool. Every worker owns a lock-free queue into which tasks are
+ * distributed in a round-robin fashion (or, if a task is enqueued from one of the
+ * workers, into that worker's own queue). Idle workers first look at a shared priority
+ * lane, then at their own queue and finally steal from the queues of the other workers,
+ * so that producers and consumers rarely contend on the same memory. Tasks are stored in
+ * a small-buffer <code>Task</code> object, so enqueueing a callable that fits into
+ * <code>Task::BufferSize</code> bytes does not cause a heap allocation.
+ */
+class ThreadPool {
 public:
-    Worker(ThreadPool& p);
-    void operator()();
+    enum class Priority {
+        Normal = 0,
+        High
+    };
 
-private:
-    ThreadPool& pool;
-};
+    /**
+     * Type-erased, move-only wrapper for a <code>void()</code> callable. Callables that
+     * are smaller than <code>BufferSize</code> and are nothrow move constructible are
+     * stored inline, larger ones fall back to a heap allocation.
+     */
+    class Task {
+    public:
+        static constexpr const size_t BufferSize = 6 * sizeof(void*);
+
+        Task() = default;
+
+        template <typename F, typename = std::enable_if_t<
+            !std::is_same<std::decay_t<F>, Task>::value>>
+        Task(F&& function);
+
+        Task(Task&& other) noexcept;
+        Task& operator=(Task&& other) noexcept;
+        ~Task();
+
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+
+        void operator()();
+        explicit operator bool() const;
+
+    private:
+        struct Operations {
+            void (*invoke)(void* storage);
+            void (*move)(void* destination, void* source);
+            void (*destroy)(void* storage);
+        };
+
+        template <typename F>
+        static const Operations* inlineOperations();
+
+        template <typename F>
+        static const Operations* heapOperations();
+
+        void reset();
+
+        alignas(std::max_align_t) unsigned char _storage[BufferSize];
+        const Operations* _operations = nullptr;
+    };
 
-class ThreadPool {
-public:
     ThreadPool(size_t numThreads);
     ThreadPool(const ThreadPool& toCopy);
     ~ThreadPool();
 
-    void enqueue(std::function<void()> f);
+    /**
+     * Adds the \p task to the pool. Tasks with the <code>Priority::High</code> are
+     * picked up by the next idle worker before any task with a normal priority.
+     */
+    void enqueue(Task task, Priority priority = Priority::Normal);
+
+    /**
+     * Removes all tasks that have not been picked up by a worker yet. Tasks that are
+     * currently executing are not affected.
+     */
     void clearTasks();
 
+    size_t numThreads() const;
+
+    /**
+     * Returns <code>true</code> if this function is called from one of the workers of
+     * this pool.
+     */
+    bool isWorkerThread() const;
+
 private:
-    friend class Worker;
+    struct alignas(64) WorkerQueue {
+        WorkerQueue();
 
-    std::vector<std::thread> workers;
+        LockFreeRingBuffer<Task> tasks;
+    };
 
-    std::deque<std::function<void()>> tasks;
+    void workerLoop(size_t workerIndex);
+    bool tryPopTask(size_t workerIndex, Task& task);
+    size_t targetQueue();
+    void notifyWorker();
 
-    std::mutex queue_mutex;
-    std::condition_variable condition;
+    // If a lock-free queue is full, tasks are stored in an overflow queue instead. High
+    // priority tasks have their own overflow queue, so that they keep their priority
+    void pushOverflow(Task task, Priority priority);
+    bool tryPopOverflow(Task& task, Priority priority);
 
-    bool stop;
+    std::vector<std::thread> _workers;
+    std::vector<std::unique_ptr<WorkerQueue>> _queues;
+    LockFreeRingBuffer<Task> _priorityTasks;
+
+    std::deque<Task> _overflowTasks;
+    std::deque<Task> _priorityOverflowTasks;
+    std::mutex _overflowMutex;
+    std::atomic<size_t> _nOverflowTasks = { 0 };
+    std::atomic<size_t> _nPriorityOverflowTasks = { 0 };
+
+    // Upper bound for the number of tasks that are enqueued but not yet picked up
+    std::atomic<int64_t> _nPendingTasks = { 0 };
+    std::atomic<size_t> _nextQueue = { 0 };
+
+    std::atomic<int> _nSleepingWorkers = { 0 };
+    std::mutex _sleepMutex;
+    std::condition_variable _condition;
+
+    std::atomic_bool _stop = { false };
 };
 
+/**
+ * Calls \p function with every index in [0, \p n) and returns once all calls have
+ * finished, so \p function can safely reference local variables of the caller. The
+ * calls for the indices 1 to n - 1 are enqueued as high priority tasks into the \p pool,
+ * while the call for the index 0 is made on the calling thread instead of idling. If
+ * \p pool is <code>nullptr</code>, all calls are made on the calling thread in order.
+ * This is also the case if the function is called from one of the workers of \p pool,
+ * as waiting for the other workers from there could deadlock.
+ *
+ * If any of the calls throws, all other calls are still waited for and the first
+ * exception is rethrown on the calling thread afterwards.
+ */
+template <typename F>
+void parallelFor(ThreadPool* pool, size_t n, const F& function);
+
 } // namespace openspace
 
+#include "threadpool.inl"
+
 #endif // __OPENSPACE_CORE___THREAD_POOL___H__
@@ -0,0 +1,154 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2018                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <exception>
+#include <new>
+#include <utility>
+
+namespace openspace {
+
+template <typename F, typename>
+ThreadPool::Task::Task(F&& function) {
+    using Function = std::decay_t<F>;
+
+    constexpr const bool FitsInline =
+        sizeof(Function) <= BufferSize &&
+        alignof(Function) <= alignof(std::max_align_t) &&
+        std::is_nothrow_move_constructible<Function>::value;
+
+    if constexpr (FitsInline) {
+        new (_storage) Function(std::forward<F>(function));
+        _operations = inlineOperations<Function>();
+    }
+    else {
+        Function* f = new Function(std::forward<F>(function));
+        new (_storage) Function*(f);
+        _operations = heapOperations<Function>();
+    }
+}
+
+template <typename F>
+const ThreadPool::Task::Operations* ThreadPool::Task::inlineOperations() {
+    static const Operations Ops = {
+        [](void* storage) {
+            (*reinterpret_cast<F*>(storage))();
+        },
+        [](void* destination, void* source) {
+            F* s = reinterpret_cast<F*>(source);
+            new (destination) F(std::move(*s));
+            s->~F();
+        },
+        [](void* storage) {
+            reinterpret_cast<F*>(storage)->~F();
+        }
+    };
+    return &Ops;
+}
+
+template <typename F>
+const ThreadPool::Task::Operations* ThreadPool::Task::heapOperations() {
+    static const Operations Ops = {
+        [](void* storage) {
+            (**reinterpret_cast<F**>(storage))();
+        },
+        [](void* destination, void* source) {
+            new (destination) F*(*reinterpret_cast<F**>(source));
+        },
+        [](void* storage) {
+            delete *reinterpret_cast<F**>(storage);
+        }
+    };
+    return &Ops;
+}
+
+template <typename F>
+void parallelFor(ThreadPool* pool, size_t n, const F& function) {
+    // Waiting for tasks from one of the pool's own workers could deadlock if all other
+    // workers are waiting as well, so nested calls run on the calling thread
+    if (!pool || n <= 1 || pool->isWorkerThread()) {
+        for (size_t i = 0; i < n; ++i) {
+            function(i);
+        }
+        return;
+    }
+
+    struct State {
+        std::mutex mutex;
+        std::condition_variable allTasksFinished;
+        size_t nRemainingTasks;
+        // The first exception that was thrown by any of the calls
+        std::exception_ptr exception;
+    };
+    State state;
+    state.nRemainingTasks = n - 1;
+
+    for (size_t i = 1; i < n; ++i) {
+        pool->enqueue(
+            [&function, &state, i]() {
+                std::exception_ptr exception;
+                try {
+                    function(i);
+                }
+                catch (...) {
+                    exception = std::current_exception();
+                }
+
+                // Notify while holding the lock, as the waiting thread destroys the
+                // condition variable as soon as it sees the last task finish
+                std::lock_guard<std::mutex> lock(state.mutex);
+                if (exception && !state.exception) {
+                    state.exception = std::move(exception);
+                }
+                --state.nRemainingTasks;
+                if (state.nRemainingTasks == 0) {
+                    state.allTasksFinished.notify_one();
+                }
+            },
+            ThreadPool::Priority::High
+        );
+    }
+
+    // The enqueued tasks reference the state and the function, so we have to wait for
+    // them even if this call throws
+    std::exception_ptr exception;
+    try {
+        function(0);
+    }
+    catch (...) {
+        exception = std::current_exception();
+    }
+
+    std::unique_lock<std::mutex> lock(state.mutex);
+    state.allTasksFinished.wait(lock, [&state]() { return state.nRemainingTasks == 0; });
+    if (!exception) {
+        exception = std::move(state.exception);
+    }
+    lock.unlock();
+
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+}
+
+} // namespace openspace
@@ -0,0 +1,150 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2018                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/base/rendering/adaptivesampling.h>
+
+#include <ghoul/misc/assert.h>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace {
+    struct Interval {
+        size_t begin;
+        size_t end;
+    };
+
+    // Returns the distance between the point p and the line segment between a and b
+    double distanceToSegment(const glm::dvec3& p, const glm::dvec3& a,
+                             const glm::dvec3& b)
+    {
+        const glm::dvec3 ab = b - a;
+        const double length2 = glm::dot(ab, ab);
+        if (length2 == 0.0) {
+            return glm::distance(p, a);
+        }
+        const double t = glm::clamp(glm::dot(p - a, ab) / length2, 0.0, 1.0);
+        return glm::distance(p, a + t * ab);
+    }
+} // namespace
+
+namespace openspace {
+
+AdaptiveSamples sampleAdaptively(double start, double end, double minInterval,
+                                 double maxInterval, double tolerance,
+                                 const PositionBatchFunction& positions)
+{
+    ghoul_assert(start < end, "Start must be smaller than end");
+    ghoul_assert(minInterval > 0.0, "Minimum interval must be positive");
+    ghoul_assert(maxInterval >= minInterval, "Maximum interval must be >= minimum");
+    ghoul_assert(tolerance >= 0.0, "Tolerance must not be negative");
+
+    // The samples are appended in the order in which they are computed and only sorted
+    // by time at the very end
+    AdaptiveSamples samples;
+
+    const size_t nInitial = static_cast<size_t>(
+        std::max(1.0, std::ceil((end - start) / maxInterval))
+    );
+    const double initialInterval = (end - start) / nInitial;
+    samples.times.resize(nInitial + 1);
+    for (size_t i = 0; i < nInitial; ++i) {
+        samples.times[i] = start + i * initialInterval;
+    }
+    samples.times[nInitial] = end;
+    samples.positions.resize(samples.times.size());
+    positions(samples.times.data(), samples.times.size(), samples.positions.data());
+
+    // Intervals are subdivided breadth-first, so that all midpoints of one level can be
+    // computed in a single batch
+    std::vector<Interval> intervals;
+    if (initialInterval >= 2.0 * minInterval) {
+        intervals.reserve(nInitial);
+        for (size_t i = 0; i < nInitial; ++i) {
+            intervals.push_back({ i, i + 1 });
+        }
+    }
+
+    std::vector<Interval> nextIntervals;
+    std::vector<double> midTimes;
+    std::vector<glm::dvec3> midPositions;
+    while (!intervals.empty()) {
+        midTimes.resize(intervals.size());
+        for (size_t i = 0; i < intervals.size(); ++i) {
+            const Interval& interval = intervals[i];
+            midTimes[i] =
+                (samples.times[interval.begin] + samples.times[interval.end]) / 2.0;
+        }
+        midPositions.resize(midTimes.size());
+        positions(midTimes.data(), midTimes.size(), midPositions.data());
+
+        nextIntervals.clear();
+        for (size_t i = 0; i < intervals.size(); ++i) {
+            const Interval& interval = intervals[i];
+            const double error = distanceToSegment(
+                midPositions[i],
+                samples.positions[interval.begin],
+                samples.positions[interval.end]
+            );
+            if (error <= tolerance) {
+                // The chord is a good enough approximation of this part of the curve
+                continue;
+            }
+
+            const size_t mid = samples.times.size();
+            samples.times.push_back(midTimes[i]);
+            samples.positions.push_back(midPositions[i]);
+
+            // The halves can only be subdivided further if their halves are not shorter
+            // than the minimum interval
+            const double length =
+                samples.times[interval.end] - samples.times[interval.begin];
+            if (length / 2.0 >= 2.0 * minInterval) {
+                nextIntervals.push_back({ interval.begin, mid });
+                nextIntervals.push_back({ mid, interval.end });
+            }
+        }
+        std::swap(intervals, nextIntervals);
+    }
+
+    // Bring the samples into temporal order
+    std::vector<size_t> order(samples.times.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(
+        order.begin(),
+        order.end(),
+        [&t = samples.times](size_t lhs, size_t rhs) { return t[lhs] < t[rhs]; }
+    );
+
+    AdaptiveSamples result;
+    result.times.reserve(order.size());
+    result.positions.reserve(order.size());
+    for (size_t i : order) {
+        result.times.push_back(samples.times[i]);
+        result.positions.push_back(samples.positions[i]);
+    }
+    return result;
+}
+
+} // namespace openspace
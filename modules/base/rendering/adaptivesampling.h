@@ -0,0 +1,79 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2018                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_BASE___ADAPTIVESAMPLING___H__
+#define __OPENSPACE_MODULE_BASE___ADAPTIVESAMPLING___H__
+
+#include <ghoul/glm.h>
+#include <functional>
+#include <vector>
+
+namespace openspace {
+
+/// The positions of a curve at strictly increasing times
+struct AdaptiveSamples {
+    std::vector<double> times;
+    std::vector<glm::dvec3> positions;
+};
+
+/// Computes the positions of the curve at \p nTimes times at once
+using PositionBatchFunction = std::function<
+    void(const double* times, size_t nTimes, glm::dvec3* positions)
+>;
+
+/**
+ * Samples the curve provided by \p positions between \p start and \p end such that the
+ * chordal error, that is the distance between the curve and the straight lines that
+ * connect consecutive samples, is below \p tolerance.
+ *
+ * The time range is first split into a uniform grid with a spacing of at most
+ * \p maxInterval. Each interval is then recursively halved as long as its midpoint is
+ * further than \p tolerance away from the chord between its end points, but never into
+ * parts shorter than \p minInterval. As only the midpoint is tested, features of the
+ * curve that are shorter than \p maxInterval and that are symmetric around the midpoint
+ * can be missed, so \p maxInterval should be chosen with the dynamics of the curve in
+ * mind.
+ *
+ * All positions of a single subdivision level are requested in a single call of the
+ * \p positions function. The returned samples always include \p start and \p end.
+ *
+ * \param start The first time of the sampled range
+ * \param end The last time of the sampled range
+ * \param minInterval The smallest time between two samples
+ * \param maxInterval The largest time between two samples
+ * \param tolerance The maximum distance between the curve and its linear approximation
+ * \param positions The function that computes the positions of the curve
+ * \return The times and positions of the samples in ascending temporal order
+ *
+ * \pre \p start must be smaller than \p end
+ * \pre \p minInterval must be positive
+ * \pre \p maxInterval must not be smaller than \p minInterval
+ * \pre \p tolerance must not be negative
+ */
+AdaptiveSamples sampleAdaptively(double start, double end, double minInterval,
+    double maxInterval, double tolerance, const PositionBatchFunction& positions);
+
+} // namespace openspace
+
+#endif // __OPENSPACE_MODULE_BASE___ADAPTIVESAMPLING___H__
@@ -26,10 +26,16 @@
 
 #include <openspace/documentation/documentation.h>
 #include <openspace/documentation/verifier.h>
+#include <openspace/engine/openspaceengine.h>
 #include <openspace/scene/translation.h>
+#include <openspace/util/threadpool.h>
 #include <openspace/util/updatestructures.h>
 #include <ghoul/opengl/programobject.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <numeric>
+#include <vector>
 
 // This class is using a VBO ring buffer + a constantly updated point as follows:
 // Structure of the array with a _resolution of 16. FF denotes the floating position that
@@ -77,6 +83,12 @@
 //
 // NB: This method was implemented without a ring buffer before by manually shifting the
 // items in memory as was shown to be much slower than the current system.   ---abock
+//
+// The fixed points are sampled at integer multiples of the time between two points, such
+// that the same sample is used by every trail that contains it. These samples are kept in
+// a second, direct-mapped cache that is indexed by the sample's multiple (the key). After
+// a jump in time, only the samples that are not part of an overlapping, previous trail
+// have to be recomputed by the translation.
 
 namespace {
     constexpr openspace::properties::Property::PropertyInfo PeriodInfo = {
@@ -97,6 +109,21 @@ namespace {
         "smoother the trail, but also more memory will be used."
     };
 
+    // Marks an unused entry of the sample cache
+    constexpr const int64_t EmptyKey = std::numeric_limits<int64_t>::min();
+
+    // The sample cache can hold this many times the number of points in the trail
+    constexpr const int SampleCacheFactor = 2;
+
+    // The minimum number of samples that are computed by a single task when sweeping in
+    // parallel. Smaller batches are not worth the synchronization overhead
+    constexpr const size_t MinSamplesPerTask = 256;
+
+    size_t cacheSlot(int64_t key, size_t cacheSize) {
+        const int64_t n = static_cast<int64_t>(cacheSize);
+        return static_cast<size_t>(((key % n) + n) % n);
+    }
+
 } // namespace
 
 namespace openspace {
@@ -145,7 +172,10 @@ RenderableTrailOrbit::RenderableTrailOrbit(const ghoul::Dictionary& dictionary)
         "RenderableTrailOrbit"
     );
 
-    _translation->onParameterChange([this]() { _needsFullSweep = true; });
+    _translation->onParameterChange([this]() {
+        _needsFullSweep = true;
+        _sampleCacheDirty = true;
+    });
 
     // Period is in days
     using namespace std::chrono;
@@ -371,17 +401,13 @@ RenderableTrailOrbit::UpdateReport RenderableTrailOrbit::updateTrails(
             return { false, true, UpdateReport::All };
         }
 
+        int64_t key = std::llround(_lastPointTime / secondsPerPoint);
         for (int i = 0; i < nNewPoints; ++i) {
-            _lastPointTime += secondsPerPoint;
+            ++key;
 
             // Get the new permanent point and write it into the (previously) floating
             // location
-            const glm::vec3 p = _translation->position({
-                {},
-                _lastPointTime,
-                0.0,
-                false
-            });
+            const glm::vec3 p = samplePosition(key, secondsPerPoint);
             _vertexArray[_primaryRenderInformation.first] = { p.x, p.y, p.z };
 
             // Move the current pointer back one step to be used as the new floating
@@ -393,9 +419,12 @@ RenderableTrailOrbit::UpdateReport RenderableTrailOrbit::updateTrails(
             }
         }
 
+        _lastPointTime = key * secondsPerPoint;
         // The previously oldest permanent point has been moved nNewPoints steps into the
         // future
-        _firstPointTime += nNewPoints * secondsPerPoint;
+        _firstPointTime =
+            (std::llround(_firstPointTime / secondsPerPoint) + nNewPoints) *
+            secondsPerPoint;
 
         return { false, true, nNewPoints };
     }
@@ -411,17 +440,13 @@ RenderableTrailOrbit::UpdateReport RenderableTrailOrbit::updateTrails(
             return { false, true, UpdateReport::All };
         }
 
+        int64_t key = std::llround(_firstPointTime / secondsPerPoint);
         for (int i = 0; i < nNewPoints; ++i) {
-            _firstPointTime -= secondsPerPoint;
+            --key;
 
             // Get the new permanent point and write it into the (previously) floating
             // location
-            const glm::vec3 p = _translation->position({
-                {},
-                _firstPointTime,
-                0.0,
-                false
-            });
+            const glm::vec3 p = samplePosition(key, secondsPerPoint);
             _vertexArray[_primaryRenderInformation.first] = { p.x, p.y, p.z };
 
             // if we are on the upper bounds of the array, we start at 0
@@ -436,8 +461,11 @@ RenderableTrailOrbit::UpdateReport RenderableTrailOrbit::updateTrails(
             }
         }
 
+        _firstPointTime = key * secondsPerPoint;
         // The previously youngest point has become nNewPoints steps older
-        _lastPointTime -= nNewPoints * secondsPerPoint;
+        _lastPointTime =
+            (std::llround(_lastPointTime / secondsPerPoint) - nNewPoints) *
+            secondsPerPoint;
 
         return { false, true, -nNewPoints };
     }
@@ -457,22 +485,121 @@ void RenderableTrailOrbit::fullSweep(double time) {
         std::iota(_indexArray.begin() + _resolution, _indexArray.end(), 0);
     }
 
-    _lastPointTime = time;
+    _primaryRenderInformation.first = 0;
+    _primaryRenderInformation.count = _resolution;
+
+    if (_resolution < 2) {
+        // The only point is the floating current one
+        _lastPointTime = time;
+        _firstPointTime = time;
+        _needsFullSweep = false;
+        return;
+    }
 
     const double secondsPerPoint = _period / (_resolution - 1);
-    // starting at 1 because the first position is a floating current one
+
+    // Changing the period or the resolution moves all samples, changing the translation
+    // moves all positions
+    const size_t cacheSize = static_cast<size_t>(SampleCacheFactor) * _resolution;
+    if (_sampleCacheDirty || _sampleCache.size() != cacheSize ||
+        _sampleCacheSecondsPerPoint != secondsPerPoint)
+    {
+        _sampleCache.assign(cacheSize, { EmptyKey, glm::vec3(0.f) });
+        _sampleCacheSecondsPerPoint = secondsPerPoint;
+        _sampleCacheDirty = false;
+    }
+
+    // The newest fixed point is the last sample that is not in the future
+    const int64_t lastKey = static_cast<int64_t>(std::floor(time / secondsPerPoint));
+
+    // Starting at 1 because the first position is a floating current one. Vertex i
+    // contains the sample with the key (lastKey - i + 1)
+    _missingIndices.clear();
+    _missingTimes.clear();
     for (int i = 1; i < _resolution; ++i) {
-        const glm::vec3 p = _translation->position({ {}, time, 0.0, false });
+        const int64_t key = lastKey - i + 1;
+        const Sample& sample = _sampleCache[cacheSlot(key, cacheSize)];
+        if (sample.key == key) {
+            const glm::vec3& p = sample.position;
+            _vertexArray[i] = { p.x, p.y, p.z };
+        }
+        else {
+            _missingIndices.push_back(i);
+            _missingTimes.push_back(key * secondsPerPoint);
+        }
+    }
+
+    computeMissingPositions();
+
+    for (size_t j = 0; j < _missingIndices.size(); ++j) {
+        const int i = _missingIndices[j];
+        const int64_t key = lastKey - i + 1;
+        const glm::vec3 p = _missingPositions[j];
+        _sampleCache[cacheSlot(key, cacheSize)] = { key, p };
         _vertexArray[i] = { p.x, p.y, p.z };
+    }
+
+    _lastPointTime = lastKey * secondsPerPoint;
+    _firstPointTime = (lastKey - _resolution + 2) * secondsPerPoint;
+    _needsFullSweep = false;
+}
 
-        time -= secondsPerPoint;
+glm::vec3 RenderableTrailOrbit::samplePosition(int64_t key, double secondsPerPoint) {
+    // The cache is only sized by a full sweep with at least two points
+    if (_sampleCache.empty()) {
+        return _translation->position({ {}, key * secondsPerPoint, 0.0, false });
     }
 
-    _primaryRenderInformation.first = 0;
-    _primaryRenderInformation.count = _resolution;
+    Sample& sample = _sampleCache[cacheSlot(key, _sampleCache.size())];
+    if (sample.key != key) {
+        sample.key = key;
+        sample.position = _translation->position({
+            {},
+            key * secondsPerPoint,
+            0.0,
+            false
+        });
+    }
+    return sample.position;
+}
 
-    _firstPointTime = time + secondsPerPoint;
-    _needsFullSweep = false;
+void RenderableTrailOrbit::computeMissingPositions() {
+    const size_t nSamples = _missingTimes.size();
+    _missingPositions.resize(nSamples);
+
+    ThreadPool* pool = OsEng.computePool();
+    if (!pool || !_translation->supportsConcurrentUpdate() ||
+        nSamples < 2 * MinSamplesPerTask)
+    {
+        // All points are requested in a single batch so that the translation can
+        // amortize its lookups
+        _translation->positions(_missingTimes.data(), nSamples, _missingPositions.data());
+        return;
+    }
+
+    // Translations are allowed to lazily initialize their state on the first evaluation,
+    // so this has to happen before the remaining samples are computed concurrently
+    _translation->positions(_missingTimes.data(), 1, _missingPositions.data());
+
+    auto compute = [this](size_t begin, size_t end) {
+        _translation->positions(
+            _missingTimes.data() + begin,
+            end - begin,
+            _missingPositions.data() + begin
+        );
+    };
+
+    const size_t nRemaining = nSamples - 1;
+    const size_t nTasks = std::min(
+        pool->numThreads() + 1,
+        nRemaining / MinSamplesPerTask
+    );
+    const size_t samplesPerTask = (nRemaining + nTasks - 1) / nTasks;
+
+    parallelFor(pool, nTasks, [&compute, samplesPerTask, nSamples](size_t task) {
+        const size_t begin = 1 + task * samplesPerTask;
+        compute(begin, std::min(begin + samplesPerTask, nSamples));
+    });
 }
 
 } // namespace openspace
@@ -29,6 +29,8 @@
 
 #include <openspace/properties/scalar/doubleproperty.h>
 #include <openspace/properties/scalar/intproperty.h>
+#include <cstdint>
+#include <vector>
 
 namespace openspace {
 
@@ -62,6 +64,22 @@ private:
      */
     void fullSweep(double time);
 
+    /**
+     * Returns the position of the sample at the time <code>key * secondsPerPoint</code>,
+     * either from the sample cache or by computing and caching it.
+     * \param key The index of the sample in time
+     * \param secondsPerPoint The time between two consecutive samples
+     * \return The position of the sample
+     */
+    glm::vec3 samplePosition(int64_t key, double secondsPerPoint);
+
+    /**
+     * Computes the positions for all times in #_missingTimes and stores them in
+     * #_missingPositions. Large batches are distributed over the trail sampling pool of
+     * the BaseModule if the translation supports concurrent evaluation.
+     */
+    void computeMissingPositions();
+
     /// This structure is returned from the #updateTrails method and gives information
     /// about which parts of the vertex array to update
     struct UpdateReport {
@@ -102,6 +120,26 @@ private:
     double _lastPointTime = 0.0;
     /// The time stamp of when the last valid trail was generated.
     double _previousTime = 0.0;
+
+    /// A position of the translation at the time <code>key * secondsPerPoint</code>
+    struct Sample {
+        int64_t key;
+        glm::vec3 position;
+    };
+    /// Direct-mapped cache of previously computed samples, indexed by the key modulo the
+    /// size. It is larger than the trail, so that samples surrounding the current trail
+    /// are reused when jumping back and forth in time
+    std::vector<Sample> _sampleCache;
+    /// The time between samples for which the _sampleCache is valid
+    double _sampleCacheSecondsPerPoint = 0.0;
+    /// Set if the translation changed, which invalidates all cached samples
+    bool _sampleCacheDirty = true;
+
+    /// The vertex indices, times, and positions of the samples that were not found in
+    /// the cache during a full sweep. These are kept to avoid reallocations
+    std::vector<int> _missingIndices;
+    std::vector<double> _missingTimes;
+    std::vector<glm::dvec3> _missingPositions;
 };
 
 } // namespace openspace
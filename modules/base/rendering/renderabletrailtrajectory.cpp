@@ -24,11 +24,14 @@
 
 #include <modules/base/rendering/renderabletrailtrajectory.h>
 
+#include <modules/base/rendering/adaptivesampling.h>
 #include <openspace/documentation/documentation.h>
 #include <openspace/documentation/verifier.h>
 #include <openspace/scene/translation.h>
 #include <openspace/util/spicemanager.h>
 #include <openspace/util/updatestructures.h>
+#include <algorithm>
+#include <vector>
 
 // This class creates the entire trajectory at once and keeps it in memory the entire
 // time. This means that there is no need for updating the trail at runtime, but also that
@@ -41,6 +44,10 @@
 // bucket that contains the line from the last shown point to the current location of the
 // object iff not the entire path is shown and the object is between _startTime and
 // _endTime. This buffer is updated every frame.
+// If the trail is sampled adaptively, the vertices are no longer equidistant in time, so
+// their times are kept to find the last vertex that lies in the past. For the same reason,
+// the time stamp points and the line fade, which both depend on the vertex index, are not
+// used for such a trail.
 
 namespace {
     constexpr openspace::properties::Property::PropertyInfo StartTimeInfo = {
@@ -81,6 +88,30 @@ namespace {
         "If this value is set to 'true', the entire trail will be rendered; if it is "
         "'false', only the trail until the current time in the application will be shown."
     };
+
+    constexpr openspace::properties::Property::PropertyInfo AdaptiveSamplingInfo = {
+        "AdaptiveSampling",
+        "Adaptive Sampling",
+        "If this value is set to 'true', the trajectory is only sampled as densely as "
+        "is necessary to keep the trail within 'SampleTolerance' of the trajectory. The "
+        "samples are never closer than 'SampleInterval' / 'TimeStampSubsampleFactor' "
+        "and at most 64 times further apart than that. This reduces the number of "
+        "vertices on nearly straight parts of the trajectory, but the time stamps are no "
+        "longer equidistant in time. Therefore, the larger points of the "
+        "'TimeStampSubsampleFactor' and the line fading are not applied to adaptively "
+        "sampled trails."
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo SampleToleranceInfo = {
+        "SampleTolerance",
+        "Sample Tolerance (in meters)",
+        "The maximum distance between the trail and the trajectory if 'AdaptiveSampling' "
+        "is enabled. Smaller values result in more vertices."
+    };
+
+    // The number of times that the initial intervals of the adaptive sampling can be
+    // halved before reaching the sample interval
+    constexpr const int MaxSubdivisionLevels = 6;
 } // namespace
 
 namespace openspace {
@@ -121,6 +152,18 @@ documentation::Documentation RenderableTrailTrajectory::Documentation() {
                 new BoolVerifier,
                 Optional::Yes,
                 RenderFullPathInfo.description
+            },
+            {
+                AdaptiveSamplingInfo.identifier,
+                new BoolVerifier,
+                Optional::Yes,
+                AdaptiveSamplingInfo.description
+            },
+            {
+                SampleToleranceInfo.identifier,
+                new DoubleGreaterVerifier(0.0),
+                Optional::Yes,
+                SampleToleranceInfo.description
             }
         }
     };
@@ -145,6 +188,8 @@ RenderableTrailTrajectory::RenderableTrailTrajectory(const ghoul::Dictionary& di
     , _sampleInterval(SampleIntervalInfo, 2.0, 2.0, 1e6)
     , _timeStampSubsamplingFactor(TimeSubSampleInfo, 1, 1, 1000000000)
     , _renderFullTrail(RenderFullPathInfo, false)
+    , _adaptiveSampling(AdaptiveSamplingInfo, false)
+    , _sampleTolerance(SampleToleranceInfo, 1e6, 1.0, 1e12)
 {
     documentation::testSpecificationAndThrow(
         Documentation(),
@@ -179,6 +224,18 @@ RenderableTrailTrajectory::RenderableTrailTrajectory(const ghoul::Dictionary& di
     }
     addProperty(_renderFullTrail);
 
+    if (dictionary.hasKeyAndValue<bool>(AdaptiveSamplingInfo.identifier)) {
+        _adaptiveSampling = dictionary.value<bool>(AdaptiveSamplingInfo.identifier);
+    }
+    _adaptiveSampling.onChange([this] { _needsFullSweep = true; });
+    addProperty(_adaptiveSampling);
+
+    if (dictionary.hasKeyAndValue<double>(SampleToleranceInfo.identifier)) {
+        _sampleTolerance = dictionary.value<double>(SampleToleranceInfo.identifier);
+    }
+    _sampleTolerance.onChange([this] { _needsFullSweep = true; });
+    addProperty(_sampleTolerance);
+
     // We store the vertices with ascending temporal order
     _primaryRenderInformation.sorting = RenderInformation::VertexSorting::OldestFirst;
 }
@@ -214,22 +271,43 @@ void RenderableTrailTrajectory::update(const UpdateData& data) {
         _end = SpiceManager::ref().ephemerisTimeFromDate(_endTime);
 
         const double totalSampleInterval = _sampleInterval / _timeStampSubsamplingFactor;
-        // How many values do we need to compute given the distance between the start and
-        // end date and the desired sample interval
-        const int nValues = static_cast<int>((_end - _start) / totalSampleInterval);
 
-        // Make space for the vertices
-        _vertexArray.clear();
-        _vertexArray.resize(nValues);
+        std::vector<glm::dvec3> positions;
+        _sampleTimes.clear();
+        if (_adaptiveSampling && _start < _end) {
+            // Only sample as densely as the curvature of the trajectory requires
+            AdaptiveSamples samples = sampleAdaptively(
+                _start,
+                _end,
+                totalSampleInterval,
+                totalSampleInterval * (1 << MaxSubdivisionLevels),
+                _sampleTolerance,
+                [this](const double* times, size_t nTimes, glm::dvec3* result) {
+                    _translation->positions(times, nTimes, result);
+                }
+            );
+            _sampleTimes = std::move(samples.times);
+            positions = std::move(samples.positions);
+        }
+        else {
+            // How many values do we need to compute given the distance between the start
+            // and end date and the desired sample interval
+            const int nValues = static_cast<int>((_end - _start) / totalSampleInterval);
+
+            // ... compute all of the values in a single batch
+            std::vector<double> times(nValues);
+            for (int i = 0; i < nValues; ++i) {
+                times[i] = _start + i * totalSampleInterval;
+            }
+            positions.resize(nValues);
+            _translation->positions(times.data(), times.size(), positions.data());
+        }
 
-        // ... fill all of the values
-        for (int i = 0; i < nValues; ++i) {
-            const glm::vec3 p = _translation->position({
-                {},
-                _start + i * totalSampleInterval,
-                0.0,
-                false
-            });
+        // Make space for the vertices and fill all of the values
+        _vertexArray.clear();
+        _vertexArray.resize(positions.size());
+        for (size_t i = 0; i < positions.size(); ++i) {
+            const glm::vec3 p = positions[i];
             _vertexArray[i] = { p.x, p.y, p.z };
         }
 
@@ -265,14 +343,29 @@ void RenderableTrailTrajectory::update(const UpdateData& data) {
         // If only trail so far should be rendered, we need to find the corresponding time
         // in the array and only render it until then
         _primaryRenderInformation.first = 0;
-        const double t = std::max(
-            0.0,
-            (data.time.j2000Seconds() - _start) / (_end - _start)
-        );
-        _primaryRenderInformation.count = std::min(
-            static_cast<GLsizei>(ceil(_vertexArray.size() * t)),
-            static_cast<GLsizei>(_vertexArray.size() - 1)
-        );
+        if (_sampleTimes.empty()) {
+            const double t = std::max(
+                0.0,
+                (data.time.j2000Seconds() - _start) / (_end - _start)
+            );
+            _primaryRenderInformation.count = std::min(
+                static_cast<GLsizei>(ceil(_vertexArray.size() * t)),
+                static_cast<GLsizei>(_vertexArray.size() - 1)
+            );
+        }
+        else {
+            // The vertices are not equidistant in time, so we have to search for the
+            // first one that lies in the future
+            const auto it = std::upper_bound(
+                _sampleTimes.begin(),
+                _sampleTimes.end(),
+                data.time.j2000Seconds()
+            );
+            _primaryRenderInformation.count = std::min(
+                static_cast<GLsizei>(std::distance(_sampleTimes.begin(), it)),
+                static_cast<GLsizei>(_vertexArray.size() - 1)
+            );
+        }
     }
 
     // If we are inside the valid time, we additionally want to draw a line from the last
@@ -327,8 +420,26 @@ void RenderableTrailTrajectory::update(const UpdateData& data) {
     if (_subsamplingIsDirty) {
         // If the subsampling information has changed (either by a property change or by
         // a request of a full sweep) we update it here
-        _primaryRenderInformation.stride = _timeStampSubsamplingFactor;
-        _floatingRenderInformation.stride = _timeStampSubsamplingFactor;
+        if (_sampleTimes.empty()) {
+            _primaryRenderInformation.stride = _timeStampSubsamplingFactor;
+            _floatingRenderInformation.stride = _timeStampSubsamplingFactor;
+            _primaryRenderInformation.sorting =
+                RenderInformation::VertexSorting::OldestFirst;
+            _floatingRenderInformation.sorting =
+                RenderInformation::VertexSorting::OldestFirst;
+        }
+        else {
+            // Adaptively sampled vertices are not equidistant in time, so every n-th
+            // vertex no longer marks a time stamp and the vertex index no longer
+            // measures the age of the trail. Instead of showing misleading markers and
+            // fading, all points have the same size and the trail is not faded
+            _primaryRenderInformation.stride = 1;
+            _floatingRenderInformation.stride = 1;
+            _primaryRenderInformation.sorting =
+                RenderInformation::VertexSorting::NoSorting;
+            _floatingRenderInformation.sorting =
+                RenderInformation::VertexSorting::NoSorting;
+        }
         _subsamplingIsDirty = false;
     }
 
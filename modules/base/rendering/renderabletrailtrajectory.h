@@ -32,6 +32,7 @@
 #include <openspace/properties/scalar/doubleproperty.h>
 #include <openspace/properties/scalar/intproperty.h>
 #include <array>
+#include <vector>
 
 namespace openspace {
 
@@ -41,12 +42,15 @@ namespace documentation { struct Documentation; }
  * This concrete implementation of a RenderableTrail renders a fixed trail, regardless of
  * its shape. The trail is sampled equitemporal (with an interval of _sampleInterval in
  * seconds) between the _startTime and the _endTime. No further update is needed until any
- * of these three values is changed. If _renderFullTrail is true, the entirety of the
- * trail is rendered, regardless of the simulation time. If it is false, the trail is only
- * rendered from the past to the current simulation time, not showing any part of the
- * trail in the future. If _renderFullTrail is false, the current position of the object
- * has to be updated constantly to make the trail connect to the object that has the
- * trail.
+ * of these three values is changed. If _adaptiveSampling is enabled, the trail is instead
+ * only sampled as densely as needed to keep the distance between the trail and the true
+ * trajectory below _sampleTolerance; as the vertices are then no longer equidistant in
+ * time, neither the larger time stamp points nor the line fade are applied to such a
+ * trail. If _renderFullTrail is true, the entirety of the trail is rendered, regardless
+ * of the simulation time. If it is false, the trail is only rendered from the past to
+ * the current simulation time, not showing any part of the trail in the future. If
+ * _renderFullTrail is false, the current position of the object has to be updated
+ * constantly to make the trail connect to the object that has the trail.
  */
 class RenderableTrailTrajectory : public RenderableTrail {
 public:
@@ -71,6 +75,11 @@ private:
     properties::IntProperty _timeStampSubsamplingFactor;
     /// Determines whether the full trail should be rendered or the future trail removed
     properties::BoolProperty _renderFullTrail;
+    /// Determines whether the trail is sampled adaptively instead of uniformly
+    properties::BoolProperty _adaptiveSampling;
+    /// The maximum distance (in meters) between an adaptively sampled trail and the
+    /// trajectory
+    properties::DoubleProperty _sampleTolerance;
 
     /// Dirty flag that determines whether the full vertex buffer needs to be resampled
     bool _needsFullSweep = true;
@@ -84,6 +93,8 @@ private:
     double _start = 0.0;
     /// The conversion of the _endTime into the internal time format
     double _end = 0.0;
+    /// The times of the vertices if the trail was sampled adaptively, empty otherwise
+    std::vector<double> _sampleTimes;
 };
 
 } // namespace openspace
@@ -122,4 +122,8 @@ glm::dmat3 ConstantRotation::matrix(const UpdateData& data) const {
     return glm::toMat3(q);
 }
 
+bool ConstantRotation::supportsConcurrentUpdate() const {
+    return true;
+}
+
 } // namespace openspace
@@ -93,4 +93,8 @@ glm::dmat3 StaticRotation::matrix(const UpdateData&) const {
     return _rotationMatrix;
 }
 
+bool StaticRotation::supportsConcurrentUpdate() const {
+    return true;
+}
+
 } // namespace openspace
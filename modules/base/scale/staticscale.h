@@ -38,6 +38,7 @@ public:
     StaticScale();
     StaticScale(const ghoul::Dictionary& dictionary);
     double scaleValue(const UpdateData& data) const override;
+    bool supportsConcurrentUpdate() const override;
 
     static documentation::Documentation Documentation();
 
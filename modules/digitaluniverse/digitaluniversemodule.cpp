@@ -28,6 +28,7 @@
 #include <modules/digitaluniverse/rendering/renderabledumeshes.h>
 #include <modules/digitaluniverse/rendering/renderableplanescloud.h>
 #include <modules/digitaluniverse/rendering/renderablepoints.h>
+#include <modules/digitaluniverse/tasks/speckconversiontask.h>
 #include <openspace/documentation/documentation.h>
 #include <openspace/rendering/renderable.h>
 #include <openspace/util/factorymanager.h>
@@ -51,6 +52,10 @@ void DigitalUniverseModule::internalInitialize(const ghoul::Dictionary&) {
     fRenderable->registerClass<RenderableBillboardsCloud>("RenderableBillboardsCloud");
     fRenderable->registerClass<RenderablePlanesCloud>("RenderablePlanesCloud");
     fRenderable->registerClass<RenderableDUMeshes>("RenderableDUMeshes");
+
+    auto fTask = FactoryManager::ref().factory<Task>();
+    ghoul_assert(fTask, "No task factory existed");
+    fTask->registerClass<SpeckConversionTask>("SpeckConversionTask");
 }
 
 void DigitalUniverseModule::internalDeinitializeGL() {
@@ -63,7 +68,8 @@ std::vector<documentation::Documentation> DigitalUniverseModule::documentations(
         RenderablePoints::Documentation(),
         RenderableBillboardsCloud::Documentation(),
         RenderablePlanesCloud::Documentation(),
-        RenderableDUMeshes::Documentation()
+        RenderableDUMeshes::Documentation(),
+        SpeckConversionTask::documentation()
     };
 }
 
@@ -27,6 +27,7 @@
 
 #include <openspace/rendering/renderable.h>
 
+#include <modules/digitaluniverse/speckfile.h>
 #include <openspace/properties/optionproperty.h>
 #include <openspace/properties/stringproperty.h>
 #include <openspace/properties/scalar/boolproperty.h>
@@ -95,6 +96,7 @@ private:
     bool readColorMapFile();
     bool readLabelFile();
     bool loadCachedFile(const std::string& file);
+    bool loadBinarySpeckFile(const std::string& file);
     bool saveCachedFile(const std::string& file) const;
 
     bool _hasSpeckFile = false;
@@ -152,6 +154,7 @@ private:
 
     std::vector<float> _slicedData;
     std::vector<float> _fullData;
+    std::vector<speck::Column> _speckColumns;
     std::vector<glm::vec4> _colorMapData;
     std::vector<std::pair<glm::vec3, std::string>> _labelData;
     std::unordered_map<std::string, int> _variableDataPositionMap;
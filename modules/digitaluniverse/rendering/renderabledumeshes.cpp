@@ -27,6 +27,7 @@
 #include <modules/digitaluniverse/digitaluniversemodule.h>
 #include <openspace/documentation/documentation.h>
 #include <openspace/documentation/verifier.h>
+#include <openspace/util/floatparser.h>
 #include <openspace/util/updatestructures.h>
 #include <openspace/engine/openspaceengine.h>
 #include <openspace/engine/wrapper/windowwrapper.h>
@@ -786,18 +787,18 @@ bool RenderableDUMeshes::readSpeckFile() {
             for (int l = 0; l < mesh.numU * mesh.numV; ++l) {
                 std::getline(file, line);
                 if (line.substr(0, 1) != "}") {
-                    std::stringstream lineData(line);
-                    for (int i = 0; i < 7; ++i) {
-                        GLfloat value;
-                        lineData >> value;
-                        bool errorReading = lineData.rdstate() & std::ifstream::failbit;
-                        if (!errorReading) {
-                            mesh.vertices.push_back(value);
-                        }
-                        else {
-                            break;
-                        }
-                    }
+                    std::array<GLfloat, 7> values;
+                    const size_t nValues = parseFloats(
+                        line.data(),
+                        line.data() + line.size(),
+                        values.data(),
+                        values.size()
+                    );
+                    mesh.vertices.insert(
+                        mesh.vertices.end(),
+                        values.begin(),
+                        values.begin() + nValues
+                    );
                 }
                 else {
                     break;
@@ -27,6 +27,8 @@
 #include <modules/digitaluniverse/digitaluniversemodule.h>
 #include <openspace/documentation/documentation.h>
 #include <openspace/documentation/verifier.h>
+#include <openspace/util/floatparser.h>
+#include <openspace/util/memorymappedfile.h>
 #include <openspace/util/updatestructures.h>
 #include <openspace/engine/openspaceengine.h>
 #include <openspace/rendering/renderengine.h>
@@ -861,7 +863,9 @@ bool RenderablePlanesCloud::loadTextures() {
 }
 
 bool RenderablePlanesCloud::readSpeckFile() {
-    std::ifstream file(_speckFile);
+    // The file is opened in binary mode, as the position after the header is used as an
+    // offset into the memory mapped file, which text mode does not guarantee
+    std::ifstream file(_speckFile, std::ios::binary);
     if (!file.good()) {
         LERROR(fmt::format("Failed to open Speck file '{}'", _speckFile));
         return false;
@@ -985,61 +989,20 @@ bool RenderablePlanesCloud::readSpeckFile() {
 
     _nValuesPerAstronomicalObject += 3; // X Y Z are not counted in the Speck file indices
 
-    do {
-        std::vector<float> values(_nValuesPerAstronomicalObject);
-
-        std::getline(file, line);
-
-        // Guard against wrong line endings (copying files from Windows to Mac) causes
-        // lines to have a final \r
-        if (!line.empty() && line.back() == '\r') {
-            line = line.substr(0, line.length() -1);
-        }
-
-        if (line.empty()) {
-            continue;
-        }
-
-        std::stringstream str(line);
-
-        glm::vec3 u(0.f);
-        glm::vec3 v(0.f);
-        int textureIndex = 0;
-
-        for (int i = 0; i < _nValuesPerAstronomicalObject; ++i) {
-            str >> values[i];
-            if ((i >= _planeStartingIndexPos) &&
-                (i <= _planeStartingIndexPos + 6)) { // vectors u and v
-                int index = i - _planeStartingIndexPos;
-                switch (index) {
-                    case 0:
-                        u.x = values[i];
-                        break;
-                    case 1:
-                        u.y = values[i];
-                        break;
-                    case 2:
-                        u.z = values[i];
-                        break;
-                    case 3:
-                        v.x = values[i];
-                        break;
-                    case 4:
-                        v.y = values[i];
-                        break;
-                    case 5:
-                        v.z = values[i];
-                        break;
-                }
-            }
-
-            // JCC: This should be moved to the RenderablePlanesCloud:
-            if (i == _textureVariableIndex) {
-                textureIndex = static_cast<int>(values[i]);
-            }
-        }
-        _fullData.insert(_fullData.end(), values.begin(), values.end());
-    } while (!file.eof());
+    // The data block is parsed directly from the memory mapped file
+    const std::streamoff dataOffset = file.tellg();
+    if (dataOffset < 0) {
+        return true;
+    }
+    file.close();
+
+    const MemoryMappedFile mappedFile(_speckFile);
+    parseFloatBlock(
+        mappedFile.data() + dataOffset,
+        mappedFile.data() + mappedFile.size(),
+        _nValuesPerAstronomicalObject,
+        _fullData
+    );
 
     return true;
 }
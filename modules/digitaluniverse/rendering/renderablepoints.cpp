@@ -25,6 +25,7 @@
 #include <modules/digitaluniverse/rendering/renderablepoints.h>
 
 #include <modules/digitaluniverse/digitaluniversemodule.h>
+#include <modules/digitaluniverse/speckfile.h>
 #include <openspace/documentation/documentation.h>
 #include <openspace/documentation/verifier.h>
 #include <openspace/util/updatestructures.h>
@@ -63,7 +64,6 @@ namespace {
     constexpr const char* GigaparsecUnit = "Gpc";
     constexpr const char* GigalightyearUnit = "Gly";
 
-    constexpr int8_t CurrentCacheVersion = 1;
     constexpr double PARSEC = 0.308567756E17;
 
     constexpr openspace::properties::Property::PropertyInfo SpriteTextureInfo = {
@@ -432,6 +432,17 @@ void RenderablePoints::update(const UpdateData&) {
 }
 
 bool RenderablePoints::loadData() {
+    // Binary speck files, for example written by the SpeckConversionTask, are memory
+    // mapped directly and do not need a cache
+    if (speck::isBinarySpeckFile(_speckFile)) {
+        LINFO(fmt::format("Loading binary Speck file '{}'", _speckFile));
+        bool success = loadBinarySpeckFile(_speckFile);
+        if (_hasColorMapFile) {
+            success &= readColorMapFile();
+        }
+        return success;
+    }
+
     std::string cachedFile = FileSys.cacheManager()->cachedFilename(
         _speckFile,
         ghoul::filesystem::CacheManager::Persistent::Yes
@@ -478,70 +489,17 @@ bool RenderablePoints::loadData() {
 }
 
 bool RenderablePoints::readSpeckFile() {
-    std::ifstream file(_speckFile);
-    if (!file.good()) {
-        LERROR(fmt::format("Failed to open Speck file '{}'", _speckFile));
-        return false;
+    try {
+        speck::SpeckData data = speck::readSpeckFile(_speckFile);
+        _nValuesPerAstronomicalObject = static_cast<int>(data.nValuesPerObject());
+        _speckColumns = std::move(data.columns);
+        _fullData = std::move(data.values);
+        return true;
     }
-
-    _nValuesPerAstronomicalObject = 0;
-
-    // The beginning of the speck file has a header that either contains comments
-    // (signaled by a preceding '#') or information about the structure of the file
-    // (signaled by the keywords 'datavar', 'texturevar', and 'texture')
-    std::string line = "";
-    while (true) {
-        std::streampos position = file.tellg();
-        std::getline(file, line);
-
-        if (line[0] == '#' || line.empty()) {
-            continue;
-        }
-
-        if (line.substr(0, 7) != "datavar" &&
-            line.substr(0, 10) != "texturevar" &&
-            line.substr(0, 7) != "texture")
-        {
-            // we read a line that doesn't belong to the header, so we have to jump
-            // back before the beginning of the current line
-            file.seekg(position);
-            break;
-        }
-
-        if (line.substr(0, 7) == "datavar") {
-            // datavar lines are structured as follows:
-            // datavar # description
-            // where # is the index of the data variable; so if we repeatedly
-            // overwrite the 'nValues' variable with the latest index, we will end up
-            // with the total number of values (+3 since X Y Z are not counted in the
-            // Speck file index)
-            std::stringstream str(line);
-
-            std::string dummy;
-            str >> dummy;
-            str >> _nValuesPerAstronomicalObject;
-            // We want the number, but the index is 0 based
-            _nValuesPerAstronomicalObject += 1;
-        }
+    catch (const ghoul::RuntimeError& e) {
+        LERROR(e.message);
+        return false;
     }
-
-    // X Y Z are not counted in the Speck file indices
-    _nValuesPerAstronomicalObject += 3;
-
-    do {
-        std::vector<float> values(_nValuesPerAstronomicalObject);
-
-        std::getline(file, line);
-        std::stringstream str(line);
-
-        for (int i = 0; i < _nValuesPerAstronomicalObject; ++i) {
-            str >> values[i];
-        }
-
-        _fullData.insert(_fullData.end(), values.begin(), values.end());
-    } while (!file.eof());
-
-    return true;
 }
 
 bool RenderablePoints::readColorMapFile() {
@@ -593,73 +551,43 @@ bool RenderablePoints::readColorMapFile() {
 }
 
 bool RenderablePoints::loadCachedFile(const std::string& file) {
-    std::ifstream fileStream(file, std::ifstream::binary);
-    if (fileStream.good()) {
-        int8_t version = 0;
-        fileStream.read(reinterpret_cast<char*>(&version), sizeof(int8_t));
-        if (version != CurrentCacheVersion) {
-            LINFO("The format of the cached file has changed: deleting old cache");
-            fileStream.close();
-            FileSys.deleteFile(file);
-            return false;
-        }
-
-        int32_t nValues = 0;
-        fileStream.read(reinterpret_cast<char*>(&nValues), sizeof(int32_t));
-        fileStream.read(
-            reinterpret_cast<char*>(&_nValuesPerAstronomicalObject),
-            sizeof(int32_t)
-        );
-
-        _fullData.resize(nValues);
-        fileStream.read(reinterpret_cast<char*>(
-            &_fullData[0]),
-            nValues * sizeof(_fullData[0])
-        );
+    const bool success = loadBinarySpeckFile(file);
+    if (!success) {
+        LINFO("The format of the cached file has changed: deleting old cache");
+        FileSys.deleteFile(file);
+    }
+    return success;
+}
 
-        const bool success = fileStream.good();
-        return success;
+bool RenderablePoints::loadBinarySpeckFile(const std::string& file) {
+    try {
+        const speck::BinarySpeckFile speckFile(file);
+        const size_t nValues = speckFile.nObjects() * speckFile.nValuesPerObject();
+        _nValuesPerAstronomicalObject = static_cast<int>(speckFile.nValuesPerObject());
+        _speckColumns = speckFile.columns();
+        // The records are stored in the layout that createDataSlice expects, so they
+        // are taken from the mapped file in a single copy
+        _fullData.assign(speckFile.values(), speckFile.values() + nValues);
+        return true;
     }
-    else {
-        LERROR(fmt::format(
-            "Error opening file '{}' for loading cache file",
-            file
-        ));
+    catch (const ghoul::RuntimeError& e) {
+        LWARNING(e.message);
         return false;
     }
 }
 
 bool RenderablePoints::saveCachedFile(const std::string& file) const {
-    std::ofstream fileStream(file, std::ofstream::binary);
-    if (fileStream.good()) {
-        fileStream.write(
-            reinterpret_cast<const char*>(&CurrentCacheVersion),
-            sizeof(int8_t)
-        );
-
-        const int32_t nValues = static_cast<int32_t>(_fullData.size());
-        if (nValues == 0) {
-            LERROR("Error writing cache: No values were loaded");
-            return false;
-        }
-        fileStream.write(reinterpret_cast<const char*>(&nValues), sizeof(int32_t));
-
-        const int32_t nValuesPerAstronomicalObject = static_cast<int32_t>(
-            _nValuesPerAstronomicalObject
-        );
-        fileStream.write(
-            reinterpret_cast<const char*>(&nValuesPerAstronomicalObject),
-            sizeof(int32_t)
-        );
-
-        const size_t nBytes = nValues * sizeof(_fullData[0]);
-        fileStream.write(reinterpret_cast<const char*>(&_fullData[0]), nBytes);
+    if (_fullData.empty()) {
+        LERROR("Error writing cache: No values were loaded");
+        return false;
+    }
 
-        const bool success = fileStream.good();
-        return success;
+    try {
+        speck::saveBinarySpeckFile(_speckColumns, _fullData, file);
+        return true;
     }
-    else {
-        LERROR(fmt::format("Error opening file '{}' for save cache file", file));
+    catch (const ghoul::RuntimeError& e) {
+        LERROR(e.message);
         return false;
     }
 }
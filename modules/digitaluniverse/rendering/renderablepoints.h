@@ -27,6 +27,7 @@
 
 #include <openspace/rendering/renderable.h>
 
+#include <modules/digitaluniverse/speckfile.h>
 #include <openspace/properties/optionproperty.h>
 #include <openspace/properties/stringproperty.h>
 #include <openspace/properties/scalar/boolproperty.h>
@@ -80,6 +81,7 @@ private:
     bool readSpeckFile();
     bool readColorMapFile();
     bool loadCachedFile(const std::string& file);
+    bool loadBinarySpeckFile(const std::string& file);
     bool saveCachedFile(const std::string& file) const;
 
     bool _dataIsDirty = true;
@@ -105,6 +107,7 @@ private:
 
     std::vector<double> _slicedData;
     std::vector<float> _fullData;
+    std::vector<speck::Column> _speckColumns;
     std::vector<glm::vec4> _colorMapData;
 
     int _nValuesPerAstronomicalObject = 0;
@@ -0,0 +1,327 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2018                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/digitaluniverse/speckfile.h>
+
+#include <openspace/util/floatparser.h>
+#include <ghoul/fmt.h>
+#include <ghoul/misc/exception.h>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+namespace {
+    constexpr const char* _loggerCat = "SpeckFile";
+
+    constexpr const std::array<char, 8> Magic = {
+        'O', 'S', 'S', 'P', 'E', 'C', 'K', '\0'
+    };
+    constexpr const uint32_t CurrentVersion = 1;
+    constexpr const uint64_t DataAlignment = 16;
+
+    struct Header {
+        std::array<char, 8> magic;
+        uint32_t version;
+        uint32_t nColumns;
+        uint64_t nObjects;
+        // Offset of the first record from the beginning of the file
+        uint64_t dataOffset;
+    };
+    static_assert(sizeof(Header) == 32, "The header must not contain padding");
+
+    // Each column is stored as type, three reserved bytes, minimum, maximum, the length
+    // of the name, and the name without a terminating null character
+    constexpr const size_t ColumnDescriptionSize = 4 + 2 * sizeof(float) +
+                                                   sizeof(uint32_t);
+
+    bool isHeaderLine(const std::string& line) {
+        return line.substr(0, 7) == "datavar" ||
+               line.substr(0, 10) == "texturevar" ||
+               line.substr(0, 7) == "texture" ||
+               line.substr(0, 10) == "polyorivar" ||
+               line.substr(0, 10) == "maxcomment";
+    }
+
+    // Guard against wrong line endings (copying files from Windows to Mac) causes lines
+    // to have a final \r
+    void stripCarriageReturn(std::string& line) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+    }
+} // namespace
+
+namespace openspace::speck {
+
+size_t SpeckData::nValuesPerObject() const {
+    return columns.size();
+}
+
+size_t SpeckData::nObjects() const {
+    return columns.empty() ? 0 : values.size() / columns.size();
+}
+
+std::unordered_map<std::string, int> SpeckData::dataVariables() const {
+    std::unordered_map<std::string, int> result;
+    for (size_t i = 3; i < columns.size(); ++i) {
+        result.insert({ columns[i].name, static_cast<int>(i - 3) });
+    }
+    return result;
+}
+
+SpeckData readSpeckFile(const std::string& path) {
+    MemoryMappedFile file;
+    try {
+        file.open(path);
+    }
+    catch (const ghoul::RuntimeError&) {
+        throw ghoul::RuntimeError(
+            fmt::format("Failed to open Speck file '{}'", path),
+            _loggerCat
+        );
+    }
+
+    SpeckData result;
+    result.columns = { { "x" }, { "y" }, { "z" } };
+
+    // The beginning of the speck file has a header that either contains comments
+    // (signaled by a preceding '#') or information about the structure of the file
+    // (signaled by the keywords 'datavar', 'texturevar', and 'texture')
+    const char* p = file.data();
+    const char* end = file.data() + file.size();
+    while (p != end) {
+        const char* lineEnd = static_cast<const char*>(
+            std::memchr(p, '\n', static_cast<size_t>(end - p))
+        );
+        if (!lineEnd) {
+            lineEnd = end;
+        }
+        std::string line(p, lineEnd);
+        stripCarriageReturn(line);
+
+        if (!line.empty() && line[0] != '#') {
+            if (!isHeaderLine(line)) {
+                // we read a line that doesn't belong to the header, so the data block
+                // starts at the beginning of the current line
+                break;
+            }
+
+            if (line.substr(0, 7) == "datavar") {
+                // datavar lines are structured as follows:
+                // datavar # description
+                // where # is the 0-based index of the data variable. X Y Z are not
+                // counted in the Speck file index
+                std::stringstream str(line);
+
+                std::string command;
+                int index = 0;
+                if (!(str >> command >> index) || index < 0) {
+                    throw ghoul::RuntimeError(
+                        fmt::format("Invalid datavar line '{}' in '{}'", line, path),
+                        _loggerCat
+                    );
+                }
+                std::string name;
+                str >> name;
+
+                const size_t column = static_cast<size_t>(index) + 3;
+                if (result.columns.size() <= column) {
+                    result.columns.resize(column + 1);
+                }
+                result.columns[column].name = name;
+            }
+        }
+
+        p = (lineEnd == end) ? end : lineEnd + 1;
+    }
+
+    const size_t nValues = result.columns.size();
+    parseFloatBlock(p, end, nValues, result.values);
+
+    for (size_t c = 0; c < nValues; ++c) {
+        Column& column = result.columns[c];
+        column.minimum = std::numeric_limits<float>::max();
+        column.maximum = std::numeric_limits<float>::lowest();
+        for (size_t i = c; i < result.values.size(); i += nValues) {
+            column.minimum = std::min(column.minimum, result.values[i]);
+            column.maximum = std::max(column.maximum, result.values[i]);
+        }
+        if (result.values.empty()) {
+            column.minimum = 0.f;
+            column.maximum = 0.f;
+        }
+    }
+
+    return result;
+}
+
+void saveBinarySpeckFile(const SpeckData& data, const std::string& path) {
+    saveBinarySpeckFile(data.columns, data.values, path);
+}
+
+void saveBinarySpeckFile(const std::vector<Column>& columns,
+                         const std::vector<float>& values, const std::string& path)
+{
+    std::ofstream file(path, std::ofstream::binary);
+    if (!file.good()) {
+        throw ghoul::RuntimeError(
+            fmt::format("Error opening file '{}' for writing", path),
+            _loggerCat
+        );
+    }
+
+    uint64_t columnsSize = 0;
+    for (const Column& column : columns) {
+        columnsSize += ColumnDescriptionSize + column.name.size();
+    }
+    const uint64_t unalignedOffset = sizeof(Header) + columnsSize;
+
+    Header header;
+    header.magic = Magic;
+    header.version = CurrentVersion;
+    header.nColumns = static_cast<uint32_t>(columns.size());
+    header.nObjects = columns.empty() ? 0 : values.size() / columns.size();
+    header.dataOffset = (unalignedOffset + DataAlignment - 1) / DataAlignment *
+                        DataAlignment;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+
+    for (const Column& column : columns) {
+        const std::array<char, 4> type = { static_cast<char>(column.type), 0, 0, 0 };
+        file.write(type.data(), type.size());
+        file.write(reinterpret_cast<const char*>(&column.minimum), sizeof(float));
+        file.write(reinterpret_cast<const char*>(&column.maximum), sizeof(float));
+        const uint32_t nameLength = static_cast<uint32_t>(column.name.size());
+        file.write(reinterpret_cast<const char*>(&nameLength), sizeof(uint32_t));
+        file.write(column.name.data(), nameLength);
+    }
+
+    const std::array<char, DataAlignment> padding = {};
+    file.write(padding.data(), header.dataOffset - unalignedOffset);
+
+    file.write(
+        reinterpret_cast<const char*>(values.data()),
+        header.nObjects * header.nColumns * sizeof(float)
+    );
+
+    if (!file.good()) {
+        throw ghoul::RuntimeError(
+            fmt::format("Error writing binary speck file '{}'", path),
+            _loggerCat
+        );
+    }
+}
+
+bool isBinarySpeckFile(const std::string& path) {
+    std::ifstream file(path, std::ifstream::binary);
+    std::array<char, 8> magic = {};
+    file.read(magic.data(), magic.size());
+    return file.good() && magic == Magic;
+}
+
+BinarySpeckFile::BinarySpeckFile(const std::string& path) : _file(path) {
+    auto error = [&path](const char* message) {
+        return ghoul::RuntimeError(
+            fmt::format("Binary speck file '{}': {}", path, message),
+            _loggerCat
+        );
+    };
+
+    if (_file.size() < sizeof(Header)) {
+        throw error("File is too small");
+    }
+
+    Header header;
+    std::memcpy(&header, _file.data(), sizeof(Header));
+    if (header.magic != Magic) {
+        throw error("Not a binary speck file");
+    }
+    if (header.version != CurrentVersion) {
+        throw error("Unsupported version");
+    }
+
+    const char* p = _file.data() + sizeof(Header);
+    const char* end = _file.data() + std::min<uint64_t>(header.dataOffset, _file.size());
+    _columns.reserve(header.nColumns);
+    for (uint32_t i = 0; i < header.nColumns; ++i) {
+        if (static_cast<size_t>(end - p) < ColumnDescriptionSize) {
+            throw error("Truncated column descriptions");
+        }
+        Column column;
+        column.type = static_cast<ColumnType>(static_cast<uint8_t>(p[0]));
+        if (column.type != ColumnType::Float32) {
+            throw error("Unsupported column type");
+        }
+        std::memcpy(&column.minimum, p + 4, sizeof(float));
+        std::memcpy(&column.maximum, p + 4 + sizeof(float), sizeof(float));
+        uint32_t nameLength = 0;
+        std::memcpy(&nameLength, p + 4 + 2 * sizeof(float), sizeof(uint32_t));
+        p += ColumnDescriptionSize;
+
+        if (static_cast<size_t>(end - p) < nameLength) {
+            throw error("Truncated column descriptions");
+        }
+        column.name = std::string(p, nameLength);
+        p += nameLength;
+        _columns.push_back(std::move(column));
+    }
+
+    const uint64_t dataSize = header.nObjects * header.nColumns * sizeof(float);
+    if (header.dataOffset % alignof(float) != 0 ||
+        header.dataOffset + dataSize > _file.size())
+    {
+        throw error("Truncated records");
+    }
+
+    _nObjects = header.nObjects;
+    // The mapping starts at a page boundary, so the aligned offset is aligned for floats
+    _values = reinterpret_cast<const float*>(_file.data() + header.dataOffset);
+}
+
+const std::vector<Column>& BinarySpeckFile::columns() const {
+    return _columns;
+}
+
+size_t BinarySpeckFile::nValuesPerObject() const {
+    return _columns.size();
+}
+
+size_t BinarySpeckFile::nObjects() const {
+    return static_cast<size_t>(_nObjects);
+}
+
+const float* BinarySpeckFile::values() const {
+    return _values;
+}
+
+SpeckData BinarySpeckFile::data() const {
+    SpeckData result;
+    result.columns = _columns;
+    result.values.assign(_values, _values + _nObjects * _columns.size());
+    return result;
+}
+
+} // namespace openspace::speck
@@ -0,0 +1,149 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2018                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_DIGITALUNIVERSE___SPECKFILE___H__
+#define __OPENSPACE_MODULE_DIGITALUNIVERSE___SPECKFILE___H__
+
+#include <openspace/util/memorymappedfile.h>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace openspace::speck {
+
+/**
+ * The type of the values stored in a column of a binary speck file. Every column that
+ * the text format can express is stored as 32 bit floating point values, the type is
+ * recorded so that other types can be added without changing the header layout.
+ */
+enum class ColumnType : uint8_t {
+    Float32 = 0
+};
+
+/**
+ * Describes one value of the records in a speck file. The first three columns are
+ * always the <code>x</code>, <code>y</code>, and <code>z</code> positions, followed by
+ * one column per <code>datavar</code> of the speck file.
+ */
+struct Column {
+    std::string name;
+    ColumnType type = ColumnType::Float32;
+    float minimum = 0.f;
+    float maximum = 0.f;
+};
+
+/**
+ * The contents of a speck file. The records are stored interleaved, that is all values
+ * of the first object are followed by all values of the second object, which is the
+ * layout that the renderables slice their vertex data from.
+ */
+struct SpeckData {
+    std::vector<Column> columns;
+    std::vector<float> values;
+
+    size_t nValuesPerObject() const;
+    size_t nObjects() const;
+
+    /**
+     * Returns the mapping from the names of the <code>datavar</code>s to their 0-based
+     * index in the speck file, which is their column index minus the three positions.
+     */
+    std::unordered_map<std::string, int> dataVariables() const;
+};
+
+/**
+ * Parses the text speck file at \p path. The header lines (<code>datavar</code>,
+ * <code>texturevar</code>, <code>texture</code>, <code>polyorivar</code>, and
+ * <code>maxcomment</code>) and comments are consumed and each remaining non-empty line
+ * results in one record. Missing values of a record are set to 0.
+ *
+ * \throw ghoul::RuntimeError If the file cannot be opened
+ */
+SpeckData readSpeckFile(const std::string& path);
+
+/**
+ * Writes \p data to \p path in the binary speck format. The file starts with a fixed size
+ * header followed by the column descriptions and the records, which begin at an offset
+ * aligned to 16 bytes.
+ *
+ * \throw ghoul::RuntimeError If the file cannot be written
+ */
+void saveBinarySpeckFile(const SpeckData& data, const std::string& path);
+
+/**
+ * Writes the records \p values that are described by \p columns to \p path in the
+ * binary speck format.
+ *
+ * \throw ghoul::RuntimeError If the file cannot be written
+ */
+void saveBinarySpeckFile(const std::vector<Column>& columns,
+    const std::vector<float>& values, const std::string& path);
+
+/**
+ * Returns <code>true</code> if the file at \p path starts with the magic bytes of the
+ * binary speck format.
+ */
+bool isBinarySpeckFile(const std::string& path);
+
+/**
+ * A binary speck file that is memory mapped on construction. The header and the column
+ * descriptions are parsed immediately, the records are paged in by the operating system
+ * when they are accessed through the <code>values</code> pointer.
+ */
+class BinarySpeckFile {
+public:
+    /**
+     * Maps the binary speck file at \p path.
+     *
+     * \throw ghoul::RuntimeError If the file cannot be mapped, is not a binary speck
+     *        file, has a different version, or is truncated
+     */
+    explicit BinarySpeckFile(const std::string& path);
+
+    const std::vector<Column>& columns() const;
+    size_t nValuesPerObject() const;
+    size_t nObjects() const;
+
+    /**
+     * Returns the pointer to the first value of the interleaved records. The pointer is
+     * valid for as long as this object exists.
+     */
+    const float* values() const;
+
+    /**
+     * Copies the records and the column descriptions into a SpeckData object.
+     */
+    SpeckData data() const;
+
+private:
+    MemoryMappedFile _file;
+    std::vector<Column> _columns;
+    uint64_t _nObjects = 0;
+    const float* _values = nullptr;
+};
+
+} // namespace openspace::speck
+
+#endif // __OPENSPACE_MODULE_DIGITALUNIVERSE___SPECKFILE___H__
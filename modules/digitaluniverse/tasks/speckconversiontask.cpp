@@ -0,0 +1,99 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2018                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/digitaluniverse/tasks/speckconversiontask.h>
+
+#include <modules/digitaluniverse/speckfile.h>
+#include <openspace/documentation/verifier.h>
+#include <ghoul/fmt.h>
+#include <ghoul/filesystem/filesystem.h>
+#include <ghoul/logging/logmanager.h>
+
+namespace {
+    constexpr const char* _loggerCat = "SpeckConversionTask";
+
+    constexpr const char* KeyInput = "Input";
+    constexpr const char* KeyOutput = "Output";
+} // namespace
+
+namespace openspace {
+
+SpeckConversionTask::SpeckConversionTask(const ghoul::Dictionary& dictionary) {
+    documentation::testSpecificationAndThrow(
+        documentation(),
+        dictionary,
+        "SpeckConversionTask"
+    );
+
+    _inputPath = absPath(dictionary.value<std::string>(KeyInput));
+    _outputPath = absPath(dictionary.value<std::string>(KeyOutput));
+}
+
+std::string SpeckConversionTask::description() {
+    return fmt::format(
+        "Convert the speck file {} to the binary speck file {}", _inputPath, _outputPath
+    );
+}
+
+void SpeckConversionTask::perform(const Task::ProgressCallback& progressCallback) {
+    const speck::SpeckData data = speck::readSpeckFile(_inputPath);
+    progressCallback(0.5f);
+
+    speck::saveBinarySpeckFile(data, _outputPath);
+    LINFO(fmt::format(
+        "Converted {} objects with {} values each",
+        data.nObjects(), data.nValuesPerObject()
+    ));
+    progressCallback(1.f);
+}
+
+documentation::Documentation SpeckConversionTask::documentation() {
+    using namespace documentation;
+    return {
+        "SpeckConversionTask",
+        "digitaluniverse_speck_conversion_task",
+        {
+            {
+                "Type",
+                new StringEqualVerifier("SpeckConversionTask"),
+                Optional::No,
+                "The type of this task"
+            },
+            {
+                KeyInput,
+                new StringAnnotationVerifier("A file path to a speck file"),
+                Optional::No,
+                "The text speck file that is converted"
+            },
+            {
+                KeyOutput,
+                new StringAnnotationVerifier("A valid filepath"),
+                Optional::No,
+                "The binary speck file that is written"
+            }
+        }
+    };
+}
+
+} // namespace openspace
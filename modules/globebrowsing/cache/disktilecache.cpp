@@ -0,0 +1,681 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2018                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/globebrowsing/cache/disktilecache.h>
+
+#include <modules/globebrowsing/tile/tilemetadata.h>
+#include <ghoul/filesystem/cachemanager.h>
+#include <ghoul/filesystem/filesystem.h>
+#include <ghoul/fmt.h>
+#include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/exception.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace {
+    constexpr const char* _loggerCat = "DiskTileCache";
+
+    constexpr const char* PackFileName = "globebrowsingtiles.pack";
+
+    constexpr const uint32_t PackMagic = 0x4B415047; // 'GPAK'
+    constexpr const uint32_t PackVersion = 2;
+    constexpr const uint32_t RecordMagic = 0x454C4954; // 'TILE'
+    constexpr const uint32_t NoMetaData = std::numeric_limits<uint32_t>::max();
+
+    struct PackHeader {
+        uint32_t magic;
+        uint32_t version;
+    };
+
+    // Each tile is stored as a RecordHeader, followed by the optional meta data (maximum
+    // values, minimum values, and the missing data flags for every raster) followed by
+    // the pixel payload
+    struct RecordHeader {
+        uint32_t magic;
+        uint32_t nMetaDataValues;
+        uint64_t providerID;
+        int32_t x;
+        int32_t y;
+        int32_t level;
+        uint32_t reserved;
+        uint64_t payloadSize;
+    };
+    static_assert(sizeof(RecordHeader) == 40, "The header must not contain padding");
+
+    constexpr const uint64_t MegaByte = 1024 * 1024;
+
+    // The pack file grows by at least this amount, and at least doubles in size, every
+    // time that it is full, so that it rarely has to be remapped
+    constexpr const uint64_t MinimumPackGrowth = 64 * MegaByte;
+
+    uint64_t metaDataSize(uint32_t nValues) {
+        if (nValues == NoMetaData) {
+            return 0;
+        }
+        return nValues * (2 * sizeof(float) + sizeof(uint8_t));
+    }
+
+    constexpr openspace::properties::Property::PropertyInfo EnabledInfo = {
+        "Enabled",
+        "Enabled",
+        "If this value is enabled, tiles that are read from their dataset are also "
+        "stored on disk and subsequent requests for the same tile are served from the "
+        "disk cache instead of the dataset, even after a restart."
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo BudgetInfo = {
+        "Budget",
+        "Budget (MB)",
+        "The maximum amount of disk space (in MB) that is used for the cached tiles. If "
+        "this value is exceeded, the least recently used tiles are removed."
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo UsedSizeInfo = {
+        "UsedSize",
+        "Used size (MB)",
+        "This value denotes the amount of disk space (in MB) used by cached tiles."
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo HitsInfo = {
+        "Hits",
+        "Hits",
+        "The number of tile requests that were served from the disk cache."
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo MissesInfo = {
+        "Misses",
+        "Misses",
+        "The number of tile requests that were not found in the disk cache."
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo BytesReadInfo = {
+        "BytesRead",
+        "Read (MB)",
+        "The amount of tile data (in MB) that has been read from the disk cache."
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo BytesWrittenInfo = {
+        "BytesWritten",
+        "Written (MB)",
+        "The amount of tile data (in MB) that has been written to the disk cache."
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo ClearInfo = {
+        "Clear",
+        "Clear disk cache",
+        "Removes all tiles from the disk cache."
+    };
+} // namespace
+
+namespace openspace::globebrowsing::cache {
+
+DiskTileCache::DiskTileCache()
+    : PropertyOwner({ "DiskTileCache" })
+    , _index(0, 16)
+    , _enabledProperty(EnabledInfo, false)
+    , _budgetProperty(BudgetInfo, 4096, 64, 1024 * 1024)
+    , _usedSize(UsedSizeInfo, 0, 0, 1024 * 1024)
+    , _hits(HitsInfo, 0, 0, std::numeric_limits<int>::max())
+    , _misses(MissesInfo, 0, 0, std::numeric_limits<int>::max())
+    , _bytesRead(BytesReadInfo, 0, 0, std::numeric_limits<int>::max())
+    , _bytesWritten(BytesWrittenInfo, 0, 0, std::numeric_limits<int>::max())
+    , _clear(ClearInfo)
+{
+    _budget = static_cast<uint64_t>(_budgetProperty) * MegaByte;
+    _index.setByteBudget(_budget);
+
+    _enabledProperty.onChange([this]() { setEnabled(_enabledProperty); });
+    addProperty(_enabledProperty);
+
+    _budgetProperty.onChange([this]() {
+        _budget = static_cast<uint64_t>(_budgetProperty) * MegaByte;
+        std::lock_guard<std::mutex> lock(_writeMutex);
+        enforceBudget();
+    });
+    addProperty(_budgetProperty);
+
+    _usedSize.setReadOnly(true);
+    addProperty(_usedSize);
+    _hits.setReadOnly(true);
+    addProperty(_hits);
+    _misses.setReadOnly(true);
+    addProperty(_misses);
+    _bytesRead.setReadOnly(true);
+    addProperty(_bytesRead);
+    _bytesWritten.setReadOnly(true);
+    addProperty(_bytesWritten);
+
+    _clear.onChange([this]() { clear(); });
+    addProperty(_clear);
+}
+
+DiskTileCache::~DiskTileCache() {
+    stopCompaction();
+    std::lock_guard<std::mutex> writeLock(_writeMutex);
+    std::unique_lock<std::shared_mutex> mappingLock(_mappingMutex);
+    closePack();
+}
+
+bool DiskTileCache::isEnabled() const {
+    return _enabled;
+}
+
+bool DiskTileCache::read(const ProviderTileKey& key, char* destination, size_t nBytes,
+                         std::shared_ptr<TileMetaData>& tileMetaData)
+{
+    if (!_enabled) {
+        return false;
+    }
+
+    // The entries in the index always point into the mapped part of the pack file, as
+    // the mapping is only replaced while holding the lock exclusively
+    std::shared_lock<std::shared_mutex> lock(_mappingMutex);
+    // Getting the entry also marks it as the most recently used one
+    PackEntry entry;
+    if (!_index.tryGet(key, entry)) {
+        ++_nMisses;
+        return false;
+    }
+
+    if (entry.payloadSize != nBytes ||
+        entry.offset + entry.recordSize > _mappedPack.size())
+    {
+        ++_nMisses;
+        return false;
+    }
+
+    const char* record = _mappedPack.data() + entry.offset;
+    RecordHeader header;
+    std::memcpy(&header, record, sizeof(RecordHeader));
+
+    if (header.nMetaDataValues == NoMetaData) {
+        tileMetaData = nullptr;
+    }
+    else {
+        const uint32_t n = header.nMetaDataValues;
+        const char* p = record + sizeof(RecordHeader);
+
+        tileMetaData = std::make_shared<TileMetaData>();
+        tileMetaData->maxValues.resize(n);
+        std::memcpy(tileMetaData->maxValues.data(), p, n * sizeof(float));
+        p += n * sizeof(float);
+        tileMetaData->minValues.resize(n);
+        std::memcpy(tileMetaData->minValues.data(), p, n * sizeof(float));
+        p += n * sizeof(float);
+        tileMetaData->hasMissingData.resize(n);
+        for (uint32_t i = 0; i < n; ++i) {
+            tileMetaData->hasMissingData[i] = p[i] != 0;
+        }
+    }
+
+    std::memcpy(destination, _mappedPack.data() + entry.payloadOffset, nBytes);
+
+    ++_nHits;
+    _nBytesRead += nBytes;
+    return true;
+}
+
+void DiskTileCache::write(const ProviderTileKey& key, const char* data, size_t nBytes,
+                          const TileMetaData* tileMetaData)
+{
+    if (!_enabled || _isCompacting) {
+        return;
+    }
+
+    // The magic number is written last, so that a record that was not written
+    // completely ends the data in the same way as the zero padding after the last record
+    RecordHeader header = {
+        0,
+        NoMetaData,
+        key.providerID,
+        key.tileIndex.x,
+        key.tileIndex.y,
+        key.tileIndex.level,
+        0,
+        nBytes
+    };
+
+    std::vector<char> metaData;
+    if (tileMetaData) {
+        const uint32_t n = static_cast<uint32_t>(tileMetaData->maxValues.size());
+        header.nMetaDataValues = n;
+        metaData.resize(metaDataSize(n));
+
+        char* p = metaData.data();
+        std::memcpy(p, tileMetaData->maxValues.data(), n * sizeof(float));
+        p += n * sizeof(float);
+        std::memcpy(p, tileMetaData->minValues.data(), n * sizeof(float));
+        p += n * sizeof(float);
+        for (uint32_t i = 0; i < n; ++i) {
+            p[i] = (i < tileMetaData->hasMissingData.size() &&
+                    tileMetaData->hasMissingData[i]) ? 1 : 0;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(_writeMutex);
+    // Tiles are skipped while the pack is compacted, as the records that are copied to
+    // the new pack are determined when the compaction starts
+    if (!_packFile.is_open() || _isCompacting) {
+        return;
+    }
+
+    const uint64_t offset = _packFileSize;
+    const uint64_t recordSize = sizeof(RecordHeader) + metaData.size() + nBytes;
+    bool success = reserve(offset + recordSize);
+    if (success) {
+        _packFile.seekp(offset);
+        _packFile.write(reinterpret_cast<const char*>(&header), sizeof(RecordHeader));
+        _packFile.write(metaData.data(), metaData.size());
+        _packFile.write(data, nBytes);
+        // The data has to reach the file before the mapping can see it
+        _packFile.flush();
+        _packFile.seekp(offset);
+        _packFile.write(reinterpret_cast<const char*>(&RecordMagic), sizeof(uint32_t));
+        _packFile.flush();
+        success = _packFile.good();
+    }
+    if (!success) {
+        LERROR(fmt::format("Error writing to tile cache '{}'", _packFilePath));
+        std::unique_lock<std::shared_mutex> mappingLock(_mappingMutex);
+        closePack();
+        // The property can only be changed on the main thread, see update
+        _enabled = false;
+        _disableRequested = true;
+        return;
+    }
+
+    const PackEntry entry = {
+        offset,
+        recordSize,
+        offset + sizeof(RecordHeader) + metaData.size(),
+        nBytes
+    };
+    _packFileSize += recordSize;
+
+    _index.put(key, entry, recordSize);
+    _liveBytes = _index.usedBytes();
+    _nBytesWritten += nBytes;
+
+    enforceBudget();
+}
+
+void DiskTileCache::clear() {
+    LINFO("Clearing disk tile cache");
+    stopCompaction();
+    std::lock_guard<std::mutex> writeLock(_writeMutex);
+    std::unique_lock<std::shared_mutex> mappingLock(_mappingMutex);
+    const bool wasOpen = _packFile.is_open();
+    closePack();
+    if (!_packFilePath.empty()) {
+        std::remove(_packFilePath.c_str());
+    }
+    if (wasOpen) {
+        openPack();
+    }
+    _enabled = _packFile.is_open();
+}
+
+void DiskTileCache::update() {
+    if (_disableRequested.exchange(false)) {
+        // The cache was disabled because of an error on another thread
+        _enabledProperty = false;
+    }
+
+    auto toInt = [](uint64_t v) {
+        return static_cast<int>(
+            std::min<uint64_t>(v, std::numeric_limits<int>::max())
+        );
+    };
+
+    _usedSize = toInt(_liveBytes / MegaByte);
+    _hits = toInt(_nHits);
+    _misses = toInt(_nMisses);
+    _bytesRead = toInt(_nBytesRead / MegaByte);
+    _bytesWritten = toInt(_nBytesWritten / MegaByte);
+}
+
+void DiskTileCache::setEnabled(bool enabled) {
+    stopCompaction();
+    std::lock_guard<std::mutex> writeLock(_writeMutex);
+    std::unique_lock<std::shared_mutex> mappingLock(_mappingMutex);
+    if (enabled && !_packFile.is_open()) {
+        openPack();
+    }
+    else if (!enabled) {
+        closePack();
+    }
+    _enabled = _packFile.is_open();
+    enforceBudget();
+}
+
+void DiskTileCache::openPack() {
+    if (!FileSys.cacheManager()) {
+        LWARNING("No cache manager available, disk tile cache cannot be used");
+        return;
+    }
+
+    _packFilePath = FileSys.cacheManager()->cachedFilename(
+        PackFileName,
+        "",
+        ghoul::filesystem::CacheManager::Persistent::Yes
+    );
+
+    // Check whether there is an existing pack file that we can continue to use
+    bool isValid = false;
+    if (FileSys.fileExists(_packFilePath)) {
+        std::ifstream file(_packFilePath, std::ios::binary);
+        PackHeader header;
+        file.read(reinterpret_cast<char*>(&header), sizeof(PackHeader));
+        isValid = file.good() && header.magic == PackMagic &&
+                  header.version == PackVersion;
+    }
+
+    if (!isValid) {
+        std::ofstream file(_packFilePath, std::ios::binary | std::ios::trunc);
+        const PackHeader header = { PackMagic, PackVersion };
+        file.write(reinterpret_cast<const char*>(&header), sizeof(PackHeader));
+        if (!file.good()) {
+            LERROR(fmt::format("Could not create tile cache '{}'", _packFilePath));
+            return;
+        }
+    }
+
+    _packFile.open(_packFilePath, std::ios::binary | std::ios::in | std::ios::out);
+    if (!_packFile.good()) {
+        LERROR(fmt::format("Could not open tile cache '{}'", _packFilePath));
+        _packFile.close();
+        return;
+    }
+
+    rebuildIndex();
+    if (_packFile.is_open()) {
+        LINFO(fmt::format(
+            "Opened disk tile cache with {} tiles ({} MB)",
+            _index.size(), _liveBytes / MegaByte
+        ));
+    }
+}
+
+void DiskTileCache::closePack() {
+    _mappedPack.close();
+    _packFile.close();
+    _index.clear();
+    _packFileSize = 0;
+    _packCapacity = 0;
+    _liveBytes = 0;
+}
+
+void DiskTileCache::rebuildIndex() {
+    _index.clear();
+    _liveBytes = 0;
+    _packFileSize = sizeof(PackHeader);
+
+    try {
+        _mappedPack.open(_packFilePath);
+    }
+    catch (const ghoul::RuntimeError& e) {
+        LERRORC(e.component, e.message);
+        closePack();
+        return;
+    }
+
+    // Records are stored in the order they were written, so the last record for a key
+    // is the valid one and the file order approximates the usage order
+    const char* data = _mappedPack.data();
+    const uint64_t size = _mappedPack.size();
+    _packCapacity = size;
+    uint64_t offset = sizeof(PackHeader);
+    bool hasInvalidData = false;
+    while (offset + sizeof(RecordHeader) <= size) {
+        RecordHeader header;
+        std::memcpy(&header, data + offset, sizeof(RecordHeader));
+        if (header.magic == 0) {
+            // We have reached the zero padding after the last record, or a record that
+            // was not written completely, which will be overwritten by the next record
+            break;
+        }
+        const uint64_t metaSize = metaDataSize(header.nMetaDataValues);
+        const uint64_t recordSize = sizeof(RecordHeader) + metaSize + header.payloadSize;
+        if (header.magic != RecordMagic || offset + recordSize > size) {
+            hasInvalidData = true;
+            break;
+        }
+
+        const ProviderTileKey key = {
+            TileIndex(header.x, header.y, header.level),
+            header.providerID
+        };
+        const PackEntry entry = {
+            offset,
+            recordSize,
+            offset + sizeof(RecordHeader) + metaSize,
+            header.payloadSize
+        };
+        _index.put(key, entry, recordSize);
+        offset += recordSize;
+    }
+    if (!hasInvalidData && offset + sizeof(RecordHeader) > size) {
+        hasInvalidData = std::any_of(
+            data + offset,
+            data + size,
+            [](char c) { return c != 0; }
+        );
+    }
+    _packFileSize = offset;
+    _liveBytes = _index.usedBytes();
+
+    if (hasInvalidData) {
+        LWARNING(fmt::format(
+            "Tile cache '{}' contained invalid data after byte {}", _packFilePath, offset
+        ));
+        // Compacting the pack removes the invalid trailing data. This only happens when
+        // the cache is opened, so there is no need to do it in the background
+        const std::string tempPath = _packFilePath + ".tmp";
+        std::unordered_map<uint64_t, uint64_t> newOffsets;
+        uint64_t newSize = 0;
+        if (!copyLiveRecords(tempPath, newOffsets, newSize) ||
+            !replacePack(tempPath, newOffsets, newSize))
+        {
+            handleCompactionFailure();
+        }
+    }
+}
+
+void DiskTileCache::enforceBudget() {
+    if (!_packFile.is_open()) {
+        return;
+    }
+
+    // Evicts the least recently used tiles if the budget has changed
+    _index.setByteBudget(_budget);
+    _liveBytes = _index.usedBytes();
+
+    // The pack file is append-only, so the removed and replaced tiles still occupy
+    // space in it. Once that space is as large as the live data, the pack is rewritten
+    // on a separate thread, while tiles can still be read from the current pack
+    const uint64_t deadBytes = _packFileSize - sizeof(PackHeader) - _liveBytes;
+    if (_enabled && !_isCompacting &&
+        deadBytes > std::max<uint64_t>(_liveBytes, 64 * MegaByte))
+    {
+        // The previous compaction has finished, as it resets _isCompacting last
+        if (_compactionThread.joinable()) {
+            _compactionThread.join();
+        }
+        _isCompacting = true;
+        _compactionThread = std::thread([this]() { compactInBackground(); });
+    }
+}
+
+bool DiskTileCache::reserve(uint64_t end) {
+    if (end <= _packCapacity) {
+        return true;
+    }
+
+    // Pad the pack with zeros, which also marks the end of the records when the index
+    // is rebuilt. Growing geometrically means the pack is only remapped a few times
+    const uint64_t capacity = std::max({
+        end,
+        2 * _packCapacity,
+        _packCapacity + MinimumPackGrowth
+    });
+    const std::vector<char> zeros(MegaByte, 0);
+    _packFile.seekp(_packCapacity);
+    for (uint64_t p = _packCapacity; p < capacity; p += zeros.size()) {
+        _packFile.write(zeros.data(), std::min<uint64_t>(zeros.size(), capacity - p));
+    }
+    _packFile.flush();
+    if (!_packFile.good()) {
+        return false;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(_mappingMutex);
+    try {
+        _mappedPack.open(_packFilePath);
+    }
+    catch (const ghoul::RuntimeError& e) {
+        LERRORC(e.component, e.message);
+        return false;
+    }
+    _packCapacity = capacity;
+    return _mappedPack.size() >= capacity;
+}
+
+void DiskTileCache::compactInBackground() {
+    const std::string tempPath = _packFilePath + ".tmp";
+    std::unordered_map<uint64_t, uint64_t> newOffsets;
+    uint64_t size = 0;
+    bool success = false;
+    {
+        // No tiles are written while compacting, so the mapping stays valid and tiles
+        // can still be read while the live records are copied
+        std::shared_lock<std::shared_mutex> lock(_mappingMutex);
+        success = copyLiveRecords(tempPath, newOffsets, size);
+    }
+
+    std::lock_guard<std::mutex> writeLock(_writeMutex);
+    std::unique_lock<std::shared_mutex> mappingLock(_mappingMutex);
+    if (!success || !replacePack(tempPath, newOffsets, size)) {
+        handleCompactionFailure();
+    }
+    _isCompacting = false;
+}
+
+void DiskTileCache::stopCompaction() {
+    // No new compaction is started once the cache is disabled
+    _enabled = false;
+    std::thread thread;
+    {
+        std::lock_guard<std::mutex> lock(_writeMutex);
+        thread = std::move(_compactionThread);
+    }
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+bool DiskTileCache::copyLiveRecords(const std::string& path,
+                                    std::unordered_map<uint64_t, uint64_t>& newOffsets,
+                                    uint64_t& size)
+{
+    // The records are written from the least to the most recently used one, which is
+    // the order in which they are reinserted into the index after a restart
+    const std::vector<PackIndex::Item> items = _index.items();
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    const PackHeader header = { PackMagic, PackVersion };
+    file.write(reinterpret_cast<const char*>(&header), sizeof(PackHeader));
+
+    uint64_t offset = sizeof(PackHeader);
+    newOffsets.reserve(items.size());
+    for (const PackIndex::Item& item : items) {
+        const PackEntry& entry = item.second;
+        file.write(_mappedPack.data() + entry.offset, entry.recordSize);
+        newOffsets[entry.offset] = offset;
+        offset += entry.recordSize;
+    }
+    size = offset;
+    return file.good();
+}
+
+bool DiskTileCache::replacePack(const std::string& path,
+                                const std::unordered_map<uint64_t, uint64_t>& newOffsets,
+                                uint64_t size)
+{
+    _mappedPack.close();
+    _packFile.close();
+    if (std::remove(_packFilePath.c_str()) != 0 ||
+        std::rename(path.c_str(), _packFilePath.c_str()) != 0)
+    {
+        return false;
+    }
+
+    _packFile.open(_packFilePath, std::ios::binary | std::ios::in | std::ios::out);
+    if (!_packFile.good()) {
+        return false;
+    }
+    try {
+        _mappedPack.open(_packFilePath);
+    }
+    catch (const ghoul::RuntimeError& e) {
+        LERRORC(e.component, e.message);
+        return false;
+    }
+    _packFileSize = size;
+    _packCapacity = size;
+
+    // Popping everything from the index gives us the entries from the least to the most
+    // recently used one, which is also the order in which we reinsert them. Tiles that
+    // were evicted while the records were copied are no longer in the index
+    std::vector<PackIndex::Item> items;
+    items.reserve(_index.size());
+    while (!_index.isEmpty()) {
+        items.push_back(_index.popLRU());
+    }
+    for (PackIndex::Item& item : items) {
+        PackEntry& entry = item.second;
+        const auto it = newOffsets.find(entry.offset);
+        if (it == newOffsets.end()) {
+            continue;
+        }
+        entry.payloadOffset = it->second + (entry.payloadOffset - entry.offset);
+        entry.offset = it->second;
+        _index.put(item.first, entry, entry.recordSize);
+    }
+    _liveBytes = _index.usedBytes();
+    return true;
+}
+
+void DiskTileCache::handleCompactionFailure() {
+    LERROR(fmt::format("Could not compact tile cache '{}'", _packFilePath));
+    std::remove((_packFilePath + ".tmp").c_str());
+    closePack();
+    // The property can only be changed on the main thread, see update
+    _enabled = false;
+    _disableRequested = true;
+}
+
+} // namespace openspace::globebrowsing::cache
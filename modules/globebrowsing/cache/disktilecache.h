@@ -0,0 +1,163 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2018                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_GLOBEBROWSING___DISK_TILE_CACHE___H__
+#define __OPENSPACE_MODULE_GLOBEBROWSING___DISK_TILE_CACHE___H__
+
+#include <modules/globebrowsing/cache/memoryawaretilecache.h>
+#include <modules/globebrowsing/cache/shardedlrucache.h>
+#include <openspace/properties/propertyowner.h>
+#include <openspace/properties/scalar/boolproperty.h>
+#include <openspace/properties/scalar/intproperty.h>
+#include <openspace/properties/triggerproperty.h>
+#include <openspace/util/memorymappedfile.h>
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace openspace::globebrowsing { struct TileMetaData; }
+
+namespace openspace::globebrowsing::cache {
+
+/**
+ * Second level tile cache that persists the pixel data of tiles that have been read by a
+ * <code>RawTileDataReader</code> across evictions from the
+ * <code>MemoryAwareTileCache</code> and across restarts. All tiles are appended to a
+ * single pack file in the cache directory, which is memory mapped for reading. The pack
+ * file grows geometrically and is padded with zeros, so that it only has to be remapped
+ * rarely. An LRU index keeps track of the tiles that are stored in the pack and, once the
+ * size of the stored tiles exceeds the budget, the least recently used tiles are dropped
+ * from the index and the pack file is compacted on a background thread.
+ *
+ * The <code>providerID</code> of the <code>ProviderTileKey</code> is expected to be a 64
+ * bit hash of the dataset, the layer, and the texture format rather than the runtime
+ * identifier of the tile provider, so that it is stable between runs and the cache is
+ * useful across restarts. All methods are thread-safe.
+ */
+class DiskTileCache : public properties::PropertyOwner {
+public:
+    DiskTileCache();
+    ~DiskTileCache();
+
+    bool isEnabled() const;
+
+    /**
+     * Copies the pixel data of the tile identified by \p key into \p destination. The
+     * tile is only considered found if exactly \p nBytes bytes were stored for it.
+     * \param tileMetaData Is set to the stored meta data, or <code>nullptr</code> if the
+     *        tile was stored without meta data
+     * \returns <code>true</code> if the tile was found in the cache
+     */
+    bool read(const ProviderTileKey& key, char* destination, size_t nBytes,
+        std::shared_ptr<TileMetaData>& tileMetaData);
+
+    /**
+     * Stores \p nBytes bytes of pixel data for the tile identified by \p key. If the tile
+     * was already stored, the previous data is replaced.
+     */
+    void write(const ProviderTileKey& key, const char* data, size_t nBytes,
+        const TileMetaData* tileMetaData);
+
+    void clear();
+
+    /**
+     * Updates the statistics properties and disables the cache if a background
+     * compaction has failed. Has to be called from the main thread.
+     */
+    void update();
+
+private:
+    struct PackEntry {
+        /// The offset of the record header in the pack file
+        uint64_t offset;
+        /// The size of the entire record including the header and meta data
+        uint64_t recordSize;
+        uint64_t payloadOffset;
+        uint64_t payloadSize;
+    };
+
+    void setEnabled(bool enabled);
+    void openPack();
+    void closePack();
+    void rebuildIndex();
+    void enforceBudget();
+    bool reserve(uint64_t end);
+
+    void compactInBackground();
+    void stopCompaction();
+    bool copyLiveRecords(const std::string& path,
+        std::unordered_map<uint64_t, uint64_t>& newOffsets, uint64_t& size);
+    bool replacePack(const std::string& path,
+        const std::unordered_map<uint64_t, uint64_t>& newOffsets, uint64_t size);
+    void handleCompactionFailure();
+
+    using PackIndex = ShardedLRUCache<ProviderTileKey, PackEntry, ProviderTileHasher>;
+
+    std::string _packFilePath;
+    std::ofstream _packFile;
+    MemoryMappedFile _mappedPack;
+    /// The end of the last record in the pack file
+    uint64_t _packFileSize = 0;
+    /// The size of the pack file including the zero padding after the last record
+    uint64_t _packCapacity = 0;
+    /// The number of bytes in the pack file that belong to tiles in the index
+    std::atomic<uint64_t> _liveBytes = { 0 };
+    PackIndex _index;
+
+    /// Protects the pack file and its size. Has to be locked before _mappingMutex
+    std::mutex _writeMutex;
+    /// Is locked shared by readers of the mapping and exclusively to replace it
+    std::shared_mutex _mappingMutex;
+
+    std::thread _compactionThread;
+    /// Tiles are not written while the pack is compacted
+    std::atomic_bool _isCompacting = { false };
+    std::atomic_bool _disableRequested = { false };
+
+    std::atomic<uint64_t> _nHits = { 0 };
+    std::atomic<uint64_t> _nMisses = { 0 };
+    std::atomic<uint64_t> _nBytesRead = { 0 };
+    std::atomic<uint64_t> _nBytesWritten = { 0 };
+    std::atomic<uint64_t> _budget = { 0 };
+    std::atomic_bool _enabled = { false };
+
+    // Properties
+    properties::BoolProperty _enabledProperty;
+    properties::IntProperty _budgetProperty;
+    properties::IntProperty _usedSize;
+    properties::IntProperty _hits;
+    properties::IntProperty _misses;
+    properties::IntProperty _bytesRead;
+    properties::IntProperty _bytesWritten;
+    properties::TriggerProperty _clear;
+};
+
+} // namespace openspace::globebrowsing::cache
+
+#endif // __OPENSPACE_MODULE_GLOBEBROWSING___DISK_TILE_CACHE___H__
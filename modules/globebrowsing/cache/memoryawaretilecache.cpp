@@ -29,6 +29,7 @@
 #include <modules/globebrowsing/tile/rawtile.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/systemcapabilities/generalcapabilitiescomponent.h>
+#include <algorithm>
 #include <numeric>
 
 namespace {
@@ -73,6 +74,20 @@ namespace {
         "data asynchronously. If this value is disabled, the upload is synchronously."
     };
 
+    // Each shard of a tile cache gets an equal part of its budget, so the number of
+    // shards is limited by the number of tiles that each shard should be able to hold
+    size_t numShards(size_t numTextures) {
+        constexpr const size_t MaxShards = 8;
+        constexpr const size_t MinTexturesPerShard = 32;
+        return std::clamp<size_t>(numTextures / MinTexturesPerShard, 1, MaxShards);
+    }
+
+    // The byte budget of a tile cache covers exactly the textures of its container, as
+    // every tile in the cache occupies one of them
+    size_t textureBytes(const openspace::globebrowsing::cache::TextureContainer& c) {
+        return c.size() * c.tileTextureInitData().totalNumBytes();
+    }
+
 } // namespace
 
 namespace openspace::globebrowsing::cache {
@@ -147,11 +162,15 @@ void MemoryAwareTileCache::assureTextureContainerExists(
     TileTextureInitData::HashKey initDataKey = initData.hashKey();
     if (_textureContainerMap.find(initDataKey) == _textureContainerMap.end()) {
         // For now create 500 textures of this type
-        _textureContainerMap.emplace(initDataKey,
-            TextureContainerTileCache(
-                std::make_unique<TextureContainer>(initData, 500),
-                std::make_unique<TileCache>(std::numeric_limits<std::size_t>::max())
-            )
+        constexpr const size_t NumTextures = 500;
+        auto container = std::make_unique<TextureContainer>(initData, NumTextures);
+        auto cache = std::make_unique<TileCache>(
+            textureBytes(*container),
+            numShards(NumTextures)
+        );
+        _textureContainerMap.emplace(
+            initDataKey,
+            TextureContainerTileCache(std::move(container), std::move(cache))
         );
     }
 }
@@ -187,7 +206,10 @@ void MemoryAwareTileCache::resetTextureContainerSize(size_t numTexturesPerTextur
         TextureContainerTileCache>& p : _textureContainerMap)
     {
         p.second.first->reset(numTexturesPerTextureType);
-        p.second.second->clear();
+        p.second.second = std::make_unique<TileCache>(
+            textureBytes(*p.second.first),
+            numShards(numTexturesPerTextureType)
+        );
     }
 }
 
@@ -231,11 +253,11 @@ ghoul::opengl::Texture* MemoryAwareTileCache::texture(
     assureTextureContainerExists(initData);
     // Now we know that the texture container exists,
     // check if there are any unused textures
-    ghoul::opengl::Texture* texture =
-        _textureContainerMap[initDataKey].first->getTextureIfFree();
+    TextureContainerTileCache& container = _textureContainerMap[initDataKey];
+    ghoul::opengl::Texture* texture = container.first->getTextureIfFree();
     // Second option. No more textures available. Pop from the LRU cache
-    if (!texture) {
-        Tile oldTile = _textureContainerMap[initDataKey].second->popLRU().second;
+    if (!texture && !container.second->isEmpty()) {
+        Tile oldTile = container.second->popLRU().second;
         // Use the old tile's texture
         texture = oldTile.texture();
     }
@@ -251,6 +273,10 @@ void MemoryAwareTileCache::createTileAndPut(ProviderTileKey key, RawTile& rawTil
     else {
         const TileTextureInitData& initData = *rawTile.textureInitData;
         Texture* tex = texture(initData);
+        if (!tex) {
+            // The texture container has been reset to zero textures
+            return;
+        }
 
         // Re-upload texture, either using PBO or by using RAM data
         if (rawTile.pbo != 0) {
@@ -277,8 +303,7 @@ void MemoryAwareTileCache::createTileAndPut(ProviderTileKey key, RawTile& rawTil
         }
         tex->setFilter(ghoul::opengl::Texture::FilterMode::AnisotropicMipMap);
         Tile tile(tex, rawTile.tileMetaData, Tile::Status::OK);
-        TileTextureInitData::HashKey initDataKey = initData.hashKey();
-        _textureContainerMap[initDataKey].second->put(std::move(key), tile);
+        putTile(_textureContainerMap[initData.hashKey()], key, std::move(tile));
     }
 }
 
@@ -286,7 +311,34 @@ void MemoryAwareTileCache::put(const ProviderTileKey& key,
                                const TileTextureInitData::HashKey& initDataKey,
                                Tile tile)
 {
-    _textureContainerMap[initDataKey].second->put(key, std::move(tile));
+    putTile(_textureContainerMap[initDataKey], key, std::move(tile));
+}
+
+void MemoryAwareTileCache::putTile(TextureContainerTileCache& container,
+                                   const ProviderTileKey& key, Tile tile)
+{
+    ghoul::opengl::Texture* texture = tile.texture();
+    std::vector<TileCache::Item> popped = container.second->putAndFetchPopped(
+        key,
+        std::move(tile),
+        container.first->tileTextureInitData().totalNumBytes()
+    );
+
+    // The textures of the evicted or replaced tiles have to be returned to the
+    // container, as they would otherwise be lost until the container is reset. A tile
+    // that replaced itself keeps its texture
+    const bool isCached = container.second->exist(key);
+    std::vector<ghoul::opengl::Texture*> released;
+    for (const TileCache::Item& item : popped) {
+        ghoul::opengl::Texture* t = item.second.texture();
+        const bool isReleased =
+            std::find(released.cbegin(), released.cend(), t) != released.cend();
+        if (!t || isReleased || (t == texture && isCached)) {
+            continue;
+        }
+        container.first->release(t);
+        released.push_back(t);
+    }
 }
 
 void MemoryAwareTileCache::update() {
@@ -307,9 +359,7 @@ size_t MemoryAwareTileCache::gpuAllocatedDataSize() const {
         [](size_t s, const std::pair<const TileTextureInitData::HashKey,
         TextureContainerTileCache>& p)
         {
-            const TextureContainer& textureContainer = *p.second.first;
-            const size_t nBytes = textureContainer.tileTextureInitData().totalNumBytes();
-            return s + nBytes * textureContainer.size();
+            return s + textureBytes(*p.second.first);
         }
     );
 }
@@ -25,13 +25,14 @@
 #ifndef __OPENSPACE_MODULE_GLOBEBROWSING___MEMORY_AWARE_TILE_CACHE___H__
 #define __OPENSPACE_MODULE_GLOBEBROWSING___MEMORY_AWARE_TILE_CACHE___H__
 
-#include <modules/globebrowsing/cache/lrucache.h>
+#include <modules/globebrowsing/cache/shardedlrucache.h>
 #include <modules/globebrowsing/cache/texturecontainer.h>
 #include <modules/globebrowsing/tile/tileindex.h>
 #include <openspace/properties/propertyowner.h>
 #include <openspace/properties/scalar/boolproperty.h>
 #include <openspace/properties/scalar/intproperty.h>
 #include <openspace/properties/triggerproperty.h>
+#include <cstdint>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -45,7 +46,7 @@ namespace openspace::globebrowsing::cache {
 
 struct ProviderTileKey {
     TileIndex tileIndex;
-    unsigned int providerID;
+    uint64_t providerID;
 
     bool operator==(const ProviderTileKey& r) const {
         return (providerID == r.providerID) &&
@@ -78,7 +79,10 @@ struct ProviderTileHasher {
         // hash key)
         // Idea: make some offset in the place of the bits for the x value. Lesser chance
         // of having different x-value than having different tile provider ids.
-        key += static_cast<unsigned long long>(t.providerID) << 25ULL;
+        // The upper half of the provider id is folded into the lower half first, as it
+        // would otherwise be shifted out
+        const uint64_t providerID = t.providerID ^ (t.providerID >> 32);
+        key += static_cast<unsigned long long>(providerID) << 25ULL;
         return key;
     }
 };
@@ -106,7 +110,7 @@ private:
     void assureTextureContainerExists(const TileTextureInitData& initData);
     void resetTextureContainerSize(size_t numTexturesPerTextureType);
 
-    using TileCache = LRUCache<ProviderTileKey, Tile, ProviderTileHasher>;
+    using TileCache = ShardedLRUCache<ProviderTileKey, Tile, ProviderTileHasher>;
     using TextureContainerTileCache = std::pair<
         std::unique_ptr<TextureContainer>,
         std::unique_ptr<TileCache>
@@ -116,6 +120,9 @@ private:
         TextureContainerTileCache
     >;
 
+    void putTile(TextureContainerTileCache& container, const ProviderTileKey& key,
+        Tile tile);
+
     TextureContainerMap _textureContainerMap;
     size_t _numTextureBytesAllocatedOnCPU;
 
@@ -0,0 +1,163 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2018                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_GLOBEBROWSING___SHARDED_LRU_CACHE___H__
+#define __OPENSPACE_MODULE_GLOBEBROWSING___SHARDED_LRU_CACHE___H__
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace openspace::globebrowsing::cache {
+
+/**
+ * Templated class implementing a Least-Recently-Used Cache that is limited by the total
+ * cost of its items rather than by their number. Every item is stored together with a
+ * cost, usually its size in bytes, and items are evicted once the sum of the costs
+ * exceeds the byte budget.
+ *
+ * The items are stored in a contiguous slab of nodes that are linked by indices instead
+ * of a heap allocated list, and removed nodes are reused by subsequent insertions. The
+ * cache can be split into a number of shards that are each protected by their own
+ * mutex, so that multiple threads can access the cache concurrently as long as their
+ * keys fall into different shards. Each shard gets an equal part of the byte budget and
+ * keeps its own LRU order. <code>popLRU</code> uses a global use counter to pop the
+ * least recently used item across all shards.
+ */
+template <typename KeyType, typename ValueType, typename HasherType>
+class ShardedLRUCache {
+public:
+    using Item = std::pair<KeyType, ValueType>;
+
+    /**
+     * \param byteBudget is the maximum total cost of the items in the cache
+     * \param nShards is the number of independently locked shards. The value is rounded
+     *        up to the next power of two
+     */
+    explicit ShardedLRUCache(size_t byteBudget, size_t nShards = 1);
+
+    /**
+     * Adds the \p value for the \p key with the provided \p cost, replacing an existing
+     * value for the same key. If the item exceeds the budget on its own, it is evicted
+     * immediately.
+     */
+    void put(KeyType key, ValueType value, size_t cost);
+
+    /**
+     * Same as <code>put</code>, but returns the items that were evicted, including the
+     * previous value for the \p key if it was replaced.
+     */
+    std::vector<Item> putAndFetchPopped(KeyType key, ValueType value, size_t cost);
+    void clear();
+    bool exist(const KeyType& key) const;
+
+    /**
+     * If value exists, the value is bumped to the front of the queue.
+     * \returns true if value of this key exists.
+     */
+    bool touch(const KeyType& key);
+    bool isEmpty() const;
+    ValueType get(const KeyType& key);
+
+    /**
+     * Combination of <code>exist</code> and <code>get</code> that cannot be interrupted
+     * by another thread removing the item in between.
+     * \returns true if value of this key exists, in which case it is copied to \p value
+     */
+    bool tryGet(const KeyType& key, ValueType& value);
+
+    /**
+     * Pops the least recently used item of all shards.
+     */
+    Item popLRU();
+
+    /**
+     * Returns a copy of all items, ordered from the least to the most recently used one,
+     * without changing the cache.
+     */
+    std::vector<Item> items() const;
+
+    /**
+     * Changes the byte budget and returns the items that had to be evicted.
+     */
+    std::vector<Item> setByteBudget(size_t byteBudget);
+
+    size_t size() const;
+    size_t usedBytes() const;
+    size_t byteBudget() const;
+    size_t numShards() const;
+
+private:
+    using NodeIndex = uint32_t;
+    static constexpr const NodeIndex InvalidNode = std::numeric_limits<NodeIndex>::max();
+
+    struct Node {
+        std::optional<Item> item;
+        size_t cost = 0;
+        uint64_t lastUse = 0;
+        NodeIndex previous = InvalidNode;
+        NodeIndex next = InvalidNode;
+    };
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::vector<Node> nodes;
+        std::vector<NodeIndex> freeNodes;
+        std::unordered_map<KeyType, NodeIndex, HasherType> index;
+        /// The most recently used node
+        NodeIndex head = InvalidNode;
+        /// The least recently used node
+        NodeIndex tail = InvalidNode;
+        size_t usedBytes = 0;
+        size_t byteBudget = 0;
+    };
+
+    Shard& shard(const KeyType& key) const;
+
+    // The following functions require the mutex of the shard to be locked
+    void unlink(Shard& shard, NodeIndex node) const;
+    void linkFront(Shard& shard, NodeIndex node);
+    void putInShard(Shard& shard, KeyType key, ValueType value, size_t cost,
+        std::vector<Item>* replaced);
+    Item remove(Shard& shard, NodeIndex node) const;
+    void evict(Shard& shard, std::vector<Item>* popped) const;
+
+    std::unique_ptr<Shard[]> _shards;
+    size_t _nShards;
+    std::atomic<size_t> _byteBudget;
+    std::atomic<uint64_t> _useCounter = { 0 };
+    HasherType _hasher;
+};
+
+} // namespace openspace::globebrowsing::cache
+
+#include <modules/globebrowsing/cache/shardedlrucache.inl>
+
+#endif // __OPENSPACE_MODULE_GLOBEBROWSING___SHARDED_LRU_CACHE___H__
@@ -0,0 +1,362 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2018                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <ghoul/misc/assert.h>
+
+namespace openspace::globebrowsing::cache {
+
+template<typename KeyType, typename ValueType, typename HasherType>
+ShardedLRUCache<KeyType, ValueType, HasherType>::ShardedLRUCache(size_t byteBudget,
+                                                                 size_t nShards)
+    : _nShards(1)
+    , _byteBudget(byteBudget)
+{
+    ghoul_assert(nShards > 0, "There must be at least one shard");
+    while (_nShards < nShards) {
+        _nShards *= 2;
+    }
+    _shards = std::make_unique<Shard[]>(_nShards);
+    for (size_t i = 0; i < _nShards; ++i) {
+        _shards[i].byteBudget = _byteBudget / _nShards;
+    }
+}
+
+template<typename KeyType, typename ValueType, typename HasherType>
+void ShardedLRUCache<KeyType, ValueType, HasherType>::put(KeyType key, ValueType value,
+                                                          size_t cost)
+{
+    Shard& s = shard(key);
+    std::lock_guard<std::mutex> lock(s.mutex);
+    putInShard(s, std::move(key), std::move(value), cost, nullptr);
+    evict(s, nullptr);
+}
+
+template<typename KeyType, typename ValueType, typename HasherType>
+std::vector<std::pair<KeyType, ValueType>>
+ShardedLRUCache<KeyType, ValueType, HasherType>::putAndFetchPopped(KeyType key,
+                                                                   ValueType value,
+                                                                   size_t cost)
+{
+    std::vector<Item> popped;
+    Shard& s = shard(key);
+    std::lock_guard<std::mutex> lock(s.mutex);
+    putInShard(s, std::move(key), std::move(value), cost, &popped);
+    evict(s, &popped);
+    return popped;
+}
+
+template<typename KeyType, typename ValueType, typename HasherType>
+void ShardedLRUCache<KeyType, ValueType, HasherType>::clear() {
+    for (size_t i = 0; i < _nShards; ++i) {
+        Shard& s = _shards[i];
+        std::lock_guard<std::mutex> lock(s.mutex);
+        s.nodes.clear();
+        s.freeNodes.clear();
+        s.index.clear();
+        s.head = InvalidNode;
+        s.tail = InvalidNode;
+        s.usedBytes = 0;
+    }
+}
+
+template<typename KeyType, typename ValueType, typename HasherType>
+bool ShardedLRUCache<KeyType, ValueType, HasherType>::exist(const KeyType& key) const {
+    const Shard& s = shard(key);
+    std::lock_guard<std::mutex> lock(s.mutex);
+    return s.index.find(key) != s.index.end();
+}
+
+template<typename KeyType, typename ValueType, typename HasherType>
+bool ShardedLRUCache<KeyType, ValueType, HasherType>::touch(const KeyType& key) {
+    Shard& s = shard(key);
+    std::lock_guard<std::mutex> lock(s.mutex);
+    const auto it = s.index.find(key);
+    if (it == s.index.end()) {
+        return false;
+    }
+    unlink(s, it->second);
+    linkFront(s, it->second);
+    return true;
+}
+
+template<typename KeyType, typename ValueType, typename HasherType>
+bool ShardedLRUCache<KeyType, ValueType, HasherType>::isEmpty() const {
+    for (size_t i = 0; i < _nShards; ++i) {
+        std::lock_guard<std::mutex> lock(_shards[i].mutex);
+        if (!_shards[i].index.empty()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<typename KeyType, typename ValueType, typename HasherType>
+ValueType ShardedLRUCache<KeyType, ValueType, HasherType>::get(const KeyType& key) {
+    Shard& s = shard(key);
+    std::lock_guard<std::mutex> lock(s.mutex);
+    const auto it = s.index.find(key);
+    ghoul_assert(it != s.index.end(), "Key must exist in the cache");
+    unlink(s, it->second);
+    linkFront(s, it->second);
+    return s.nodes[it->second].item->second;
+}
+
+template<typename KeyType, typename ValueType, typename HasherType>
+bool ShardedLRUCache<KeyType, ValueType, HasherType>::tryGet(const KeyType& key,
+                                                             ValueType& value)
+{
+    Shard& s = shard(key);
+    std::lock_guard<std::mutex> lock(s.mutex);
+    const auto it = s.index.find(key);
+    if (it == s.index.end()) {
+        return false;
+    }
+    unlink(s, it->second);
+    linkFront(s, it->second);
+    value = s.nodes[it->second].item->second;
+    return true;
+}
+
+template<typename KeyType, typename ValueType, typename HasherType>
+std::pair<KeyType, ValueType> ShardedLRUCache<KeyType, ValueType, HasherType>::popLRU() {
+    // Find the shard whose least recently used item has been used the longest time ago.
+    // Another thread might modify the shards while we are looking, in which case the
+    // popped item is only approximately the least recently used one
+    while (true) {
+        size_t oldestShard = _nShards;
+        uint64_t oldestUse = std::numeric_limits<uint64_t>::max();
+        for (size_t i = 0; i < _nShards; ++i) {
+            Shard& s = _shards[i];
+            std::lock_guard<std::mutex> lock(s.mutex);
+            if (s.tail != InvalidNode && s.nodes[s.tail].lastUse < oldestUse) {
+                oldestShard = i;
+                oldestUse = s.nodes[s.tail].lastUse;
+            }
+        }
+        ghoul_assert(
+            oldestShard != _nShards,
+            "Cannot pop LRU cache. Ensure cache is not empty."
+        );
+
+        Shard& s = _shards[oldestShard];
+        std::lock_guard<std::mutex> lock(s.mutex);
+        if (s.tail != InvalidNode) {
+            return remove(s, s.tail);
+        }
+    }
+}
+
+template<typename KeyType, typename ValueType, typename HasherType>
+std::vector<std::pair<KeyType, ValueType>>
+ShardedLRUCache<KeyType, ValueType, HasherType>::setByteBudget(size_t byteBudget) {
+    _byteBudget = byteBudget;
+    std::vector<Item> popped;
+    for (size_t i = 0; i < _nShards; ++i) {
+        Shard& s = _shards[i];
+        std::lock_guard<std::mutex> lock(s.mutex);
+        s.byteBudget = byteBudget / _nShards;
+        evict(s, &popped);
+    }
+    return popped;
+}
+
+template<typename KeyType, typename ValueType, typename HasherType>
+std::vector<std::pair<KeyType, ValueType>>
+ShardedLRUCache<KeyType, ValueType, HasherType>::items() const {
+    std::vector<std::pair<uint64_t, Item>> usedItems;
+    for (size_t i = 0; i < _nShards; ++i) {
+        const Shard& s = _shards[i];
+        std::lock_guard<std::mutex> lock(s.mutex);
+        for (NodeIndex n = s.tail; n != InvalidNode; n = s.nodes[n].previous) {
+            usedItems.emplace_back(s.nodes[n].lastUse, *s.nodes[n].item);
+        }
+    }
+
+    // The items of each shard are already sorted, but the shards have to be merged
+    std::sort(
+        usedItems.begin(),
+        usedItems.end(),
+        [](const std::pair<uint64_t, Item>& a, const std::pair<uint64_t, Item>& b) {
+            return a.first < b.first;
+        }
+    );
+
+    std::vector<Item> result;
+    result.reserve(usedItems.size());
+    for (std::pair<uint64_t, Item>& item : usedItems) {
+        result.push_back(std::move(item.second));
+    }
+    return result;
+}
+
+template<typename KeyType, typename ValueType, typename HasherType>
+size_t ShardedLRUCache<KeyType, ValueType, HasherType>::size() const {
+    size_t result = 0;
+    for (size_t i = 0; i < _nShards; ++i) {
+        std::lock_guard<std::mutex> lock(_shards[i].mutex);
+        result += _shards[i].index.size();
+    }
+    return result;
+}
+
+template<typename KeyType, typename ValueType, typename HasherType>
+size_t ShardedLRUCache<KeyType, ValueType, HasherType>::usedBytes() const {
+    size_t result = 0;
+    for (size_t i = 0; i < _nShards; ++i) {
+        std::lock_guard<std::mutex> lock(_shards[i].mutex);
+        result += _shards[i].usedBytes;
+    }
+    return result;
+}
+
+template<typename KeyType, typename ValueType, typename HasherType>
+size_t ShardedLRUCache<KeyType, ValueType, HasherType>::byteBudget() const {
+    return _byteBudget;
+}
+
+template<typename KeyType, typename ValueType, typename HasherType>
+size_t ShardedLRUCache<KeyType, ValueType, HasherType>::numShards() const {
+    return _nShards;
+}
+
+template<typename KeyType, typename ValueType, typename HasherType>
+typename ShardedLRUCache<KeyType, ValueType, HasherType>::Shard&
+ShardedLRUCache<KeyType, ValueType, HasherType>::shard(const KeyType& key) const {
+    if (_nShards == 1) {
+        return _shards[0];
+    }
+    // The hashers used for tiles put the level into the lowest bits, so the hash is
+    // mixed before the shard is selected to spread neighboring tiles across shards
+    const uint64_t hash = static_cast<uint64_t>(_hasher(key)) * 0x9E3779B97F4A7C15ULL;
+    return _shards[(hash >> 32) & (_nShards - 1)];
+}
+
+template<typename KeyType, typename ValueType, typename HasherType>
+void ShardedLRUCache<KeyType, ValueType, HasherType>::unlink(Shard& shard,
+                                                             NodeIndex node) const
+{
+    Node& n = shard.nodes[node];
+    if (n.previous != InvalidNode) {
+        shard.nodes[n.previous].next = n.next;
+    }
+    else {
+        shard.head = n.next;
+    }
+    if (n.next != InvalidNode) {
+        shard.nodes[n.next].previous = n.previous;
+    }
+    else {
+        shard.tail = n.previous;
+    }
+    n.previous = InvalidNode;
+    n.next = InvalidNode;
+}
+
+template<typename KeyType, typename ValueType, typename HasherType>
+void ShardedLRUCache<KeyType, ValueType, HasherType>::linkFront(Shard& shard,
+                                                                NodeIndex node)
+{
+    Node& n = shard.nodes[node];
+    n.lastUse = _useCounter.fetch_add(1, std::memory_order_relaxed);
+    n.previous = InvalidNode;
+    n.next = shard.head;
+    if (shard.head != InvalidNode) {
+        shard.nodes[shard.head].previous = node;
+    }
+    shard.head = node;
+    if (shard.tail == InvalidNode) {
+        shard.tail = node;
+    }
+}
+
+template<typename KeyType, typename ValueType, typename HasherType>
+void ShardedLRUCache<KeyType, ValueType, HasherType>::putInShard(Shard& shard,
+                                                                 KeyType key,
+                                                                 ValueType value,
+                                                                 size_t cost,
+                                                           std::vector<Item>* replaced)
+{
+    const auto it = shard.index.find(key);
+    if (it != shard.index.end()) {
+        // Replace the existing value and bump it to the front
+        Node& n = shard.nodes[it->second];
+        if (replaced) {
+            replaced->emplace_back(n.item->first, std::move(n.item->second));
+        }
+        n.item->second = std::move(value);
+        shard.usedBytes = shard.usedBytes - n.cost + cost;
+        n.cost = cost;
+        unlink(shard, it->second);
+        linkFront(shard, it->second);
+        return;
+    }
+
+    NodeIndex node;
+    if (!shard.freeNodes.empty()) {
+        node = shard.freeNodes.back();
+        shard.freeNodes.pop_back();
+    }
+    else {
+        ghoul_assert(shard.nodes.size() < InvalidNode, "Too many items in the cache");
+        node = static_cast<NodeIndex>(shard.nodes.size());
+        shard.nodes.emplace_back();
+    }
+
+    Node& n = shard.nodes[node];
+    n.item.emplace(key, std::move(value));
+    n.cost = cost;
+    shard.usedBytes += cost;
+    shard.index.emplace(std::move(key), node);
+    linkFront(shard, node);
+}
+
+template<typename KeyType, typename ValueType, typename HasherType>
+std::pair<KeyType, ValueType>
+ShardedLRUCache<KeyType, ValueType, HasherType>::remove(Shard& shard,
+                                                        NodeIndex node) const
+{
+    unlink(shard, node);
+    Node& n = shard.nodes[node];
+    Item item = std::move(*n.item);
+    n.item.reset();
+    shard.index.erase(item.first);
+    shard.usedBytes -= n.cost;
+    n.cost = 0;
+    shard.freeNodes.push_back(node);
+    return item;
+}
+
+template<typename KeyType, typename ValueType, typename HasherType>
+void ShardedLRUCache<KeyType, ValueType, HasherType>::evict(Shard& shard,
+                                                      std::vector<Item>* popped) const
+{
+    while (shard.usedBytes > shard.byteBudget && shard.tail != InvalidNode) {
+        Item item = remove(shard, shard.tail);
+        if (popped) {
+            popped->push_back(std::move(item));
+        }
+    }
+}
+
+} // namespace openspace::globebrowsing::cache
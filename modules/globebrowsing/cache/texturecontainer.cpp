@@ -24,6 +24,9 @@
 
 #include <modules/globebrowsing/cache/texturecontainer.h>
 
+#include <ghoul/misc/assert.h>
+#include <algorithm>
+
 namespace openspace::globebrowsing::cache {
 
 TextureContainer::TextureContainer(TileTextureInitData initData, size_t numTextures)
@@ -35,6 +38,7 @@ TextureContainer::TextureContainer(TileTextureInitData initData, size_t numTextu
 
 void TextureContainer::reset() {
     _textures.clear();
+    _releasedTextures.clear();
     _freeTexture = 0;
     for (size_t i = 0; i < _numTextures; ++i) {
         using namespace ghoul::opengl;
@@ -62,7 +66,12 @@ void TextureContainer::reset(size_t numTextures) {
 }
 
 ghoul::opengl::Texture* TextureContainer::getTextureIfFree() {
-    if (_freeTexture < _textures.size()) {
+    if (!_releasedTextures.empty()) {
+        ghoul::opengl::Texture* texture = _releasedTextures.back();
+        _releasedTextures.pop_back();
+        return texture;
+    }
+    else if (_freeTexture < _textures.size()) {
         ghoul::opengl::Texture* texture = _textures[_freeTexture].get();
         _freeTexture++;
         return texture;
@@ -72,6 +81,20 @@ ghoul::opengl::Texture* TextureContainer::getTextureIfFree() {
     }
 }
 
+void TextureContainer::release(ghoul::opengl::Texture* texture) {
+    ghoul_assert(
+        std::find_if(
+            _textures.cbegin(),
+            _textures.cbegin() + _freeTexture,
+            [texture](const std::unique_ptr<ghoul::opengl::Texture>& t) {
+                return t.get() == texture;
+            }
+        ) != _textures.cbegin() + _freeTexture,
+        "Texture must have been handed out by this container"
+    );
+    _releasedTextures.push_back(texture);
+}
+
 const TileTextureInitData& TextureContainer::tileTextureInitData() const {
     return _initData;
 }
@@ -50,12 +50,19 @@ public:
     void reset(size_t numTextures);
 
     /**
-     * \return A pointer to a texture if there is one texture never used before. If there
-     *         are no textures left, nullptr is returned. TextureContainer still owns the
-     *         texture so no delete should be called on the raw pointer.
+     * \return A pointer to a texture if there is one texture that was never used before
+     *         or that has been released. If there are no textures left, nullptr is
+     *         returned. TextureContainer still owns the texture so no delete should be
+     *         called on the raw pointer.
      */
     ghoul::opengl::Texture* getTextureIfFree();
 
+    /**
+     * Returns the \p texture, which has to be owned by this container, so that it can be
+     * handed out again by <code>getTextureIfFree</code>.
+     */
+    void release(ghoul::opengl::Texture* texture);
+
     const TileTextureInitData& tileTextureInitData() const;
 
     /**
@@ -65,6 +72,7 @@ public:
 
 private:
     std::vector<std::unique_ptr<ghoul::opengl::Texture>> _textures;
+    std::vector<ghoul::opengl::Texture*> _releasedTextures;
 
     const TileTextureInitData _initData;
     size_t _freeTexture = 0;
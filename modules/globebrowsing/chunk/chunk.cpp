@@ -27,6 +27,7 @@
 #include <modules/globebrowsing/geometry/geodetic3.h>
 #include <modules/globebrowsing/globes/renderableglobe.h>
 #include <modules/globebrowsing/globes/chunkedlodglobe.h>
+#include <modules/globebrowsing/rendering/layer/layer.h>
 #include <modules/globebrowsing/rendering/layer/layergroup.h>
 #include <modules/globebrowsing/rendering/layer/layermanager.h>
 #include <modules/globebrowsing/tile/chunktile.h>
@@ -60,7 +61,21 @@ bool Chunk::isVisible() const {
     return _isVisible;
 }
 
-Chunk::Status Chunk::update(const RenderData& data) {
+void Chunk::updateTileData() {
+    _tileData = TileData{ calculateBoundingHeights(), calculateHasAvailableTileData() };
+}
+
+void Chunk::setTileData(const BoundingHeights& boundingHeights,
+                        bool hasAvailableTileData)
+{
+    _tileData = TileData{ boundingHeights, hasAvailableTileData };
+}
+
+bool Chunk::hasTileData() const {
+    return _tileData.has_value();
+}
+
+Chunk::Status Chunk::update(const RenderData& data, const glm::dmat4& viewProjection) {
     const std::shared_ptr<const Camera>& savedCamera = _owner.savedCamera();
     const Camera& camRef = savedCamera ? *savedCamera : data.camera;
 
@@ -74,7 +89,7 @@ Chunk::Status Chunk::update(const RenderData& data) {
     };
 
     _isVisible = true;
-    if (_owner.chunkedLodGlobe()->testIfCullable(*this, myRenderData)) {
+    if (_owner.chunkedLodGlobe()->testIfCullable(*this, myRenderData, viewProjection)) {
         _isVisible = false;
         return Status::WantMerge;
     }
@@ -96,6 +111,14 @@ Chunk::Status Chunk::update(const RenderData& data) {
 }
 
 Chunk::BoundingHeights Chunk::boundingHeights() const {
+    return _tileData ? _tileData->boundingHeights : calculateBoundingHeights();
+}
+
+bool Chunk::hasAvailableTileData() const {
+    return _tileData ? _tileData->hasAvailableTileData : calculateHasAvailableTileData();
+}
+
+Chunk::BoundingHeights Chunk::calculateBoundingHeights() const {
     using ChunkTileSettingsPair = std::pair<ChunkTile, const LayerRenderSettings*>;
 
     BoundingHeights boundingHeights { 0.f, 0.f, false };
@@ -156,6 +179,19 @@ Chunk::BoundingHeights Chunk::boundingHeights() const {
     return boundingHeights;
 }
 
+bool Chunk::calculateHasAvailableTileData() const {
+    std::shared_ptr<LayerManager> lm = owner().chunkedLodGlobe()->layerManager();
+
+    for (size_t i = 0; i < layergroupid::NUM_LAYER_GROUPS; ++i) {
+        for (const std::shared_ptr<Layer>& layer : lm->layerGroup(i).activeLayers()) {
+            if (layer->tileStatus(_tileIndex) == Tile::Status::OK) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
 std::vector<glm::dvec4> Chunk::boundingPolyhedronCorners() const {
     const Ellipsoid& ellipsoid = owner().ellipsoid();
     const GeodeticPatch& patch = surfacePatch();
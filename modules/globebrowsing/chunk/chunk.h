@@ -28,6 +28,7 @@
 #include <modules/globebrowsing/geometry/geodeticpatch.h>
 #include <modules/globebrowsing/tile/tileindex.h>
 #include <ghoul/glm.h>
+#include <optional>
 #include <vector>
 
 namespace openspace { struct RenderData; }
@@ -56,6 +57,31 @@ public:
     Chunk(const RenderableGlobe& owner, const TileIndex& tileIndex,
           bool initVisible = true);
 
+    /**
+     * Queries the tile providers for the bounding heights and the availability of tile
+     * data for this Chunk and stores them, so that they are used by the following calls
+     * to <code>update</code>, <code>boundingHeights</code> and
+     * <code>hasAvailableTileData</code>. Querying the tile providers can enqueue tile
+     * requests and create textures, so this function has to be called on the render
+     * thread. Afterwards, <code>update</code> does not access any tile provider and can
+     * be called for different Chunks concurrently.
+     */
+    void updateTileData();
+
+    /**
+     * Stores the provided bounding heights and availability of tile data instead of
+     * querying the tile providers. This is used to evaluate Chunks that are not part of
+     * the chunk tree without enqueueing any tile requests.
+     */
+    void setTileData(const BoundingHeights& boundingHeights, bool hasAvailableTileData);
+
+    /**
+     * Returns true if the tile data was stored by <code>updateTileData</code> or
+     * <code>setTileData</code>, in which case <code>boundingHeights</code> and
+     * <code>hasAvailableTileData</code> do not access any tile provider.
+     */
+    bool hasTileData() const;
+
     /**
      * Updates the Chunk internally and returns the Status of the Chunk.
      *
@@ -63,11 +89,13 @@ public:
      * Chunk is cullable it will be set to invisible and return Status::WANT_MERGE.
      * If the desired level is smaller than the current level of the chunk it will
      * return Status::WANT_MERGE, if it is larger it will return Status::WANT_SPLIT,
-     * otherwise Status::DO_NOTHING.
+     * otherwise Status::DO_NOTHING. The <code>viewProjection</code> matrix of the
+     * camera that is used for the evaluation is passed in, so that this function does
+     * not write to the Camera's caches and can be called concurrently.
      *
      * \return The Status of the chunk.
      */
-    Status update(const RenderData& data);
+    Status update(const RenderData& data, const glm::dmat4& viewProjection);
 
     /**
      * Returns a convex polyhedron of eight vertices tightly bounding the volume of
@@ -91,11 +119,27 @@ public:
      */
     BoundingHeights boundingHeights() const;
 
+    /**
+     * Returns true if any of the active layers has a loaded tile for this Chunk.
+     */
+    bool hasAvailableTileData() const;
+
 private:
+    struct TileData {
+        BoundingHeights boundingHeights;
+        bool hasAvailableTileData;
+    };
+
+    BoundingHeights calculateBoundingHeights() const;
+    bool calculateHasAvailableTileData() const;
+
     const RenderableGlobe& _owner;
     const TileIndex _tileIndex;
     bool _isVisible;
     const GeodeticPatch _surfacePatch;
+
+    // Set by updateTileData
+    std::optional<TileData> _tileData;
 };
 
 } // namespace openspace::globebrowsing
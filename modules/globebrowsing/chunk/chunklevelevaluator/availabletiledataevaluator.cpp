@@ -25,33 +25,14 @@
 #include <modules/globebrowsing/chunk/chunklevelevaluator/availabletiledataevaluator.h>
 
 #include <modules/globebrowsing/chunk/chunk.h>
-#include <modules/globebrowsing/globes/chunkedlodglobe.h>
-#include <modules/globebrowsing/globes/renderableglobe.h>
-#include <modules/globebrowsing/rendering/layer/layer.h>
-#include <modules/globebrowsing/rendering/layer/layergroup.h>
-#include <modules/globebrowsing/rendering/layer/layermanager.h>
-#include <modules/globebrowsing/tile/tile.h>
 
 namespace openspace::globebrowsing::chunklevelevaluator {
 
 int AvailableTileData::desiredLevel(const Chunk& chunk, const RenderData&) const {
-    std::shared_ptr<LayerManager> layerManager =
-        chunk.owner().chunkedLodGlobe()->layerManager();
-
-    const int currLevel = chunk.tileIndex().level;
-
-    for (size_t i = 0; i < layergroupid::NUM_LAYER_GROUPS; ++i) {
-        for (const std::shared_ptr<Layer>& layer :
-             layerManager->layerGroup(i).activeLayers())
-        {
-            Tile::Status status = layer->tileStatus(chunk.tileIndex());
-            if (status == Tile::Status::OK) {
-                return UnknownDesiredLevel;
-            }
-        }
+    if (chunk.hasAvailableTileData()) {
+        return UnknownDesiredLevel;
     }
-
-    return currLevel - 1;
+    return chunk.tileIndex().level - 1;
 }
 
 } // namespace openspace::globebrowsing::chunklevelevaluator
@@ -0,0 +1,209 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2018                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_GLOBEBROWSING___CHUNK_TREE___H__
+#define __OPENSPACE_MODULE_GLOBEBROWSING___CHUNK_TREE___H__
+
+#include <modules/globebrowsing/chunk/chunk.h>
+#include <modules/globebrowsing/tile/quad.h>
+
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace openspace::globebrowsing {
+
+/**
+ * A quadtree whose nodes are stored in a single contiguous pool and are addressed by
+ * indices that stay valid for as long as the node exists. The four children of a node
+ * are allocated as one block, and merged blocks are kept on a free list and reused by
+ * later splits. Once the pool has grown to the working size of the tree, splitting,
+ * merging and traversing the tree does not allocate any memory.
+ *
+ * The roots of the tree occupy the first indices of the pool, in the order in which
+ * they were passed to the constructor.
+ *
+ * \tparam T is the value stored in each node, for example a Chunk
+ */
+template <typename T>
+class ChunkTree {
+public:
+    using NodeIndex = uint32_t;
+    static constexpr const NodeIndex InvalidIndex = std::numeric_limits<NodeIndex>::max();
+
+    class Node {
+    public:
+        bool isRoot() const;
+        bool isLeaf() const;
+
+        T& value();
+        const T& value() const;
+
+    private:
+        friend class ChunkTree;
+
+        NodeIndex _parent = InvalidIndex;
+        NodeIndex _firstChild = InvalidIndex;
+        std::optional<T> _value;
+    };
+
+    /**
+     * Iterates over all nodes of the tree in depth first order by following the parent
+     * and child indices of the nodes, so no stack needs to be allocated.
+     */
+    class ConstIterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Node;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Node*;
+        using reference = const Node&;
+
+        ConstIterator(const ChunkTree& tree, NodeIndex index);
+
+        reference operator*() const;
+        pointer operator->() const;
+        ConstIterator& operator++();
+        ConstIterator operator++(int);
+        bool operator==(const ConstIterator& rhs) const;
+        bool operator!=(const ConstIterator& rhs) const;
+
+        NodeIndex index() const;
+
+    private:
+        const ChunkTree* _tree;
+        NodeIndex _index;
+    };
+
+    explicit ChunkTree(std::vector<T> roots);
+
+    size_t numRoots() const;
+    NodeIndex root(size_t i) const;
+
+    /**
+     * Returns the total number of nodes that are currently part of the tree.
+     */
+    size_t size() const;
+
+    /**
+     * Returns the number of nodes the pool has storage for, including the blocks that
+     * are on the free list.
+     */
+    size_t capacity() const;
+
+    Node& node(NodeIndex index);
+    const Node& node(NodeIndex index) const;
+    NodeIndex parent(NodeIndex index) const;
+    NodeIndex child(NodeIndex index, Quad quad) const;
+
+    /**
+     * Splits the leaf node at \p index. The children are created by calling
+     * \p createChild with the value of the node and the Quad of each child, in the
+     * order of the Quad enum.
+     */
+    template <typename CreateChild>
+    void split(NodeIndex index, CreateChild&& createChild);
+
+    /**
+     * Removes all descendants of the node at \p index and returns their storage to the
+     * free list.
+     */
+    void merge(NodeIndex index);
+
+    /**
+     * Updates all nodes of the tree. Every leaf is split if \p status returns
+     * Chunk::Status::WantSplit for it. An inner node is merged if all of its children
+     * returned Chunk::Status::WantMerge and the node itself does not want to split.
+     * New children are created with \p createChild as in <code>split</code>.
+     *
+     * \param status is called as <code>Chunk::Status(NodeIndex)</code> once for each
+     *        node that existed before the update, children before their parent
+     * \returns the number of nodes that were evaluated
+     */
+    template <typename StatusFunc, typename CreateChild>
+    size_t updateChunkTree(StatusFunc&& status, CreateChild&& createChild);
+
+    /**
+     * Stores the indices of all nodes that <code>updateChunkTree</code> evaluates in
+     * \p result, which are all nodes of the tree in the order in which they are
+     * evaluated. This makes it possible to evaluate the nodes up front, for example
+     * concurrently, and pass the stored results to <code>updateChunkTree</code>.
+     */
+    void nodesToEvaluate(std::vector<NodeIndex>& result) const;
+
+    /**
+     * Walks from the node at \p index towards the leaves, calling \p selectQuad with the
+     * value of each inner node to decide which child to descend into, and returns the
+     * index of the leaf that was reached.
+     */
+    template <typename SelectQuad>
+    NodeIndex findLeaf(NodeIndex index, SelectQuad&& selectQuad) const;
+
+    ConstIterator begin() const;
+    ConstIterator end() const;
+
+    template <typename F>
+    void depthFirst(F&& f) const;
+
+    /**
+     * Calls \p f for all nodes in breadth first order. The order is built in a buffer
+     * that is owned by the tree and reused between calls, so this function must not be
+     * called concurrently on the same tree.
+     */
+    template <typename F>
+    void breadthFirst(F&& f) const;
+
+    /**
+     * Calls \p f for all nodes in reversed breadth first order, that is the deepest
+     * nodes first and the roots last. The same restrictions as for
+     * <code>breadthFirst</code> apply.
+     */
+    template <typename F>
+    void reverseBreadthFirst(F&& f) const;
+
+private:
+    template <typename StatusFunc, typename CreateChild>
+    bool updateNode(NodeIndex index, StatusFunc& status, CreateChild& createChild,
+        size_t& nEvaluated);
+
+    NodeIndex allocateBlock();
+    NodeIndex next(NodeIndex index) const;
+    void appendPostOrder(NodeIndex index, std::vector<NodeIndex>& result) const;
+    void buildBreadthFirstOrder() const;
+
+    std::vector<Node> _nodes;
+    std::vector<NodeIndex> _freeBlocks;
+    NodeIndex _nRoots;
+    size_t _size;
+
+    mutable std::vector<NodeIndex> _traversalOrder;
+};
+
+} // namespace openspace::globebrowsing
+
+#include <modules/globebrowsing/chunk/chunktree.inl>
+
+#endif // __OPENSPACE_MODULE_GLOBEBROWSING___CHUNK_TREE___H__
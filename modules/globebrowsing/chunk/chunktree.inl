@@ -0,0 +1,355 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2018                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <ghoul/misc/assert.h>
+
+namespace openspace::globebrowsing {
+
+template<typename T>
+bool ChunkTree<T>::Node::isRoot() const {
+    return _parent == InvalidIndex;
+}
+
+template<typename T>
+bool ChunkTree<T>::Node::isLeaf() const {
+    return _firstChild == InvalidIndex;
+}
+
+template<typename T>
+T& ChunkTree<T>::Node::value() {
+    return *_value;
+}
+
+template<typename T>
+const T& ChunkTree<T>::Node::value() const {
+    return *_value;
+}
+
+template<typename T>
+ChunkTree<T>::ConstIterator::ConstIterator(const ChunkTree& tree, NodeIndex index)
+    : _tree(&tree)
+    , _index(index)
+{}
+
+template<typename T>
+typename ChunkTree<T>::ConstIterator::reference
+ChunkTree<T>::ConstIterator::operator*() const
+{
+    return _tree->_nodes[_index];
+}
+
+template<typename T>
+typename ChunkTree<T>::ConstIterator::pointer
+ChunkTree<T>::ConstIterator::operator->() const
+{
+    return &_tree->_nodes[_index];
+}
+
+template<typename T>
+typename ChunkTree<T>::ConstIterator& ChunkTree<T>::ConstIterator::operator++() {
+    _index = _tree->next(_index);
+    return *this;
+}
+
+template<typename T>
+typename ChunkTree<T>::ConstIterator ChunkTree<T>::ConstIterator::operator++(int) {
+    ConstIterator it = *this;
+    _index = _tree->next(_index);
+    return it;
+}
+
+template<typename T>
+bool ChunkTree<T>::ConstIterator::operator==(const ConstIterator& rhs) const {
+    return _tree == rhs._tree && _index == rhs._index;
+}
+
+template<typename T>
+bool ChunkTree<T>::ConstIterator::operator!=(const ConstIterator& rhs) const {
+    return !(*this == rhs);
+}
+
+template<typename T>
+typename ChunkTree<T>::NodeIndex ChunkTree<T>::ConstIterator::index() const {
+    return _index;
+}
+
+template<typename T>
+ChunkTree<T>::ChunkTree(std::vector<T> roots)
+    : _nRoots(static_cast<NodeIndex>(roots.size()))
+    , _size(roots.size())
+{
+    ghoul_assert(!roots.empty(), "The tree must have at least one root");
+    _nodes.resize(roots.size());
+    for (size_t i = 0; i < roots.size(); ++i) {
+        _nodes[i]._value.emplace(std::move(roots[i]));
+    }
+}
+
+template<typename T>
+size_t ChunkTree<T>::numRoots() const {
+    return _nRoots;
+}
+
+template<typename T>
+typename ChunkTree<T>::NodeIndex ChunkTree<T>::root(size_t i) const {
+    ghoul_assert(i < _nRoots, "Root index out of range");
+    return static_cast<NodeIndex>(i);
+}
+
+template<typename T>
+size_t ChunkTree<T>::size() const {
+    return _size;
+}
+
+template<typename T>
+size_t ChunkTree<T>::capacity() const {
+    return _nodes.size();
+}
+
+template<typename T>
+typename ChunkTree<T>::Node& ChunkTree<T>::node(NodeIndex index) {
+    ghoul_assert(index < _nodes.size(), "Node index out of range");
+    return _nodes[index];
+}
+
+template<typename T>
+const typename ChunkTree<T>::Node& ChunkTree<T>::node(NodeIndex index) const {
+    ghoul_assert(index < _nodes.size(), "Node index out of range");
+    return _nodes[index];
+}
+
+template<typename T>
+typename ChunkTree<T>::NodeIndex ChunkTree<T>::parent(NodeIndex index) const {
+    return _nodes[index]._parent;
+}
+
+template<typename T>
+typename ChunkTree<T>::NodeIndex ChunkTree<T>::child(NodeIndex index, Quad quad) const {
+    ghoul_assert(!_nodes[index].isLeaf(), "Leaf nodes have no children");
+    return _nodes[index]._firstChild + static_cast<NodeIndex>(quad);
+}
+
+template<typename T>
+template<typename CreateChild>
+void ChunkTree<T>::split(NodeIndex index, CreateChild&& createChild) {
+    ghoul_assert(_nodes[index].isLeaf(), "Only leaf nodes can be split");
+
+    // Allocating the block might grow the pool, so no references into it can be held
+    // until the block exists
+    const NodeIndex block = allocateBlock();
+    for (NodeIndex i = 0; i < 4; ++i) {
+        Node& c = _nodes[block + i];
+        c._parent = index;
+        c._firstChild = InvalidIndex;
+        c._value.emplace(createChild(*_nodes[index]._value, static_cast<Quad>(i)));
+    }
+    _nodes[index]._firstChild = block;
+    _size += 4;
+}
+
+template<typename T>
+void ChunkTree<T>::merge(NodeIndex index) {
+    const NodeIndex block = _nodes[index]._firstChild;
+    if (block == InvalidIndex) {
+        return;
+    }
+
+    for (NodeIndex i = 0; i < 4; ++i) {
+        merge(block + i);
+        _nodes[block + i]._value.reset();
+    }
+    _nodes[index]._firstChild = InvalidIndex;
+    _freeBlocks.push_back(block);
+    _size -= 4;
+
+    ghoul_assert(_nodes[index].isLeaf(), "ChunkNode must be leaf after merge");
+}
+
+template<typename T>
+template<typename StatusFunc, typename CreateChild>
+size_t ChunkTree<T>::updateChunkTree(StatusFunc&& status, CreateChild&& createChild) {
+    size_t nEvaluated = 0;
+    for (NodeIndex i = 0; i < _nRoots; ++i) {
+        updateNode(i, status, createChild, nEvaluated);
+    }
+    return nEvaluated;
+}
+
+template<typename T>
+template<typename StatusFunc, typename CreateChild>
+bool ChunkTree<T>::updateNode(NodeIndex index, StatusFunc& status,
+                              CreateChild& createChild, size_t& nEvaluated)
+{
+    if (_nodes[index].isLeaf()) {
+        ++nEvaluated;
+        const Chunk::Status s = status(index);
+        if (s == Chunk::Status::WantSplit) {
+            split(index, createChild);
+        }
+        return s == Chunk::Status::WantMerge;
+    }
+    else {
+        // The children block of this node cannot be moved or freed while the children
+        // are being updated, so the index stays valid even if the pool grows
+        const NodeIndex block = _nodes[index]._firstChild;
+        char requestedMergeMask = 0;
+        for (NodeIndex i = 0; i < 4; ++i) {
+            if (updateNode(block + i, status, createChild, nEvaluated)) {
+                requestedMergeMask |= (1 << i);
+            }
+        }
+
+        // Evaluating a chunk has side effects that the frame relies on, such as the
+        // requests of its tiles and its visibility, so inner nodes are evaluated even if
+        // their children do not want to merge
+        ++nEvaluated;
+        const bool allChildrenWantMerge = requestedMergeMask == 0xf;
+        const bool thisChunkWantsSplit = status(index) == Chunk::Status::WantSplit;
+        if (allChildrenWantMerge && !thisChunkWantsSplit) {
+            merge(index);
+        }
+
+        return false;
+    }
+}
+
+template<typename T>
+void ChunkTree<T>::nodesToEvaluate(std::vector<NodeIndex>& result) const {
+    result.clear();
+    result.reserve(_size);
+    for (NodeIndex i = 0; i < _nRoots; ++i) {
+        appendPostOrder(i, result);
+    }
+}
+
+template<typename T>
+template<typename SelectQuad>
+typename ChunkTree<T>::NodeIndex ChunkTree<T>::findLeaf(NodeIndex index,
+                                                        SelectQuad&& selectQuad) const
+{
+    while (!_nodes[index].isLeaf()) {
+        const Quad quad = selectQuad(*_nodes[index]._value);
+        index = _nodes[index]._firstChild + static_cast<NodeIndex>(quad);
+    }
+    return index;
+}
+
+template<typename T>
+typename ChunkTree<T>::ConstIterator ChunkTree<T>::begin() const {
+    return ConstIterator(*this, 0);
+}
+
+template<typename T>
+typename ChunkTree<T>::ConstIterator ChunkTree<T>::end() const {
+    return ConstIterator(*this, InvalidIndex);
+}
+
+template<typename T>
+template<typename F>
+void ChunkTree<T>::depthFirst(F&& f) const {
+    for (NodeIndex i = 0; i != InvalidIndex; i = next(i)) {
+        f(_nodes[i]);
+    }
+}
+
+template<typename T>
+template<typename F>
+void ChunkTree<T>::breadthFirst(F&& f) const {
+    buildBreadthFirstOrder();
+    for (NodeIndex i : _traversalOrder) {
+        f(_nodes[i]);
+    }
+}
+
+template<typename T>
+template<typename F>
+void ChunkTree<T>::reverseBreadthFirst(F&& f) const {
+    buildBreadthFirstOrder();
+    for (auto it = _traversalOrder.rbegin(); it != _traversalOrder.rend(); ++it) {
+        f(_nodes[*it]);
+    }
+}
+
+template<typename T>
+typename ChunkTree<T>::NodeIndex ChunkTree<T>::allocateBlock() {
+    if (!_freeBlocks.empty()) {
+        const NodeIndex block = _freeBlocks.back();
+        _freeBlocks.pop_back();
+        return block;
+    }
+    const NodeIndex block = static_cast<NodeIndex>(_nodes.size());
+    _nodes.resize(_nodes.size() + 4);
+    return block;
+}
+
+template<typename T>
+typename ChunkTree<T>::NodeIndex ChunkTree<T>::next(NodeIndex index) const {
+    if (!_nodes[index].isLeaf()) {
+        return _nodes[index]._firstChild;
+    }
+
+    // Find the closest ancestor (or the node itself) that has a next sibling
+    while (true) {
+        const NodeIndex p = _nodes[index]._parent;
+        if (p == InvalidIndex) {
+            return index + 1 < _nRoots ? index + 1 : InvalidIndex;
+        }
+        if (index - _nodes[p]._firstChild < 3) {
+            return index + 1;
+        }
+        index = p;
+    }
+}
+
+template<typename T>
+void ChunkTree<T>::appendPostOrder(NodeIndex index, std::vector<NodeIndex>& result) const
+{
+    const NodeIndex block = _nodes[index]._firstChild;
+    if (block != InvalidIndex) {
+        for (NodeIndex c = 0; c < 4; ++c) {
+            appendPostOrder(block + c, result);
+        }
+    }
+    result.push_back(index);
+}
+
+template<typename T>
+void ChunkTree<T>::buildBreadthFirstOrder() const {
+    // The buffer is used as the queue itself; every node appends its children and the
+    // read position trails behind the end until all nodes have been visited
+    _traversalOrder.clear();
+    for (NodeIndex i = 0; i < _nRoots; ++i) {
+        _traversalOrder.push_back(i);
+    }
+    for (size_t i = 0; i < _traversalOrder.size(); ++i) {
+        const NodeIndex block = _nodes[_traversalOrder[i]]._firstChild;
+        if (block != InvalidIndex) {
+            for (NodeIndex c = 0; c < 4; ++c) {
+                _traversalOrder.push_back(block + c);
+            }
+        }
+    }
+}
+
+} // namespace openspace::globebrowsing
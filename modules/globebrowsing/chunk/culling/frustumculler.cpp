@@ -36,12 +36,18 @@ FrustumCuller::FrustumCuller(AABB3 viewFrustum)
 {}
 
 bool FrustumCuller::isCullable(const Chunk& chunk, const RenderData& renderData) {
-    // Calculate the MVP matrix
-    const glm::dmat4 modelTransform = chunk.owner().modelTransform();
     const glm::dmat4 viewTransform = glm::dmat4(renderData.camera.combinedViewMatrix());
-    const glm::dmat4 modelViewProjectionTransform = glm::dmat4(
+    const glm::dmat4 viewProjection = glm::dmat4(
         renderData.camera.sgctInternal.projectionMatrix()
-    ) * viewTransform * modelTransform;
+    ) * viewTransform;
+    return isCullable(chunk, viewProjection);
+}
+
+bool FrustumCuller::isCullable(const Chunk& chunk, const glm::dmat4& viewProjection) const
+{
+    // Calculate the MVP matrix
+    const glm::dmat4 modelViewProjectionTransform =
+        viewProjection * chunk.owner().modelTransform();
 
     const std::vector<glm::dvec4>& corners = chunk.boundingPolyhedronCorners();
 
@@ -28,6 +28,7 @@
 #include <modules/globebrowsing/chunk/culling/chunkculler.h>
 
 #include <modules/globebrowsing/geometry/aabb.h>
+#include <ghoul/glm.h>
 
 namespace openspace::globebrowsing::culling {
 
@@ -50,6 +51,13 @@ public:
 
     bool isCullable(const Chunk& chunk, const RenderData& renderData) override;
 
+    /**
+     * Same as the overload taking the RenderData, but using a precomputed view
+     * projection matrix. As this function does not access the Camera, it can be called
+     * from multiple threads at once.
+     */
+    bool isCullable(const Chunk& chunk, const glm::dmat4& viewProjection) const;
+
 private:
     const AABB3 _viewFrustum;
 };
@@ -0,0 +1,244 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2018                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/globebrowsing/chunk/tileprefetcher.h>
+
+#include <modules/globebrowsing/chunk/chunk.h>
+#include <modules/globebrowsing/globes/chunkedlodglobe.h>
+#include <modules/globebrowsing/globes/renderableglobe.h>
+#include <modules/globebrowsing/rendering/layer/layer.h>
+#include <modules/globebrowsing/rendering/layer/layergroup.h>
+#include <modules/globebrowsing/rendering/layer/layermanager.h>
+#include <modules/globebrowsing/tile/tileindex.h>
+#include <modules/globebrowsing/tile/tileprovider/tileprovider.h>
+#include <openspace/util/camera.h>
+#include <openspace/util/updatestructures.h>
+#include <chrono>
+#include <queue>
+
+namespace {
+    // The camera states of this time span (in seconds) are used to estimate the velocity
+    constexpr const double HistoryDuration = 0.25;
+
+    // Below these values, the camera is considered to be standing still, in which case
+    // the tiles are already requested by the rendering
+    constexpr const double MinimumDisplacement = 1.0;
+    constexpr const double MinimumAngle = 1e-4;
+
+    // Limits the number of chunks that are evaluated per requested chunk, in case most
+    // of the tiles are already loaded
+    constexpr const int MaxEvaluationsPerRequest = 16;
+
+    double currentTime() {
+        using namespace std::chrono;
+        return duration<double>(steady_clock::now().time_since_epoch()).count();
+    }
+} // namespace
+
+namespace openspace::globebrowsing {
+
+TilePrefetcher::TilePrefetcher(const RenderableGlobe& owner)
+    : _owner(owner)
+{}
+
+void TilePrefetcher::update(const RenderData& data, double lookahead, int budget) {
+    const double now = currentTime();
+    if (!_history.empty() && now - _history.back().time > HistoryDuration) {
+        // The globe has not been rendered for a while, so the old states are useless
+        _history.clear();
+    }
+
+    const glm::dvec3 modelPosition = glm::dvec3(
+        _owner.inverseModelTransform() * glm::dvec4(data.camera.positionVec3(), 1.0)
+    );
+    _history.push_back({ modelPosition, data.camera.rotationQuaternion(), now });
+    while (_history.size() > 2 && now - _history[1].time > HistoryDuration) {
+        _history.pop_front();
+    }
+
+    // The saved camera is used to debug the culling and level evaluation, in which case
+    // the chunk tree does not follow the camera anyway
+    if (lookahead <= 0.0 || budget <= 0 || _owner.savedCamera()) {
+        return;
+    }
+
+    std::unique_ptr<Camera> camera = predictCamera(data, lookahead);
+    if (!camera) {
+        return;
+    }
+
+    const RenderData predictedData = {
+        *camera,
+        data.position,
+        data.time,
+        data.doPerformanceMeasurement,
+        data.renderBinMask,
+        data.modelTransform
+    };
+    const glm::dmat4 viewProjection =
+        glm::dmat4(camera->sgctInternal.projectionMatrix()) *
+        glm::dmat4(camera->combinedViewMatrix());
+
+    // Traverse the chunk tree that would be built for the predicted camera in breadth
+    // first order without actually building it. The tile requests of the coarser levels
+    // are issued first and will be served last by the job manager, which prefers the
+    // most recent requests
+    const ChunkedLodGlobe& globe = *_owner.chunkedLodGlobe();
+    const ChunkTree<Chunk>& tree = globe.chunkTree();
+    std::queue<PredictedChunk> chunks;
+    for (size_t i = 0; i < tree.numRoots(); ++i) {
+        const ChunkTree<Chunk>::NodeIndex root = tree.root(i);
+        const Chunk::BoundingHeights defaultHeights = {
+            Chunk::DefaultHeight,
+            Chunk::DefaultHeight,
+            false
+        };
+        chunks.push({
+            tree.node(root).value().tileIndex(),
+            root,
+            boundingHeights(root, defaultHeights)
+        });
+    }
+
+    int nRequests = 0;
+    int nEvaluations = 0;
+    const int maxEvaluations = budget * MaxEvaluationsPerRequest;
+    while (!chunks.empty() && nRequests < budget && nEvaluations < maxEvaluations) {
+        const PredictedChunk predicted = chunks.front();
+        chunks.pop();
+        ++nEvaluations;
+
+        // Querying the tile providers for the bounding heights would request the tiles
+        // with the same priority as the visible ones, so the heights are taken from the
+        // chunk tree instead. The tiles of this chunk are the ones that are about to be
+        // requested, so its level is not limited by the data that is already loaded
+        Chunk chunk(_owner, predicted.tileIndex);
+        chunk.setTileData(predicted.boundingHeights, true);
+        if (globe.testIfCullable(chunk, predictedData, viewProjection)) {
+            continue;
+        }
+
+        if (predicted.tileIndex.level < globe.desiredLevel(chunk, predictedData)) {
+            const bool hasChildren = predicted.node != ChunkTree<Chunk>::InvalidIndex &&
+                                     !tree.node(predicted.node).isLeaf();
+            for (int i = 0; i < 4; ++i) {
+                const Quad quad = static_cast<Quad>(i);
+                const ChunkTree<Chunk>::NodeIndex child = hasChildren ?
+                    tree.child(predicted.node, quad) :
+                    ChunkTree<Chunk>::InvalidIndex;
+                chunks.push({
+                    predicted.tileIndex.child(quad),
+                    child,
+                    boundingHeights(child, predicted.boundingHeights)
+                });
+            }
+        }
+        else if (requestTiles(predicted.tileIndex)) {
+            ++nRequests;
+        }
+    }
+}
+
+Chunk::BoundingHeights TilePrefetcher::boundingHeights(ChunkTree<Chunk>::NodeIndex node,
+                                        const Chunk::BoundingHeights& parentHeights) const
+{
+    if (node == ChunkTree<Chunk>::InvalidIndex) {
+        // The heights of a chunk are within the heights of its parent, so these are a
+        // conservative estimate for chunks that are not part of the chunk tree
+        return parentHeights;
+    }
+    const Chunk& chunk = _owner.chunkedLodGlobe()->chunkTree().node(node).value();
+    return chunk.hasTileData() ? chunk.boundingHeights() : parentHeights;
+}
+
+std::unique_ptr<Camera> TilePrefetcher::predictCamera(const RenderData& data,
+                                                      double lookahead) const
+{
+    if (_history.size() < 2) {
+        return nullptr;
+    }
+
+    const CameraState& first = _history.front();
+    const CameraState& last = _history.back();
+    const double dt = last.time - first.time;
+    if (dt <= 0.0) {
+        return nullptr;
+    }
+
+    // Extrapolate linearly in position and with a constant angular velocity
+    const double factor = lookahead / dt;
+    const glm::dvec3 displacement = (last.position - first.position) * factor;
+
+    glm::dquat rotationDiff = last.rotation * glm::inverse(first.rotation);
+    if (rotationDiff.w < 0.0) {
+        // Take the shortest way around
+        rotationDiff = -rotationDiff;
+    }
+    const double angle = glm::min(
+        glm::angle(rotationDiff) * factor,
+        glm::half_pi<double>()
+    );
+
+    if (glm::length(displacement) < MinimumDisplacement && angle < MinimumAngle) {
+        return nullptr;
+    }
+
+    const glm::dvec3 position = last.position + displacement;
+    if (glm::length(position) < _owner.ellipsoid().minimumRadius()) {
+        // The camera would end up inside the globe, the prediction is not reliable
+        return nullptr;
+    }
+
+    std::unique_ptr<Camera> camera = std::make_unique<Camera>(data.camera);
+    camera->setPositionVec3(
+        glm::dvec3(_owner.modelTransform() * glm::dvec4(position, 1.0))
+    );
+    if (angle >= MinimumAngle) {
+        const glm::dquat predictedDiff = glm::angleAxis(angle, glm::axis(rotationDiff));
+        camera->setRotation(glm::normalize(predictedDiff * last.rotation));
+    }
+    return camera;
+}
+
+bool TilePrefetcher::requestTiles(const TileIndex& tileIndex) const {
+    bool hasRequested = false;
+    const LayerManager& layerManager = *_owner.chunkedLodGlobe()->layerManager();
+    for (const std::shared_ptr<LayerGroup>& layerGroup : layerManager.layerGroups()) {
+        for (const std::shared_ptr<Layer>& layer : layerGroup->activeLayers()) {
+            tileprovider::TileProvider* tileProvider = layer->tileProvider();
+            if (!tileProvider) {
+                continue;
+            }
+
+            const Tile::Status status = tileProvider->tileStatus(tileIndex);
+            if (status != Tile::Status::OK && status != Tile::Status::OutOfRange) {
+                tileProvider->prefetchTile(tileIndex);
+                hasRequested = true;
+            }
+        }
+    }
+    return hasRequested;
+}
+
+} // namespace openspace::globebrowsing
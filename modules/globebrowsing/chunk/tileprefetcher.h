@@ -0,0 +1,107 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2018                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_GLOBEBROWSING___TILE_PREFETCHER___H__
+#define __OPENSPACE_MODULE_GLOBEBROWSING___TILE_PREFETCHER___H__
+
+#include <modules/globebrowsing/chunk/chunk.h>
+#include <modules/globebrowsing/chunk/chunktree.h>
+#include <modules/globebrowsing/tile/tileindex.h>
+#include <ghoul/glm.h>
+#include <glm/gtx/quaternion.hpp>
+#include <deque>
+#include <memory>
+
+namespace openspace {
+    class Camera;
+    struct RenderData;
+} // namespace openspace
+
+namespace openspace::globebrowsing {
+
+class RenderableGlobe;
+
+/**
+ * Requests the tiles that will be needed in the near future so that they are already
+ * loaded once the camera gets there. The camera is extrapolated from its recent states
+ * and the chunk tree that would be created for the predicted camera is evaluated using
+ * the same culling and level evaluation as the <code>ChunkedLodGlobe</code>. The
+ * bounding heights of the predicted chunks are taken from the current chunk tree, so
+ * that the evaluation does not access any tiles. The tiles of the resulting chunks are
+ * requested through <code>TileProvider::prefetchTile</code> with a lower priority than
+ * the tiles that are needed for rendering the current frame.
+ */
+class TilePrefetcher {
+public:
+    TilePrefetcher(const RenderableGlobe& owner);
+
+    /**
+     * Records the camera state of this frame and requests the tiles for the camera
+     * predicted \p lookahead seconds into the future.
+     * \param budget The maximum number of chunks for which tiles are requested
+     */
+    void update(const RenderData& data, double lookahead, int budget);
+
+private:
+    struct PredictedChunk {
+        TileIndex tileIndex;
+        /// The node of the current chunk tree for this chunk, if it exists
+        ChunkTree<Chunk>::NodeIndex node;
+        Chunk::BoundingHeights boundingHeights;
+    };
+
+    struct CameraState {
+        /// The position of the camera in the model space of the globe
+        glm::dvec3 position;
+        glm::dquat rotation;
+        /// The wall clock time in seconds when this state was recorded
+        double time;
+    };
+
+    /**
+     * \returns the predicted camera, or <code>nullptr</code> if there is not enough
+     *          history or the camera is not moving
+     */
+    std::unique_ptr<Camera> predictCamera(const RenderData& data,
+        double lookahead) const;
+
+    /**
+     * \returns <code>true</code> if at least one of the tiles had to be requested
+     */
+    bool requestTiles(const TileIndex& tileIndex) const;
+
+    /**
+     * \returns the bounding heights of the \p node of the current chunk tree if they
+     *          have already been calculated, or \p parentHeights otherwise
+     */
+    Chunk::BoundingHeights boundingHeights(ChunkTree<Chunk>::NodeIndex node,
+        const Chunk::BoundingHeights& parentHeights) const;
+
+    const RenderableGlobe& _owner;
+    std::deque<CameraState> _history;
+};
+
+} // namespace openspace::globebrowsing
+
+#endif // __OPENSPACE_MODULE_GLOBEBROWSING___TILE_PREFETCHER___H__
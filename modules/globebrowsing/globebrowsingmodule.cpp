@@ -24,6 +24,7 @@
 
 #include <modules/globebrowsing/globebrowsingmodule.h>
 
+#include <modules/globebrowsing/cache/disktilecache.h>
 #include <modules/globebrowsing/cache/memoryawaretilecache.h>
 #include <modules/globebrowsing/dashboard/dashboarditemglobelocation.h>
 #include <modules/globebrowsing/geometry/geodetic3.h>
@@ -147,6 +148,8 @@ void GlobeBrowsingModule::internalInitialize(const ghoul::Dictionary&) {
         [&]() {
             _tileCache = std::make_unique<globebrowsing::cache::MemoryAwareTileCache>();
             addPropertySubOwner(*_tileCache);
+            _diskTileCache = std::make_unique<globebrowsing::cache::DiskTileCache>();
+            addPropertySubOwner(*_diskTileCache);
 #ifdef GLOBEBROWSING_USE_GDAL
             // Convert from MB to Bytes
             GdalWrapper::create(
@@ -161,7 +164,10 @@ void GlobeBrowsingModule::internalInitialize(const ghoul::Dictionary&) {
     // Render
     OsEng.registerModuleCallback(
         OpenSpaceEngine::CallbackOption::Render,
-        [&]() { _tileCache->update(); }
+        [&]() {
+            _tileCache->update();
+            _diskTileCache->update();
+        }
     );
 
     // Deinitialize
@@ -230,6 +236,10 @@ globebrowsing::cache::MemoryAwareTileCache* GlobeBrowsingModule::tileCache() {
     return _tileCache.get();
 }
 
+globebrowsing::cache::DiskTileCache* GlobeBrowsingModule::diskTileCache() {
+    return _diskTileCache.get();
+}
+
 scripting::LuaLibrary GlobeBrowsingModule::luaLibrary() const {
     std::string listLayerGroups = layerGroupNamesList();
 
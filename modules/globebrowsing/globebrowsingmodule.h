@@ -37,7 +37,10 @@ namespace openspace::globebrowsing {
     struct Geodetic2;
     struct Geodetic3;
 
-    namespace cache { class MemoryAwareTileCache; }
+    namespace cache {
+        class DiskTileCache;
+        class MemoryAwareTileCache;
+    } // namespace cache
 } // namespace openspace::globebrowsing
 
 namespace openspace {
@@ -58,6 +61,8 @@ public:
         double latitude, double longitude, double altitude);
 
     globebrowsing::cache::MemoryAwareTileCache* tileCache();
+    globebrowsing::cache::DiskTileCache* diskTileCache();
+
     scripting::LuaLibrary luaLibrary() const override;
     const globebrowsing::RenderableGlobe* castFocusNodeRenderableToGlobe();
 
@@ -107,6 +112,7 @@ private:
     static std::string layerTypeNamesList();
 
     std::unique_ptr<globebrowsing::cache::MemoryAwareTileCache> _tileCache;
+    std::unique_ptr<globebrowsing::cache::DiskTileCache> _diskTileCache;
 
 #ifdef GLOBEBROWSING_USE_GDAL
     // name -> capabilities
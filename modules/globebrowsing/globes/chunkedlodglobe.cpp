@@ -29,7 +29,8 @@
 #include <modules/globebrowsing/chunk/chunklevelevaluator/availabletiledataevaluator.h>
 #include <modules/globebrowsing/chunk/chunklevelevaluator/distanceevaluator.h>
 #include <modules/globebrowsing/chunk/chunklevelevaluator/projectedareaevaluator.h>
-#include <modules/globebrowsing/chunk/chunknode.h>
+#include <modules/globebrowsing/chunk/chunktree.h>
+#include <modules/globebrowsing/chunk/tileprefetcher.h>
 #include <modules/globebrowsing/chunk/culling/chunkculler.h>
 #include <modules/globebrowsing/chunk/culling/frustumculler.h>
 #include <modules/globebrowsing/chunk/culling/horizonculler.h>
@@ -42,9 +43,13 @@
 #include <modules/globebrowsing/rendering/layer/layergroup.h>
 #include <modules/globebrowsing/rendering/layer/layermanager.h>
 #include <modules/debugging/rendering/debugrenderer.h>
+#include <openspace/engine/openspaceengine.h>
+#include <openspace/util/camera.h>
+#include <openspace/util/threadpool.h>
 #include <openspace/util/time.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/opengl/texture.h>
+#include <algorithm>
 //#include <math.h>
 
 namespace {
@@ -56,6 +61,10 @@ namespace {
 
     const openspace::globebrowsing::TileIndex RightHemisphereIndex =
         openspace::globebrowsing::TileIndex(1, 0, 1);
+
+    // Evaluating a chunk takes in the order of microseconds, so fewer chunks than this
+    // are not worth handing to another thread
+    constexpr const size_t MinChunksPerTask = 64;
 } // namespace
 
 namespace openspace::globebrowsing {
@@ -68,8 +77,10 @@ ChunkedLodGlobe::ChunkedLodGlobe(const RenderableGlobe& owner, size_t segmentsPe
     , stats(StatsCollector(absPath("test_stats"), 1, StatsCollector::Enabled::No))
 #endif // DEBUG_GLOBEBROWSING_STATSRECORD
     , _owner(owner)
-    , _leftRoot(std::make_unique<ChunkNode>(Chunk(owner, LeftHemisphereIndex)))
-    , _rightRoot(std::make_unique<ChunkNode>(Chunk(owner, RightHemisphereIndex)))
+    , _chunkTree(std::make_unique<ChunkTree<Chunk>>(std::vector<Chunk>{
+        Chunk(owner, LeftHemisphereIndex),
+        Chunk(owner, RightHemisphereIndex)
+    }))
     , _layerManager(layerManager)
 {
     std::shared_ptr<SkirtedGrid> geometry = std::make_shared<SkirtedGrid>(
@@ -80,13 +91,13 @@ ChunkedLodGlobe::ChunkedLodGlobe(const RenderableGlobe& owner, size_t segmentsPe
         TriangleSoup::Normals::No
     );
 
-    _chunkCullers.push_back(std::make_unique<culling::HorizonCuller>());
-    _chunkCullers.push_back(std::make_unique<culling::FrustumCuller>(
+    _horizonCuller = std::make_unique<culling::HorizonCuller>();
+    _frustumCuller = std::make_unique<culling::FrustumCuller>(
         AABB3(
             glm::vec3(-1, -1, 0),
             glm::vec3(1, 1, 1e35)
         )
-    ));
+    );
 
     _chunkEvaluatorByAvailableTiles =
         std::make_unique<chunklevelevaluator::AvailableTileData>();
@@ -94,6 +105,8 @@ ChunkedLodGlobe::ChunkedLodGlobe(const RenderableGlobe& owner, size_t segmentsPe
         std::make_unique<chunklevelevaluator::ProjectedArea>();
     _chunkEvaluatorByDistance = std::make_unique<chunklevelevaluator::Distance>();
 
+    _tilePrefetcher = std::make_unique<TilePrefetcher>(owner);
+
     _renderer = std::make_unique<ChunkRenderer>(geometry, layerManager, ellipsoid);
 }
 
@@ -107,29 +120,50 @@ std::shared_ptr<LayerManager> ChunkedLodGlobe::layerManager() const {
     return _layerManager;
 }
 
-bool ChunkedLodGlobe::testIfCullable(const Chunk& chunk,
-                                     const RenderData& renderData) const
+const ChunkTree<Chunk>& ChunkedLodGlobe::chunkTree() const {
+    return *_chunkTree;
+}
+
+bool ChunkedLodGlobe::testIfCullable(const Chunk& chunk, const RenderData& renderData,
+                                     const glm::dmat4& viewProjection) const
 {
     if (_owner.debugProperties().performHorizonCulling &&
-        _chunkCullers[0]->isCullable(chunk, renderData)) {
+        _horizonCuller->isCullable(chunk, renderData)) {
         return true;
     }
     if (_owner.debugProperties().performFrustumCulling &&
-        _chunkCullers[1]->isCullable(chunk, renderData)) {
+        _frustumCuller->isCullable(chunk, viewProjection)) {
         return true;
     }
     return false;
 }
 
-const ChunkNode& ChunkedLodGlobe::findChunkNode(const Geodetic2& location) const {
+const Chunk& ChunkedLodGlobe::findChunk(const Geodetic2& location) const {
     ghoul_assert(
         Coverage.contains(location),
         "Point must be in lat [-90, 90] and lon [-180, 180]"
     );
 
-    return location.lon < Coverage.center().lon ?
-        _leftRoot->find(location) :
-        _rightRoot->find(location);
+    const ChunkTree<Chunk>::NodeIndex root = _chunkTree->root(
+        location.lon < Coverage.center().lon ? 0 : 1
+    );
+
+    const ChunkTree<Chunk>::NodeIndex leaf = _chunkTree->findLeaf(
+        root,
+        [&location](const Chunk& chunk) {
+            const Geodetic2 center = chunk.surfacePatch().center();
+            int index = 0;
+            if (center.lon < location.lon) {
+                ++index;
+            }
+            if (location.lat < center.lat) {
+                ++index;
+                ++index;
+            }
+            return static_cast<Quad>(index);
+        }
+    );
+    return _chunkTree->node(leaf).value();
 }
 
 int ChunkedLodGlobe::desiredLevel(const Chunk& chunk,
@@ -162,7 +196,7 @@ float ChunkedLodGlobe::getHeight(const glm::dvec3& position) const {
 
     // Get the uv coordinates to sample from
     const Geodetic2 geodeticPosition = _owner.ellipsoid().cartesianToGeodetic2(position);
-    const int chunkLevel = findChunkNode(geodeticPosition).chunk().tileIndex().level;
+    const int chunkLevel = findChunk(geodeticPosition).tileIndex().level;
 
     const TileIndex tileIndex = TileIndex(geodeticPosition, chunkLevel);
     const GeodeticPatch patch = GeodeticPatch(tileIndex);
@@ -305,8 +339,22 @@ void ChunkedLodGlobe::render(const RenderData& data, RendererTasks&) {
     stats.i["time"] = millis;
 #endif // DEBUG_GLOBEBROWSING_STATSRECORD
 
-    _leftRoot->updateChunkTree(data);
-    _rightRoot->updateChunkTree(data);
+    // The chunks are evaluated first, potentially concurrently, and the resulting
+    // splits and merges are applied to the tree afterwards
+    evaluateChunks(data);
+    _chunkTree->updateChunkTree(
+        [this](ChunkTree<Chunk>::NodeIndex node) { return _chunkStatus[node]; },
+        [](const Chunk& parent, Quad quad) {
+            return Chunk(parent.owner(), parent.tileIndex().child(quad));
+        }
+    );
+
+    // Request the tiles for where the camera is heading. This is done after the chunk
+    // tree was updated, so that the tiles needed right now are requested first
+    const RenderableGlobe::PrefetchProperties& prefetch = _owner.prefetchProperties();
+    if (prefetch.enabled) {
+        _tilePrefetcher->update(data, prefetch.lookahead, prefetch.budget);
+    }
 
     // Calculate the MVP matrix
     const glm::dmat4 viewTransform = glm::dmat4(data.camera.combinedViewMatrix());
@@ -315,11 +363,11 @@ void ChunkedLodGlobe::render(const RenderData& data, RendererTasks&) {
     const glm::dmat4 mvp = vp * _owner.modelTransform();
 
     // Render function
-    auto renderJob = [this, &data, &mvp](const ChunkNode& chunkNode) {
+    auto renderJob = [this, &data, &mvp](const ChunkTree<Chunk>::Node& chunkNode) {
 #ifdef DEBUG_GLOBEBROWSING_STATSRECORD
         stats.i["chunks nodes"]++;
 #endif // DEBUG_GLOBEBROWSING_STATSRECORD
-        const Chunk& chunk = chunkNode.chunk();
+        const Chunk& chunk = chunkNode.value();
         if (chunkNode.isLeaf()) {
 #ifdef DEBUG_GLOBEBROWSING_STATSRECORD
             stats.i["leafs chunk nodes"]++;
@@ -329,17 +377,15 @@ void ChunkedLodGlobe::render(const RenderData& data, RendererTasks&) {
 #ifdef DEBUG_GLOBEBROWSING_STATSRECORD
                 stats.i["rendered chunks"]++;
 #endif // DEBUG_GLOBEBROWSING_STATSRECORD
-                _renderer->renderChunk(chunkNode.chunk(), data);
+                _renderer->renderChunk(chunk, data);
                 debugRenderChunk(chunk, mvp);
             }
         }
     };
 
-    _leftRoot->breadthFirst(renderJob);
-    _rightRoot->breadthFirst(renderJob);
+    _chunkTree->breadthFirst(renderJob);
 
-    //_leftRoot->reverseBreadthFirst(renderJob);
-    //_rightRoot->reverseBreadthFirst(renderJob);
+    //_chunkTree->reverseBreadthFirst(renderJob);
 
 #ifdef DEBUG_GLOBEBROWSING_STATSRECORD
     auto duration2 = std::chrono::system_clock::now().time_since_epoch();
@@ -348,6 +394,49 @@ void ChunkedLodGlobe::render(const RenderData& data, RendererTasks&) {
 #endif // DEBUG_GLOBEBROWSING_STATSRECORD
 }
 
+void ChunkedLodGlobe::evaluateChunks(const RenderData& data) {
+    _chunkTree->nodesToEvaluate(_nodesToEvaluate);
+    _chunkStatus.resize(_chunkTree->capacity());
+
+    // Querying the tile providers has side effects, such as enqueueing tile requests,
+    // and has to happen on this thread
+    for (ChunkTree<Chunk>::NodeIndex node : _nodesToEvaluate) {
+        _chunkTree->node(node).value().updateTileData();
+    }
+
+    // Camera::combinedViewMatrix writes to the camera's cache, so the view projection
+    // matrix is computed here once instead of by each worker
+    const std::shared_ptr<const Camera>& savedCamera = _owner.savedCamera();
+    const Camera& camera = savedCamera ? *savedCamera : data.camera;
+    const glm::dmat4 viewProjection =
+        glm::dmat4(camera.sgctInternal.projectionMatrix()) *
+        glm::dmat4(camera.combinedViewMatrix());
+
+    auto evaluate = [this, &data, viewProjection](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const ChunkTree<Chunk>::NodeIndex node = _nodesToEvaluate[i];
+            _chunkStatus[node] = _chunkTree->node(node).value().update(
+                data,
+                viewProjection
+            );
+        }
+    };
+
+    const size_t nChunks = _nodesToEvaluate.size();
+    ThreadPool* pool = OsEng.computePool();
+    if (!pool || nChunks < 2 * MinChunksPerTask) {
+        evaluate(0, nChunks);
+        return;
+    }
+
+    const size_t nTasks = std::min(pool->numThreads() + 1, nChunks / MinChunksPerTask);
+    const size_t chunksPerTask = (nChunks + nTasks - 1) / nTasks;
+    parallelFor(pool, nTasks, [&evaluate, chunksPerTask, nChunks](size_t task) {
+        const size_t begin = task * chunksPerTask;
+        evaluate(begin, std::min(begin + chunksPerTask, nChunks));
+    });
+}
+
 void ChunkedLodGlobe::debugRenderChunk(const Chunk& chunk, const glm::dmat4& mvp) const {
     if (_owner.debugProperties().showChunkBounds ||
         _owner.debugProperties().showChunkAABB)
@@ -27,7 +27,9 @@
 
 #include <openspace/rendering/renderable.h>
 
+#include <modules/globebrowsing/chunk/chunktree.h>
 #include <memory>
+#include <vector>
 
 //#define DEBUG_GLOBEBROWSING_STATSRECORD
 
@@ -39,15 +41,17 @@ namespace openspace::globebrowsing {
 
 namespace chunklevelevaluator { class Evaluator; }
 
-namespace culling { class ChunkCuller; }
+namespace culling {
+    class FrustumCuller;
+    class HorizonCuller;
+} // namespace culling
 
-class Chunk;
-class ChunkNode;
 class ChunkRenderer;
 class Ellipsoid;
 struct Geodetic2;
 class LayerManager;
 class RenderableGlobe;
+class TilePrefetcher;
 
 class ChunkedLodGlobe : public Renderable {
 public:
@@ -61,22 +65,25 @@ public:
     void update(const UpdateData& data) override;
 
     /**
-     * Traverse the chunk tree and find the highest level chunk node.
+     * Traverse the chunk tree and find the highest level chunk.
      *
      * \param location is given in geodetic coordinates and must be in the range
      * latitude [-90, 90] and longitude [-180, 180]. In other words, it must be a
      * position defined on the globe in georeferenced coordinates.
      */
-    const ChunkNode& findChunkNode(const Geodetic2& location) const;
+    const Chunk& findChunk(const Geodetic2& location) const;
 
     /**
      * Test if a specific chunk can saf;ely be culled without affecting the rendered
      * image.
      *
      * Goes through all available <code>ChunkCuller</code>s and check if any of them
-     * allows culling of the <code>Chunk</code>s in question.
+     * allows culling of the <code>Chunk</code>s in question. The
+     * <code>viewProjection</code> matrix has to be computed from the camera of the
+     * <code>renderData</code>, which allows calling this function from several threads.
      */
-    bool testIfCullable(const Chunk& chunk, const RenderData& renderData) const;
+    bool testIfCullable(const Chunk& chunk, const RenderData& renderData,
+        const glm::dmat4& viewProjection) const;
 
     /**
      * Gets the desired level which can be used to determine if a chunk should split
@@ -120,30 +127,45 @@ public:
 
     std::shared_ptr<LayerManager> layerManager() const;
 
+    const ChunkTree<Chunk>& chunkTree() const;
+
 #ifdef DEBUG_GLOBEBROWSING_STATSRECORD
     StatsCollector stats;
 #endif // DEBUG_GLOBEBROWSING_STATSRECORD
 
 private:
+    /**
+     * Updates all chunks that the update of the chunk tree might ask for and stores
+     * their Status in <code>_chunkStatus</code>. The tile data of the chunks is queried
+     * on the calling thread, the culling and level evaluation is distributed across the
+     * compute thread pool of the engine.
+     */
+    void evaluateChunks(const RenderData& data);
+
     void debugRenderChunk(const Chunk& chunk, const glm::dmat4& mvp) const;
 
     const RenderableGlobe& _owner;
 
-    // Covers all negative longitudes
-    std::unique_ptr<ChunkNode> _leftRoot;
+    // The first root covers all negative longitudes, the second root covers all
+    // positive longitudes
+    std::unique_ptr<ChunkTree<Chunk>> _chunkTree;
 
-    // Covers all positive longitudes
-    std::unique_ptr<ChunkNode> _rightRoot;
+    // Reused between frames by evaluateChunks
+    std::vector<ChunkTree<Chunk>::NodeIndex> _nodesToEvaluate;
+    std::vector<Chunk::Status> _chunkStatus;
 
     // the patch used for actual rendering
     std::unique_ptr<ChunkRenderer> _renderer;
 
-    std::vector<std::unique_ptr<culling::ChunkCuller>> _chunkCullers;
+    std::unique_ptr<culling::HorizonCuller> _horizonCuller;
+    std::unique_ptr<culling::FrustumCuller> _frustumCuller;
 
     std::unique_ptr<chunklevelevaluator::Evaluator> _chunkEvaluatorByAvailableTiles;
     std::unique_ptr<chunklevelevaluator::Evaluator> _chunkEvaluatorByProjectedArea;
     std::unique_ptr<chunklevelevaluator::Evaluator> _chunkEvaluatorByDistance;
 
+    std::unique_ptr<TilePrefetcher> _tilePrefetcher;
+
     std::shared_ptr<LayerManager> _layerManager;
 
     bool _shadersNeedRecompilation = true;
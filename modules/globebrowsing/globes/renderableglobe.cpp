@@ -164,6 +164,27 @@ namespace {
         "orenNayarRoughness",
         "" // @TODO Missing documentation
     };
+
+    constexpr openspace::properties::Property::PropertyInfo PrefetchEnabledInfo = {
+        "Enabled",
+        "Enabled",
+        "If this value is enabled, the tiles that will be visible for the camera in the "
+        "near future are requested with a low priority. The future camera is predicted "
+        "from its recent movement."
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo PrefetchLookaheadInfo = {
+        "Lookahead",
+        "Lookahead (seconds)",
+        "The number of seconds into the future for which the camera is predicted when "
+        "requesting tiles."
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo PrefetchBudgetInfo = {
+        "Budget",
+        "Budget",
+        "The maximum number of chunks for which tiles are requested per frame."
+    };
 } // namespace
 
 using namespace openspace::properties;
@@ -197,7 +218,13 @@ RenderableGlobe::RenderableGlobe(const ghoul::Dictionary& dictionary)
         FloatProperty(CameraMinHeightInfo, 100.f, 0.f, 1000.f),
         FloatProperty(OrenNayarRoughnessInfo, 0.f, 0.f, 1.f)
     })
+    , _prefetchProperties({
+        BoolProperty(PrefetchEnabledInfo, false),
+        FloatProperty(PrefetchLookaheadInfo, 0.5f, 0.f, 5.f),
+        IntProperty(PrefetchBudgetInfo, 32, 0, 1024)
+    })
     , _debugPropertyOwner({ "Debug" })
+    , _prefetchPropertyOwner({ "Prefetch" })
 {
     setIdentifier("RenderableGlobe");
 
@@ -268,6 +295,10 @@ RenderableGlobe::RenderableGlobe(const ghoul::Dictionary& dictionary)
     _debugPropertyOwner.addProperty(_debugProperties.limitLevelByAvailableData);
     _debugPropertyOwner.addProperty(_debugProperties.modelSpaceRenderingCutoffLevel);
 
+    _prefetchPropertyOwner.addProperty(_prefetchProperties.enabled);
+    _prefetchPropertyOwner.addProperty(_prefetchProperties.lookahead);
+    _prefetchPropertyOwner.addProperty(_prefetchProperties.budget);
+
     auto notifyShaderRecompilation = [&](){
         _chunkedLodGlobe->notifyShaderRecompilation();
     };
@@ -283,6 +314,7 @@ RenderableGlobe::RenderableGlobe(const ghoul::Dictionary& dictionary)
     _layerManager->onChange(notifyShaderRecompilation);
 
     addPropertySubOwner(_debugPropertyOwner);
+    addPropertySubOwner(_prefetchPropertyOwner);
     addPropertySubOwner(_layerManager.get());
     //addPropertySubOwner(_pointGlobe.get());
 
@@ -494,6 +526,12 @@ const RenderableGlobe::GeneralProperties&
     return _generalProperties;
 }
 
+const RenderableGlobe::PrefetchProperties&
+    RenderableGlobe::prefetchProperties() const
+{
+    return _prefetchProperties;
+}
+
 const std::shared_ptr<const Camera> RenderableGlobe::savedCamera() const {
     return _savedCamera;
 }
@@ -83,6 +83,16 @@ public:
         properties::FloatProperty orenNayarRoughness;
     };
 
+    /**
+     * Controls the requesting of tiles that are expected to be needed in the near future
+     * based on the current movement of the camera.
+     */
+    struct PrefetchProperties {
+        properties::BoolProperty enabled;
+        properties::FloatProperty lookahead;
+        properties::IntProperty budget;
+    };
+
     // Shadow structure
     struct ShadowRenderingStruct {
         double xu;
@@ -116,6 +126,7 @@ public:
     const glm::dmat4& inverseModelTransform() const;
     const DebugProperties& debugProperties() const;
     const GeneralProperties& generalProperties() const;
+    const PrefetchProperties& prefetchProperties() const;
     const std::shared_ptr<const Camera> savedCamera() const;
     double interactionDepthBelowEllipsoid();
 
@@ -141,7 +152,9 @@ private:
     // Properties
     DebugProperties _debugProperties;
     GeneralProperties _generalProperties;
+    PrefetchProperties _prefetchProperties;
     properties::PropertyOwner _debugPropertyOwner;
+    properties::PropertyOwner _prefetchPropertyOwner;
 };
 
 } // namespace openspace::globebrowsing
@@ -38,6 +38,16 @@ namespace openspace::globebrowsing {
 
 template<typename KeyType> class LRUThreadPool;
 
+/**
+ * Low priority tasks are only executed when there are no normal priority tasks enqueued.
+ * They are kept in a separate queue so that they can never push a normal priority task
+ * out of the queue.
+ */
+enum class TaskPriority {
+    Normal = 0,
+    Low
+};
+
 template<typename KeyType>
 class LRUThreadPoolWorker {
 public:
@@ -56,7 +66,10 @@ private:
  * times. The user must ensure that an enqueued task with a given key should be
  * equal in outcome to a second enqueued task with the same key. This is because a second
  * enqueued task with the same key will simply be bumped and prioritised before other
- * enqueued tasks. The given task will be ignored.
+ * enqueued tasks. The given task will be ignored. A task that is enqueued or touched with
+ * normal priority while it is waiting in the low priority queue is moved to the normal
+ * priority queue, whereas a low priority task is ignored if a task with the same key is
+ * already enqueued with normal priority.
  */
 template<typename KeyType>
 class LRUThreadPool {
@@ -65,7 +78,8 @@ public:
     LRUThreadPool(const LRUThreadPool& toCopy);
     ~LRUThreadPool();
 
-    void enqueue(std::function<void()> f, KeyType key);
+    void enqueue(std::function<void()> f, KeyType key,
+        TaskPriority priority = TaskPriority::Normal);
     bool touch(KeyType key);
     std::vector<KeyType> getQueuedTasksKeys();
     std::vector<KeyType> getUnqueuedTasksKeys();
@@ -80,7 +94,14 @@ private:
     friend class LRUThreadPoolWorker<KeyType>;
 
     std::vector<std::thread> _workers;
-    cache::LRUCache<KeyType, std::function<void()>, DefaultHasher> _queuedTasks;
+    using TaskQueue = cache::LRUCache<KeyType, std::function<void()>, DefaultHasher>;
+
+    /// Moves the task identified by \p key from the low to the normal priority queue
+    bool promote(const KeyType& key);
+    void addUnqueuedTasks(const std::vector<typename TaskQueue::Item>& tasks);
+
+    TaskQueue _queuedTasks;
+    TaskQueue _lowPriorityTasks;
     std::vector<KeyType> _unqueuedTasks;
     std::mutex _queueMutex;
     std::condition_variable _condition;
@@ -38,7 +38,9 @@ void LRUThreadPoolWorker<KeyType>::operator()() {
             std::unique_lock<std::mutex> lock(_pool._queueMutex);
 
             // look for a work item
-            while (!_pool._stop && _pool._queuedTasks.isEmpty()) {
+            while (!_pool._stop && _pool._queuedTasks.isEmpty() &&
+                   _pool._lowPriorityTasks.isEmpty())
+            {
                 // if there are none wait for notification
                 _pool._condition.wait(lock);
             }
@@ -47,8 +49,14 @@ void LRUThreadPoolWorker<KeyType>::operator()() {
                 return;
             }
 
-            // get the task from the queue
-            task = _pool._queuedTasks.popMRU().second;
+            // get the task from the queue, low priority tasks only if there is nothing
+            // else to do
+            if (!_pool._queuedTasks.isEmpty()) {
+                task = _pool._queuedTasks.popMRU().second;
+            }
+            else {
+                task = _pool._lowPriorityTasks.popMRU().second;
+            }
 
         }// release lock
 
@@ -60,6 +68,7 @@ void LRUThreadPoolWorker<KeyType>::operator()() {
 template<typename KeyType>
 LRUThreadPool<KeyType>::LRUThreadPool(size_t numThreads, size_t queueSize)
     : _queuedTasks(queueSize)
+    , _lowPriorityTasks(queueSize)
 {
     for (size_t i = 0; i < numThreads; ++i) {
         _workers.push_back(std::thread(LRUThreadPoolWorker<KeyType>(*this)));
@@ -88,18 +97,20 @@ LRUThreadPool<KeyType>::~LRUThreadPool() {
 
 // add new work item to the pool
 template<typename KeyType>
-void LRUThreadPool<KeyType>::enqueue(std::function<void()> f, KeyType key) {
+void LRUThreadPool<KeyType>::enqueue(std::function<void()> f, KeyType key,
+                                     TaskPriority priority)
+{
     {
         std::unique_lock<std::mutex> lock(_queueMutex);
 
         // add the task
-        //_queuedTasks.put(key, f);
-        const std::vector<std::pair<KeyType, std::function<void()>>>& unfinishedTasks =
-            _queuedTasks.putAndFetchPopped(key, f);
-        for (const std::pair<KeyType, std::function<void()>>& unfinishedTask :
-             unfinishedTasks)
-        {
-            _unqueuedTasks.push_back(unfinishedTask.first);
+        if (priority == TaskPriority::Normal) {
+            // If the task was waiting as a low priority task, the new task replaces it
+            promote(key);
+            addUnqueuedTasks(_queuedTasks.putAndFetchPopped(key, f));
+        }
+        else if (!_queuedTasks.exist(key)) {
+            addUnqueuedTasks(_lowPriorityTasks.putAndFetchPopped(key, f));
         }
     }
 
@@ -110,7 +121,29 @@ void LRUThreadPool<KeyType>::enqueue(std::function<void()> f, KeyType key) {
 template<typename KeyType>
 bool LRUThreadPool<KeyType>::touch(KeyType key) {
     std::unique_lock<std::mutex> lock(_queueMutex);
-    return _queuedTasks.touch(key);
+    return _queuedTasks.touch(key) || promote(key);
+}
+
+template<typename KeyType>
+bool LRUThreadPool<KeyType>::promote(const KeyType& key) {
+    // Touching the task moves it to the front of the queue, from where it can be popped
+    if (!_lowPriorityTasks.touch(key)) {
+        return false;
+    }
+    std::pair<KeyType, std::function<void()>> task = _lowPriorityTasks.popMRU();
+    addUnqueuedTasks(
+        _queuedTasks.putAndFetchPopped(std::move(task.first), std::move(task.second))
+    );
+    return true;
+}
+
+template<typename KeyType>
+void LRUThreadPool<KeyType>::addUnqueuedTasks(
+                                      const std::vector<typename TaskQueue::Item>& tasks)
+{
+    for (const std::pair<KeyType, std::function<void()>>& task : tasks) {
+        _unqueuedTasks.push_back(task.first);
+    }
 }
 
 template<typename KeyType>
@@ -131,6 +164,9 @@ std::vector<KeyType> LRUThreadPool<KeyType>::getQueuedTasksKeys() {
         while (!_queuedTasks.isEmpty()) {
             queuedTasks.push_back(_queuedTasks.popMRU().first);
         }
+        while (!_lowPriorityTasks.isEmpty()) {
+            queuedTasks.push_back(_lowPriorityTasks.popMRU().first);
+        }
     }
     return queuedTasks;
 }
@@ -139,6 +175,7 @@ template<typename KeyType>
 void LRUThreadPool<KeyType>::clearEnqueuedTasks() {
     std::unique_lock<std::mutex> lock(_queueMutex);
     _queuedTasks.clear();
+    _lowPriorityTasks.clear();
 }
 
 } // namespace openspace::globebrowsing
@@ -30,7 +30,8 @@
 //#include <openspace/util/concurrentjobmanager.h>
 #include <openspace/util/concurrentqueue.h>
 
-#include <mutex>
+#include <memory>
+#include <vector>
 
 namespace openspace { template <typename T> struct Job; }
 
@@ -48,9 +49,11 @@ public:
     PrioritizingConcurrentJobManager(LRUThreadPool<KeyType> pool);
 
     /**
-     * Enqueues a job which is identified using a given key
+     * Enqueues a job which is identified using a given key. Low priority jobs are only
+     * executed if there are no normal priority jobs waiting.
      */
-    void enqueueJob(std::shared_ptr<Job<P>> job, KeyType key);
+    void enqueueJob(std::shared_ptr<Job<P>> job, KeyType key,
+        TaskPriority priority = TaskPriority::Normal);
 
     /**
      * The keys returned by this function have been popped from the queue and corresponds
@@ -79,15 +82,22 @@ public:
     void clearEnqueuedJobs();
 
     /**
-     * \returns one finished job.
+     * \returns one finished job or <code>nullptr</code> if there is no finished job.
      */
     std::shared_ptr<Job<P>> popFinishedJob();
 
+    /**
+     * \returns all jobs that have finished since the last call, in a single operation.
+     */
+    std::vector<std::shared_ptr<Job<P>>> popFinishedJobs();
+
     size_t numFinishedJobs() const;
 
 private:
-    ConcurrentQueue<std::shared_ptr<Job<P>>> _finishedJobs;
-    std::mutex _finishedJobsMutex;
+    /// Workers push finished jobs without taking a lock; they are drained once per frame.
+    /// If the main thread drains late and the ring buffer fills up, the remaining jobs
+    /// spill into the queue's overflow list instead of stalling the workers
+    ConcurrentQueue<std::shared_ptr<Job<P>>, ConcurrentQueueType::LockFree> _finishedJobs;
     /// An LRU thread pool is used since the jobs can be bumped and hence prioritized.
     LRUThreadPool<KeyType> _threadPool;
 };
@@ -34,13 +34,13 @@ PrioritizingConcurrentJobManager<P, KeyType>::PrioritizingConcurrentJobManager(
 
 template <typename P, typename KeyType>
 void PrioritizingConcurrentJobManager<P, KeyType>::enqueueJob(std::shared_ptr<Job<P>> job,
-                                                              KeyType key)
+                                                              KeyType key,
+                                                              TaskPriority priority)
 {
     _threadPool.enqueue([this, job]() {
         job->execute();
-        std::lock_guard<std::mutex> lock(_finishedJobsMutex);
         _finishedJobs.push(job);
-    }, key);
+    }, key, priority);
 }
 
 template <typename P, typename KeyType>
@@ -67,10 +67,20 @@ void PrioritizingConcurrentJobManager<P, KeyType>::clearEnqueuedJobs() {
 
 template <typename P, typename KeyType>
 std::shared_ptr<Job<P>> PrioritizingConcurrentJobManager<P, KeyType>::popFinishedJob() {
-    ghoul_assert(!_finishedJobs.empty(), "There is no finished job to pop!");
+    // numFinishedJobs also counts jobs that are still being pushed by a worker, so the
+    // queue can be empty even if it reported a finished job
+    std::shared_ptr<Job<P>> result;
+    if (!_finishedJobs.tryPop(result)) {
+        return nullptr;
+    }
+    return result;
+}
 
-    std::lock_guard<std::mutex> lock(_finishedJobsMutex);
-    std::shared_ptr<Job<P>> result = _finishedJobs.pop();
+template <typename P, typename KeyType>
+std::vector<std::shared_ptr<Job<P>>>
+PrioritizingConcurrentJobManager<P, KeyType>::popFinishedJobs() {
+    std::vector<std::shared_ptr<Job<P>>> result;
+    _finishedJobs.popAll(result);
     return result;
 }
 
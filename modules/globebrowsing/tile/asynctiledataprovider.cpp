@@ -24,6 +24,7 @@
 
 #include <modules/globebrowsing/tile/asynctiledataprovider.h>
 
+#include <modules/globebrowsing/cache/disktilecache.h>
 #include <modules/globebrowsing/cache/memoryawaretilecache.h>
 #include <modules/globebrowsing/globebrowsingmodule.h>
 #include <modules/globebrowsing/other/pixelbuffercontainer.h>
@@ -31,6 +32,7 @@
 #include <modules/globebrowsing/tile/rawtiledatareader/rawtiledatareader.h>
 #include <openspace/engine/moduleengine.h>
 #include <openspace/engine/openspaceengine.h>
+#include <ghoul/fmt.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/opengl/ghoul_gl.h>
 
@@ -38,6 +40,21 @@ namespace openspace::globebrowsing {
 
 namespace {
     constexpr const char* _loggerCat = "AsyncTileDataProvider";
+
+    constexpr const size_t NumPixelBuffers = 10;
+
+    // 64 bit FNV-1a hash. std::hash is not guaranteed to produce the same values between
+    // runs, which is required for the disk cache. As a collision would serve the tiles of
+    // one layer for another, 32 bits are not enough for the number of layers that can
+    // share a persistent cache
+    uint64_t stableHash(const std::string& s) {
+        uint64_t hash = 14695981039346656037ull;
+        for (char c : s) {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
 } // namespace
 
 AsyncTileDataProvider::AsyncTileDataProvider(std::string name,
@@ -47,78 +64,124 @@ AsyncTileDataProvider::AsyncTileDataProvider(std::string name,
     , _concurrentJobManager(LRUThreadPool<TileIndex::TileHashKey>(1, 10))
 {
     _globeBrowsingModule = OsEng.moduleEngine().module<GlobeBrowsingModule>();
+
+    _diskCacheProviderID = stableHash(fmt::format(
+        "{}|{}|{}|{}",
+        _name,
+        _rawTileDataReader->datasetFilePath(),
+        _rawTileDataReader->tileTextureInitData().hashKey(),
+        _rawTileDataReader->performsPreprocessing()
+    ));
+
     performReset(ResetRawTileDataReader::No);
 }
 
-AsyncTileDataProvider::~AsyncTileDataProvider() {} // NOLINT
+AsyncTileDataProvider::~AsyncTileDataProvider() {
+    const size_t nSavedReads = _rawTileDataReader->numSavedRasterReads();
+    if (nSavedReads > 0) {
+        LDEBUG(fmt::format(
+            "Tile data reader '{}' saved {} raster reads by batching neighboring tiles",
+            _name, nSavedReads
+        ));
+    }
+}
 
 std::shared_ptr<RawTileDataReader> AsyncTileDataProvider::rawTileDataReader() const {
     return _rawTileDataReader;
 }
 
-bool AsyncTileDataProvider::enqueueTileIO(const TileIndex& tileIndex) {
-    if (_resetMode == ResetMode::ShouldNotReset && satisfiesEnqueueCriteria(tileIndex)) {
-        if (_pboContainer) {
-            char* dataPtr = static_cast<char*>(_pboContainer->mapBuffer(
-                tileIndex.hashKey(), PixelBuffer::Access::WriteOnly));
-            if (dataPtr) {
-                auto job = std::make_shared<TileLoadJob>(_rawTileDataReader, tileIndex,
-                    dataPtr);
-                _concurrentJobManager.enqueueJob(job, tileIndex.hashKey());
-                _enqueuedTileRequests.insert(tileIndex.hashKey());
-            }
-            else {
-                return false;
-            }
+bool AsyncTileDataProvider::enqueueTileIO(const TileIndex& tileIndex,
+                                          TaskPriority priority)
+{
+    if (_resetMode != ResetMode::ShouldNotReset) {
+        return false;
+    }
+
+    if (priority == TaskPriority::Low) {
+        // A prefetch must not touch the tile, as that would bump it to normal priority.
+        // Prefetches also have to leave half of the pixel buffers for the tiles that are
+        // needed for rendering
+        const TileIndex::TileHashKey key = tileIndex.hashKey();
+        const bool isEnqueued = _enqueuedTileRequests.find(key) !=
+                                _enqueuedTileRequests.end();
+        const bool hasFreePbo = !_pboContainer ||
+                                _enqueuedTileRequests.size() < NumPixelBuffers / 2;
+        if (isEnqueued || !hasFreePbo) {
+            return false;
+        }
+    }
+    else if (!satisfiesEnqueueCriteria(tileIndex)) {
+        return false;
+    }
+
+    std::shared_ptr<TileLoadJob> job;
+    if (_pboContainer) {
+        char* dataPtr = static_cast<char*>(_pboContainer->mapBuffer(
+            tileIndex.hashKey(), PixelBuffer::Access::WriteOnly));
+        if (dataPtr) {
+            job = std::make_shared<TileLoadJob>(_rawTileDataReader, tileIndex,
+                dataPtr);
         }
         else {
-            auto job = std::make_shared<TileLoadJob>(_rawTileDataReader, tileIndex);
-            _concurrentJobManager.enqueueJob(job, tileIndex.hashKey());
-            _enqueuedTileRequests.insert(tileIndex.hashKey());
+            return false;
         }
-        return true;
     }
-    return false;
+    else {
+        job = std::make_shared<TileLoadJob>(_rawTileDataReader, tileIndex);
+    }
+
+    // Consult the disk cache before the tile is read from the dataset
+    cache::DiskTileCache* diskCache = _globeBrowsingModule->diskTileCache();
+    if (diskCache && diskCache->isEnabled()) {
+        job->setDiskCache(diskCache, _diskCacheProviderID);
+    }
+
+    _concurrentJobManager.enqueueJob(job, tileIndex.hashKey(), priority);
+    _enqueuedTileRequests.insert(tileIndex.hashKey());
+    // Lets the reader batch this tile with neighboring tiles that are read before it
+    _rawTileDataReader->beginTileRead(tileIndex.hashKey());
+    return true;
 }
 
 std::vector<std::shared_ptr<RawTile>> AsyncTileDataProvider::rawTiles() {
+    // Drain all finished jobs at once instead of taking them off the queue one by one
+    std::vector<std::shared_ptr<Job<RawTile>>> finishedJobs =
+        _concurrentJobManager.popFinishedJobs();
+
     std::vector<std::shared_ptr<RawTile>> readyResults;
-    std::shared_ptr<RawTile> finishedJob = popFinishedRawTile();
-    while (finishedJob) {
-        readyResults.push_back(finishedJob);
-        finishedJob = popFinishedRawTile();
+    readyResults.reserve(finishedJobs.size());
+    for (const std::shared_ptr<Job<RawTile>>& job : finishedJobs) {
+        std::shared_ptr<RawTile> tile = finishRawTile(job->product());
+        if (tile) {
+            readyResults.push_back(std::move(tile));
+        }
     }
     return readyResults;
 }
 
-std::shared_ptr<RawTile> AsyncTileDataProvider::popFinishedRawTile() {
-    if (_concurrentJobManager.numFinishedJobs() > 0) {
-        // Now the tile load job looses ownerwhip of the data pointer
-        std::shared_ptr<RawTile> product =
-            _concurrentJobManager.popFinishedJob()->product();
-
-        const TileIndex::TileHashKey key = product->tileIndex.hashKey();
-        // No longer enqueued. Remove from set of enqueued tiles
-        _enqueuedTileRequests.erase(key);
-        // Pbo is still mapped. Set the id for the raw tile
-        if (_pboContainer) {
-            product->pbo = _pboContainer->idOfMappedBuffer(key);
-            // Now we are finished with the mapping of this pbo
-            _pboContainer->unMapBuffer(key);
-        }
-        else {
-            product->pbo = 0;
-            if (product->error != RawTile::ReadError::None) {
-                delete[] product->imageData;
-                return nullptr;
-            }
-        }
-
-        return product;
+std::shared_ptr<RawTile> AsyncTileDataProvider::finishRawTile(
+                                                         std::shared_ptr<RawTile> product)
+{
+    // Now the tile load job looses ownerwhip of the data pointer
+    const TileIndex::TileHashKey key = product->tileIndex.hashKey();
+    // No longer enqueued. Remove from set of enqueued tiles
+    _enqueuedTileRequests.erase(key);
+    _rawTileDataReader->endTileRead(key);
+    // Pbo is still mapped. Set the id for the raw tile
+    if (_pboContainer) {
+        product->pbo = _pboContainer->idOfMappedBuffer(key);
+        // Now we are finished with the mapping of this pbo
+        _pboContainer->unMapBuffer(key);
     }
     else {
-        return nullptr;
+        product->pbo = 0;
+        if (product->error != RawTile::ReadError::None) {
+            delete[] product->imageData;
+            return nullptr;
+        }
     }
+
+    return product;
 }
 
 bool AsyncTileDataProvider::satisfiesEnqueueCriteria(const TileIndex& tileIndex) {
@@ -143,6 +206,7 @@ void AsyncTileDataProvider::endUnfinishedJobs() {
         }
         // When erasing the job before
         _enqueuedTileRequests.erase(unfinishedJob);
+        _rawTileDataReader->endTileRead(unfinishedJob);
     }
 }
 
@@ -156,6 +220,7 @@ void AsyncTileDataProvider::endEnqueuedJobs() {
         }
         // When erasing the job before
         _enqueuedTileRequests.erase(enqueuedJob);
+        _rawTileDataReader->endTileRead(enqueuedJob);
     }
 }
 
@@ -244,7 +309,7 @@ void AsyncTileDataProvider::performReset(ResetRawTileDataReader resetRawTileData
         _pboContainer = std::make_unique<PixelBufferContainer<TileIndex::TileHashKey>>(
             pboNumBytes,
             PixelBuffer::Usage::StreamDraw,
-            10
+            NumPixelBuffers
         );
     }
     else {
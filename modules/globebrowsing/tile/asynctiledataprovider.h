@@ -57,19 +57,19 @@ public:
 
     /**
      * Creates a job which asynchronously loads a raw tile. This job is enqueued.
+     * \param priority Low priority is used for tiles that are not needed yet, but are
+     *        expected to be needed soon. These jobs are only executed if no other tiles
+     *        are waiting to be loaded
      */
-    bool enqueueTileIO(const TileIndex& tileIndex);
+    bool enqueueTileIO(const TileIndex& tileIndex,
+        TaskPriority priority = TaskPriority::Normal);
 
     /**
-     * Get all finished jobs.
+     * Get all finished jobs. The finished jobs are removed from the job manager in one
+     * batch.
      */
     std::vector<std::shared_ptr<RawTile>> rawTiles();
 
-    /**
-     * Get one finished job.
-     */
-    std::shared_ptr<RawTile> popFinishedRawTile();
-
     void update();
     void reset();
     void prepairToBeDeleted();
@@ -103,6 +103,13 @@ protected:
 
     void endEnqueuedJobs();
 
+    /**
+     * Releases the PBO mapping and bookkeeping of a finished <code>RawTile</code>.
+     * \returns the tile, or <code>nullptr</code> if it failed to load and there is no
+     *          PBO that needs to be uploaded
+     */
+    std::shared_ptr<RawTile> finishRawTile(std::shared_ptr<RawTile> product);
+
     void updatePboUsage();
 
     void performReset(ResetRawTileDataReader resetRawTileDataReader);
@@ -120,6 +127,10 @@ private:
     std::unique_ptr<PixelBufferContainer<TileIndex::TileHashKey>> _pboContainer;
     std::set<TileIndex::TileHashKey> _enqueuedTileRequests;
 
+    /// Identifies the tiles of this provider in the disk cache. In contrast to the
+    /// identifier of the tile provider, this value is stable between runs
+    uint64_t _diskCacheProviderID = 0;
+
     ResetMode _resetMode = ResetMode::ShouldResetAllButRawTileDataReader;
     bool _shouldBeDeleted = false;
 };
@@ -105,6 +105,10 @@ int GdalRawTileDataReader::dataSourceNumRasters() const {
     return _gdalDatasetMetaDataCached.rasterCount;
 }
 
+const std::string& GdalRawTileDataReader::datasetFilePath() const {
+    return _datasetFilePath;
+}
+
 float GdalRawTileDataReader::depthOffset() const {
     return _gdalDatasetMetaDataCached.offset;
 }
@@ -161,6 +165,12 @@ void GdalRawTileDataReader::initialize() {
     _cached._maxLevel = std::max(_cached._maxLevel, 2);
 }
 
+bool GdalRawTileDataReader::supportsBatchedReads() const {
+    // The raster read writes the lines bottom to top and the IODescription is never
+    // adjusted, so a region covering several tiles can be read at once
+    return true;
+}
+
 RawTile::ReadError GdalRawTileDataReader::rasterRead(int rasterBand,
                                                      const IODescription& io,
                                                      char* dataDestination) const
@@ -65,6 +65,7 @@ public:
     virtual int rasterXSize() const override;
     virtual int rasterYSize() const override;
     virtual int dataSourceNumRasters() const override;
+    virtual const std::string& datasetFilePath() const override;
     virtual float depthOffset() const override;
     virtual float depthScale() const override;
 
@@ -83,6 +84,7 @@ private:
     virtual void initialize() override;
     virtual RawTile::ReadError rasterRead(int rasterBand, const IODescription& io,
                                           char* dst) const override;
+    virtual bool supportsBatchedReads() const override;
 
     // GDAL Helper methods
     GDALDataset* openGdalDataset(const std::string& filePath);
@@ -53,22 +53,19 @@ std::shared_ptr<RawTile> RawTileDataReader::readTileData(TileIndex tileIndex,
     // Build the RawTile from the data we querred
     std::shared_ptr<RawTile> rawTile = std::make_shared<RawTile>();
 
-    if (dataDestination && !pboMappedDataDestination) {
-        // Write only to cpu data destination
-        memset(dataDestination, 255, _initData.totalNumBytes());
-        readImageData(io, worstError, dataDestination);
-    }
-    else if (!dataDestination && pboMappedDataDestination) {
-        // Write only to pbo mapped data destination
-        memset(pboMappedDataDestination, 255, _initData.totalNumBytes());
-        readImageData(io, worstError, pboMappedDataDestination);
-    }
-    else if (dataDestination && pboMappedDataDestination) {
-        // Write to both data destinations
-        memset(dataDestination, 255, _initData.totalNumBytes());
-        readImageData(io, worstError, dataDestination);
-        size_t numBytes = _initData.totalNumBytes();
-        memcpy(pboMappedDataDestination, dataDestination, numBytes);
+    // Read into the cpu data destination if there is one and copy to the mapped pbo
+    // afterwards, otherwise the pbo is written to directly
+    char* destination = dataDestination ? dataDestination : pboMappedDataDestination;
+    if (destination) {
+        memset(destination, 255, _initData.totalNumBytes());
+        if (!readBatchedImageData(tileIndex, io, worstError, destination)) {
+            readImageData(io, worstError, destination);
+        }
+        if (dataDestination && pboMappedDataDestination) {
+            // Write to both data destinations
+            size_t numBytes = _initData.totalNumBytes();
+            memcpy(pboMappedDataDestination, dataDestination, numBytes);
+        }
     }
     else {
         ghoul_assert(false, "Need to specify a data destination");
@@ -88,11 +85,18 @@ std::shared_ptr<RawTile> RawTileDataReader::readTileData(TileIndex tileIndex,
     return rawTile;
 }
 
-void RawTileDataReader::readImageData(IODescription& io, RawTile::ReadError& worstError,
-                                      char* imageDataDest) const
+int RawTileDataReader::readImageData(IODescription& io, RawTile::ReadError& worstError,
+                                     char* imageDataDest) const
 {
     io = adjustIODescription(io);
 
+    int nRasterReads = 0;
+    auto readBand = [&](int rasterBand, char* dest) {
+        const RawTile::ReadError err = repeatedRasterRead(rasterBand, io, dest);
+        worstError = std::max(worstError, err);
+        ++nRasterReads;
+    };
+
     // Only read the minimum number of rasters
     int nRastersToRead = std::min(
         dataSourceNumRasters(),
@@ -102,8 +106,7 @@ void RawTileDataReader::readImageData(IODescription& io, RawTile::ReadError& wor
     switch (_initData.ghoulTextureFormat()) {
         case ghoul::opengl::Texture::Format::Red: {
             char* dest = imageDataDest;
-            const RawTile::ReadError err = repeatedRasterRead(1, io, dest);
-            worstError = std::max(worstError, err);
+            readBand(1, dest);
             break;
         }
         case ghoul::opengl::Texture::Format::RG:
@@ -114,8 +117,7 @@ void RawTileDataReader::readImageData(IODescription& io, RawTile::ReadError& wor
                     // The final destination pointer is offsetted by one datum byte size
                     // for every raster (or data channel, i.e. R in RGB)
                     char* dest = imageDataDest + (i * _initData.bytesPerDatum());
-                    const RawTile::ReadError err = repeatedRasterRead(1, io, dest);
-                    worstError = std::max(worstError, err);
+                    readBand(1, dest);
                 }
             }
             else if (nRastersToRead == 2) { // Grayscale + alpha
@@ -123,21 +125,18 @@ void RawTileDataReader::readImageData(IODescription& io, RawTile::ReadError& wor
                     // The final destination pointer is offsetted by one datum byte size
                     // for every raster (or data channel, i.e. R in RGB)
                     char* dest = imageDataDest + (i * _initData.bytesPerDatum());
-                    const RawTile::ReadError err = repeatedRasterRead(1, io, dest);
-                    worstError = std::max(worstError, err);
+                    readBand(1, dest);
                 }
                 // Last read is the alpha channel
                 char* dest = imageDataDest + (3 * _initData.bytesPerDatum());
-                const RawTile::ReadError err = repeatedRasterRead(2, io, dest);
-                worstError = std::max(worstError, err);
+                readBand(2, dest);
             }
             else { // Three or more rasters
                 for (int i = 0; i < nRastersToRead; i++) {
                     // The final destination pointer is offsetted by one datum byte size
                     // for every raster (or data channel, i.e. R in RGB)
                     char* dest = imageDataDest + (i * _initData.bytesPerDatum());
-                    const RawTile::ReadError err = repeatedRasterRead(i + 1, io, dest);
-                    worstError = std::max(worstError, err);
+                    readBand(i + 1, dest);
                 }
             }
             break;
@@ -149,8 +148,7 @@ void RawTileDataReader::readImageData(IODescription& io, RawTile::ReadError& wor
                     // The final destination pointer is offsetted by one datum byte size
                     // for every raster (or data channel, i.e. R in RGB)
                     char* dest = imageDataDest + (i * _initData.bytesPerDatum());
-                    const RawTile::ReadError err = repeatedRasterRead(1, io, dest);
-                    worstError = std::max(worstError, err);
+                    readBand(1, dest);
                 }
             }
             else if (nRastersToRead == 2) { // Grayscale + alpha
@@ -158,28 +156,24 @@ void RawTileDataReader::readImageData(IODescription& io, RawTile::ReadError& wor
                     // The final destination pointer is offsetted by one datum byte size
                     // for every raster (or data channel, i.e. R in RGB)
                     char* dest = imageDataDest + (i * _initData.bytesPerDatum());
-                    const RawTile::ReadError err = repeatedRasterRead(1, io, dest);
-                    worstError = std::max(worstError, err);
+                    readBand(1, dest);
                 }
                 // Last read is the alpha channel
                 char* dest = imageDataDest + (3 * _initData.bytesPerDatum());
-                const RawTile::ReadError err = repeatedRasterRead(2, io, dest);
-                worstError = std::max(worstError, err);
+                readBand(2, dest);
             }
             else { // Three or more rasters
                 for (int i = 0; i < 3 && i < nRastersToRead; i++) {
                     // The final destination pointer is offsetted by one datum byte size
                     // for every raster (or data channel, i.e. R in RGB)
                     char* dest = imageDataDest + (i * _initData.bytesPerDatum());
-                    const RawTile::ReadError err = repeatedRasterRead(3 - i, io, dest);
-                    worstError = std::max(worstError, err);
+                    readBand(3 - i, dest);
                 }
             }
             if (nRastersToRead > 3) { // Alpha channel exists
                 // Last read is the alpha channel
                 char* dest = imageDataDest + (3 * _initData.bytesPerDatum());
-                const RawTile::ReadError err = repeatedRasterRead(4, io, dest);
-                worstError = std::max(worstError, err);
+                readBand(4, dest);
             }
             break;
         }
@@ -188,6 +182,202 @@ void RawTileDataReader::readImageData(IODescription& io, RawTile::ReadError& wor
             break;
         }
     }
+    return nRasterReads;
+}
+
+void RawTileDataReader::beginTileRead(TileIndex::TileHashKey key) {
+    std::lock_guard<std::mutex> guard(_batchMutex);
+    _pendingTileReads.insert(key);
+}
+
+void RawTileDataReader::endTileRead(TileIndex::TileHashKey key) {
+    std::lock_guard<std::mutex> guard(_batchMutex);
+    _pendingTileReads.erase(key);
+    _batchedTiles.erase(key);
+}
+
+size_t RawTileDataReader::numSavedRasterReads() const {
+    return _nSavedRasterReads;
+}
+
+bool RawTileDataReader::supportsBatchedReads() const {
+    return false;
+}
+
+std::vector<TileIndex> RawTileDataReader::pendingTileBatch(
+                                                      const TileIndex& tileIndex) const
+{
+    // Level 0 only has a single row of tiles, so there are no vertical neighbors
+    if (tileIndex.level < 1) {
+        return { tileIndex };
+    }
+
+    auto isPending = [this](const TileIndex& t) {
+        return _pendingTileReads.find(t.hashKey()) != _pendingTileReads.end();
+    };
+
+    // Only siblings are batched, so that the batch always forms a rectangle that is
+    // two tiles wide or high. Flipping the lowest bit yields the sibling coordinate
+    const TileIndex horizontal(tileIndex.x ^ 1, tileIndex.y, tileIndex.level);
+    const TileIndex vertical(tileIndex.x, tileIndex.y ^ 1, tileIndex.level);
+    const TileIndex diagonal(tileIndex.x ^ 1, tileIndex.y ^ 1, tileIndex.level);
+
+    const bool h = isPending(horizontal);
+    const bool v = isPending(vertical);
+    if (h && v && isPending(diagonal)) {
+        return { tileIndex, horizontal, vertical, diagonal };
+    }
+    else if (h) {
+        return { tileIndex, horizontal };
+    }
+    else if (v) {
+        return { tileIndex, vertical };
+    }
+    else {
+        return { tileIndex };
+    }
+}
+
+bool RawTileDataReader::readBatchedImageData(const TileIndex& tileIndex,
+                                             IODescription& io,
+                                             RawTile::ReadError& worstError,
+                                             char* imageDataDest) const
+{
+    if (!supportsBatchedReads()) {
+        return false;
+    }
+
+    std::vector<TileIndex> batch;
+    {
+        std::lock_guard<std::mutex> guard(_batchMutex);
+        _pendingTileReads.erase(tileIndex.hashKey());
+
+        // The tile might already have been read as part of an earlier batch
+        auto it = _batchedTiles.find(tileIndex.hashKey());
+        if (it != _batchedTiles.end()) {
+            std::memcpy(
+                imageDataDest,
+                it->second.imageData.data(),
+                it->second.imageData.size()
+            );
+            worstError = std::max(worstError, it->second.error);
+            io = adjustIODescription(io);
+            _batchedTiles.erase(it);
+            return true;
+        }
+
+        batch = pendingTileBatch(tileIndex);
+        if (batch.size() == 1) {
+            return false;
+        }
+    }
+
+    // All tiles of the batch have to map to the same number of pixels in the dataset and
+    // in the texture, and the offsets between them have to be whole texture pixels.
+    // Otherwise slicing the combined read would not produce the same data as reading
+    // the tiles one by one
+    std::vector<IODescription> ios;
+    ios.reserve(batch.size());
+    for (const TileIndex& t : batch) {
+        ios.push_back(ioDescription(t));
+    }
+    const PixelRegion::PixelRange readSize = ios.front().read.region.numPixels;
+    const PixelRegion::PixelRange writeSize = ios.front().write.region.numPixels;
+
+    PixelRegion::PixelCoordinate batchStart = ios.front().read.region.start;
+    PixelRegion::PixelCoordinate batchEnd = ios.front().read.region.end();
+    for (const IODescription& tileIO : ios) {
+        const bool isCompatible = tileIO.read.region.numPixels == readSize &&
+                                  tileIO.write.region.numPixels == writeSize &&
+                                  tileIO.read.overview == ios.front().read.overview &&
+                                  tileIO.read.region.isInside(tileIO.read.fullRegion);
+        if (!isCompatible) {
+            return false;
+        }
+        batchStart = glm::min(batchStart, tileIO.read.region.start);
+        batchEnd = glm::max(batchEnd, tileIO.read.region.end());
+    }
+
+    auto isWholeWritePixels = [&](const PixelRegion::PixelCoordinate& p) {
+        return (p.x * writeSize.x) % readSize.x == 0 &&
+               (p.y * writeSize.y) % readSize.y == 0;
+    };
+    auto toWritePixels = [&](const PixelRegion::PixelCoordinate& p) {
+        return PixelRegion::PixelCoordinate(
+            (p.x * writeSize.x) / readSize.x,
+            (p.y * writeSize.y) / readSize.y
+        );
+    };
+
+    if (!isWholeWritePixels(batchEnd - batchStart)) {
+        return false;
+    }
+    for (const IODescription& tileIO : ios) {
+        if (!isWholeWritePixels(tileIO.read.region.start - batchStart)) {
+            return false;
+        }
+    }
+
+    // Read the bounding region of all tiles in the batch in one go
+    const size_t bytesPerPixel = _initData.bytesPerPixel();
+    IODescription batchIO = ios.front();
+    batchIO.read.region = PixelRegion(batchStart, batchEnd - batchStart);
+    batchIO.write.region = PixelRegion(
+        PixelRegion::PixelCoordinate(0, 0),
+        toWritePixels(batchEnd - batchStart)
+    );
+    batchIO.write.bytesPerLine = batchIO.write.region.numPixels.x * bytesPerPixel;
+    batchIO.write.totalNumBytes = batchIO.write.bytesPerLine *
+                                  batchIO.write.region.numPixels.y;
+
+    std::vector<char> batchData(batchIO.write.totalNumBytes, static_cast<char>(255));
+    RawTile::ReadError batchError = RawTile::ReadError::None;
+    const int nRasterReads = readImageData(batchIO, batchError, batchData.data());
+
+    // Slice the batch into the individual tiles. The lines are stored bottom to top,
+    // so the first line of a tile is found counting from the bottom of the batch
+    const int batchHeight = batchIO.write.region.numPixels.y;
+    const size_t bytesPerTileLine = writeSize.x * bytesPerPixel;
+    std::lock_guard<std::mutex> guard(_batchMutex);
+    for (size_t i = 0; i < batch.size(); ++i) {
+        const PixelRegion::PixelCoordinate offset = toWritePixels(
+            ios[i].read.region.start - batchStart
+        );
+        const int firstLine = batchHeight - offset.y - writeSize.y;
+
+        BatchedTile slice;
+        char* dest = imageDataDest;
+        if (i != 0) {
+            // The siblings are kept until they are read themselves, unless their read
+            // has been cancelled in the meantime
+            const TileIndex::TileHashKey key = batch[i].hashKey();
+            if (_pendingTileReads.find(key) == _pendingTileReads.end()) {
+                continue;
+            }
+            _pendingTileReads.erase(key);
+            slice.imageData.resize(_initData.totalNumBytes(), static_cast<char>(255));
+            slice.error = batchError;
+            dest = slice.imageData.data();
+        }
+
+        for (int line = 0; line < writeSize.y; ++line) {
+            std::memcpy(
+                dest + line * ios[i].write.bytesPerLine,
+                batchData.data() + (firstLine + line) * batchIO.write.bytesPerLine +
+                    offset.x * bytesPerPixel,
+                bytesPerTileLine
+            );
+        }
+
+        if (i != 0) {
+            _batchedTiles[batch[i].hashKey()] = std::move(slice);
+            _nSavedRasterReads += nRasterReads;
+        }
+    }
+
+    worstError = std::max(worstError, batchError);
+    io = adjustIODescription(ios.front());
+    return true;
 }
 
 IODescription RawTileDataReader::adjustIODescription(const IODescription& io) const {
@@ -245,6 +435,10 @@ const TileTextureInitData& RawTileDataReader::tileTextureInitData() const {
     return _initData;
 }
 
+bool RawTileDataReader::performsPreprocessing() const {
+    return _preprocess == PerformPreprocessing::Yes;
+}
+
 const PixelRegion::PixelRange RawTileDataReader::fullPixelSize() const {
     return glm::uvec2(geodeticToPixel(Geodetic2(90, 180)));
 }
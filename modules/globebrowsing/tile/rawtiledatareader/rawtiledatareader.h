@@ -30,6 +30,12 @@
 #include <modules/globebrowsing/tile/tiledepthtransform.h>
 #include <modules/globebrowsing/tile/tiletextureinitdata.h>
 #include <ghoul/misc/boolean.h>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
 
 namespace openspace::globebrowsing {
 
@@ -50,8 +56,31 @@ public:
      */
     std::shared_ptr<RawTile> readTileData(TileIndex tileIndex,
         char* dataDestination, char* pboMappedDataDestination) const;
+
+    /**
+     * Registers that the tile with the given key is going to be read with
+     * <code>readTileData</code>. If the reader supports batched reads, a tile that is
+     * read together with pending siblings reads all of them with one raster read per
+     * band. The siblings' data is kept until they are read themselves or until
+     * <code>endTileRead</code> is called for them.
+     */
+    void beginTileRead(TileIndex::TileHashKey key);
+
+    /**
+     * Removes the tile with the given key from the pending reads and drops its data if
+     * it has been read as part of a batch but not been requested yet.
+     */
+    void endTileRead(TileIndex::TileHashKey key);
+
+    /**
+     * \return The number of raster reads that were saved by reading pending siblings
+     * together with a requested tile
+     */
+    size_t numSavedRasterReads() const;
+
     const TileDepthTransform& depthTransform() const;
     const TileTextureInitData& tileTextureInitData() const;
+    bool performsPreprocessing() const;
     const PixelRegion::PixelRange fullPixelSize() const;
 
     /**
@@ -68,6 +97,11 @@ public:
     virtual int rasterXSize() const = 0;
     virtual int rasterYSize() const = 0;
     virtual int dataSourceNumRasters() const = 0;
+
+    /**
+     * \return The path of the dataset that is read, which identifies the dataset
+     */
+    virtual const std::string& datasetFilePath() const = 0;
     virtual float depthOffset() const;
     virtual float depthScale() const;
     PixelRegion fullPixelRegion() const;
@@ -95,10 +129,36 @@ protected:
      *
      * \param io describes how to read the data.
      * \param worstError should be set to the error code returned when reading the data.
+     * \return The number of raster reads that were performed
      */
-    void readImageData(
+    int readImageData(
         IODescription& io, RawTile::ReadError& worstError, char* imageDataDest) const;
 
+    /**
+     * Reads the tile together with its pending siblings if possible, or copies the data
+     * if the tile has already been read as part of an earlier batch.
+     *
+     * \return <code>true</code> if the image data was written to \p imageDataDest,
+     *         <code>false</code> if the tile has to be read on its own
+     */
+    bool readBatchedImageData(const TileIndex& tileIndex, IODescription& io,
+        RawTile::ReadError& worstError, char* imageDataDest) const;
+
+    /**
+     * Returns the tile and the pending siblings it can be read together with. The
+     * <code>_batchMutex</code> has to be locked when calling this function.
+     */
+    std::vector<TileIndex> pendingTileBatch(const TileIndex& tileIndex) const;
+
+    /**
+     * Returns whether neighboring tiles can be read with a single
+     * <code>rasterRead</code> per band. This requires that the raster read stores the
+     * lines of the write region bottom to top and that
+     * <code>adjustIODescription</code> keeps the read region unchanged. The default
+     * returns <code>false</code>.
+     */
+    virtual bool supportsBatchedReads() const;
+
     /**
      * The default does not affect the IODescription but this function can be used for
      * example to flip the y axis.
@@ -157,6 +217,16 @@ protected:
     const TileTextureInitData _initData;
     PerformPreprocessing _preprocess;
     TileDepthTransform _depthTransform = { 0.f, 0.f };
+
+    struct BatchedTile {
+        std::vector<char> imageData;
+        RawTile::ReadError error = RawTile::ReadError::None;
+    };
+
+    mutable std::mutex _batchMutex;
+    mutable std::set<TileIndex::TileHashKey> _pendingTileReads;
+    mutable std::map<TileIndex::TileHashKey, BatchedTile> _batchedTiles;
+    mutable std::atomic<size_t> _nSavedRasterReads = { 0 };
 };
 
 } // namespace openspace::globebrowsing
@@ -64,6 +64,10 @@ int SimpleRawTileDataReader::dataSourceNumRasters() const {
     return _dataTexture->numberOfChannels();
 }
 
+const std::string& SimpleRawTileDataReader::datasetFilePath() const {
+    return _datasetFilePath;
+}
+
 float SimpleRawTileDataReader::depthOffset() const {
     return 0.f;
 }
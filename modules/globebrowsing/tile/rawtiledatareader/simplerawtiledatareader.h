@@ -50,6 +50,7 @@ public:
     virtual int rasterXSize() const override;
     virtual int rasterYSize() const override;
     virtual int dataSourceNumRasters() const override;
+    virtual const std::string& datasetFilePath() const override;
     virtual float depthOffset() const override;
     virtual float depthScale() const override;
 
@@ -24,7 +24,9 @@
 
 #include <modules/globebrowsing/tile/tileloadjob.h>
 
+#include <modules/globebrowsing/cache/disktilecache.h>
 #include <modules/globebrowsing/tile/rawtiledatareader/rawtiledatareader.h>
+#include <modules/globebrowsing/tile/tilemetadata.h>
 
 namespace openspace::globebrowsing {
 
@@ -50,20 +52,60 @@ TileLoadJob::~TileLoadJob() {
     }
 }
 
+void TileLoadJob::setDiskCache(cache::DiskTileCache* diskCache, uint64_t providerID)
+{
+    _diskCache = diskCache;
+    _diskCacheProviderID = providerID;
+}
+
 void TileLoadJob::execute() {
-    size_t numBytes = _rawTileDataReader->tileTextureInitData().totalNumBytes();
+    const TileTextureInitData& initData = _rawTileDataReader->tileTextureInitData();
+    size_t numBytes = initData.totalNumBytes();
     char* dataPtr = nullptr;
-    if (_rawTileDataReader->tileTextureInitData().shouldAllocateDataOnCPU() ||
-        !_pboMappedDataDestination)
-    {
+    if (initData.shouldAllocateDataOnCPU() || !_pboMappedDataDestination) {
         dataPtr = new char[numBytes];
         _hasOwnershipOfData = true;
     }
+
+    const cache::ProviderTileKey key = { _chunkIndex, _diskCacheProviderID };
+    if (_diskCache) {
+        // Try to serve the tile from the disk cache before going to the dataset
+        char* destination = dataPtr ? dataPtr : _pboMappedDataDestination;
+        std::shared_ptr<TileMetaData> tileMetaData;
+        if (_diskCache->read(key, destination, numBytes, tileMetaData)) {
+            if (dataPtr && _pboMappedDataDestination) {
+                memcpy(_pboMappedDataDestination, dataPtr, numBytes);
+            }
+            _rawTile = std::make_shared<RawTile>();
+            _rawTile->imageData = dataPtr;
+            _rawTile->tileIndex = _chunkIndex;
+            _rawTile->textureInitData = std::make_shared<TileTextureInitData>(initData);
+            _rawTile->tileMetaData = std::move(tileMetaData);
+            return;
+        }
+    }
+
+    // The mapped PBO memory must not be read from, so if there is no CPU copy of the
+    // tile, the disk cache needs a temporary one
+    std::unique_ptr<char[]> cacheBuffer;
+    char* readDestination = dataPtr;
+    if (_diskCache && !dataPtr) {
+        cacheBuffer = std::make_unique<char[]>(numBytes);
+        readDestination = cacheBuffer.get();
+    }
+
     _rawTile = _rawTileDataReader->readTileData(
         _chunkIndex,
-        dataPtr,
+        readDestination,
         _pboMappedDataDestination
     );
+
+    if (_diskCache && _rawTile->error == RawTile::ReadError::None) {
+        _diskCache->write(key, readDestination, numBytes, _rawTile->tileMetaData.get());
+    }
+    if (cacheBuffer) {
+        _rawTile->imageData = nullptr;
+    }
 }
 
 std::shared_ptr<RawTile> TileLoadJob::product() {
@@ -31,6 +31,8 @@
 
 namespace openspace::globebrowsing {
 
+namespace cache { class DiskTileCache; }
+
 class RawTileDataReader;
 struct RawTile;
 
@@ -58,6 +60,13 @@ struct TileLoadJob : public Job<RawTile> {
      */
     ~TileLoadJob();
 
+    /**
+     * Makes the job look for the tile in the \p diskCache before reading it with the
+     * RawTileDataReader and store tiles that had to be read in the cache. The tiles are
+     * identified in the cache by the \p providerID.
+     */
+    void setDiskCache(cache::DiskTileCache* diskCache, uint64_t providerID);
+
     /**
      * If the TileLoadJob has been created using PBO, this is the address that the
      * RawTileDataReader will read to. In case specified so in the TileTextureInitData
@@ -86,6 +95,8 @@ protected:
     TileIndex _chunkIndex;
     char* _pboMappedDataDestination = nullptr;
     bool _hasOwnershipOfData = false;
+    cache::DiskTileCache* _diskCache = nullptr;
+    uint64_t _diskCacheProviderID = 0;
 };
 
 } // namespace openspace::globebrowsing
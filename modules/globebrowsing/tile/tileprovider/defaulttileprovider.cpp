@@ -185,6 +185,17 @@ Tile DefaultTileProvider::tile(const TileIndex& tileIndex) {
     }
 }
 
+void DefaultTileProvider::prefetchTile(const TileIndex& tileIndex) {
+    if (!_asyncTextureDataProvider || tileIndex.level > maxLevel()) {
+        return;
+    }
+
+    const cache::ProviderTileKey key = { tileIndex, uniqueIdentifier() };
+    if (!_tileCache->exist(key)) {
+        _asyncTextureDataProvider->enqueueTileIO(tileIndex, TaskPriority::Low);
+    }
+}
+
 float DefaultTileProvider::noDataValueAsFloat() {
     if (_asyncTextureDataProvider) {
         return _asyncTextureDataProvider->noDataValueAsFloat();
@@ -196,8 +207,9 @@ float DefaultTileProvider::noDataValueAsFloat() {
 
 void DefaultTileProvider::initTexturesFromLoadedData() {
     if (_asyncTextureDataProvider) {
-        std::shared_ptr<RawTile> tile = _asyncTextureDataProvider->popFinishedRawTile();
-        if (tile) {
+        std::vector<std::shared_ptr<RawTile>> tiles =
+            _asyncTextureDataProvider->rawTiles();
+        for (const std::shared_ptr<RawTile>& tile : tiles) {
             const cache::ProviderTileKey key = { tile->tileIndex, uniqueIdentifier() };
             ghoul_assert(!_tileCache->exist(key), "Tile must not be existing in cache");
             _tileCache->createTileAndPut(key, *tile);
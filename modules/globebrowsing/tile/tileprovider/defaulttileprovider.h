@@ -58,6 +58,7 @@ public:
      *         enqueue some IO operations on a separate thread.
      */
     virtual Tile tile(const TileIndex& tileIndex) override;
+    virtual void prefetchTile(const TileIndex& tileIndex) override;
 
     virtual Tile::Status tileStatus(const TileIndex& tileIndex) override;
     virtual TileDepthTransform depthTransform() override;
@@ -282,6 +282,13 @@ Tile TemporalTileProvider::tile(const TileIndex& tileIndex) {
     }
 }
 
+void TemporalTileProvider::prefetchTile(const TileIndex& tileIndex) {
+    if (_successfulInitialization) {
+        ensureUpdated();
+        _currentTileProvider->prefetchTile(tileIndex);
+    }
+}
+
 int TemporalTileProvider::maxLevel() {
     if (_successfulInitialization) {
         ensureUpdated();
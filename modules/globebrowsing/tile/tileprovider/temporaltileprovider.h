@@ -68,6 +68,7 @@ public:
     // These methods implements the TileProvider interface
 
     virtual Tile tile(const TileIndex& tileIndex) override;
+    virtual void prefetchTile(const TileIndex& tileIndex) override;
     virtual Tile::Status tileStatus(const TileIndex& tileIndex) override;
     virtual TileDepthTransform depthTransform() override;
     virtual void update() override;
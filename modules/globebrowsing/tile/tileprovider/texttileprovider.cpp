@@ -76,6 +76,9 @@ Tile TextTileProvider::tile(const TileIndex& tileIndex) {
 
     if (tile.texture() == nullptr) {
         tile = TextTileProvider::createChunkIndexTile(tileIndex);
+        if (tile.texture() == nullptr) {
+            return tile;
+        }
         _tileCache->put(key, _initData.hashKey(), tile);
     }
     return tile;
@@ -100,6 +103,10 @@ void TextTileProvider::reset() {
 
 Tile TextTileProvider::createChunkIndexTile(const TileIndex& tileIndex) {
     ghoul::opengl::Texture* texture = _tileCache->texture(_initData);
+    if (!texture) {
+        // The texture container has been reset to zero textures
+        return Tile::TileUnavailable;
+    }
 
     // Keep track of defaultFBO and viewport to be able to reset state when done
     GLint defaultFBO;
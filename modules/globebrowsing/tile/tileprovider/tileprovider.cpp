@@ -72,6 +72,8 @@ bool TileProvider::deinitialize() {
     return true;
 }
 
+void TileProvider::prefetchTile(const TileIndex&) {}
+
 float TileProvider::noDataValueAsFloat() {
     ghoul_assert(_isInitialized, "TileProvider was not initialized.");
     return std::numeric_limits<float>::min();
@@ -92,6 +92,15 @@ public:
      */
     virtual Tile tile(const TileIndex& tileIndex) = 0;
 
+    /**
+     * Requests the tile for the given <code>TileIndex</code> to be loaded in the
+     * background without returning it. This is used for tiles that are not needed yet,
+     * but are expected to be needed in the near future, so their loading must not delay
+     * the tiles requested through the <code>tile</code> method. The default
+     * implementation does nothing.
+     */
+    virtual void prefetchTile(const TileIndex& tileIndex);
+
 
     virtual ChunkTile chunkTile(TileIndex tileIndex, int parents = 0,
         int maxParents = 1337);
@@ -100,6 +100,13 @@ Tile TileProviderByIndex::tile(const TileIndex& tileIndex) {
     return hasProvider ? it->second->tile(tileIndex) : Tile::TileUnavailable;
 }
 
+void TileProviderByIndex::prefetchTile(const TileIndex& tileIndex) {
+    const auto it = _tileProviderMap.find(tileIndex.hashKey());
+    if (it != _tileProviderMap.end()) {
+        it->second->prefetchTile(tileIndex);
+    }
+}
+
 Tile::Status TileProviderByIndex::tileStatus(const TileIndex& tileIndex) {
     const auto it = _tileProviderMap.find(tileIndex.hashKey());
     const bool hasProvider = it != _tileProviderMap.end();
@@ -39,6 +39,7 @@ public:
     virtual ~TileProviderByIndex() = default;
 
     virtual Tile tile(const TileIndex& tileIndex) override;
+    virtual void prefetchTile(const TileIndex& tileIndex) override;
     virtual Tile::Status tileStatus(const TileIndex& tileIndex) override;
     virtual TileDepthTransform depthTransform() override;
     virtual void update() override;
@@ -131,6 +131,13 @@ Tile TileProviderByLevel::tile(const TileIndex& tileIndex) {
     }
 }
 
+void TileProviderByLevel::prefetchTile(const TileIndex& tileIndex) {
+    TileProvider* provider = levelProvider(tileIndex.level);
+    if (provider) {
+        provider->prefetchTile(tileIndex);
+    }
+}
+
 Tile::Status TileProviderByLevel::tileStatus(const TileIndex& index) {
     TileProvider* provider = levelProvider(index.level);
     if (provider) {
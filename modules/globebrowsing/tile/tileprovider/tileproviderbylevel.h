@@ -39,6 +39,7 @@ public:
     bool deinitialize() override;
 
     virtual Tile tile(const TileIndex& tileIndex) override;
+    virtual void prefetchTile(const TileIndex& tileIndex) override;
     virtual Tile::Status tileStatus(const TileIndex& index) override;
     virtual TileDepthTransform depthTransform() override;
     virtual void update() override;
@@ -25,14 +25,25 @@
 #include <modules/multiresvolume/rendering/atlasmanager.h>
 
 #include <modules/multiresvolume/rendering/tsp.h>
+#include <openspace/util/threadpool.h>
+#include <ghoul/fmt.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/opengl/texture.h>
+#include <chrono>
 #include <cstring>
 
+namespace {
+    constexpr const char* _loggerCat = "AtlasManager";
+} // namespace
+
 namespace openspace {
 
 AtlasManager::AtlasManager(TSP* tsp) : _tsp(tsp) {}
 
+AtlasManager::~AtlasManager() {
+    waitForLoad();
+}
+
 bool AtlasManager::initialize() {
     TSP::Header header = _tsp->header();
 
@@ -87,6 +98,49 @@ unsigned int AtlasManager::atlasMapBuffer() const {
 }
 
 void AtlasManager::updateAtlas(BufferIndex bufferIndex, std::vector<int>& brickIndices) {
+    // Before the first selection is resident there is nothing else to render, so it is
+    // always read synchronously
+    if (_asyncStreaming && !_residentBrickIndices.empty()) {
+        streamAtlas(bufferIndex, brickIndices);
+        return;
+    }
+
+    // A background load is based on the atlas contents that are about to change
+    waitForLoad();
+
+    float* mappedBuffer = beginAtlasUpdate(bufferIndex, brickIndices);
+    if (!mappedBuffer) {
+        return;
+    }
+
+    for (auto itStart = _requiredBricks.begin(); itStart != _requiredBricks.end();) {
+        int firstBrick = *itStart;
+        int lastBrick = firstBrick;
+
+        auto itEnd = itStart;
+        for (itEnd++;
+            itEnd != _requiredBricks.end() &&
+            *itEnd == static_cast<unsigned int>(lastBrick) + 1;
+            itEnd++)
+        {
+            lastBrick = *itEnd;
+        }
+
+        addToAtlas(firstBrick, lastBrick, mappedBuffer);
+
+        itStart = itEnd;
+    }
+
+    endAtlasUpdate(bufferIndex, brickIndices);
+}
+
+void AtlasManager::setAsyncStreaming(bool enabled) {
+    _asyncStreaming = enabled;
+}
+
+float* AtlasManager::beginAtlasUpdate(BufferIndex bufferIndex,
+                                      const std::vector<int>& brickIndices)
+{
     size_t nBrickIndices = brickIndices.size();
 
     _requiredBricks.clear();
@@ -112,37 +166,24 @@ void AtlasManager::updateAtlas(BufferIndex bufferIndex, std::vector<int>& brickI
     );
 
     if (!mappedBuffer) {
-        LERRORC("AtlasManager", "Failed to map PBO");
+        LERROR("Failed to map PBO");
         std::cout << glGetError() << std::endl;
-        return;
-    }
-
-    for (auto itStart = _requiredBricks.begin(); itStart != _requiredBricks.end();) {
-        int firstBrick = *itStart;
-        int lastBrick = firstBrick;
-
-        auto itEnd = itStart;
-        for (itEnd++;
-            itEnd != _requiredBricks.end() &&
-            *itEnd == static_cast<unsigned int>(lastBrick) + 1;
-            itEnd++)
-        {
-            lastBrick = *itEnd;
-        }
-
-        addToAtlas(firstBrick, lastBrick, mappedBuffer);
-
-        itStart = itEnd;
     }
+    return mappedBuffer;
+}
 
+void AtlasManager::endAtlasUpdate(BufferIndex bufferIndex,
+                                  const std::vector<int>& brickIndices)
+{
     glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
     glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
 
-    for (size_t i = 0; i < nBrickIndices; i++) {
+    for (size_t i = 0; i < brickIndices.size(); i++) {
         _atlasMap[i] = _brickMap[brickIndices[i]];
     }
 
     std::swap(_prevRequiredBricks, _requiredBricks);
+    _residentBrickIndices = brickIndices;
 
     pboToAtlas(bufferIndex);
 
@@ -180,19 +221,10 @@ void AtlasManager::addToAtlas(int firstBrickIndex, int lastBrickIndex,
 
     for (int brickIndex = firstBrickIndex; brickIndex <= lastBrickIndex; brickIndex++) {
         if (!_brickMap.count(brickIndex)) {
-            unsigned int atlasCoords = _freeAtlasCoords.back();
-            _freeAtlasCoords.pop_back();
-            int level = _nOtLevels - static_cast<int>(
-                floor(log((7.0 * (float(brickIndex % _nOtNodes)) + 1.0))/log(8)) - 1
-            );
-            ghoul_assert(atlasCoords <= 0x0FFFFFFF, "@MISSING");
-            unsigned int atlasData = (level << 28) + atlasCoords;
-            _brickMap.emplace(brickIndex, atlasData);
-            _nStreamedBricks++;
-            fillVolume(
+            insertBrick(
+                brickIndex,
                 &sequenceBuffer[_nBrickVals*(brickIndex - firstBrickIndex)],
-                mappedBuffer,
-                atlasCoords
+                mappedBuffer
             );
         }
     }
@@ -200,6 +232,141 @@ void AtlasManager::addToAtlas(int firstBrickIndex, int lastBrickIndex,
     delete[] sequenceBuffer;
 }
 
+void AtlasManager::insertBrick(int brickIndex, float* voxels, float* mappedBuffer) {
+    unsigned int atlasCoords = _freeAtlasCoords.back();
+    _freeAtlasCoords.pop_back();
+    int level = _nOtLevels - static_cast<int>(
+        floor(log((7.0 * (float(brickIndex % _nOtNodes)) + 1.0))/log(8)) - 1
+    );
+    ghoul_assert(atlasCoords <= 0x0FFFFFFF, "@MISSING");
+    unsigned int atlasData = (level << 28) + atlasCoords;
+    _brickMap.emplace(brickIndex, atlasData);
+    _nStreamedBricks++;
+    fillVolume(voxels, mappedBuffer, atlasCoords);
+}
+
+void AtlasManager::streamAtlas(BufferIndex bufferIndex,
+                               const std::vector<int>& brickIndices)
+{
+    // Stats
+    _nStreamedBricks = 0;
+    _nDiskReads = 0;
+
+    if (_pendingLoad.valid()) {
+        if (_pendingLoad.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        {
+            // Keep rendering the resident bricks until the load is complete
+            return;
+        }
+        _pendingLoad.get();
+        commitLoad(bufferIndex);
+    }
+
+    if (brickIndices == _failedBrickIndices) {
+        // Reading the same bricks again would most likely fail again
+        return;
+    }
+    _failedBrickIndices.clear();
+
+    if (brickIndices != _residentBrickIndices) {
+        startLoad(brickIndices);
+        if (!_pendingLoad.valid()) {
+            // All bricks were already resident, so the atlas map can be switched
+            // right away
+            commitLoad(bufferIndex);
+        }
+    }
+}
+
+void AtlasManager::startLoad(const std::vector<int>& brickIndices) {
+    _load.brickIndices = brickIndices;
+    _load.bricks.clear();
+    _load.nDiskReads = 0;
+    _load.success = true;
+
+    // The set is sorted by brick index, and thereby by the offset in the file, which
+    // turns the reads into sequential runs
+    std::set<unsigned int> required(brickIndices.begin(), brickIndices.end());
+    for (unsigned int brick : required) {
+        if (!_brickMap.count(brick)) {
+            _load.bricks.push_back(brick);
+        }
+    }
+
+    if (_load.bricks.empty()) {
+        return;
+    }
+
+    _load.voxels.resize(_load.bricks.size() * _nBrickVals);
+
+    if (!_loadingThread) {
+        _loadingThread = std::make_unique<ThreadPool>(1);
+        _brickFile.open(_tsp->filename(), std::ios::in | std::ios::binary);
+    }
+
+    auto load = std::make_shared<std::packaged_task<void()>>([this]() { readBricks(); });
+    _pendingLoad = load->get_future();
+    _loadingThread->enqueue([load]() { (*load)(); });
+}
+
+void AtlasManager::readBricks() {
+    // Read every run of consecutive bricks with a single read into the staging memory
+    size_t first = 0;
+    while (first < _load.bricks.size()) {
+        size_t last = first;
+        while (last + 1 < _load.bricks.size() &&
+               _load.bricks[last + 1] == _load.bricks[last] + 1)
+        {
+            last++;
+        }
+
+        long long offset = TSP::dataPosition() +
+                           static_cast<long long>(_load.bricks[first]) * _brickSize;
+        _brickFile.seekg(offset);
+        _brickFile.read(
+            reinterpret_cast<char*>(&_load.voxels[first * _nBrickVals]),
+            (last - first + 1) * _brickSize
+        );
+        _load.nDiskReads++;
+
+        if (!_brickFile.good()) {
+            _brickFile.clear();
+            _load.success = false;
+            return;
+        }
+
+        first = last + 1;
+    }
+}
+
+void AtlasManager::commitLoad(BufferIndex bufferIndex) {
+    if (!_load.success) {
+        // Keep the resident bricks until a different selection is requested
+        LERROR(fmt::format("Failed to read bricks from {}", _tsp->filename()));
+        _failedBrickIndices = _load.brickIndices;
+        return;
+    }
+
+    float* mappedBuffer = beginAtlasUpdate(bufferIndex, _load.brickIndices);
+    if (!mappedBuffer) {
+        return;
+    }
+
+    for (size_t i = 0; i < _load.bricks.size(); ++i) {
+        insertBrick(_load.bricks[i], &_load.voxels[i * _nBrickVals], mappedBuffer);
+    }
+    _nDiskReads = _load.nDiskReads;
+
+    endAtlasUpdate(bufferIndex, _load.brickIndices);
+}
+
+void AtlasManager::waitForLoad() {
+    if (_pendingLoad.valid()) {
+        _pendingLoad.wait();
+        _pendingLoad = std::future<void>();
+    }
+}
+
 void AtlasManager::removeFromAtlas(int brickIndex) {
     unsigned int atlasData = _brickMap[brickIndex];
     unsigned int atlasCoords = atlasData & 0x0FFFFFFF;
@@ -27,7 +27,10 @@
 
 #include <ghoul/glm.h>
 #include <glm/gtx/std_based_type.hpp>
+#include <fstream>
+#include <future>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -36,6 +39,7 @@ namespace ghoul::opengl { class Texture; }
 
 namespace openspace {
 
+class ThreadPool;
 class TSP;
 
 class AtlasManager {
@@ -46,9 +50,17 @@ public:
     };
 
     AtlasManager(TSP* tsp);
-    ~AtlasManager() = default;
+    ~AtlasManager();
 
     void updateAtlas(BufferIndex bufferIndex, std::vector<int>& brickIndices);
+
+    /**
+     * If enabled, the bricks that are missing from the atlas are read from disk on a
+     * background thread instead of in updateAtlas. The previously selected bricks are
+     * rendered until all bricks of the new selection have been read, and only then is
+     * the atlas switched over to the new selection.
+     */
+    void setAsyncStreaming(bool enabled);
     void addToAtlas(int firstBrickIndex, int lastBrickIndex, float* mappedBuffer);
     void removeFromAtlas(int brickIndex);
     bool initialize();
@@ -96,7 +108,45 @@ private:
     unsigned int _nBricksInMap;
     unsigned int _atlasDim;
 
+    // A set of bricks that is read from disk in the background
+    struct BrickLoad {
+        // The selection that the load was started for
+        std::vector<int> brickIndices;
+        // The bricks that were missing from the atlas, sorted by their file offset
+        std::vector<unsigned int> bricks;
+        // Staging memory that holds the voxels of the bricks in the same order. It is
+        // reused between loads to avoid reallocating it for every selection
+        std::vector<float> voxels;
+        unsigned int nDiskReads = 0;
+        bool success = false;
+    };
+
+    // Frees the bricks that are no longer required and maps the PBO that the new bricks
+    // are written into. Returns nullptr if the PBO could not be mapped
+    float* beginAtlasUpdate(BufferIndex bufferIndex,
+        const std::vector<int>& brickIndices);
+    // Uploads the PBO into the atlas and the new atlas map to its buffer
+    void endAtlasUpdate(BufferIndex bufferIndex, const std::vector<int>& brickIndices);
+
+    void insertBrick(int brickIndex, float* voxels, float* mappedBuffer);
     void fillVolume(float* in, float* out, unsigned int linearAtlasCoords);
+
+    void streamAtlas(BufferIndex bufferIndex, const std::vector<int>& brickIndices);
+    void startLoad(const std::vector<int>& brickIndices);
+    void commitLoad(BufferIndex bufferIndex);
+    void readBricks();
+    void waitForLoad();
+
+    bool _asyncStreaming = false;
+    // The brick selection that is currently stored in the atlas
+    std::vector<int> _residentBrickIndices;
+    // The brick selection whose bricks could not be read. It is not loaded again until
+    // a different selection is requested
+    std::vector<int> _failedBrickIndices;
+    BrickLoad _load;
+    std::future<void> _pendingLoad;
+    std::ifstream _brickFile;
+    std::unique_ptr<ThreadPool> _loadingThread;
 };
 
 } // namespace openspace
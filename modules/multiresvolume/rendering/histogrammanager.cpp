@@ -25,6 +25,7 @@
 #include <modules/multiresvolume/rendering/histogrammanager.h>
 
 #include <modules/multiresvolume/rendering/tsp.h>
+#include <modules/volume/volumeutils.h>
 #include <cstring>
 #include <string>
 
@@ -59,11 +60,7 @@ bool HistogramManager::buildHistogram(TSP* tsp, unsigned int brickIndex) {
     if (isBstLeaf && isOctreeLeaf) {
         // TSP leaf, read from file and build histogram
         std::vector<float> voxelValues = readValues(tsp, brickIndex);
-        size_t numVoxels = voxelValues.size();
-
-        for (size_t v = 0; v < numVoxels; ++v) {
-            histogram.add(voxelValues[v], 1.0);
-        }
+        volume::addToHistogram(voxelValues.data(), voxelValues.size(), histogram);
     } else {
         // Has children
         std::vector<unsigned int> children;
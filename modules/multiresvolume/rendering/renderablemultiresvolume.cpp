@@ -138,6 +138,28 @@ namespace {
         "" // @TODO Missing documentation
     };
 
+    constexpr openspace::properties::Property::PropertyInfo AsyncStreamingInfo = {
+        "AsyncBrickStreaming",
+        "Asynchronous Brick Streaming",
+        "If this value is enabled, bricks are read from disk on a background thread and "
+        "the previously selected bricks are rendered until all bricks of a new "
+        "selection are available. Otherwise, the bricks are read during the update, "
+        "which stalls the frame if many bricks change."
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo RecordFrameTimesInfo = {
+        "RecordFrameTimes",
+        "Record Frame Times",
+        "While this value is enabled, the durations of all frames are collected into a "
+        "histogram. When it is disabled again, the histogram is written to the stats "
+        "file with the extension '.frametimes'."
+    };
+
+    // The frame time histogram has bins of one millisecond; the last bin also contains
+    // all frames that took even longer
+    constexpr const double FrameTimeBinWidth = 1.0;
+    constexpr const size_t NumFrameTimeBins = 100;
+
     constexpr openspace::properties::Property::PropertyInfo ScalingExponentInfo = {
         "ScalingExponent",
         "Scaling Exponent",
@@ -176,6 +198,8 @@ RenderableMultiresVolume::RenderableMultiresVolume(const ghoul::Dictionary& dict
     , _selectorName(SelectorNameInfo, "tf")
     , _statsToFile(StatsToFileInfo, false)
     , _statsToFileName(StatsToFileNameInfo)
+    , _asyncStreaming(AsyncStreamingInfo, true)
+    , _recordFrameTimes(RecordFrameTimesInfo, false)
     , _scalingExponent(ScalingExponentInfo, 1, -10, 20)
     , _translation(TranslationInfo, glm::vec3(0.f), glm::vec3(0.f), glm::vec3(10.f))
     , _rotation(RotationInfo, glm::vec3(0.f, 0.f, 0.f), glm::vec3(0.f), glm::vec3(6.28f))
@@ -264,6 +288,10 @@ RenderableMultiresVolume::RenderableMultiresVolume(const ghoul::Dictionary& dict
 
     _tsp = std::make_shared<TSP>(_filename);
     _atlasManager = std::make_shared<AtlasManager>(_tsp.get());
+    _atlasManager->setAsyncStreaming(_asyncStreaming);
+    _asyncStreaming.onChange([this]() {
+        _atlasManager->setAsyncStreaming(_asyncStreaming);
+    });
 
     if (dictionary.hasKeyAndValue<std::string>(KeyBrickSelector)) {
         _selectorName = dictionary.value<std::string>(KeyBrickSelector);
@@ -299,6 +327,8 @@ RenderableMultiresVolume::RenderableMultiresVolume(const ghoul::Dictionary& dict
     addProperty(_loop);
     addProperty(_statsToFile);
     addProperty(_statsToFileName);
+    addProperty(_asyncStreaming);
+    addProperty(_recordFrameTimes);
     addProperty(_scaling);
     addProperty(_scalingExponent);
     addProperty(_translation);
@@ -378,7 +408,9 @@ void RenderableMultiresVolume::setSelectorType(Selector selector) {
 }
 
 void RenderableMultiresVolume::initializeGL() {
-    bool success = _tsp && _tsp->load();
+    std::chrono::system_clock::time_point loadStart = std::chrono::system_clock::now();
+
+    bool success = _tsp && _tsp->load(OsEng.computePool());
 
     unsigned int maxNumBricks = _tsp->header().xNumBricks * _tsp->header().yNumBricks *
                                 _tsp->header().zNumBricks;
@@ -442,6 +474,12 @@ void RenderableMultiresVolume::initializeGL() {
     if (!success) {
         throw ghoul::RuntimeError("Error during initialization");
     }
+
+    std::chrono::duration<double> loadDuration =
+        std::chrono::system_clock::now() - loadStart;
+    LINFO(fmt::format(
+        "Prepared {} for rendering in {:.2f} s", _filename, loadDuration.count()
+    ));
 }
 
 void RenderableMultiresVolume::deinitializeGL() {
@@ -656,6 +694,28 @@ void RenderableMultiresVolume::update(const UpdateData& data) {
         _statsToFile = false;
     }
 
+    std::chrono::system_clock::time_point updateTime = std::chrono::system_clock::now();
+    if (_recordFrameTimes) {
+        if (_frameTimeCounts.empty()) {
+            // The first frame only starts the timer
+            _frameTimeCounts.resize(NumFrameTimeBins, 0);
+        }
+        else {
+            std::chrono::duration<double, std::milli> frameDuration =
+                updateTime - _lastUpdateTime;
+            const size_t bin = std::min(
+                static_cast<size_t>(frameDuration.count() / FrameTimeBinWidth),
+                NumFrameTimeBins - 1
+            );
+            _frameTimeCounts[bin]++;
+        }
+    }
+    else if (!_frameTimeCounts.empty()) {
+        writeFrameTimes();
+        _frameTimeCounts.clear();
+    }
+    _lastUpdateTime = updateTime;
+
     int numTimesteps = _tsp->header().numTimesteps;
     int currentTimestep;
     bool visible = true;
@@ -743,6 +803,28 @@ void RenderableMultiresVolume::update(const UpdateData& data) {
     }
 }
 
+void RenderableMultiresVolume::writeFrameTimes() const {
+    const std::string fileName = _statsToFileName.value() + ".frametimes";
+
+    // Make sure that the directory exists
+    ghoul::filesystem::File file(fileName);
+    ghoul::filesystem::Directory directory(file.directoryName());
+    FileSys.createDirectory(directory, ghoul::filesystem::FileSystem::Recursive::Yes);
+
+    std::ofstream ofs(fileName, std::ofstream::out);
+    if (!ofs.good()) {
+        LERROR(fmt::format("Failed to write frame times to {}", fileName));
+        return;
+    }
+
+    // Every line contains the lower end of a bin in milliseconds and its frame count
+    ofs << "# AsyncBrickStreaming: " << (_asyncStreaming ? "on" : "off") << '\n';
+    for (size_t i = 0; i < _frameTimeCounts.size(); ++i) {
+        ofs << i * FrameTimeBinWidth << " " << _frameTimeCounts[i] << '\n';
+    }
+    LINFO(fmt::format("Wrote frame time histogram to {}", fileName));
+}
+
 void RenderableMultiresVolume::render(const RenderData& data, RendererTasks& tasks) {
     RaycasterTask task { _raycaster.get(), data };
     tasks.raycasterTasks.push_back(task);
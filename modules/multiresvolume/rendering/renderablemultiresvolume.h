@@ -84,6 +84,8 @@ public:
     //virtual std::vector<unsigned int> getBuffers() override;
 
 private:
+    void writeFrameTimes() const;
+
     properties::BoolProperty _useGlobalTime;
     properties::BoolProperty _loop;
     // used to vary time, if not using global time nor looping
@@ -94,6 +96,8 @@ private:
     properties::StringProperty _selectorName;
     properties::BoolProperty _statsToFile;
     properties::StringProperty _statsToFileName;
+    properties::BoolProperty _asyncStreaming;
+    properties::BoolProperty _recordFrameTimes;
     properties::IntProperty _scalingExponent;
     properties::Vec3Property _translation;
     properties::Vec3Property _rotation;
@@ -114,6 +118,10 @@ private:
     unsigned int _nUsedBricks;
     unsigned int _nStreamedBricks;
 
+    // Histogram of the frame durations while the frame times are being recorded
+    std::vector<unsigned int> _frameTimeCounts;
+    std::chrono::system_clock::time_point _lastUpdateTime;
+
     int _timestep = 0;
 
     std::string _filename;
@@ -24,17 +24,55 @@
 
 #include <modules/multiresvolume/rendering/tsp.h>
 
+#include <openspace/util/threadpool.h>
+
 #include <ghoul/fmt.h>
 #include <ghoul/glm.h>
 #include <ghoul/filesystem/file.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/filesystem/cachemanager.h>
 #include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/exception.h>
+#include <algorithm>
+#include <atomic>
 #include <numeric>
 #include <queue>
 
 namespace {
     constexpr const char* _loggerCat = "TSP";
+
+    // Nodes close to the roots of the trees cover far more leaf bricks than the
+    // others, so the nodes are handed out to the threads in small chunks on demand
+    // rather than being split into equally large ranges up front
+    constexpr const unsigned int NodesPerChunk = 16;
+
+    // Calls func for every index in [0, n). The calls for different indices must be
+    // independent of each other, which makes the result the same as a serial loop
+    template <typename Func>
+    void forEachIndex(openspace::ThreadPool* pool, unsigned int n, const Func& func) {
+        if (!pool || n <= NodesPerChunk) {
+            for (unsigned int i = 0; i < n; ++i) {
+                func(i);
+            }
+            return;
+        }
+
+        std::atomic<size_t> nextChunk(0);
+        auto run = [&func, &nextChunk, n]() {
+            size_t begin = nextChunk.fetch_add(NodesPerChunk);
+            while (begin < n) {
+                const size_t end = std::min(begin + NodesPerChunk, size_t(n));
+                for (size_t i = begin; i < end; ++i) {
+                    func(static_cast<unsigned int>(i));
+                }
+                begin = nextChunk.fetch_add(NodesPerChunk);
+            }
+        };
+
+        const size_t nChunks = (n + NodesPerChunk - 1) / NodesPerChunk;
+        const size_t nTasks = std::min(pool->numThreads() + 1, nChunks);
+        openspace::parallelFor(pool, nTasks, [&run](size_t) { run(); });
+    }
 } // namespace
 
 namespace openspace {
@@ -51,7 +89,7 @@ TSP::~TSP() {
     }
 }
 
-bool TSP::load() {
+bool TSP::load(ThreadPool* pool) {
     if (!readHeader()) {
         LERROR("Could not read header");
         return false;
@@ -61,17 +99,17 @@ bool TSP::load() {
         LINFO("Using cache");
     }
     else {
-        if (!construct()) {
+        if (!construct(pool)) {
             LERROR("Could not construct");
             return false;
         }
 
         if (false) {
-            if (!calculateSpatialError()) {
+            if (!calculateSpatialError(pool)) {
                 LERROR("Could not calculate spatial error");
                 return false;
             }
-            if (!calculateTemporalError()) {
+            if (!calculateTemporalError(pool)) {
                 LERROR("Could not calculate temporal error");
                 return false;
             }
@@ -130,73 +168,75 @@ bool TSP::readHeader() {
     return true;
 }
 
-bool TSP::construct() {
+bool TSP::construct(ThreadPool* pool) {
     LDEBUG("Constructing TSP tree");
 
-    // Loop over the OTs (one per BST node)
-    for (unsigned int OT = 0; OT < _numBSTNodes; ++OT) {
-        // Start at the root of each OT
-        unsigned int OTNode = OT * _numOTNodes;
-
-        // Calculate BST level (first level is level 0)
-        unsigned int BSTLevel = static_cast<unsigned int>(log(OT + 1) / log(2));
-
-        // Traverse OT
-        unsigned int OTChild = 1;
-        unsigned int OTLevel = 0;
-        while (OTLevel < _numOTLevels) {
-            unsigned int OTNodesInLevel = static_cast<unsigned int>(pow(8, OTLevel));
-            for (unsigned int i = 0; i<OTNodesInLevel; ++i) {
-                // Brick index
-                _data[OTNode*NUM_DATA + BRICK_INDEX] = static_cast<int>(OTNode);
-
-                // Error metrics
-                _data[OTNode*NUM_DATA + TEMPORAL_ERR] = static_cast<int>(
-                    _numBSTLevels - 1 - BSTLevel
+    // Loop over the OTs (one per BST node). Every OT only writes its own nodes
+    forEachIndex(pool, _numBSTNodes, [this](unsigned int OT) { constructOctree(OT); });
+    return true;
+}
+
+void TSP::constructOctree(unsigned int OT) {
+    // Start at the root of each OT
+    unsigned int OTNode = OT * _numOTNodes;
+
+    // Calculate BST level (first level is level 0)
+    unsigned int BSTLevel = static_cast<unsigned int>(log(OT + 1) / log(2));
+
+    // Traverse OT
+    unsigned int OTChild = 1;
+    unsigned int OTLevel = 0;
+    while (OTLevel < _numOTLevels) {
+        unsigned int OTNodesInLevel = static_cast<unsigned int>(pow(8, OTLevel));
+        for (unsigned int i = 0; i<OTNodesInLevel; ++i) {
+            // Brick index
+            _data[OTNode*NUM_DATA + BRICK_INDEX] = static_cast<int>(OTNode);
+
+            // Error metrics
+            _data[OTNode*NUM_DATA + TEMPORAL_ERR] = static_cast<int>(
+                _numBSTLevels - 1 - BSTLevel
+            );
+            _data[OTNode*NUM_DATA + SPATIAL_ERR] = static_cast<int>(
+                _numOTLevels - 1 - OTLevel
+            );
+
+            if (BSTLevel == 0) {
+                // Calculate OT child index (-1 if node is leaf)
+                int OTChildIndex = (OTChild < _numOTNodes) ?
+                    static_cast<int>(OT*_numOTNodes + OTChild) :
+                    -1;
+                _data[OTNode*NUM_DATA + CHILD_INDEX] = OTChildIndex;
+            }
+            else {
+                // Calculate BST child index (-1 if node is BST leaf)
+
+                // First BST node of current level
+                int firstNode = static_cast<unsigned int>(
+                    (2 * pow(2, BSTLevel - 1) - 1) * _numOTNodes
                 );
-                _data[OTNode*NUM_DATA + SPATIAL_ERR] = static_cast<int>(
-                    _numOTLevels - 1 - OTLevel
+                // First BST node of next level
+                int firstChild = static_cast<unsigned int>(
+                    (2 * pow(2, BSTLevel) - 1) * _numOTNodes
                 );
+                // Difference between first nodes between levels
+                int levelGap = firstChild - firstNode;
+                // How many nodes away from the first node are we?
+                int offset = (OTNode - firstNode) / _numOTNodes;
 
-                if (BSTLevel == 0) {
-                    // Calculate OT child index (-1 if node is leaf)
-                    int OTChildIndex = (OTChild < _numOTNodes) ?
-                        static_cast<int>(OT*_numOTNodes + OTChild) :
-                        -1;
-                    _data[OTNode*NUM_DATA + CHILD_INDEX] = OTChildIndex;
-                }
-                else {
-                    // Calculate BST child index (-1 if node is BST leaf)
-
-                    // First BST node of current level
-                    int firstNode = static_cast<unsigned int>(
-                        (2 * pow(2, BSTLevel - 1) - 1) * _numOTNodes
-                    );
-                    // First BST node of next level
-                    int firstChild = static_cast<unsigned int>(
-                        (2 * pow(2, BSTLevel) - 1) * _numOTNodes
-                    );
-                    // Difference between first nodes between levels
-                    int levelGap = firstChild - firstNode;
-                    // How many nodes away from the first node are we?
-                    int offset = (OTNode - firstNode) / _numOTNodes;
-
-                    // Use level gap and offset to calculate child index
-                    int BSTChildIndex = (BSTLevel < _numBSTLevels - 1) ?
-                        static_cast<int>(OTNode + levelGap + (offset*_numOTNodes)) :
-                        -1;
-
-                    _data[OTNode*NUM_DATA + CHILD_INDEX] = BSTChildIndex;
-                }
+                // Use level gap and offset to calculate child index
+                int BSTChildIndex = (BSTLevel < _numBSTLevels - 1) ?
+                    static_cast<int>(OTNode + levelGap + (offset*_numOTNodes)) :
+                    -1;
 
-                OTNode++;
-                OTChild += 8;
+                _data[OTNode*NUM_DATA + CHILD_INDEX] = BSTChildIndex;
             }
 
-            OTLevel++;
+            OTNode++;
+            OTChild += 8;
         }
+
+        OTLevel++;
     }
-    return true;
 }
 
 bool TSP::initalizeSSO() {
@@ -217,6 +257,10 @@ const TSP::Header& TSP::header() const {
     return _header;
 }
 
+const std::string& TSP::filename() const {
+    return _filename;
+}
+
 long long TSP::dataPosition() {
     return sizeof(Header);
 }
@@ -265,48 +309,34 @@ GLuint TSP::ssbo() const {
     return _dataSSBO;
 }
 
-bool TSP::calculateSpatialError() {
+bool TSP::calculateSpatialError(ThreadPool* pool) {
     unsigned int numBrickVals = _paddedBrickDim*_paddedBrickDim*_paddedBrickDim;
 
-    if (!_file.is_open()) {
+    if (!mapBricks()) {
         return false;
     }
 
-    std::vector<float> buffer(numBrickVals);
     std::vector<float> averages(_numTotalNodes);
     std::vector<float> stdDevs(_numTotalNodes);
 
     // First pass: Calculate average color for each brick
     LDEBUG("Calculating spatial error, first pass");
-    for (unsigned int brick = 0; brick<_numTotalNodes; ++brick) {
-        // Offset in file
-        std::streampos offset = dataPosition() +
-                                static_cast<long long>(brick*numBrickVals*sizeof(float));
-        _file.seekg(offset);
-
-        _file.read(
-            reinterpret_cast<char*>(&buffer[0]),
-            static_cast<size_t>(numBrickVals) * sizeof(float)
-        );
+    forEachIndex(pool, _numTotalNodes, [&](unsigned int brick) {
+        const float* voxels = brickData(brick);
 
         double average = std::accumulate(
-            buffer.begin(),
-            buffer.end(),
+            voxels,
+            voxels + numBrickVals,
             0.0,
             [](double a, float b) { return a + static_cast<double>(b); }
         );
         averages[brick] = static_cast<float>(average / static_cast<double>(numBrickVals));
-    }
-
-    // Spatial SNR stats
-    float minError = 1e20f;
-    float maxError = 0.f;
-    std::vector<float> medianArray(_numTotalNodes);
+    });
 
     // Second pass: For each brick, compare the covered leaf voxels with
     // the brick average
     LDEBUG("Calculating spatial error, second pass");
-    for (unsigned int brick = 0; brick < _numTotalNodes; ++brick) {
+    forEachIndex(pool, _numTotalNodes, [&](unsigned int brick) {
         // Fetch mean intensity
         float brickAvg = averages[brick];
 
@@ -323,21 +353,13 @@ bool TSP::calculateSpatialError() {
             stdDev = -0.1f;
         }
         else {
-
             // Calculate "standard deviation" corresponding to leaves
-            for (auto lb = leafBricksCovered.begin(); lb != leafBricksCovered.end(); ++lb)
-            {
-                // Read brick
-                std::streampos offset = dataPosition() +
-                                 static_cast<long long>((*lb)*numBrickVals*sizeof(float));
-                _file.seekg(offset);
-
-                _file.read(reinterpret_cast<char*>(&buffer[0]),
-                    static_cast<size_t>(numBrickVals)*sizeof(float));
+            for (unsigned int leafBrick : leafBricksCovered) {
+                const float* voxels = brickData(leafBrick);
 
                 // Add to sum
-                for (auto v = buffer.begin(); v != buffer.end(); ++v) {
-                    stdDev += pow(*v - brickAvg, 2.f);
+                for (unsigned int v = 0; v < numBrickVals; ++v) {
+                    stdDev += pow(voxels[v] - brickAvg, 2.f);
                 }
             }
 
@@ -345,19 +367,8 @@ bool TSP::calculateSpatialError() {
             stdDev = sqrt(stdDev);
         } // if not leaf
 
-        if (stdDev < minError) {
-            minError = stdDev;
-        }
-        else if (stdDev > maxError) {
-            maxError = stdDev;
-        }
-
         stdDevs[brick] = stdDev;
-        medianArray[brick] = stdDev;
-    }
-
-    std::sort(medianArray.begin(), medianArray.end());
-    //float medError = medianArray[medianArray.size()/2];
+    });
 
     // "Normalize" errors
     float minNorm = 1e20f;
@@ -391,41 +402,20 @@ bool TSP::calculateSpatialError() {
     return true;
 }
 
-bool TSP::calculateTemporalError() {
-    if (!_file.is_open()) {
+bool TSP::calculateTemporalError(ThreadPool* pool) {
+    if (!mapBricks()) {
         return false;
     }
 
     LDEBUG("Calculating temporal error");
 
-    // Statistics
-    //float minErr = 1e20f;
-    //float maxErr = 0.f;
-    std::vector<float> meanArray(_numTotalNodes);
+    const unsigned int numBrickVals = _paddedBrickDim * _paddedBrickDim * _paddedBrickDim;
 
     // Save errors
     std::vector<float> errors(_numTotalNodes);
 
     // Calculate temporal error for one brick at a time
-    for (unsigned int brick = 0; brick<_numTotalNodes; ++brick) {
-        unsigned int numBrickVals = _paddedBrickDim * _paddedBrickDim * _paddedBrickDim;
-
-        // Save the individual voxel's average over timesteps. Because the
-        // BSTs are built by averaging leaf nodes, we only need to sample
-        // the brick at the correct coordinate.
-        std::vector<float> voxelAverages(numBrickVals);
-        std::vector<float> voxelStdDevs(numBrickVals);
-
-        // Read the whole brick to fill the averages
-        std::streampos offset = dataPosition() +
-                                static_cast<long long>(brick*numBrickVals*sizeof(float));
-        _file.seekg(offset);
-
-        _file.read(
-            reinterpret_cast<char*>(voxelAverages.data()),
-            static_cast<size_t>(numBrickVals)*sizeof(float)
-        );
-
+    forEachIndex(pool, _numTotalNodes, [&](unsigned int brick) {
         // Build a list of the BST leaf bricks (within the same octree level) that
         // this brick covers
         std::list<unsigned int> coveredBricks = coveredBSTLeafBricks(brick);
@@ -436,40 +426,39 @@ bool TSP::calculateTemporalError() {
         // 0.0 higher up in the tree
         if (coveredBricks.size() == 1) {
             errors[brick] = -0.1f;
-        } else {
-            // Calculate standard deviation per voxel, average over brick
-            float avgStdDev = 0.f;
-            for (unsigned int voxel = 0; voxel<numBrickVals; ++voxel) {
-                float stdDev = 0.f;
-                for (auto leaf = coveredBricks.begin();
-                    leaf != coveredBricks.end(); ++leaf)
-                {
-                    // Sample the leaves at the corresponding voxel position
-                    _file.seekg(dataPosition() +
-                        static_cast<long long>(
-                            (*leaf * numBrickVals + voxel) * sizeof(float)
-                        )
-                    );
-
-                    float sample;
-                    _file.read(reinterpret_cast<char*>(&sample), sizeof(float));
-
-                    stdDev += pow(sample - voxelAverages[voxel], 2.f);
-                }
-                stdDev /= static_cast<float>(coveredBricks.size());
-                stdDev = sqrt(stdDev);
-
-                avgStdDev += stdDev;
-            } // for voxel
+            return;
+        }
 
-            avgStdDev /= static_cast<float>(numBrickVals);
-            meanArray[brick] = avgStdDev;
-            errors[brick] = avgStdDev;
+        // The individual voxel's average over timesteps. Because the BSTs are
+        // built by averaging leaf nodes, we only need to sample the brick at the
+        // correct coordinate.
+        const float* voxelAverages = brickData(brick);
+
+        // Sum up the squared deviations of all voxels one leaf at a time, so that
+        // every leaf brick is read sequentially. Each voxel's sum is still
+        // accumulated over the leaves in the same order
+        std::vector<float> voxelStdDevs(numBrickVals, 0.f);
+        for (unsigned int leaf : coveredBricks) {
+            // Sample the leaves at the corresponding voxel position
+            const float* samples = brickData(leaf);
+            for (unsigned int voxel = 0; voxel < numBrickVals; ++voxel) {
+                voxelStdDevs[voxel] += pow(samples[voxel] - voxelAverages[voxel], 2.f);
+            }
         }
-    } // for all bricks
 
-    std::sort(meanArray.begin(), meanArray.end());
-    //float medErr = meanArray[meanArray.size()/2];
+        // Calculate standard deviation per voxel, average over brick
+        float avgStdDev = 0.f;
+        for (unsigned int voxel = 0; voxel < numBrickVals; ++voxel) {
+            float stdDev = voxelStdDevs[voxel];
+            stdDev /= static_cast<float>(coveredBricks.size());
+            stdDev = sqrt(stdDev);
+
+            avgStdDev += stdDev;
+        } // for voxel
+
+        avgStdDev /= static_cast<float>(numBrickVals);
+        errors[brick] = avgStdDev;
+    });
 
     // Adjust errors using user-provided exponents
     float minNorm = 1e20f;
@@ -572,6 +561,38 @@ bool TSP::writeCache() {
     return true;
 }
 
+bool TSP::mapBricks() {
+    if (!_mappedFile.isOpen()) {
+        try {
+            _mappedFile.open(_filename);
+        }
+        catch (const ghoul::RuntimeError& e) {
+            LERROR(e.message);
+            return false;
+        }
+    }
+
+    const size_t brickSize = static_cast<size_t>(_paddedBrickDim) * _paddedBrickDim *
+                             _paddedBrickDim * sizeof(float);
+    const size_t size = static_cast<size_t>(dataPosition()) + _numTotalNodes * brickSize;
+    if (_mappedFile.size() < size) {
+        LERROR(fmt::format(
+            "File {} is too small to hold {} bricks", _filename, _numTotalNodes
+        ));
+        return false;
+    }
+    return true;
+}
+
+const float* TSP::brickData(unsigned int brickIndex) const {
+    const size_t numBrickVals = static_cast<size_t>(_paddedBrickDim) * _paddedBrickDim *
+                                _paddedBrickDim;
+    const float* bricks = reinterpret_cast<const float*>(
+        _mappedFile.data() + dataPosition()
+    );
+    return bricks + brickIndex * numBrickVals;
+}
+
 float TSP::spatialError(unsigned int brickIndex) const {
     return reinterpret_cast<const float&>(_data[brickIndex*NUM_DATA + SPATIAL_ERR]);
 }
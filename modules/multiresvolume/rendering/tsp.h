@@ -25,6 +25,8 @@
 #ifndef __OPENSPACE_MODULE_MULTIRESVOLUME___TSP___H__
 #define __OPENSPACE_MODULE_MULTIRESVOLUME___TSP___H__
 
+#include <openspace/util/memorymappedfile.h>
+
 #include <ghoul/opengl/ghoul_gl.h>
 #include <fstream>
 #include <list>
@@ -33,6 +35,8 @@
 
 namespace openspace {
 
+class ThreadPool;
+
 class TSP {
 public:
     struct Header {
@@ -59,16 +63,19 @@ public:
     ~TSP();
 
     // load performs readHeader, readCache, writeCache and construct
-    // in the correct sequence
-    bool load();
+    // in the correct sequence. If a pool is passed, the tree construction
+    // and the error metrics are computed in parallel on it; the result is
+    // identical to the serial one
+    bool load(ThreadPool* pool = nullptr);
 
     bool readHeader();
     bool readCache();
     bool writeCache();
-    bool construct();
+    bool construct(ThreadPool* pool = nullptr);
     bool initalizeSSO();
 
     const Header& header() const;
+    const std::string& filename() const;
     static long long dataPosition();
     std::ifstream& file();
     unsigned int numTotalNodes() const;
@@ -82,8 +89,8 @@ public:
     unsigned int numBricksPerAxis() const;
     GLuint ssbo() const;
 
-    bool calculateSpatialError();
-    bool calculateTemporalError();
+    bool calculateSpatialError(ThreadPool* pool = nullptr);
+    bool calculateTemporalError(ThreadPool* pool = nullptr);
 
     float spatialError(unsigned int brickIndex) const;
     float temporalError(unsigned int brickIndex) const;
@@ -96,6 +103,9 @@ public:
     bool isOctreeLeaf(unsigned int brickIndex) const;
 
 private:
+    // Fills in the nodes of the octree that belongs to the given BST node
+    void constructOctree(unsigned int OT);
+
     // Returns a list of the octree leaf nodes that a given input
     // brick covers. If the input is already a leaf, the list will
     // only contain that one index.
@@ -108,9 +118,18 @@ private:
     // Return a list of eight children brick incices given a brick index
     std::list<unsigned int> childBricks(unsigned int brickIndex);
 
+    // Maps the file into memory on first use, so that the error metrics can
+    // read bricks from several threads without sharing a stream. Returns false
+    // if the file cannot be mapped or does not contain all bricks
+    bool mapBricks();
+
+    // Returns the voxels of a brick in the mapped file
+    const float* brickData(unsigned int brickIndex) const;
+
     std::string _filename;
     std::ifstream _file;
     std::streampos _dataOffset;
+    MemoryMappedFile _mappedFile;
 
     // Holds the actual structure
     std::vector<int> _data;
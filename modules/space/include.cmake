@@ -1 +1,5 @@
 set(DEFAULT_MODULE ON)
+
+set (OPENSPACE_DEPENDENCIES
+    digitaluniverse
+)
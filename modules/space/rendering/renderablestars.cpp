@@ -39,9 +39,9 @@
 #include <ghoul/opengl/texture.h>
 #include <ghoul/opengl/textureunit.h>
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
-#include <fstream>
 
 namespace {
     constexpr const char* _loggerCat = "RenderableStars";
@@ -53,8 +53,6 @@ namespace {
         "minBillboardSize", "screenSize", "scaling", "psfTexture", "colorTexture"
     };
 
-    constexpr int8_t CurrentCacheVersion = 1;
-
     struct ColorVBOLayout {
         std::array<float, 4> position; // (x,y,z,e)
 
@@ -556,9 +554,15 @@ void RenderableStars::update(const UpdateData&) {
 }
 
 bool RenderableStars::loadData() {
-    std::string _file = _speckFile;
+    // Binary speck files, for example written by the SpeckConversionTask, are memory
+    // mapped directly and do not need a cache
+    if (speck::isBinarySpeckFile(_speckFile)) {
+        LINFO(fmt::format("Loading binary Speck file '{}'", _speckFile));
+        return loadBinarySpeckFile(_speckFile);
+    }
+
     std::string cachedFile = FileSys.cacheManager()->cachedFilename(
-        _file,
+        _speckFile,
         ghoul::filesystem::CacheManager::Persistent::Yes
     );
 
@@ -567,7 +571,7 @@ bool RenderableStars::loadData() {
         LINFO(fmt::format(
             "Cached file '{}' used for Speck file '{}'",
             cachedFile,
-            _file
+            _speckFile
         ));
 
         bool success = loadCachedFile(cachedFile);
@@ -575,15 +579,15 @@ bool RenderableStars::loadData() {
             return true;
         }
         else {
-            FileSys.cacheManager()->removeCacheFile(_file);
+            FileSys.cacheManager()->removeCacheFile(_speckFile);
             // Intentional fall-through to the 'else' computation to generate the cache
             // file for the next run
         }
     }
     else {
-        LINFO(fmt::format("Cache for Speck file '{}' not found", _file));
+        LINFO(fmt::format("Cache for Speck file '{}' not found", _speckFile));
     }
-    LINFO(fmt::format("Loading Speck file '{}'", _file));
+    LINFO(fmt::format("Loading Speck file '{}'", _speckFile));
 
     bool success = readSpeckFile();
     if (!success) {
@@ -597,131 +601,74 @@ bool RenderableStars::loadData() {
 }
 
 bool RenderableStars::readSpeckFile() {
-    std::string _file = _speckFile;
-    std::ifstream file(_file);
-    if (!file.good()) {
-        LERROR(fmt::format("Failed to open Speck file '{}'", _file));
+    try {
+        speck::SpeckData data = speck::readSpeckFile(_speckFile);
+        _nValuesPerStar = static_cast<int>(data.nValuesPerObject());
+        _speckColumns = std::move(data.columns);
+        _fullData = std::move(data.values);
+    }
+    catch (const ghoul::RuntimeError& e) {
+        LERROR(e.message);
         return false;
     }
 
-    _nValuesPerStar = 0;
-
-    // The beginning of the speck file has a header that either contains comments
-    // (signaled by a preceding '#') or information about the structure of the file
-    // (signaled by the keywords 'datavar', 'texturevar', and 'texture')
-    std::string line;
-    while (true) {
-        std::streampos position = file.tellg();
-        std::getline(file, line);
-
-        if (line[0] == '#' || line.empty()) {
+    // Remove the stars whose values are all zero in place
+    const size_t nValues = static_cast<size_t>(_nValuesPerStar);
+    auto isNull = [](float v) { return v == 0.f; };
+    size_t nKept = 0;
+    for (size_t i = 0; i < _fullData.size(); i += nValues) {
+        const auto star = _fullData.begin() + i;
+        if (std::all_of(star, star + nValues, isNull)) {
             continue;
         }
-
-        if (line.substr(0, 7) != "datavar" &&
-            line.substr(0, 10) != "texturevar" &&
-            line.substr(0, 7) != "texture")
-        {
-            // we read a line that doesn't belong to the header, so we have to jump back
-            // before the beginning of the current line
-            file.seekg(position);
-            break;
-        }
-
-        if (line.substr(0, 7) == "datavar") {
-            // datavar lines are structured as follows:
-            // datavar # description
-            // where # is the index of the data variable; so if we repeatedly overwrite
-            // the 'nValues' variable with the latest index, we will end up with the total
-            // number of values (+3 since X Y Z are not counted in the Speck file index)
-            std::stringstream str(line);
-
-            std::string dummy;
-            str >> dummy;
-            str >> _nValuesPerStar;
-            _nValuesPerStar += 1; // We want the number, but the index is 0 based
+        if (nKept != i) {
+            std::copy(star, star + nValues, _fullData.begin() + nKept);
         }
+        nKept += nValues;
     }
-
-    _nValuesPerStar += 3; // X Y Z are not counted in the Speck file indices
-
-    do {
-        std::vector<float> values(_nValuesPerStar);
-
-        std::getline(file, line);
-        std::stringstream str(line);
-
-        for (int i = 0; i < _nValuesPerStar; ++i) {
-            str >> values[i];
-        }
-        bool nullArray = true;
-        for (size_t i = 0; i < values.size(); ++i) {
-            if (values[i] != 0.0) {
-                nullArray = false;
-                break;
-            }
-        }
-        if (!nullArray) {
-            _fullData.insert(_fullData.end(), values.begin(), values.end());
-        }
-    } while (!file.eof());
+    _fullData.resize(nKept);
 
     return true;
 }
 
 bool RenderableStars::loadCachedFile(const std::string& file) {
-    std::ifstream fileStream(file, std::ifstream::binary);
-    if (fileStream.good()) {
-        int8_t version = 0;
-        fileStream.read(reinterpret_cast<char*>(&version), sizeof(int8_t));
-        if (version != CurrentCacheVersion) {
-            LINFO("The format of the cached file has changed: deleting old cache");
-            fileStream.close();
-            FileSys.deleteFile(file);
-            return false;
-        }
-
-        int32_t nValues = 0;
-        fileStream.read(reinterpret_cast<char*>(&nValues), sizeof(int32_t));
-        fileStream.read(reinterpret_cast<char*>(&_nValuesPerStar), sizeof(int32_t));
-
-        _fullData.resize(nValues);
-        fileStream.read(reinterpret_cast<char*>(&_fullData[0]),
-            nValues * sizeof(_fullData[0]));
+    const bool success = loadBinarySpeckFile(file);
+    if (!success) {
+        LINFO("The format of the cached file has changed: deleting old cache");
+        FileSys.deleteFile(file);
+    }
+    return success;
+}
 
-        bool success = fileStream.good();
-        return success;
+bool RenderableStars::loadBinarySpeckFile(const std::string& file) {
+    try {
+        const speck::BinarySpeckFile speckFile(file);
+        const size_t nValues = speckFile.nObjects() * speckFile.nValuesPerObject();
+        _nValuesPerStar = static_cast<int>(speckFile.nValuesPerObject());
+        _speckColumns = speckFile.columns();
+        // The records are stored in the layout that createDataSlice expects, so they
+        // are taken from the mapped file in a single copy
+        _fullData.assign(speckFile.values(), speckFile.values() + nValues);
+        return true;
     }
-    else {
-        LERROR(fmt::format("Error opening file '{}' for loading cache file", file));
+    catch (const ghoul::RuntimeError& e) {
+        LWARNING(e.message);
         return false;
     }
 }
 
 bool RenderableStars::saveCachedFile(const std::string& file) const {
-    std::ofstream fileStream(file, std::ofstream::binary);
-    if (fileStream.good()) {
-        fileStream.write(reinterpret_cast<const char*>(&CurrentCacheVersion),
-            sizeof(int8_t));
-
-        int32_t nValues = static_cast<int32_t>(_fullData.size());
-        if (nValues == 0) {
-            LERROR("Error writing cache: No values were loaded");
-            return false;
-        }
-        fileStream.write(reinterpret_cast<const char*>(&nValues), sizeof(int32_t));
-
-        int32_t nValuesPerStar = static_cast<int32_t>(_nValuesPerStar);
-        fileStream.write(reinterpret_cast<const char*>(&nValuesPerStar), sizeof(int32_t));
-
-        size_t nBytes = nValues * sizeof(_fullData[0]);
-        fileStream.write(reinterpret_cast<const char*>(&_fullData[0]), nBytes);
+    if (_fullData.empty()) {
+        LERROR("Error writing cache: No values were loaded");
+        return false;
+    }
 
-        bool success = fileStream.good();
-        return success;
+    try {
+        speck::saveBinarySpeckFile(_speckColumns, _fullData, file);
+        return true;
     }
-    else {
-        LERROR(fmt::format("Error opening file '{}' for save cache file", file));
+    catch (const ghoul::RuntimeError& e) {
+        LERROR(e.message);
         return false;
     }
 }
@@ -27,6 +27,7 @@
 
 #include <openspace/rendering/renderable.h>
 
+#include <modules/digitaluniverse/speckfile.h>
 #include <openspace/properties/stringproperty.h>
 #include <openspace/properties/optionproperty.h>
 #include <openspace/properties/scalar/floatproperty.h>
@@ -71,6 +72,7 @@ private:
     bool loadData();
     bool readSpeckFile();
     bool loadCachedFile(const std::string& file);
+    bool loadBinarySpeckFile(const std::string& file);
     bool saveCachedFile(const std::string& file) const;
 
     properties::StringProperty _pointSpreadFunctionTexturePath;
@@ -98,6 +100,7 @@ private:
 
     std::vector<float> _slicedData;
     std::vector<float> _fullData;
+    std::vector<speck::Column> _speckColumns;
     int _nValuesPerStar;
 
     GLuint _vao;
@@ -22,63 +22,43 @@
  * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
  ****************************************************************************************/
 
-#ifndef __OPENSPACE_MODULE_GLOBEBROWSING___CHUNKNODE___H__
-#define __OPENSPACE_MODULE_GLOBEBROWSING___CHUNKNODE___H__
+#ifndef __OPENSPACE_MODULE_SPACE___EPHEMERISROTATION___H__
+#define __OPENSPACE_MODULE_SPACE___EPHEMERISROTATION___H__
 
-#include <modules/globebrowsing/chunk/chunk.h>
+#include <openspace/scene/rotation.h>
 
-#include <array>
-#include <functional>
+#include <modules/space/util/ephemerisfile.h>
 #include <memory>
+#include <string>
 
-namespace openspace::globebrowsing {
+namespace openspace {
 
-class ChunkedLodGlobe;
+namespace documentation { struct Documentation; }
 
-class ChunkNode {
+/**
+ * A rotation that evaluates a rotation matrix from the Chebyshev coefficients stored in a
+ * binary ephemeris file, which is created by the EphemerisExportTask. The file is memory
+ * mapped and the evaluation does not use SPICE or take any lock, so neither the kernels
+ * nor the SpiceManager are required at runtime. Times outside of the exported range are
+ * clamped to the first or last exported rotation.
+ */
+class EphemerisRotation : public Rotation {
 public:
-    ChunkNode(Chunk chunk, ChunkNode* parent = nullptr);
+    EphemerisRotation(const ghoul::Dictionary& dictionary);
 
-    /**
-     * Recursively split the ChunkNode.
-     *
-     * \param depth defines how deep the recursion should go. If depth == 1 (default),
-     * the ChunkNode will only split once.
-     */
-    void split(int depth = 1);
+    glm::dmat3 matrix(const UpdateData& data) const override;
+    bool supportsConcurrentUpdate() const override;
 
-    /**
-     * Deletes all children of the ChunkNode recursively.
-     */
-    void merge();
-
-    bool isRoot() const;
-    bool isLeaf() const;
-
-    void depthFirst(const std::function<void(const ChunkNode&)>& f) const;
-    void breadthFirst(const std::function<void(const ChunkNode&)>& f) const;
-    void reverseBreadthFirst(const std::function<void(const ChunkNode&)>& f) const;
-
-    const ChunkNode& find(const Geodetic2& location) const;
-    const ChunkNode& child(const Quad& quad) const;
-    const Chunk& chunk() const;
-
-    /**
-     * Updates all children recursively. If this ChunkNode wants to split it will,
-     * otherwise check if the children wants to merge. If all children wants to merge
-     * and the Status of this Chunk is not Status::WANT_SPLIT it will merge.
-     *
-     * \returns true if the ChunkNode can merge and false if it can not merge.
-    */
-    bool updateChunkTree(const RenderData& data);
+    static documentation::Documentation Documentation();
 
 private:
-    ChunkNode* _parent;
-    std::array<std::unique_ptr<ChunkNode>, 4> _children;
+    std::string _filePath;
+    std::string _name;
 
-    Chunk _chunk;
+    std::unique_ptr<ephemeris::EphemerisFile> _file;
+    ephemeris::Segments _segments;
 };
 
-} // namespace openspace::globebrowsing
+} // namespace openspace
 
-#endif // __OPENSPACE_MODULE_GLOBEBROWSING___CHUNKNODE___H__
+#endif // __OPENSPACE_MODULE_SPACE___EPHEMERISROTATION___H__
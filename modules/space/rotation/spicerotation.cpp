@@ -33,6 +33,10 @@
 namespace {
     constexpr const char* KeyKernels = "Kernels";
 
+    // The time step (in seconds) for the central differences that approximate the
+    // derivative of the rotation for frames that do not provide angular velocities
+    constexpr const double DerivativeTimeStep = 1.0;
+
     constexpr openspace::properties::Property::PropertyInfo SourceInfo = {
         "SourceFrame",
         "Source",
@@ -46,6 +50,23 @@ namespace {
         "This value specifies the destination frame that is used for the coordinate "
         "transformation. This has to be a valid SPICE name."
     };
+
+    constexpr openspace::properties::Property::PropertyInfo UseCacheInfo = {
+        "UseCache",
+        "Use Ephemeris Cache",
+        "If this value is enabled, the rotation matrices are sampled on a time grid "
+        "that is sized to the rotation rate of the frame and are interpolated between "
+        "the samples, instead of being computed by SPICE for every frame. Times for "
+        "which the cache cannot be sampled are computed exactly."
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo CacheToleranceInfo = {
+        "CacheTolerance",
+        "Cache Tolerance",
+        "The maximum error for each element of the rotation matrix that the "
+        "interpolation of the ephemeris cache is allowed to introduce. This roughly "
+        "corresponds to the angular error in radians."
+    };
 } // namespace
 
 namespace openspace {
@@ -73,6 +94,18 @@ documentation::Documentation SpiceRotation::Documentation() {
                 Optional::No,
                 DestinationInfo.description
             },
+            {
+                UseCacheInfo.identifier,
+                new BoolVerifier,
+                Optional::Yes,
+                UseCacheInfo.description
+            },
+            {
+                CacheToleranceInfo.identifier,
+                new DoubleGreaterVerifier(0.0),
+                Optional::Yes,
+                CacheToleranceInfo.description
+            },
             {
                 KeyKernels,
                 new OrVerifier({ new StringListVerifier, new StringVerifier }),
@@ -88,6 +121,9 @@ documentation::Documentation SpiceRotation::Documentation() {
 SpiceRotation::SpiceRotation(const ghoul::Dictionary& dictionary)
     : _sourceFrame(SourceInfo)
     , _destinationFrame(DestinationInfo)
+    , _useCache(UseCacheInfo, false)
+    , _cacheTolerance(CacheToleranceInfo, 1e-9, 1e-12, 1e-2)
+    , _cache(_cacheTolerance)
 {
     documentation::testSpecificationAndThrow(
         Documentation(),
@@ -98,6 +134,15 @@ SpiceRotation::SpiceRotation(const ghoul::Dictionary& dictionary)
     _sourceFrame = dictionary.value<std::string>(SourceInfo.identifier);
     _destinationFrame = dictionary.value<std::string>(DestinationInfo.identifier);
 
+    if (dictionary.hasKey(UseCacheInfo.identifier)) {
+        _useCache = dictionary.value<bool>(UseCacheInfo.identifier);
+    }
+
+    if (dictionary.hasKey(CacheToleranceInfo.identifier)) {
+        _cacheTolerance = dictionary.value<double>(CacheToleranceInfo.identifier);
+        _cache.setTolerance(_cacheTolerance);
+    }
+
     if (dictionary.hasKeyAndValue<std::string>(KeyKernels)) {
         SpiceManager::ref().loadKernel(dictionary.value<std::string>(KeyKernels));
     }
@@ -115,12 +160,93 @@ SpiceRotation::SpiceRotation(const ghoul::Dictionary& dictionary)
 
     addProperty(_sourceFrame);
     addProperty(_destinationFrame);
+    addProperty(_useCache);
+    addProperty(_cacheTolerance);
 
-    _sourceFrame.onChange([this]() { requireUpdate(); });
-    _destinationFrame.onChange([this]() { requireUpdate(); });
+    _sourceFrame.onChange([this]() {
+        _cache.clear();
+        _hasStateTransform = true;
+        requireUpdate();
+    });
+    _destinationFrame.onChange([this]() {
+        _cache.clear();
+        _hasStateTransform = true;
+        requireUpdate();
+    });
+    _useCache.onChange([this]() { _cache.clear(); });
+    _cacheTolerance.onChange([this]() {
+        _cache.setTolerance(_cacheTolerance);
+        requireUpdate();
+    });
 }
 
 glm::dmat3 SpiceRotation::matrix(const UpdateData& data) const {
+    if (_useCache) {
+        using Cache = EphemerisCache<glm::dmat3>;
+        using Result = std::optional<Cache::Sample>;
+        const Cache::SampleFunction sample = [this](double t) -> Result {
+            const SpiceManager& spice = SpiceManager::ref();
+            Cache::Sample s;
+            if (_hasStateTransform) {
+                try {
+                    const SpiceManager::TransformMatrix m = spice.stateTransformMatrix(
+                        _sourceFrame,
+                        _destinationFrame,
+                        t
+                    );
+
+                    // The state transformation is a row-major 6x6 matrix whose upper
+                    // left block is the rotation and whose lower left block is its time
+                    // derivative
+                    for (glm::length_t r = 0; r < 3; ++r) {
+                        for (glm::length_t c = 0; c < 3; ++c) {
+                            s.value[c][r] = m[r * 6 + c];
+                            s.derivative[c][r] = m[(r + 3) * 6 + c];
+                        }
+                    }
+                    return s;
+                }
+                catch (const SpiceManager::SpiceException&) {
+                    // Either the time is not covered or the frames do not provide
+                    // angular velocities, which is tested below
+                }
+            }
+
+            try {
+                s.value = spice.positionTransformMatrix(
+                    _sourceFrame,
+                    _destinationFrame,
+                    t
+                );
+                // The rotation is available where the state transformation is not, so
+                // the state transformation does not need to be tried again
+                _hasStateTransform = false;
+
+                const glm::dmat3 before = spice.positionTransformMatrix(
+                    _sourceFrame,
+                    _destinationFrame,
+                    t - DerivativeTimeStep
+                );
+                const glm::dmat3 after = spice.positionTransformMatrix(
+                    _sourceFrame,
+                    _destinationFrame,
+                    t + DerivativeTimeStep
+                );
+                s.derivative = (after - before) / (2.0 * DerivativeTimeStep);
+                return s;
+            }
+            catch (const SpiceManager::SpiceException&) {
+                // Leave the estimation of uncovered times to the exact computation
+                return std::nullopt;
+            }
+        };
+
+        std::optional<glm::dmat3> m = _cache.value(data.time.j2000Seconds(), sample);
+        if (m) {
+            return *m;
+        }
+    }
+
     return SpiceManager::ref().positionTransformMatrix(
         _sourceFrame,
         _destinationFrame,
@@ -27,7 +27,12 @@
 
 #include <openspace/scene/rotation.h>
 
+#include <modules/space/util/ephemeriscache.h>
+
 #include <openspace/properties/stringproperty.h>
+#include <openspace/properties/scalar/boolproperty.h>
+#include <openspace/properties/scalar/doubleproperty.h>
+#include <atomic>
 
 namespace openspace {
 
@@ -45,6 +50,13 @@ public:
 private:
     properties::StringProperty _sourceFrame;
     properties::StringProperty _destinationFrame;
+    properties::BoolProperty _useCache;
+    properties::DoubleProperty _cacheTolerance;
+
+    mutable EphemerisCache<glm::dmat3> _cache;
+    /// Frames without angular velocities, for example from C-kernels, do not provide
+    /// state transformations, in which case the cache is sampled by finite differences
+    mutable std::atomic_bool _hasStateTransform = { true };
 };
 
 } // namespace openspace
@@ -29,15 +29,19 @@
 #include <modules/space/rendering/renderablerings.h>
 #include <modules/space/rendering/renderablestars.h>
 #include <modules/space/rendering/simplespheregeometry.h>
+#include <modules/space/tasks/ephemerisexporttask.h>
+#include <modules/space/translation/ephemeristranslation.h>
 #include <modules/space/translation/keplertranslation.h>
 #include <modules/space/translation/spicetranslation.h>
 #include <modules/space/translation/tletranslation.h>
+#include <modules/space/rotation/ephemerisrotation.h>
 #include <modules/space/rotation/spicerotation.h>
 #include <openspace/documentation/documentation.h>
 #include <openspace/rendering/renderable.h>
 #include <openspace/rendering/screenspacerenderable.h>
 #include <openspace/util/factorymanager.h>
 #include <openspace/util/spicemanager.h>
+#include <openspace/util/task.h>
 #include <ghoul/misc/assert.h>
 #include <ghoul/misc/templatefactory.h>
 
@@ -83,6 +87,7 @@ void SpaceModule::internalInitialize(const ghoul::Dictionary&) {
     auto fTranslation = FactoryManager::ref().factory<Translation>();
     ghoul_assert(fTranslation, "Ephemeris factory was not created");
 
+    fTranslation->registerClass<EphemerisTranslation>("EphemerisTranslation");
     fTranslation->registerClass<KeplerTranslation>("KeplerTranslation");
     fTranslation->registerClass<SpiceTranslation>("SpiceTranslation");
     fTranslation->registerClass<TLETranslation>("TLETranslation");
@@ -90,8 +95,13 @@ void SpaceModule::internalInitialize(const ghoul::Dictionary&) {
     auto fRotation = FactoryManager::ref().factory<Rotation>();
     ghoul_assert(fRotation, "Rotation factory was not created");
 
+    fRotation->registerClass<EphemerisRotation>("EphemerisRotation");
     fRotation->registerClass<SpiceRotation>("SpiceRotation");
 
+    auto fTask = FactoryManager::ref().factory<Task>();
+    ghoul_assert(fTask, "No task factory existed");
+    fTask->registerClass<EphemerisExportTask>("EphemerisExportTask");
+
     auto fGeometry = FactoryManager::ref().factory<planetgeometry::PlanetGeometry>();
     ghoul_assert(fGeometry, "Planet geometry factory was not created");
     fGeometry->registerClass<planetgeometry::SimpleSphereGeometry>("SimpleSphere");
@@ -107,12 +117,15 @@ std::vector<documentation::Documentation> SpaceModule::documentations() const {
         RenderablePlanet::Documentation(),
         RenderableRings::Documentation(),
         RenderableStars::Documentation(),
+        EphemerisRotation::Documentation(),
         SpiceRotation::Documentation(),
+        EphemerisTranslation::Documentation(),
         SpiceTranslation::Documentation(),
         KeplerTranslation::Documentation(),
         TLETranslation::Documentation(),
         planetgeometry::PlanetGeometry::Documentation(),
-        planetgeometry::SimpleSphereGeometry::Documentation()
+        planetgeometry::SimpleSphereGeometry::Documentation(),
+        EphemerisExportTask::documentation()
     };
 }
 
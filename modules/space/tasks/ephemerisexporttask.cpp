@@ -0,0 +1,288 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2018                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/space/tasks/ephemerisexporttask.h>
+
+#include <modules/space/util/ephemerisfile.h>
+#include <openspace/documentation/verifier.h>
+#include <openspace/scene/rotation.h>
+#include <openspace/scene/translation.h>
+#include <openspace/util/spicemanager.h>
+#include <openspace/util/time.h>
+#include <openspace/util/updatestructures.h>
+#include <ghoul/fmt.h>
+#include <ghoul/filesystem/filesystem.h>
+#include <ghoul/logging/logmanager.h>
+#include <cstring>
+
+namespace {
+    constexpr const char* _loggerCat = "EphemerisExportTask";
+
+    constexpr const char* KeyOutput = "Output";
+    constexpr const char* KeyStartTime = "StartTime";
+    constexpr const char* KeyEndTime = "EndTime";
+    constexpr const char* KeyKernels = "Kernels";
+    constexpr const char* KeyTranslations = "Translations";
+    constexpr const char* KeyRotations = "Rotations";
+    constexpr const char* KeySegmentLength = "SegmentLength";
+    constexpr const char* KeyCoefficients = "Coefficients";
+    constexpr const char* KeyPositionTolerance = "PositionTolerance";
+    constexpr const char* KeyRotationTolerance = "RotationTolerance";
+
+    // Segments are not subdivided below this length even if the tolerance is not met
+    constexpr const double MinimumSegmentLength = 1.0;
+
+    openspace::ephemeris::Series fit(const std::string& name,
+                                     openspace::ephemeris::SeriesType type,
+                                     uint32_t nComponents, double start, double end,
+                                     double segmentLength, uint32_t nCoefficients,
+                                     double tolerance,
+                                     const std::function<void(double, double*)>& f)
+    {
+        using namespace openspace::ephemeris;
+        double error = 0.0;
+        Series series = fitSeries(
+            name,
+            type,
+            nComponents,
+            start,
+            end,
+            segmentLength,
+            nCoefficients,
+            f,
+            &error,
+            tolerance,
+            MinimumSegmentLength
+        );
+
+        if (error > tolerance) {
+            LWARNING(fmt::format(
+                "Could not fit '{}' within the tolerance {}, error is {}",
+                name, tolerance, error
+            ));
+        }
+        LINFO(fmt::format(
+            "Exported '{}' with {} segments, maximum error {}",
+            name, series.nSegments(), error
+        ));
+        return series;
+    }
+} // namespace
+
+namespace openspace {
+
+EphemerisExportTask::EphemerisExportTask(const ghoul::Dictionary& dictionary) {
+    documentation::testSpecificationAndThrow(
+        documentation(),
+        dictionary,
+        "EphemerisExportTask"
+    );
+
+    _outputPath = absPath(dictionary.value<std::string>(KeyOutput));
+    _startTime = dictionary.value<std::string>(KeyStartTime);
+    _endTime = dictionary.value<std::string>(KeyEndTime);
+
+    if (dictionary.hasKey(KeyKernels)) {
+        const ghoul::Dictionary kernels = dictionary.value<ghoul::Dictionary>(KeyKernels);
+        for (size_t i = 1; i <= kernels.size(); ++i) {
+            _kernels.push_back(absPath(kernels.value<std::string>(std::to_string(i))));
+        }
+    }
+    if (dictionary.hasKey(KeyTranslations)) {
+        _translations = dictionary.value<ghoul::Dictionary>(KeyTranslations);
+    }
+    if (dictionary.hasKey(KeyRotations)) {
+        _rotations = dictionary.value<ghoul::Dictionary>(KeyRotations);
+    }
+    if (dictionary.hasKey(KeySegmentLength)) {
+        _segmentLength = dictionary.value<double>(KeySegmentLength);
+    }
+    if (dictionary.hasKey(KeyCoefficients)) {
+        _nCoefficients = static_cast<int>(dictionary.value<double>(KeyCoefficients));
+    }
+    if (dictionary.hasKey(KeyPositionTolerance)) {
+        _positionTolerance = dictionary.value<double>(KeyPositionTolerance);
+    }
+    if (dictionary.hasKey(KeyRotationTolerance)) {
+        _rotationTolerance = dictionary.value<double>(KeyRotationTolerance);
+    }
+}
+
+std::string EphemerisExportTask::description() {
+    return fmt::format(
+        "Export {} translations and {} rotations between {} and {} to the ephemeris "
+        "file {}",
+        _translations.size(), _rotations.size(), _startTime, _endTime, _outputPath
+    );
+}
+
+void EphemerisExportTask::perform(const Task::ProgressCallback& progressCallback) {
+    for (const std::string& kernel : _kernels) {
+        SpiceManager::ref().loadKernel(kernel);
+    }
+    const double start = SpiceManager::ref().ephemerisTimeFromDate(_startTime);
+    const double end = SpiceManager::ref().ephemerisTimeFromDate(_endTime);
+    if (end <= start) {
+        LERROR(fmt::format(
+            "End time {} is not after start time {}", _endTime, _startTime
+        ));
+        return;
+    }
+
+    const size_t nTotal = _translations.size() + _rotations.size();
+    std::vector<ephemeris::Series> series;
+    series.reserve(nTotal);
+
+    for (const std::string& name : _translations.keys()) {
+        std::unique_ptr<Translation> translation = Translation::createFromDictionary(
+            _translations.value<ghoul::Dictionary>(name)
+        );
+        translation->initialize();
+
+        series.push_back(fit(
+            name,
+            ephemeris::SeriesType::Translation,
+            3,
+            start,
+            end,
+            _segmentLength,
+            static_cast<uint32_t>(_nCoefficients),
+            _positionTolerance,
+            [&translation](double time, double* result) {
+                const glm::dvec3 p = translation->position({ {}, time, 0.0, false });
+                std::memcpy(result, glm::value_ptr(p), 3 * sizeof(double));
+            }
+        ));
+        progressCallback(static_cast<float>(series.size()) / nTotal);
+    }
+
+    for (const std::string& name : _rotations.keys()) {
+        std::unique_ptr<Rotation> rotation = Rotation::createFromDictionary(
+            _rotations.value<ghoul::Dictionary>(name)
+        );
+        rotation->initialize();
+
+        series.push_back(fit(
+            name,
+            ephemeris::SeriesType::Rotation,
+            9,
+            start,
+            end,
+            _segmentLength,
+            static_cast<uint32_t>(_nCoefficients),
+            _rotationTolerance,
+            [&rotation](double time, double* result) {
+                const glm::dmat3 m = rotation->matrix({ {}, time, 0.0, false });
+                std::memcpy(result, glm::value_ptr(m), 9 * sizeof(double));
+            }
+        ));
+        progressCallback(static_cast<float>(series.size()) / nTotal);
+    }
+
+    ephemeris::saveEphemerisFile(series, _outputPath);
+    progressCallback(1.f);
+}
+
+documentation::Documentation EphemerisExportTask::documentation() {
+    using namespace documentation;
+    return {
+        "EphemerisExportTask",
+        "space_ephemeris_export_task",
+        {
+            {
+                "Type",
+                new StringEqualVerifier("EphemerisExportTask"),
+                Optional::No,
+                "The type of this task"
+            },
+            {
+                KeyOutput,
+                new StringAnnotationVerifier("A valid filepath"),
+                Optional::No,
+                "The binary ephemeris file that is written"
+            },
+            {
+                KeyStartTime,
+                new StringAnnotationVerifier("A time string that SPICE can parse"),
+                Optional::No,
+                "The beginning of the exported time range"
+            },
+            {
+                KeyEndTime,
+                new StringAnnotationVerifier("A time string that SPICE can parse"),
+                Optional::No,
+                "The end of the exported time range"
+            },
+            {
+                KeyKernels,
+                new StringListVerifier,
+                Optional::Yes,
+                "The kernels that are loaded before the export. These have to include a "
+                "leap seconds kernel to convert the start and end times"
+            },
+            {
+                KeyTranslations,
+                new TableVerifier,
+                Optional::Yes,
+                "A table mapping the names under which the translations are exported to "
+                "the dictionaries describing the translations, for example a "
+                "SpiceTranslation"
+            },
+            {
+                KeyRotations,
+                new TableVerifier,
+                Optional::Yes,
+                "A table mapping the names under which the rotations are exported to the "
+                "dictionaries describing the rotations, for example a SpiceRotation"
+            },
+            {
+                KeySegmentLength,
+                new DoubleGreaterVerifier(0.0),
+                Optional::Yes,
+                "The initial length of each Chebyshev segment in seconds. Defaults to "
+                "one day"
+            },
+            {
+                KeyCoefficients,
+                new DoubleInRangeVerifier(2.0, 32.0),
+                Optional::Yes,
+                "The number of Chebyshev coefficients per segment. Defaults to 12"
+            },
+            {
+                KeyPositionTolerance,
+                new DoubleGreaterVerifier(0.0),
+                Optional::Yes,
+                "The maximum error of each position component in meters. Defaults to 1"
+            },
+            {
+                KeyRotationTolerance,
+                new DoubleGreaterVerifier(0.0),
+                Optional::Yes,
+                "The maximum error of each rotation matrix element. Defaults to 1e-9"
+            }
+        }
+    };
+}
+
+} // namespace openspace
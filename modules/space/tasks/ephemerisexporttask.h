@@ -0,0 +1,71 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2018                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_SPACE___EPHEMERISEXPORTTASK___H__
+#define __OPENSPACE_MODULE_SPACE___EPHEMERISEXPORTTASK___H__
+
+#include <openspace/util/task.h>
+
+#include <ghoul/misc/dictionary.h>
+#include <string>
+#include <vector>
+
+namespace openspace {
+
+namespace documentation { struct Documentation; }
+
+/**
+ * Samples a list of translations and rotations, for example SpiceTranslation and
+ * SpiceRotation, over a time range and stores them as Chebyshev segments in a binary
+ * ephemeris file. The file can be used at runtime by the EphemerisTranslation and
+ * EphemerisRotation without loading any SPICE kernels. Segments whose fit is not within
+ * the requested tolerance are bisected until it is.
+ */
+class EphemerisExportTask : public Task {
+public:
+    EphemerisExportTask(const ghoul::Dictionary& dictionary);
+
+    std::string description() override;
+    void perform(const Task::ProgressCallback& progressCallback) override;
+
+    static documentation::Documentation documentation();
+
+private:
+    std::string _outputPath;
+    std::string _startTime;
+    std::string _endTime;
+    std::vector<std::string> _kernels;
+
+    ghoul::Dictionary _translations;
+    ghoul::Dictionary _rotations;
+
+    double _segmentLength = 24.0 * 60.0 * 60.0;
+    int _nCoefficients = 12;
+    double _positionTolerance = 1.0;
+    double _rotationTolerance = 1e-9;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_MODULE_SPACE___EPHEMERISEXPORTTASK___H__
@@ -0,0 +1,91 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2018                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/space/translation/ephemeristranslation.h>
+
+#include <openspace/documentation/documentation.h>
+#include <openspace/documentation/verifier.h>
+#include <openspace/util/time.h>
+#include <openspace/util/updatestructures.h>
+#include <ghoul/filesystem/filesystem.h>
+
+namespace {
+    constexpr const char* KeyFile = "File";
+    constexpr const char* KeyName = "Name";
+} // namespace
+
+namespace openspace {
+
+documentation::Documentation EphemerisTranslation::Documentation() {
+    using namespace openspace::documentation;
+    return {
+        "Ephemeris Translation",
+        "space_translation_ephemeris",
+        {
+            {
+                "Type",
+                new StringEqualVerifier("EphemerisTranslation"),
+                Optional::No
+            },
+            {
+                KeyFile,
+                new StringVerifier,
+                Optional::No,
+                "The binary ephemeris file that was created by the EphemerisExportTask"
+            },
+            {
+                KeyName,
+                new StringVerifier,
+                Optional::No,
+                "The name under which the translation was exported into the file"
+            }
+        }
+    };
+}
+
+EphemerisTranslation::EphemerisTranslation(const ghoul::Dictionary& dictionary) {
+    documentation::testSpecificationAndThrow(
+        Documentation(),
+        dictionary,
+        "EphemerisTranslation"
+    );
+
+    _filePath = absPath(dictionary.value<std::string>(KeyFile));
+    _name = dictionary.value<std::string>(KeyName);
+
+    _file = std::make_unique<ephemeris::EphemerisFile>(_filePath);
+    _segments = _file->series(_name, ephemeris::SeriesType::Translation);
+}
+
+glm::dvec3 EphemerisTranslation::position(const UpdateData& data) const {
+    glm::dvec3 position;
+    _segments.evaluate(data.time.j2000Seconds(), glm::value_ptr(position));
+    return position;
+}
+
+bool EphemerisTranslation::supportsConcurrentUpdate() const {
+    return true;
+}
+
+} // namespace openspace
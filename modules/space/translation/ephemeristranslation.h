@@ -0,0 +1,64 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2018                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_SPACE___EPHEMERISTRANSLATION___H__
+#define __OPENSPACE_MODULE_SPACE___EPHEMERISTRANSLATION___H__
+
+#include <openspace/scene/translation.h>
+
+#include <modules/space/util/ephemerisfile.h>
+#include <memory>
+#include <string>
+
+namespace openspace {
+
+namespace documentation { struct Documentation; }
+
+/**
+ * A translation that evaluates a position from the Chebyshev coefficients stored in a
+ * binary ephemeris file, which is created by the EphemerisExportTask. The file is memory
+ * mapped and the evaluation does not use SPICE or take any lock, so neither the kernels
+ * nor the SpiceManager are required at runtime. Times outside of the exported range are
+ * clamped to the first or last exported position.
+ */
+class EphemerisTranslation : public Translation {
+public:
+    EphemerisTranslation(const ghoul::Dictionary& dictionary);
+
+    glm::dvec3 position(const UpdateData& data) const override;
+    bool supportsConcurrentUpdate() const override;
+
+    static documentation::Documentation Documentation();
+
+private:
+    std::string _filePath;
+    std::string _name;
+
+    std::unique_ptr<ephemeris::EphemerisFile> _file;
+    ephemeris::Segments _segments;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_MODULE_SPACE___EPHEMERISTRANSLATION___H__
@@ -402,4 +402,8 @@ void KeplerTranslation::setKeplerElements(double eccentricity, double semiMajorA
     computeOrbitPlane();
 }
 
+bool KeplerTranslation::supportsConcurrentUpdate() const {
+    return true;
+}
+
 } // namespace openspace
@@ -68,6 +68,10 @@ public:
     */
     glm::dvec3 position(const UpdateData& data) const override;
 
+    /// The position only depends on the Keplerian elements, so it can be updated
+    /// concurrently with other scene graph nodes
+    bool supportsConcurrentUpdate() const override;
+
     /**
      * Method returning the openspace::Documentation that describes the ghoul::Dictinoary
      * that can be passed to the constructor.
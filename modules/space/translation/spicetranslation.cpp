@@ -60,6 +60,22 @@ namespace {
         "This is the SPICE NAIF name for the reference frame in which the position "
         "should be retrieved. The default value is GALACTIC."
     };
+
+    constexpr openspace::properties::Property::PropertyInfo UseCacheInfo = {
+        "UseCache",
+        "Use Ephemeris Cache",
+        "If this value is enabled, the positions are sampled on a time grid that is "
+        "sized to the dynamics of the body and are interpolated between the samples, "
+        "instead of being computed by SPICE for every frame. Times for which the "
+        "cache cannot be sampled are computed exactly."
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo CacheToleranceInfo = {
+        "CacheTolerance",
+        "Cache Tolerance",
+        "The maximum error in meters that the interpolation of the ephemeris cache is "
+        "allowed to introduce. Smaller values result in a finer time grid."
+    };
 } // namespace
 
 namespace openspace {
@@ -98,6 +114,18 @@ documentation::Documentation SpiceTranslation::Documentation() {
                 Optional::Yes,
                 FrameInfo.description
             },
+            {
+                UseCacheInfo.identifier,
+                new BoolVerifier,
+                Optional::Yes,
+                UseCacheInfo.description
+            },
+            {
+                CacheToleranceInfo.identifier,
+                new DoubleGreaterVerifier(0.0),
+                Optional::Yes,
+                CacheToleranceInfo.description
+            },
             {
                 KeyKernels,
                 new OrVerifier({ new StringListVerifier, new StringVerifier }),
@@ -114,6 +142,9 @@ SpiceTranslation::SpiceTranslation(const ghoul::Dictionary& dictionary)
     : _target(TargetInfo)
     , _observer(ObserverInfo)
     , _frame(FrameInfo, DefaultReferenceFrame)
+    , _useCache(UseCacheInfo, false)
+    , _cacheTolerance(CacheToleranceInfo, 1.0, 1e-3, 1e6)
+    , _cache(_cacheTolerance / 1000.0)
 {
     documentation::testSpecificationAndThrow(
         Documentation(),
@@ -128,6 +159,15 @@ SpiceTranslation::SpiceTranslation(const ghoul::Dictionary& dictionary)
         _frame = dictionary.value<std::string>(FrameInfo.identifier);
     }
 
+    if (dictionary.hasKey(UseCacheInfo.identifier)) {
+        _useCache = dictionary.value<bool>(UseCacheInfo.identifier);
+    }
+
+    if (dictionary.hasKey(CacheToleranceInfo.identifier)) {
+        _cacheTolerance = dictionary.value<double>(CacheToleranceInfo.identifier);
+        _cache.setTolerance(_cacheTolerance / 1000.0);
+    }
+
     auto loadKernel = [](const std::string& kernel) {
         if (!FileSys.fileExists(kernel)) {
             throw SpiceManager::SpiceException("Kernel '" + kernel + "' does not exist");
@@ -157,6 +197,7 @@ SpiceTranslation::SpiceTranslation(const ghoul::Dictionary& dictionary)
     }
 
     auto update = [this](){
+        _cache.clear();
         requireUpdate();
         notifyObservers();
     };
@@ -169,9 +210,46 @@ SpiceTranslation::SpiceTranslation(const ghoul::Dictionary& dictionary)
 
     _frame.onChange(update);
     addProperty(_frame);
+
+    _useCache.onChange([this]() { _cache.clear(); });
+    addProperty(_useCache);
+
+    _cacheTolerance.onChange([this]() {
+        _cache.setTolerance(_cacheTolerance / 1000.0);
+        requireUpdate();
+    });
+    addProperty(_cacheTolerance);
 }
 
 glm::dvec3 SpiceTranslation::position(const UpdateData& data) const {
+    if (_useCache) {
+        // The cache only holds samples where SPICE has actual coverage; the estimated
+        // positions outside of the coverage are always computed exactly
+        using Cache = EphemerisCache<glm::dvec3>;
+        using Result = std::optional<Cache::Sample>;
+        const Cache::SampleFunction sample = [this](double t) -> Result {
+            SpiceManager& spice = SpiceManager::ref();
+            if (!spice.hasSpkCoverage(_target, t) ||
+                !spice.hasSpkCoverage(_observer, t))
+            {
+                return std::nullopt;
+            }
+            SpiceManager::TargetStateResult state = spice.targetState(
+                _target,
+                _observer,
+                _frame,
+                {},
+                t
+            );
+            return Cache::Sample{ state.position, state.velocity };
+        };
+
+        std::optional<glm::dvec3> p = _cache.value(data.time.j2000Seconds(), sample);
+        if (p) {
+            return *p * glm::pow(10.0, 3.0);
+        }
+    }
+
     double lightTime = 0.0;
     return SpiceManager::ref().targetPosition(
         _target,
@@ -183,4 +261,21 @@ glm::dvec3 SpiceTranslation::position(const UpdateData& data) const {
     ) * glm::pow(10.0, 3.0);
 }
 
+void SpiceTranslation::positions(const double* times, size_t nTimes,
+                                 glm::dvec3* positions) const
+{
+    SpiceManager::ref().targetPositions(
+        _target,
+        _observer,
+        _frame,
+        {},
+        times,
+        nTimes,
+        positions
+    );
+    for (size_t i = 0; i < nTimes; ++i) {
+        positions[i] *= glm::pow(10.0, 3.0);
+    }
+}
+
 } // namespace openspace
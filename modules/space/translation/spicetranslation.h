@@ -27,7 +27,11 @@
 
 #include <openspace/scene/translation.h>
 
+#include <modules/space/util/ephemeriscache.h>
+
 #include <openspace/properties/stringproperty.h>
+#include <openspace/properties/scalar/boolproperty.h>
+#include <openspace/properties/scalar/doubleproperty.h>
 
 namespace openspace {
 
@@ -36,6 +40,8 @@ public:
     SpiceTranslation(const ghoul::Dictionary& dictionary);
 
     glm::dvec3 position(const UpdateData& data) const override;
+    void positions(const double* times, size_t nTimes,
+        glm::dvec3* positions) const override;
 
     static documentation::Documentation Documentation();
 
@@ -43,6 +49,11 @@ private:
     properties::StringProperty _target;
     properties::StringProperty _observer;
     properties::StringProperty _frame;
+    properties::BoolProperty _useCache;
+    properties::DoubleProperty _cacheTolerance;
+
+    // Positions are cached in kilometers, the unit in which SPICE returns them
+    mutable EphemerisCache<glm::dvec3> _cache;
 
     glm::dvec3 _position;
 };
@@ -0,0 +1,130 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2018                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_SPACE___EPHEMERISCACHE___H__
+#define __OPENSPACE_MODULE_SPACE___EPHEMERISCACHE___H__
+
+#include <ghoul/glm.h>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace openspace {
+
+/**
+ * This class caches a time-dependent quantity (a position or a rotation matrix) on a
+ * regular time grid and serves queries by cubic Hermite interpolation between the two
+ * grid samples that enclose the queried time. Each sample consists of the exact value and
+ * its time derivative, which are provided by a user-supplied sample function.
+ *
+ * The grid step is sized to the dynamics of the sampled quantity: the first sample is
+ * used to estimate the step for which the interpolation error stays below the tolerance
+ * and each newly sampled interval is validated against an exact value at its midpoint.
+ * If the validation fails, the step is halved and the cache is rebuilt.
+ *
+ * Queries for which no validated interval exists are a miss; in that case the interval
+ * is sampled and the query is served from it. If the sample function does not cover the
+ * entire interval, for example at the edge of a SPICE kernel, the interval is clamped
+ * to the covered part that contains the queried time. Only for times outside of the
+ * covered part of an interval, or if the interval fails the validation at the minimum
+ * step size, the caller is responsible for computing the exact value. All methods are
+ * thread-safe.
+ */
+template <typename T>
+class EphemerisCache {
+public:
+    struct Sample {
+        T value;
+        T derivative;
+    };
+
+    /// The function that computes exact samples; returns std::nullopt if the quantity
+    /// cannot be sampled at the provided time, for example due to missing coverage
+    using SampleFunction = std::function<std::optional<Sample>(double)>;
+
+    /**
+     * Creates an empty cache with the maximum interpolation error \p tolerance, which is
+     * measured in the units of the cached quantity.
+     */
+    explicit EphemerisCache(double tolerance);
+
+    /// Changes the maximum interpolation error and clears the cache
+    void setTolerance(double tolerance);
+    double tolerance() const;
+
+    /// Removes all cached samples and resets the grid step
+    void clear();
+
+    /**
+     * Returns the interpolated value at \p time. If \p time is not covered by the cache
+     * yet, \p sample is used to fill the cache around \p time first. Returns
+     * std::nullopt if no valid interval could be sampled around \p time.
+     */
+    std::optional<T> value(double time, const SampleFunction& sample);
+
+    /// Returns the current grid step in seconds or 0 if nothing has been sampled yet
+    double stepSize() const;
+
+    size_t nHits() const;
+    size_t nMisses() const;
+
+private:
+    struct Interval {
+        // The times of the start and end samples. These are the grid points, unless the
+        // interval was clamped to the coverage of the sample function
+        double startTime;
+        double endTime;
+        Sample start;
+        Sample end;
+    };
+
+    // Samples and validates the interval with the provided index, which contains the
+    // time, and adds it to the cache if the validation passes. Returns false if the
+    // validation failed and the step size was reduced, in which case the caller has to
+    // retry. Requires _mutex
+    bool sampleInterval(int64_t index, double time, const SampleFunction& sample);
+
+    // Interpolates the interval at the absolute time t
+    T interpolate(const Interval& interval, double t) const;
+
+    double _tolerance;
+    double _step = 0.0;
+    std::unordered_map<int64_t, Interval> _intervals;
+    // Intervals that failed the validation at the minimum step size
+    std::unordered_set<int64_t> _rejectedIntervals;
+
+    size_t _nHits = 0;
+    size_t _nMisses = 0;
+
+    mutable std::mutex _mutex;
+};
+
+} // namespace openspace
+
+#include "ephemeriscache.inl"
+
+#endif // __OPENSPACE_MODULE_SPACE___EPHEMERISCACHE___H__
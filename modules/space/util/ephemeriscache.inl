@@ -0,0 +1,276 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2018                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+#include <utility>
+
+namespace openspace {
+
+namespace ephemeriscache {
+    // The smallest and largest grid step that will be used
+    constexpr const double MinimumStep = 1.0;
+    constexpr const double MaximumStep = 30.0 * 24.0 * 60.0 * 60.0;
+
+    // Number of intervals after which the cache is flushed to bound its memory usage
+    constexpr const size_t MaximumIntervals = 8192;
+
+    // Returns the time closest to the invalid time that can still be sampled, up to the
+    // minimum step, together with its sample. The time valid has to be sampleable
+    template <typename Sample, typename SampleFunction>
+    std::pair<double, Sample> coverageBoundary(double valid, Sample validSample,
+                                               double invalid,
+                                               const SampleFunction& sample)
+    {
+        while (std::abs(invalid - valid) > MinimumStep) {
+            const double mid = (valid + invalid) / 2.0;
+            std::optional<Sample> s = sample(mid);
+            if (s) {
+                valid = mid;
+                validSample = std::move(*s);
+            }
+            else {
+                invalid = mid;
+            }
+        }
+        return { valid, std::move(validSample) };
+    }
+
+    inline double norm(const glm::dvec3& v) {
+        return glm::length(v);
+    }
+
+    inline double norm(const glm::dmat3& m) {
+        return std::max({ glm::length(m[0]), glm::length(m[1]), glm::length(m[2]) });
+    }
+
+    inline double difference(const glm::dvec3& a, const glm::dvec3& b) {
+        return glm::length(a - b);
+    }
+
+    inline double difference(const glm::dmat3& a, const glm::dmat3& b) {
+        double result = 0.0;
+        for (glm::length_t c = 0; c < 3; ++c) {
+            for (glm::length_t r = 0; r < 3; ++r) {
+                result = std::max(result, std::abs(a[c][r] - b[c][r]));
+            }
+        }
+        return result;
+    }
+
+    // The error of cubic Hermite interpolation over a step h is bounded by
+    // h^4 / 384 * max|f''''|. Treating the quantity as a rotation with the radius |f| and
+    // the angular rate |f'| / |f| gives |f''''| = |f| w^4, from which we get a step that
+    // stays within the tolerance for smooth motion
+    template <typename T>
+    double initialStep(const T& value, const T& derivative, double tolerance) {
+        const double scale = norm(value);
+        const double rate = norm(derivative) / std::max(scale, 1e-12);
+        const double variation = scale * std::pow(rate, 4.0);
+        if (variation <= 0.0) {
+            return MaximumStep;
+        }
+        const double step = std::pow(384.0 * tolerance / variation, 0.25);
+        return std::clamp(step, MinimumStep, MaximumStep);
+    }
+} // namespace ephemeriscache
+
+template <typename T>
+EphemerisCache<T>::EphemerisCache(double tolerance)
+    : _tolerance(tolerance)
+{}
+
+template <typename T>
+void EphemerisCache<T>::setTolerance(double tolerance) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _tolerance = tolerance;
+    _step = 0.0;
+    _intervals.clear();
+    _rejectedIntervals.clear();
+}
+
+template <typename T>
+double EphemerisCache<T>::tolerance() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _tolerance;
+}
+
+template <typename T>
+void EphemerisCache<T>::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _step = 0.0;
+    _intervals.clear();
+    _rejectedIntervals.clear();
+}
+
+template <typename T>
+std::optional<T> EphemerisCache<T>::value(double time, const SampleFunction& sample) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_step > 0.0) {
+        const int64_t index = static_cast<int64_t>(std::floor(time / _step));
+        const auto it = _intervals.find(index);
+        if (it != _intervals.end()) {
+            const Interval& interval = it->second;
+            if (time < interval.startTime || time > interval.endTime) {
+                // The interval was clamped to the coverage of the sample function and
+                // sampling it again would not extend it
+                ++_nMisses;
+                return std::nullopt;
+            }
+            ++_nHits;
+            return interpolate(interval, time);
+        }
+    }
+    ++_nMisses;
+
+    if (_step == 0.0) {
+        std::optional<Sample> s = sample(time);
+        if (!s) {
+            return std::nullopt;
+        }
+        _step = ephemeriscache::initialStep(s->value, s->derivative, _tolerance);
+    }
+
+    while (true) {
+        const int64_t index = static_cast<int64_t>(std::floor(time / _step));
+        if (_rejectedIntervals.find(index) != _rejectedIntervals.end()) {
+            return std::nullopt;
+        }
+        if (sampleInterval(index, time, sample)) {
+            // The interval was just sampled at the cost of three exact samples, so the
+            // miss is served from it instead of making the caller compute a fourth
+            const auto it = _intervals.find(index);
+            if (it == _intervals.end()) {
+                return std::nullopt;
+            }
+            const Interval& interval = it->second;
+            if (time < interval.startTime || time > interval.endTime) {
+                return std::nullopt;
+            }
+            return interpolate(interval, time);
+        }
+    }
+}
+
+template <typename T>
+bool EphemerisCache<T>::sampleInterval(int64_t index, double time,
+                                       const SampleFunction& sample)
+{
+    double start = index * _step;
+    double end = start + _step;
+
+    std::optional<Sample> s0 = sample(start);
+    std::optional<Sample> s1 = sample(end);
+    if (!s0 || !s1) {
+        // The interval reaches beyond the coverage of the sample function, so it is
+        // clamped to the covered part around the queried time. Finding the edge of the
+        // coverage costs more samples than a regular interval, but it only has to be
+        // done once instead of for every query close to the edge
+        std::optional<Sample> s = sample(time);
+        if (!s) {
+            return true;
+        }
+        if (!s0) {
+            std::tie(start, s0) = ephemeriscache::coverageBoundary(
+                time, *s, start, sample
+            );
+        }
+        if (!s1) {
+            std::tie(end, s1) = ephemeriscache::coverageBoundary(time, *s, end, sample);
+        }
+        if (end - start < ephemeriscache::MinimumStep) {
+            // The covered part is too short to be worth caching
+            _rejectedIntervals.insert(index);
+            return true;
+        }
+    }
+    std::optional<Sample> mid = sample((start + end) / 2.0);
+    if (!mid) {
+        return true;
+    }
+
+    Interval interval = { start, end, *s0, *s1 };
+    const double error = ephemeriscache::difference(
+        interpolate(interval, (start + end) / 2.0),
+        mid->value
+    );
+    if (error > _tolerance) {
+        if (_step / 2.0 >= ephemeriscache::MinimumStep) {
+            // The dynamics are faster than estimated, so all existing intervals might be
+            // too coarse as well
+            _step /= 2.0;
+            _intervals.clear();
+            _rejectedIntervals.clear();
+            return false;
+        }
+        else {
+            _rejectedIntervals.insert(index);
+            return true;
+        }
+    }
+
+    if (_intervals.size() >= ephemeriscache::MaximumIntervals) {
+        _intervals.clear();
+    }
+    _intervals[index] = std::move(interval);
+    return true;
+}
+
+template <typename T>
+T EphemerisCache<T>::interpolate(const Interval& interval, double t) const {
+    const double length = interval.endTime - interval.startTime;
+    const double s = (t - interval.startTime) / length;
+    const double s2 = s * s;
+    const double s3 = s2 * s;
+
+    const double h00 = 2.0 * s3 - 3.0 * s2 + 1.0;
+    const double h10 = s3 - 2.0 * s2 + s;
+    const double h01 = -2.0 * s3 + 3.0 * s2;
+    const double h11 = s3 - s2;
+
+    return h00 * interval.start.value + (h10 * length) * interval.start.derivative +
+           h01 * interval.end.value + (h11 * length) * interval.end.derivative;
+}
+
+template <typename T>
+double EphemerisCache<T>::stepSize() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _step;
+}
+
+template <typename T>
+size_t EphemerisCache<T>::nHits() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _nHits;
+}
+
+template <typename T>
+size_t EphemerisCache<T>::nMisses() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _nMisses;
+}
+
+} // namespace openspace
@@ -0,0 +1,398 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2018                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/space/util/ephemerisfile.h>
+
+#include <ghoul/fmt.h>
+#include <ghoul/misc/assert.h>
+#include <ghoul/misc/exception.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <utility>
+
+namespace {
+    constexpr const char* _loggerCat = "EphemerisFile";
+
+    constexpr const std::array<char, 8> Magic = {
+        'O', 'S', 'E', 'P', 'H', 'E', 'M', '\0'
+    };
+    constexpr const uint32_t CurrentVersion = 2;
+    constexpr const size_t MaximumNameLength = 63;
+
+    constexpr const double Pi = 3.14159265358979323846;
+
+    struct Header {
+        std::array<char, 8> magic;
+        uint32_t version;
+        uint32_t nSeries;
+    };
+    static_assert(sizeof(Header) == 16, "The header must not contain padding");
+
+    struct Description {
+        uint32_t type;
+        uint32_t nComponents;
+        uint32_t nCoefficients;
+        uint32_t nSegments;
+        // Offset of the first segment boundary from the beginning of the file. The
+        // nSegments + 1 boundaries are directly followed by the coefficients
+        uint64_t offset;
+        // Null-terminated name of the series
+        std::array<char, MaximumNameLength + 1> name;
+    };
+    static_assert(sizeof(Description) == 88, "The description must not contain padding");
+
+    uint32_t nComponents(openspace::ephemeris::SeriesType type) {
+        return type == openspace::ephemeris::SeriesType::Translation ? 3 : 9;
+    }
+
+    // Evaluates the Chebyshev series with n coefficients c at tau in [-1, 1] using the
+    // Clenshaw recurrence
+    double chebyshev(const double* c, uint32_t n, double tau) {
+        double b1 = 0.0;
+        double b2 = 0.0;
+        for (uint32_t k = n - 1; k >= 1; --k) {
+            const double b0 = 2.0 * tau * b1 - b2 + c[k];
+            b2 = b1;
+            b1 = b0;
+        }
+        return tau * b1 - b2 + c[0];
+    }
+} // namespace
+
+namespace openspace::ephemeris {
+
+double Segments::start() const {
+    return boundaries[0];
+}
+
+double Segments::end() const {
+    return boundaries[nSegments];
+}
+
+void Segments::evaluate(double t, double* result) const {
+    // The first inner boundary that is after t is the end of its segment; times before
+    // the first or after the last segment are clamped to these
+    const double* inner = std::upper_bound(boundaries + 1, boundaries + nSegments, t);
+    const size_t segment = static_cast<size_t>(inner - (boundaries + 1));
+    const double segmentStart = boundaries[segment];
+    const double segmentLength = boundaries[segment + 1] - segmentStart;
+    const double tau = std::clamp(
+        2.0 * (t - segmentStart) / segmentLength - 1.0,
+        -1.0,
+        1.0
+    );
+
+    const double* c = coefficients + segment * nComponents * nCoefficients;
+    for (uint32_t i = 0; i < nComponents; ++i) {
+        result[i] = chebyshev(c + i * nCoefficients, nCoefficients, tau);
+    }
+}
+
+uint32_t Series::nSegments() const {
+    return boundaries.empty() ? 0 : static_cast<uint32_t>(boundaries.size() - 1);
+}
+
+Segments Series::segments() const {
+    Segments s;
+    s.nComponents = nComponents;
+    s.nCoefficients = nCoefficients;
+    s.nSegments = nSegments();
+    s.boundaries = boundaries.data();
+    s.coefficients = coefficients.data();
+    return s;
+}
+
+Series fitSeries(std::string name, SeriesType type, uint32_t nComponents,
+                 double start, double end, double segmentLength, uint32_t nCoefficients,
+                 const std::function<void(double, double*)>& f, double* maximumError,
+                 double tolerance, double minimumSegmentLength)
+{
+    ghoul_assert(end > start, "The time range must not be empty");
+    ghoul_assert(segmentLength > 0.0, "Segment length must be positive");
+    ghoul_assert(nCoefficients > 0, "At least one coefficient is required");
+
+    Series series;
+    series.name = std::move(name);
+    series.type = type;
+    series.nComponents = nComponents;
+    series.nCoefficients = nCoefficients;
+
+    const uint32_t nSegments = std::max(
+        1u,
+        static_cast<uint32_t>(std::ceil((end - start) / segmentLength))
+    );
+    series.boundaries.reserve(nSegments + 1);
+    series.coefficients.reserve(
+        static_cast<size_t>(nSegments) * nComponents * nCoefficients
+    );
+    series.boundaries.push_back(start);
+
+    const bool measureError = maximumError ||
+                              tolerance < std::numeric_limits<double>::infinity();
+
+    // The values of all components at the Chebyshev nodes of the current segment
+    std::vector<double> values(static_cast<size_t>(nCoefficients) * nComponents);
+    std::vector<double> value(nComponents);
+    std::vector<double> c(static_cast<size_t>(nComponents) * nCoefficients);
+    double error = 0.0;
+
+    // Fits the segment [segmentStart, segmentEnd] into c and returns its error
+    auto fitSegment = [&](double segmentStart, double segmentEnd) {
+        const double length = segmentEnd - segmentStart;
+        const auto timeAt = [segmentStart, length](double tau) {
+            return segmentStart + (tau + 1.0) * 0.5 * length;
+        };
+
+        for (uint32_t j = 0; j < nCoefficients; ++j) {
+            const double tau = std::cos(Pi * (j + 0.5) / nCoefficients);
+            f(timeAt(tau), values.data() + j * nComponents);
+        }
+
+        for (uint32_t i = 0; i < nComponents; ++i) {
+            for (uint32_t k = 0; k < nCoefficients; ++k) {
+                double sum = 0.0;
+                for (uint32_t j = 0; j < nCoefficients; ++j) {
+                    sum += values[j * nComponents + i] *
+                           std::cos(Pi * k * (j + 0.5) / nCoefficients);
+                }
+                c[i * nCoefficients + k] = 2.0 * sum / nCoefficients;
+            }
+            c[i * nCoefficients] *= 0.5;
+        }
+
+        double segmentError = 0.0;
+        if (measureError) {
+            // The interpolation error is largest between the nodes, which includes the
+            // segment boundaries
+            for (uint32_t j = 0; j <= nCoefficients; ++j) {
+                const double tau = std::cos(Pi * j / nCoefficients);
+                f(timeAt(tau), value.data());
+                for (uint32_t i = 0; i < nComponents; ++i) {
+                    const double* ci = c.data() + i * nCoefficients;
+                    const double fitted = chebyshev(ci, nCoefficients, tau);
+                    segmentError = std::max(segmentError, std::abs(fitted - value[i]));
+                }
+            }
+        }
+        return segmentError;
+    };
+
+    // The segments that still have to be fitted, with the earliest one at the back so
+    // that the segments are appended in order. The last segment is shortened to end at
+    // the end of the time range if the range is not a multiple of the segment length
+    std::vector<std::pair<double, double>> remaining;
+    for (uint32_t s = nSegments; s > 0; --s) {
+        remaining.emplace_back(
+            start + (s - 1) * segmentLength,
+            std::min(start + s * segmentLength, end)
+        );
+    }
+    while (!remaining.empty()) {
+        const std::pair<double, double> segment = remaining.back();
+        remaining.pop_back();
+
+        const double segmentError = fitSegment(segment.first, segment.second);
+        const double half = 0.5 * (segment.second - segment.first);
+        if (segmentError > tolerance && half >= minimumSegmentLength) {
+            const double center = segment.first + half;
+            remaining.emplace_back(center, segment.second);
+            remaining.emplace_back(segment.first, center);
+            continue;
+        }
+
+        error = std::max(error, segmentError);
+        series.boundaries.push_back(segment.second);
+        series.coefficients.insert(series.coefficients.end(), c.begin(), c.end());
+    }
+
+    if (maximumError) {
+        *maximumError = error;
+    }
+    return series;
+}
+
+void saveEphemerisFile(const std::vector<Series>& series, const std::string& path) {
+    std::ofstream file(path, std::ofstream::binary);
+    if (!file.good()) {
+        throw ghoul::RuntimeError(
+            fmt::format("Error opening file '{}' for writing", path),
+            _loggerCat
+        );
+    }
+
+    Header header;
+    header.magic = Magic;
+    header.version = CurrentVersion;
+    header.nSeries = static_cast<uint32_t>(series.size());
+    file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+
+    // Both the header and the descriptions are multiples of 8 bytes, so all coefficient
+    // blocks are aligned for doubles
+    uint64_t offset = sizeof(Header) + series.size() * sizeof(Description);
+    for (const Series& s : series) {
+        if (s.name.size() > MaximumNameLength) {
+            throw ghoul::RuntimeError(
+                fmt::format(
+                    "Name '{}' is longer than {} characters", s.name, MaximumNameLength
+                ),
+                _loggerCat
+            );
+        }
+
+        Description desc = {};
+        desc.type = static_cast<uint32_t>(s.type);
+        desc.nComponents = s.nComponents;
+        desc.nCoefficients = s.nCoefficients;
+        desc.nSegments = s.nSegments();
+        desc.offset = offset;
+        std::copy(s.name.begin(), s.name.end(), desc.name.begin());
+        file.write(reinterpret_cast<const char*>(&desc), sizeof(Description));
+
+        offset += (s.boundaries.size() + s.coefficients.size()) * sizeof(double);
+    }
+
+    for (const Series& s : series) {
+        file.write(
+            reinterpret_cast<const char*>(s.boundaries.data()),
+            s.boundaries.size() * sizeof(double)
+        );
+        file.write(
+            reinterpret_cast<const char*>(s.coefficients.data()),
+            s.coefficients.size() * sizeof(double)
+        );
+    }
+
+    if (!file.good()) {
+        throw ghoul::RuntimeError(
+            fmt::format("Error writing ephemeris file '{}'", path),
+            _loggerCat
+        );
+    }
+}
+
+EphemerisFile::EphemerisFile(const std::string& path) : _file(path) {
+    auto error = [&path](const char* message) {
+        return ghoul::RuntimeError(
+            fmt::format("Ephemeris file '{}': {}", path, message),
+            _loggerCat
+        );
+    };
+
+    if (_file.size() < sizeof(Header)) {
+        throw error("File is too small");
+    }
+
+    Header header;
+    std::memcpy(&header, _file.data(), sizeof(Header));
+    if (header.magic != Magic) {
+        throw error("Not an ephemeris file");
+    }
+    if (header.version != CurrentVersion) {
+        throw error("Unsupported version");
+    }
+    if (sizeof(Header) + header.nSeries * sizeof(Description) > _file.size()) {
+        throw error("Truncated series descriptions");
+    }
+
+    _entries.reserve(header.nSeries);
+    for (uint32_t i = 0; i < header.nSeries; ++i) {
+        Description desc;
+        std::memcpy(
+            &desc,
+            _file.data() + sizeof(Header) + i * sizeof(Description),
+            sizeof(Description)
+        );
+
+        const SeriesType type = static_cast<SeriesType>(desc.type);
+        if ((type != SeriesType::Translation && type != SeriesType::Rotation) ||
+            desc.nComponents != nComponents(type))
+        {
+            throw error("Unsupported series type");
+        }
+        if (desc.nCoefficients == 0 || desc.nSegments == 0) {
+            throw error("Empty series");
+        }
+
+        const uint64_t size = (desc.nSegments + 1 + static_cast<uint64_t>(
+            desc.nSegments) * desc.nComponents * desc.nCoefficients) * sizeof(double);
+        if (desc.offset % alignof(double) != 0 || desc.offset + size > _file.size()) {
+            throw error("Truncated coefficients");
+        }
+        // The mapping starts at a page boundary, so the offset is aligned for doubles
+        const double* boundaries = reinterpret_cast<const double*>(
+            _file.data() + desc.offset
+        );
+        for (uint32_t s = 0; s < desc.nSegments; ++s) {
+            if (!(boundaries[s] < boundaries[s + 1])) {
+                throw error("Segment boundaries are not ascending");
+            }
+        }
+        desc.name.back() = '\0';
+
+        Entry e;
+        e.name = desc.name.data();
+        e.type = type;
+        e.segments.nComponents = desc.nComponents;
+        e.segments.nCoefficients = desc.nCoefficients;
+        e.segments.nSegments = desc.nSegments;
+        e.segments.boundaries = boundaries;
+        e.segments.coefficients = boundaries + desc.nSegments + 1;
+        _entries.push_back(std::move(e));
+    }
+}
+
+Segments EphemerisFile::series(const std::string& name, SeriesType type) const {
+    const auto it = std::find_if(
+        _entries.begin(),
+        _entries.end(),
+        [&name, type](const Entry& e) { return e.name == name && e.type == type; }
+    );
+    if (it == _entries.end()) {
+        throw ghoul::RuntimeError(
+            fmt::format(
+                "Ephemeris file '{}' does not contain a {} named '{}'",
+                _file.path(),
+                type == SeriesType::Translation ? "translation" : "rotation",
+                name
+            ),
+            _loggerCat
+        );
+    }
+    return it->segments;
+}
+
+std::vector<std::string> EphemerisFile::names() const {
+    std::vector<std::string> result;
+    result.reserve(_entries.size());
+    for (const Entry& e : _entries) {
+        result.push_back(e.name);
+    }
+    return result;
+}
+
+} // namespace openspace::ephemeris
@@ -0,0 +1,149 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2018                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_SPACE___EPHEMERISFILE___H__
+#define __OPENSPACE_MODULE_SPACE___EPHEMERISFILE___H__
+
+#include <openspace/util/memorymappedfile.h>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace openspace::ephemeris {
+
+/// The kind of quantity that is stored in a Series
+enum class SeriesType : uint32_t {
+    /// A position in meters, stored as 3 components
+    Translation = 0,
+    /// A rotation matrix, stored as 9 components in column-major order
+    Rotation = 1
+};
+
+/**
+ * A non-owning view on the Chebyshev coefficients of a single translation or rotation.
+ * The covered time range is split into <code>nSegments</code> segments, whose
+ * <code>nSegments + 1</code> ascending boundaries are stored in <code>boundaries</code>.
+ * Each segment stores <code>nCoefficients</code> Chebyshev coefficients for each of the
+ * <code>nComponents</code> components. The coefficients are laid out as
+ * <code>[segment][component][coefficient]</code>.
+ */
+struct Segments {
+    uint32_t nComponents = 0;
+    uint32_t nCoefficients = 0;
+    uint32_t nSegments = 0;
+    const double* boundaries = nullptr;
+    const double* coefficients = nullptr;
+
+    double start() const;
+    double end() const;
+
+    /**
+     * Evaluates all components at the time \p t and stores them in \p result, which has
+     * to have space for <code>nComponents</code> values. Times outside of the covered
+     * range are clamped to the first or last segment's boundary.
+     */
+    void evaluate(double t, double* result) const;
+};
+
+/// An owning Series of Chebyshev segments that is created by #fitSeries
+struct Series {
+    std::string name;
+    SeriesType type = SeriesType::Translation;
+    uint32_t nComponents = 0;
+    uint32_t nCoefficients = 0;
+    std::vector<double> boundaries;
+    std::vector<double> coefficients;
+
+    uint32_t nSegments() const;
+    Segments segments() const;
+};
+
+/**
+ * Fits Chebyshev segments of the length \p segmentLength with \p nCoefficients
+ * coefficients per component to the function \p f on the time range [\p start,
+ * \p end]; the last segment is shorter if the range is not a multiple of
+ * \p segmentLength, so \p f is never sampled past \p end. \p f is called with a time and has to store the values of all
+ * \p nComponents components in the provided pointer. The error of the fit is measured
+ * between the interpolation nodes and written to \p maximumError if it is not
+ * <code>nullptr</code>. Each segment whose error exceeds \p tolerance is bisected until
+ * the tolerance is met or the halves would be shorter than \p minimumSegmentLength, so
+ * that only the parts of the time range that are hard to fit use shorter segments.
+ */
+Series fitSeries(std::string name, SeriesType type, uint32_t nComponents,
+    double start, double end, double segmentLength, uint32_t nCoefficients,
+    const std::function<void(double, double*)>& f, double* maximumError = nullptr,
+    double tolerance = std::numeric_limits<double>::infinity(),
+    double minimumSegmentLength = 0.0);
+
+/**
+ * Writes all \p series into the binary ephemeris file at \p path. The file starts with a
+ * fixed size header followed by one fixed size description per series and the segment
+ * boundaries and coefficients of all series, which start at 8 byte aligned offsets.
+ *
+ * \throw ghoul::RuntimeError If the file cannot be written
+ */
+void saveEphemerisFile(const std::vector<Series>& series, const std::string& path);
+
+/**
+ * A binary ephemeris file that is memory mapped on construction. Only the series
+ * descriptions are parsed, the coefficients are paged in by the operating system as they
+ * are evaluated. Evaluating the Segments returned by #series does not require any
+ * synchronization and is valid for as long as this object exists.
+ */
+class EphemerisFile {
+public:
+    /**
+     * Maps the ephemeris file at \p path.
+     *
+     * \throw ghoul::RuntimeError If the file cannot be mapped, is not an ephemeris file,
+     *        has a different version, or is truncated
+     */
+    explicit EphemerisFile(const std::string& path);
+
+    /**
+     * Returns the segments of the series with the provided \p name and \p type.
+     *
+     * \throw ghoul::RuntimeError If the file does not contain such a series
+     */
+    Segments series(const std::string& name, SeriesType type) const;
+
+    /// Returns the names of all series in the file
+    std::vector<std::string> names() const;
+
+private:
+    struct Entry {
+        std::string name;
+        SeriesType type;
+        Segments segments;
+    };
+
+    MemoryMappedFile _file;
+    std::vector<Entry> _entries;
+};
+
+} // namespace openspace::ephemeris
+
+#endif // __OPENSPACE_MODULE_SPACE___EPHEMERISFILE___H__
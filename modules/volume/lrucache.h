@@ -46,6 +46,8 @@ public:
     ValueType& use(const KeyType& key);
     ValueType& get(const KeyType& key);
     void evict();
+    const KeyType& leastRecentlyUsed() const;
+    size_t size() const;
     size_t capacity() const;
 
 private:
@@ -59,4 +61,6 @@ private:
 
 } // namespace openspace::volume
 
+#include "lrucache.inl"
+
 #endif // __OPENSPACE_MODULE_VOLUME___LRUCACHE___H__
@@ -40,7 +40,7 @@ void LruCache<KeyType, ValueType, ContainerType>::set(const KeyType& key, ValueT
     auto prev = _cache.find(key);
     if (prev != _cache.end()) {
         prev->second.first = value;
-        std::list<KeyType>::iterator trackerIter = prev->second.second;
+        typename std::list<KeyType>::iterator trackerIter = prev->second.second;
         _tracker.splice(_tracker.end(), _tracker, trackerIter);
     }
     else {
@@ -51,7 +51,7 @@ void LruCache<KeyType, ValueType, ContainerType>::set(const KeyType& key, ValueT
 template <typename KeyType, typename ValueType, template<typename...> class ContainerType>
 ValueType& LruCache<KeyType, ValueType, ContainerType>::use(const KeyType& key) {
     auto iter = _cache.find(key);
-    std::list<KeyType>::iterator trackerIter = iter->second.second;
+    typename std::list<KeyType>::iterator trackerIter = iter->second.second;
     _tracker.splice(_tracker.end(), _tracker, trackerIter);
     return iter->second.first;
 }
@@ -68,6 +68,16 @@ void LruCache<KeyType, ValueType, ContainerType>::evict() {
     _tracker.pop_front();
 }
 
+template <typename KeyType, typename ValueType, template<typename...> class ContainerType>
+const KeyType& LruCache<KeyType, ValueType, ContainerType>::leastRecentlyUsed() const {
+    return _tracker.front();
+}
+
+template <typename KeyType, typename ValueType, template<typename...> class ContainerType>
+size_t LruCache<KeyType, ValueType, ContainerType>::size() const {
+    return _cache.size();
+}
+
 template <typename KeyType, typename ValueType, template<typename...> class ContainerType>
 size_t LruCache<KeyType, ValueType, ContainerType>::capacity() const {
     return _capacity;
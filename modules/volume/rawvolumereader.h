@@ -25,6 +25,7 @@
 #ifndef __OPENSPACE_MODULE_VOLUME___RAWVOLUMEREADER___H__
 #define __OPENSPACE_MODULE_VOLUME___RAWVOLUMEREADER___H__
 
+#include <openspace/util/memorymappedfile.h>
 #include <ghoul/glm.h>
 #include <memory>
 #include <string>
@@ -33,6 +34,15 @@ namespace openspace::volume {
 
 template <typename T> class RawVolume;
 
+/**
+ * Reads volumes that are stored as a dense array of voxels, with the x coordinate varying
+ * fastest. Besides reading the entire volume with #read, single voxels, subvolumes, and
+ * downsampled versions of the volume can be accessed without reading the entire file.
+ * For these, the file is memory mapped on the first access, so that only the accessed
+ * parts of the file have to be loaded by the operating system. This makes it possible to
+ * process volumes that are larger than the available memory.
+ * After the first access, the random access methods can be called concurrently.
+ */
 template <typename Type>
 class RawVolumeReader {
 public:
@@ -44,15 +54,56 @@ public:
     std::string path() const;
     void setPath(const std::string& path);
     void setDimensions(const glm::uvec3& dimensions);
-    //VoxelType get(const glm::ivec3& coordinates) const; // TODO: Implement this
-    //VoxelType get(const size_t index) const; // TODO: Implement this
+
+    /**
+     * Returns the voxel at the \p coordinates.
+     * \throw ghoul::RuntimeError If the coordinates are outside the volume or the file
+     *        cannot be mapped or is too small for the dimensions
+     */
+    VoxelType get(const glm::uvec3& coordinates) const;
+
+    /**
+     * Returns the voxel at the linear \p index.
+     * \throw ghoul::RuntimeError If the index is outside the volume or the file cannot
+     *        be mapped or is too small for the dimensions
+     */
+    VoxelType get(size_t index) const;
+
+    /**
+     * Reads the entire volume into memory.
+     * \throw ghoul::FileNotFoundError If the file does not exist
+     * \throw ghoul::RuntimeError If the file is too small for the dimensions
+     */
     std::unique_ptr<RawVolume<VoxelType>> read();
 
+    /**
+     * Reads the axis-aligned part of the volume that starts at \p offset and has the
+     * size \p dimensions.
+     * \throw ghoul::RuntimeError If the subvolume is not contained in the volume or the
+     *        file cannot be mapped or is too small for the dimensions
+     */
+    std::unique_ptr<RawVolume<VoxelType>> readSubvolume(const glm::uvec3& offset,
+        const glm::uvec3& dimensions) const;
+
+    /**
+     * Reads every <code>stride</code>th voxel along each axis, starting with the first
+     * one. The resulting volume has <code>ceil(dimensions / stride)</code> voxels along
+     * each axis.
+     * \throw ghoul::RuntimeError If a component of \p stride is 0 or the file cannot be
+     *        mapped or is too small for the dimensions
+     */
+    std::unique_ptr<RawVolume<VoxelType>> readDownsampled(const glm::uvec3& stride) const;
+
 private:
     size_t coordsToIndex(const glm::uvec3& cartesian) const;
     glm::uvec3 indexToCoords(size_t linear) const;
+
+    // Maps the file if this has not happened yet and returns the first voxel
+    const char* mappedVoxels() const;
+
     glm::uvec3 _dimensions;
     std::string _path;
+    mutable MemoryMappedFile _file;
 };
 
 } // namespace openspace::volume
@@ -22,6 +22,10 @@
  * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
  ****************************************************************************************/
 
+#include <modules/volume/volumeutils.h>
+#include <ghoul/fmt.h>
+#include <ghoul/misc/exception.h>
+#include <cstring>
 #include <fstream>
 
 namespace openspace::volume {
@@ -41,6 +45,7 @@ glm::uvec3 RawVolumeReader<VoxelType>::dimensions() const {
 template <typename VoxelType>
 void RawVolumeReader<VoxelType>::setDimensions(const glm::uvec3& dimensions) {
     _dimensions = dimensions;
+    _file.close();
 }
 
 template <typename VoxelType>
@@ -51,30 +56,138 @@ std::string RawVolumeReader<VoxelType>::path() const {
 template <typename VoxelType>
 void RawVolumeReader<VoxelType>::setPath(const std::string& path) {
     _path = path;
+    _file.close();
 }
 
-
-/*
-TODO: Implement these methods for random access in raw volume file
 template <typename VoxelType>
-VoxelType RawVolumeReader<VoxelType>::get(const glm::ivec3& coordinates) const {
-    return get(coordsToIndex(coordinates, dimensions()));
+VoxelType RawVolumeReader<VoxelType>::get(const glm::uvec3& coordinates) const {
+    if (glm::any(glm::greaterThanEqual(coordinates, _dimensions))) {
+        throw ghoul::RuntimeError(fmt::format(
+            "Voxel ({}, {}, {}) is outside the volume '{}'",
+            coordinates.x, coordinates.y, coordinates.z, _path
+        ));
+    }
+    return get(coordsToIndex(coordinates));
 }
 
 template <typename VoxelType>
 VoxelType RawVolumeReader<VoxelType>::get(size_t index) const {
-    // TODO: read from specific position.
-    return VoxelType();
-}*/
+    const size_t nVoxels = static_cast<size_t>(_dimensions.x) * _dimensions.y *
+                           _dimensions.z;
+    if (index >= nVoxels) {
+        throw ghoul::RuntimeError(fmt::format(
+            "Voxel {} is outside the volume '{}'", index, _path
+        ));
+    }
+
+    // The mapped file has no alignment guarantees for the voxel type, so the voxel is
+    // copied instead of dereferenced
+    VoxelType voxel;
+    std::memcpy(&voxel, mappedVoxels() + index * sizeof(VoxelType), sizeof(VoxelType));
+    return voxel;
+}
 
 template <typename VoxelType>
 size_t RawVolumeReader<VoxelType>::coordsToIndex(const glm::uvec3& cartesian) const {
-    return coordsToIndex(cartesian, dimensions());
+    return volume::coordsToIndex(cartesian, dimensions());
 }
 
 template <typename VoxelType>
 glm::uvec3 RawVolumeReader<VoxelType>::indexToCoords(size_t linear) const {
-    return indexToCoords(linear, dimensions());
+    return volume::indexToCoords(linear, dimensions());
+}
+
+template <typename VoxelType>
+const char* RawVolumeReader<VoxelType>::mappedVoxels() const {
+    if (!_file.isOpen()) {
+        _file.open(_path);
+    }
+
+    const size_t length = static_cast<size_t>(_dimensions.x) * _dimensions.y *
+                          _dimensions.z * sizeof(VoxelType);
+    if (_file.size() < length) {
+        throw ghoul::RuntimeError(fmt::format(
+            "Volume file '{}' is too small for dimensions ({}, {}, {})",
+            _path, _dimensions.x, _dimensions.y, _dimensions.z
+        ));
+    }
+    return _file.data();
+}
+
+template <typename VoxelType>
+std::unique_ptr<RawVolume<VoxelType>> RawVolumeReader<VoxelType>::readSubvolume(
+                                                             const glm::uvec3& offset,
+                                                       const glm::uvec3& dimensions) const
+{
+    if (glm::any(glm::greaterThan(offset + dimensions, _dimensions)) ||
+        glm::any(glm::lessThan(offset + dimensions, offset)))
+    {
+        throw ghoul::RuntimeError(fmt::format(
+            "Subvolume at ({}, {}, {}) with size ({}, {}, {}) is outside the volume '{}'",
+            offset.x, offset.y, offset.z, dimensions.x, dimensions.y, dimensions.z, _path
+        ));
+    }
+
+    std::unique_ptr<RawVolume<VoxelType>> volume = std::make_unique<RawVolume<VoxelType>>(
+        dimensions
+    );
+    if (volume->nCells() == 0) {
+        return volume;
+    }
+
+    const char* voxels = mappedVoxels();
+    char* buffer = reinterpret_cast<char*>(volume->data());
+
+    // The x axis is contiguous in the file, so the subvolume is copied row by row
+    const size_t rowLength = dimensions.x * sizeof(VoxelType);
+    for (unsigned int z = 0; z < dimensions.z; ++z) {
+        for (unsigned int y = 0; y < dimensions.y; ++y) {
+            const size_t source = coordsToIndex(offset + glm::uvec3(0, y, z));
+            const size_t destination = volume->coordsToIndex(glm::uvec3(0, y, z));
+            std::memcpy(
+                buffer + destination * sizeof(VoxelType),
+                voxels + source * sizeof(VoxelType),
+                rowLength
+            );
+        }
+    }
+    return volume;
+}
+
+template <typename VoxelType>
+std::unique_ptr<RawVolume<VoxelType>> RawVolumeReader<VoxelType>::readDownsampled(
+                                                           const glm::uvec3& stride) const
+{
+    if (glm::any(glm::equal(stride, glm::uvec3(0)))) {
+        throw ghoul::RuntimeError("The stride must be positive along all axes");
+    }
+
+    const glm::uvec3 dims = (_dimensions + stride - glm::uvec3(1)) / stride;
+    std::unique_ptr<RawVolume<VoxelType>> volume = std::make_unique<RawVolume<VoxelType>>(
+        dims
+    );
+    if (volume->nCells() == 0) {
+        return volume;
+    }
+
+    const char* voxels = mappedVoxels();
+    char* buffer = reinterpret_cast<char*>(volume->data());
+
+    size_t destination = 0;
+    for (unsigned int z = 0; z < dims.z; ++z) {
+        for (unsigned int y = 0; y < dims.y; ++y) {
+            for (unsigned int x = 0; x < dims.x; ++x) {
+                const size_t source = coordsToIndex(glm::uvec3(x, y, z) * stride);
+                std::memcpy(
+                    buffer + destination * sizeof(VoxelType),
+                    voxels + source * sizeof(VoxelType),
+                    sizeof(VoxelType)
+                );
+                ++destination;
+            }
+        }
+    }
+    return volume;
 }
 
 
@@ -30,12 +30,14 @@
 #include <modules/volume/rawvolume.h>
 #include <modules/volume/rawvolumereader.h>
 #include <modules/volume/volumegridtype.h>
+#include <modules/volume/volumeutils.h>
 #include <openspace/documentation/documentation.h>
 #include <openspace/documentation/verifier.h>
 #include <openspace/engine/openspaceengine.h>
 #include <openspace/rendering/raycastermanager.h>
 #include <openspace/rendering/renderengine.h>
 #include <openspace/util/histogram.h>
+#include <openspace/util/threadpool.h>
 #include <openspace/util/time.h>
 #include <openspace/util/timemanager.h>
 #include <openspace/util/updatestructures.h>
@@ -43,6 +45,7 @@
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/opengl/texture.h>
+#include <algorithm>
 
 namespace {
     constexpr const char* _loggerCat = "RenderableTimeVaryingVolume";
@@ -63,8 +66,15 @@ namespace {
     constexpr const char* KeyMaxValue = "MaxValue";
     constexpr const char* KeyTime = "Time";
     constexpr const char* KeyUnit = "VisUnit";
+    constexpr const char* KeyStreaming = "Streaming";
+    constexpr const char* KeyLookahead = "LookaheadTimesteps";
+    constexpr const char* KeyMemoryBudget = "StreamingMemoryBudget";
     constexpr const float SecondsInOneDay = 60 * 60 * 24;
 
+    // Loading the timesteps is mostly bound by the disk, so more threads do not help
+    constexpr const size_t NumLoadingThreads = 2;
+    constexpr const double DefaultMemoryBudget = 2048.0; // MB
+
     constexpr openspace::properties::Property::PropertyInfo StepSizeInfo = {
         "stepSize",
         "Step Size",
@@ -136,10 +146,66 @@ namespace {
         "Radius upper bound",
         "" // @TODO Missing documentation
     };
+
+    constexpr openspace::properties::Property::PropertyInfo LookaheadInfo = {
+        "lookaheadTimesteps",
+        "Lookahead timesteps",
+        "The number of timesteps that are loaded ahead of the current timestep in the "
+        "direction in which the simulation time moves. This is only used when the "
+        "timesteps are streamed and is limited by the memory budget."
+    };
 } // namespace
 
 namespace openspace::volume {
 
+namespace {
+    // Reads the volume from the path, normalizes its values into the range [0, 1] using
+    // the value range in the metadata, and adds them to the histogram. This function is
+    // called from the loading threads, so it must not access any state of the renderable
+    std::unique_ptr<RawVolume<float>> readNormalizedVolume(const std::string& path,
+                                                        const RawVolumeMetadata& metadata,
+                                                                     Histogram& histogram,
+                                                                         ThreadPool* pool)
+    {
+        RawVolumeReader<float> reader(path, metadata.dimensions);
+        std::unique_ptr<RawVolume<float>> volume = reader.read();
+
+        normalizeWithHistogram(
+            volume->data(),
+            volume->nCells(),
+            metadata.minValue,
+            metadata.maxValue,
+            histogram,
+            pool
+        );
+        return volume;
+    }
+
+    std::shared_ptr<Histogram> createHistogram() {
+        return std::make_shared<Histogram>(0.f, 1.f, 100);
+    }
+
+    // The texture references the voxel data, so the volume has to outlive the texture
+    std::shared_ptr<ghoul::opengl::Texture> createTexture(RawVolume<float>& volume) {
+        std::shared_ptr<ghoul::opengl::Texture> texture =
+            std::make_shared<ghoul::opengl::Texture>(
+                volume.dimensions(),
+                ghoul::opengl::Texture::Format::Red,
+                GL_RED,
+                GL_FLOAT,
+                ghoul::opengl::Texture::FilterMode::Linear,
+                ghoul::opengl::Texture::WrappingMode::Clamp
+            );
+
+        texture->setPixelData(
+            reinterpret_cast<void*>(volume.data()),
+            ghoul::opengl::Texture::TakeOwnership::No
+        );
+        texture->uploadTexture();
+        return texture;
+    }
+} // namespace
+
     documentation::Documentation RenderableTimeVaryingVolume::Documentation() {
     using namespace documentation;
     return {
@@ -171,6 +237,28 @@ namespace openspace::volume {
                 Optional::No,
                 "Specifies the number of seconds to show the the last timestep after its "
                 "actual time"
+            },
+            {
+                KeyStreaming,
+                new BoolVerifier,
+                Optional::Yes,
+                "If this value is 'true', the timesteps are not all loaded at startup, "
+                "but the current timestep and the following ones are loaded in the "
+                "background as they are needed. The default value is 'false'."
+            },
+            {
+                KeyLookahead,
+                new IntVerifier,
+                Optional::Yes,
+                LookaheadInfo.description
+            },
+            {
+                KeyMemoryBudget,
+                new DoubleGreaterVerifier(0.0),
+                Optional::Yes,
+                "The maximum amount of voxel data (in MB) that is kept in memory when "
+                "the timesteps are streamed. The least recently used timesteps are "
+                "removed when this budget is exceeded. The default value is 2048 MB."
             }
         }
     };
@@ -238,6 +326,7 @@ RenderableTimeVaryingVolume::RenderableTimeVaryingVolume(
     , _triggerTimeJump(TriggerTimeJumpInfo)
     , _jumpToTimestep(JumpToTimestepInfo, 0, 0, 256)
     , _currentTimestep(CurrentTimeStepInfo, 0, 0, 256)
+    , _lookahead(LookaheadInfo, 2, 0, 64)
 {
     documentation::testSpecificationAndThrow(
         Documentation(),
@@ -279,6 +368,18 @@ RenderableTimeVaryingVolume::RenderableTimeVaryingVolume(
         );
         _gridType = static_cast<std::underlying_type_t<VolumeGridType>>(gridType);
     }
+
+    if (dictionary.hasKeyAndValue<bool>(KeyStreaming)) {
+        _useStreaming = dictionary.value<bool>(KeyStreaming);
+    }
+    if (dictionary.hasKeyAndValue<double>(KeyLookahead)) {
+        _lookahead = static_cast<int>(dictionary.value<double>(KeyLookahead));
+    }
+    double memoryBudget = DefaultMemoryBudget;
+    if (dictionary.hasKeyAndValue<double>(KeyMemoryBudget)) {
+        memoryBudget = dictionary.value<double>(KeyMemoryBudget);
+    }
+    _memoryBudget = static_cast<size_t>(memoryBudget * 1024.0 * 1024.0);
 }
 
 RenderableTimeVaryingVolume::~RenderableTimeVaryingVolume() {}
@@ -304,43 +405,41 @@ void RenderableTimeVaryingVolume::initializeGL() {
         }
     }
 
-    // TODO: defer loading of data to later (separate thread or at least not when loading)
-    for (std::pair<const double, Timestep>& p : _volumeTimesteps) {
-        Timestep& t = p.second;
-        std::string path = FileSys.pathByAppendingComponent(
-            _sourceDirectory, t.baseName
-        ) + ".rawvolume";
-        RawVolumeReader<float> reader(path, t.metadata.dimensions);
-        t.rawVolume = reader.read();
-
-        float min = t.metadata.minValue;
-        float diff = t.metadata.maxValue - t.metadata.minValue;
-        float* data = t.rawVolume->data();
-        for (size_t i = 0; i < t.rawVolume->nCells(); ++i) {
-            data[i] = glm::clamp((data[i] - min) / diff, 0.f, 1.f);
+    if (_useStreaming) {
+        // The cache holds as many timesteps as fit into the memory budget, assuming that
+        // all of them are as large as the largest one
+        size_t maxTimestepSize = 0;
+        for (const std::pair<const double, Timestep>& p : _volumeTimesteps) {
+            const glm::uvec3 dims = p.second.metadata.dimensions;
+            const size_t size = static_cast<size_t>(dims.x) * dims.y * dims.z *
+                                sizeof(float);
+            maxTimestepSize = std::max(maxTimestepSize, size);
         }
-
-        t.histogram = std::make_shared<Histogram>(0.f, 1.f, 100);
-        for (size_t i = 0; i < t.rawVolume->nCells(); ++i) {
-            t.histogram->add(data[i]);
+        const size_t capacity = maxTimestepSize > 0 ?
+            std::max<size_t>(_memoryBudget / maxTimestepSize, 1) :
+            1;
+        _streamedTimesteps = std::make_unique<
+            LruCache<int, StreamedTimestep, std::unordered_map>
+        >(capacity);
+        _loadingPool = std::make_unique<ThreadPool>(NumLoadingThreads);
+    }
+    else {
+        ThreadPool* pool = OsEng.computePool();
+        for (std::pair<const double, Timestep>& p : _volumeTimesteps) {
+            Timestep& t = p.second;
+            std::string path = FileSys.pathByAppendingComponent(
+                _sourceDirectory, t.baseName
+            ) + ".rawvolume";
+            t.histogram = createHistogram();
+            t.rawVolume = readNormalizedVolume(path, t.metadata, *t.histogram, pool);
+
+            // TODO: handle normalization properly for different timesteps + transfer
+            //       function
+
+            t.texture = createTexture(*t.rawVolume);
+            t.inRam = true;
+            t.onGpu = true;
         }
-
-        // TODO: handle normalization properly for different timesteps + transfer function
-
-        t.texture = std::make_shared<ghoul::opengl::Texture>(
-            t.metadata.dimensions,
-            ghoul::opengl::Texture::Format::Red,
-            GL_RED,
-            GL_FLOAT,
-            ghoul::opengl::Texture::FilterMode::Linear,
-            ghoul::opengl::Texture::WrappingMode::Clamp
-        );
-
-        t.texture->setPixelData(
-            reinterpret_cast<void*>(data),
-            ghoul::opengl::Texture::TakeOwnership::No
-        );
-        t.texture->uploadTexture();
     }
 
     //_transferFunction->initialize();
@@ -381,6 +480,9 @@ void RenderableTimeVaryingVolume::initializeGL() {
     addProperty(_triggerTimeJump);
     addProperty(_jumpToTimestep);
     addProperty(_currentTimestep);
+    if (_useStreaming) {
+        addProperty(_lookahead);
+    }
     addProperty(_opacity);
     addProperty(_rNormalization);
     addProperty(_rUpperBound);
@@ -487,15 +589,148 @@ void RenderableTimeVaryingVolume::jumpToTimestep(int target) {
     }
 }
 
+std::shared_ptr<ghoul::opengl::Texture> RenderableTimeVaryingVolume::updateStreaming(
+                                                                         int currentIndex)
+{
+    // The timesteps that should be in memory, ordered by their priority. The lookahead
+    // is limited so that loading a later timestep never evicts the current one
+    std::vector<int> window;
+    if (currentIndex >= 0) {
+        const int direction = OsEng.timeManager().deltaTime() >= 0.0 ? 1 : -1;
+        const int nTimesteps = static_cast<int>(_volumeTimesteps.size());
+        const int lookahead = std::min(
+            _lookahead.value(),
+            static_cast<int>(_streamedTimesteps->capacity()) - 1
+        );
+        for (int i = 0; i <= lookahead; ++i) {
+            const int index = currentIndex + direction * i;
+            if (index < 0 || index >= nTimesteps) {
+                break;
+            }
+            window.push_back(index);
+        }
+    }
+    auto isInWindow = [&window](int index) {
+        return std::find(window.begin(), window.end(), index) != window.end();
+    };
+
+    // Move the timesteps that were loaded in the meantime into the cache. Timesteps
+    // that have left the window since they were requested are dropped, as inserting
+    // them could evict a timestep that is still needed
+    std::vector<std::pair<int, StreamedTimestep>> loaded;
+    {
+        std::lock_guard<std::mutex> lock(_streamingMutex);
+        loaded.swap(_loadedTimesteps);
+        _wantedTimesteps = std::set<int>(window.begin(), window.end());
+    }
+    for (std::pair<int, StreamedTimestep>& l : loaded) {
+        _pendingTimesteps.erase(l.first);
+        if (l.second.rawVolume && isInWindow(l.first)) {
+            _streamedTimesteps->set(l.first, std::move(l.second));
+        }
+    }
+
+    // Mark the window as recently used, ending with the current timestep, so that the
+    // timesteps that are furthest behind are evicted first
+    for (auto it = window.rbegin(); it != window.rend(); ++it) {
+        if (_streamedTimesteps->has(*it)) {
+            _streamedTimesteps->use(*it);
+        }
+    }
+
+    // Request the missing timesteps; the current one is loaded before all others
+    for (int index : window) {
+        if (_streamedTimesteps->has(index) || _pendingTimesteps.count(index) > 0) {
+            continue;
+        }
+
+        // Timesteps that are being loaded count against the memory budget, so room is
+        // made by evicting the timesteps outside of the window first. If there is none
+        // left, the remaining timesteps are requested once the loads in flight finish
+        while (_streamedTimesteps->size() + _pendingTimesteps.size() >=
+               _streamedTimesteps->capacity() &&
+               _streamedTimesteps->size() > 0 &&
+               !isInWindow(_streamedTimesteps->leastRecentlyUsed()))
+        {
+            _streamedTimesteps->evict();
+        }
+        if (_streamedTimesteps->size() + _pendingTimesteps.size() >=
+            _streamedTimesteps->capacity())
+        {
+            break;
+        }
+
+        Timestep* t = timestepFromIndex(index);
+        std::string path = FileSys.pathByAppendingComponent(
+            _sourceDirectory, t->baseName
+        ) + ".rawvolume";
+        _pendingTimesteps.insert(index);
+        ThreadPool* pool = OsEng.computePool();
+        _loadingPool->enqueue(
+            [this, index, path = std::move(path), metadata = t->metadata, pool]() {
+                StreamedTimestep data;
+                bool isWanted;
+                {
+                    std::lock_guard<std::mutex> lock(_streamingMutex);
+                    isWanted = _wantedTimesteps.count(index) > 0;
+                }
+                if (isWanted) {
+                    try {
+                        data.histogram = createHistogram();
+                        data.rawVolume = readNormalizedVolume(
+                            path,
+                            metadata,
+                            *data.histogram,
+                            pool
+                        );
+                    }
+                    catch (const ghoul::RuntimeError& e) {
+                        LERRORC(e.component, e.what());
+                    }
+                    catch (const std::exception& e) {
+                        // An empty result still has to be reported, as the timestep
+                        // would otherwise stay pending forever
+                        LERROR(fmt::format("Error loading '{}': {}", path, e.what()));
+                    }
+                }
+
+                std::lock_guard<std::mutex> lock(_streamingMutex);
+                _loadedTimesteps.emplace_back(index, std::move(data));
+            },
+            index == currentIndex ? ThreadPool::Priority::High :
+                                    ThreadPool::Priority::Normal
+        );
+    }
+
+    if (currentIndex < 0 || !_streamedTimesteps->has(currentIndex)) {
+        return nullptr;
+    }
+    StreamedTimestep& current = _streamedTimesteps->use(currentIndex);
+    if (!current.texture) {
+        current.texture = createTexture(*current.rawVolume);
+    }
+    return current.texture;
+}
+
 void RenderableTimeVaryingVolume::update(const UpdateData&) {
     if (_raycaster) {
         Timestep* t = currentTimestep();
         _currentTimestep = timestepIndex(t);
 
+        std::shared_ptr<ghoul::opengl::Texture> texture;
+        bool isCurrentLoading = false;
+        if (_useStreaming) {
+            texture = updateStreaming(_currentTimestep);
+            isCurrentLoading = _pendingTimesteps.count(_currentTimestep) > 0;
+        }
+        else if (t) {
+            texture = t->texture;
+        }
+
         // Set scale and translation matrices:
         // The original data cube is a unit cube centered in 0
         // ie with lower bound from (-0.5, -0.5, -0.5) and upper bound (0.5, 0.5, 0.5)
-        if (t && t->texture) {
+        if (t && texture) {
             if (_raycaster->gridType() == volume::VolumeGridType::Cartesian) {
                 glm::dvec3 scale = t->metadata.upperDomainBound -
                     t->metadata.lowerDomainBound;
@@ -516,13 +751,16 @@ void RenderableTimeVaryingVolume::update(const UpdateData&) {
                     )
                 );
             }
-            _raycaster->setVolumeTexture(t->texture);
+            _raycaster->setVolumeTexture(texture);
             //_transferFunctionHandler->setUnit(t->metadata.valueUnit);
             //_transferFunctionHandler->setMinAndMaxValue(
             //    t->metadata.minValue, t->metadata.maxValue);
 
             //_transferFunctionHandler->setHistogramProperty(t->histogram);
-        } else {
+        }
+        else if (!isCurrentLoading) {
+            // While the current timestep is still loading, the previously shown volume
+            // is kept to not have the volume disappear for the duration of the load
             _raycaster->setVolumeTexture(nullptr);
         }
         _raycaster->setStepSize(_stepSize);
@@ -543,6 +781,15 @@ bool RenderableTimeVaryingVolume::isReady() const {
 }
 
 void RenderableTimeVaryingVolume::deinitializeGL() {
+    if (_loadingPool) {
+        // Wait for the loads in progress, as they reference this renderable
+        _loadingPool->clearTasks();
+        _loadingPool = nullptr;
+    }
+    _streamedTimesteps = nullptr;
+    _pendingTimesteps.clear();
+    _loadedTimesteps.clear();
+
     if (_raycaster) {
         OsEng.renderEngine().raycasterManager().detachRaycaster(*_raycaster.get());
         _raycaster = nullptr;
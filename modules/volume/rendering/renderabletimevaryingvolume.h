@@ -32,6 +32,12 @@
 #include <openspace/properties/triggerproperty.h>
 // #include <modules/volume/rawvolume.h>
  #include <modules/volume/rawvolumemetadata.h>
+#include <modules/volume/lrucache.h>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 // #include <modules/volume/rendering/basicvolumeraycaster.h>
 // #include <modules/volume/rendering/volumeclipplanes.h>
 
@@ -45,6 +51,7 @@
 namespace openspace {
     class Histogram;
     struct RenderData;
+    class ThreadPool;
     class TransferFunction;
 } // namespace openspace
 
@@ -78,6 +85,14 @@ private:
         std::shared_ptr<Histogram> histogram;
     };
 
+    /// The data of a timestep that was loaded in the background while streaming. The
+    /// texture is only created once the timestep is shown
+    struct StreamedTimestep {
+        std::shared_ptr<RawVolume<float>> rawVolume;
+        std::shared_ptr<Histogram> histogram;
+        std::shared_ptr<ghoul::opengl::Texture> texture;
+    };
+
     Timestep* currentTimestep();
     int timestepIndex(const Timestep* t) const;
     Timestep* timestepFromIndex(int index);
@@ -85,6 +100,14 @@ private:
 
     void loadTimestepMetadata(const std::string& path);
 
+    /**
+     * Collects the timesteps that were loaded in the background, requests the timesteps
+     * from \p currentIndex up to the lookahead in the direction in which the simulation
+     * time is moving, and returns the texture of the timestep at \p currentIndex if it
+     * is available.
+     */
+    std::shared_ptr<ghoul::opengl::Texture> updateStreaming(int currentIndex);
+
     properties::OptionProperty _gridType;
     std::shared_ptr<VolumeClipPlanes> _clipPlanes;
 
@@ -100,11 +123,35 @@ private:
     properties::TriggerProperty _triggerTimeJump;
     properties::IntProperty _jumpToTimestep;
     properties::IntProperty _currentTimestep;
+    properties::IntProperty _lookahead;
 
     std::map<double, Timestep> _volumeTimesteps;
     std::unique_ptr<BasicVolumeRaycaster> _raycaster;
 
     std::shared_ptr<openspace::TransferFunction> _transferFunction;
+
+    /// If this is true, timesteps are loaded on demand instead of all at startup
+    bool _useStreaming = false;
+    /// The maximum number of bytes of voxel data kept in memory while streaming
+    size_t _memoryBudget = 0;
+    /// The timesteps that are in memory, indexed by their position in _volumeTimesteps
+    std::unique_ptr<
+        LruCache<int, StreamedTimestep, std::unordered_map>
+    > _streamedTimesteps;
+    std::unique_ptr<ThreadPool> _loadingPool;
+    /// The timesteps that have been requested from the _loadingPool but not received yet.
+    /// These count against the capacity of the _streamedTimesteps
+    std::set<int> _pendingTimesteps;
+
+    /// Protects the _wantedTimesteps and the _loadedTimesteps, which are shared with the
+    /// loading threads
+    std::mutex _streamingMutex;
+    /// Requested timesteps that are no longer part of this set are skipped by the
+    /// loading threads
+    std::set<int> _wantedTimesteps;
+    /// The timesteps that have been loaded, but not yet been moved into the cache. The
+    /// data is empty if the loading was skipped or failed
+    std::vector<std::pair<int, StreamedTimestep>> _loadedTimesteps;
 };
 
 } // namespace openspace::volume
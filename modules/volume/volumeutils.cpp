@@ -24,6 +24,182 @@
 
 #include <modules/volume/volumeutils.h>
 
+#include <openspace/util/histogram.h>
+#include <openspace/util/threadpool.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OPENSPACE_VOLUMEUTILS_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace {
+    // The values are processed in blocks that are first normalized and binned, which can
+    // be vectorized, and then counted while they are still in the cache
+    constexpr const size_t BlockSize = 256;
+
+    // The minimum number of values that are processed by a single task. Smaller arrays
+    // are not worth the synchronization overhead
+    constexpr const size_t MinValuesPerTask = 1 << 18;
+
+    struct Normalization {
+        float minValue;
+        float diff;
+    };
+
+    struct HistogramRange {
+        float minValue;
+        float maxValue;
+        float nBins;
+    };
+
+    // Maps the values into [0, 1] exactly like glm::clamp((v - minValue) / diff, 0, 1)
+    void normalize(float* data, size_t n, const Normalization& norm) {
+        size_t i = 0;
+#ifdef OPENSPACE_VOLUMEUTILS_SSE2
+        const __m128 minValue = _mm_set1_ps(norm.minValue);
+        const __m128 diff = _mm_set1_ps(norm.diff);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.f);
+        for (; i + 4 <= n; i += 4) {
+            const __m128 v = _mm_div_ps(
+                _mm_sub_ps(_mm_loadu_ps(data + i), minValue),
+                diff
+            );
+            // The bounds are the first operands, so that NaNs are kept like in glm::clamp
+            _mm_storeu_ps(data + i, _mm_min_ps(one, _mm_max_ps(zero, v)));
+        }
+#endif // OPENSPACE_VOLUMEUTILS_SSE2
+        for (; i < n; ++i) {
+            data[i] = glm::clamp((data[i] - norm.minValue) / norm.diff, 0.f, 1.f);
+        }
+    }
+
+    // Computes the bin for each value in the same way as Histogram::add. Values that are
+    // outside of the histogram's range, including NaNs, get the index nBins
+    void computeBins(const float* values, size_t n, const HistogramRange& range,
+                     int32_t* bins)
+    {
+        const float diff = range.maxValue - range.minValue;
+        const int32_t outside = static_cast<int32_t>(range.nBins);
+
+        size_t i = 0;
+#ifdef OPENSPACE_VOLUMEUTILS_SSE2
+        const __m128 minValue = _mm_set1_ps(range.minValue);
+        const __m128 maxValue = _mm_set1_ps(range.maxValue);
+        const __m128 diffV = _mm_set1_ps(diff);
+        const __m128 nBins = _mm_set1_ps(range.nBins);
+        const __m128 lastBin = _mm_set1_ps(range.nBins - 1.f);
+        const __m128i outsideV = _mm_set1_epi32(outside);
+        for (; i + 4 <= n; i += 4) {
+            const __m128 v = _mm_loadu_ps(values + i);
+            const __m128i inside = _mm_castps_si128(
+                _mm_and_ps(_mm_cmpge_ps(v, minValue), _mm_cmple_ps(v, maxValue))
+            );
+            // Inside values are not negative, so truncating is the same as flooring
+            const __m128 bin = _mm_min_ps(
+                _mm_mul_ps(_mm_div_ps(_mm_sub_ps(v, minValue), diffV), nBins),
+                lastBin
+            );
+            const __m128i index = _mm_or_si128(
+                _mm_and_si128(inside, _mm_cvttps_epi32(bin)),
+                _mm_andnot_si128(inside, outsideV)
+            );
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(bins + i), index);
+        }
+#endif // OPENSPACE_VOLUMEUTILS_SSE2
+        for (; i < n; ++i) {
+            const float v = values[i];
+            if (v >= range.minValue && v <= range.maxValue) {
+                const float normalized = (v - range.minValue) / diff;
+                bins[i] = static_cast<int32_t>(
+                    std::min(std::floor(normalized * range.nBins), range.nBins - 1.f)
+                );
+            }
+            else {
+                bins[i] = outside;
+            }
+        }
+    }
+
+    // Normalizes the values in [begin, end) of data if a normalization is provided and
+    // counts the values into counts, which has one additional entry for the values
+    // outside of the histogram. If range is nullptr, the values are not counted
+    void processRange(float* data, const float* values, size_t begin, size_t end,
+                      const Normalization* normalization, const HistogramRange* range,
+                      uint64_t* counts)
+    {
+        std::array<int32_t, BlockSize> bins;
+        for (size_t b = begin; b < end; b += BlockSize) {
+            const size_t n = std::min(BlockSize, end - b);
+            if (normalization) {
+                normalize(data + b, n, *normalization);
+            }
+            if (range) {
+                computeBins(values + b, n, *range, bins.data());
+                for (size_t i = 0; i < n; ++i) {
+                    ++counts[bins[i]];
+                }
+            }
+        }
+    }
+
+    void process(float* data, const float* values, size_t nValues,
+                 const Normalization* normalization, openspace::Histogram& histogram,
+                 openspace::ThreadPool* pool)
+    {
+        HistogramRange range = {
+            histogram.minValue(),
+            histogram.maxValue(),
+            static_cast<float>(histogram.numBins())
+        };
+        const HistogramRange* r = histogram.isValid() ? &range : nullptr;
+        const size_t nCounts = r ? histogram.numBins() + 1 : 0;
+
+        const size_t nTasks = (!pool || nValues < 2 * MinValuesPerTask) ?
+            1 :
+            std::min(pool->numThreads() + 1, nValues / MinValuesPerTask);
+        const size_t valuesPerTask = (nValues + nTasks - 1) / nTasks;
+
+        // Every task counts into its own histogram; these are merged at the end
+        std::vector<uint64_t> counts(nTasks * nCounts, 0);
+        auto run = [&](size_t task) {
+            const size_t begin = task * valuesPerTask;
+            const size_t end = std::min(begin + valuesPerTask, nValues);
+            processRange(
+                data,
+                values,
+                begin,
+                end,
+                normalization,
+                r,
+                counts.data() + task * nCounts
+            );
+        };
+
+        openspace::parallelFor(pool, nTasks, run);
+
+        if (!r) {
+            return;
+        }
+
+        // Add the counts of each bin at once, without converting them to float first
+        for (int bin = 0; bin < histogram.numBins(); ++bin) {
+            uint64_t count = 0;
+            for (size_t t = 0; t < nTasks; ++t) {
+                count += counts[t * nCounts + bin];
+            }
+            if (count > 0) {
+                histogram.addToBin(bin, count);
+            }
+        }
+    }
+} // namespace
+
 namespace openspace::volume {
 
 size_t coordsToIndex(const glm::uvec3& coords, const glm::uvec3& dims) {
@@ -43,4 +219,17 @@ glm::uvec3 indexToCoords(size_t index, const glm::uvec3& dims) {
     return glm::uvec3(x, y, z);
 }
 
+void normalizeWithHistogram(float* data, size_t nValues, float minValue, float maxValue,
+                            Histogram& histogram, ThreadPool* pool)
+{
+    const Normalization normalization = { minValue, maxValue - minValue };
+    process(data, data, nValues, &normalization, histogram, pool);
+}
+
+void addToHistogram(const float* data, size_t nValues, Histogram& histogram,
+                    ThreadPool* pool)
+{
+    process(nullptr, data, nValues, nullptr, histogram, pool);
+}
+
 } // namespace openspace::volume
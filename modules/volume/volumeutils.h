@@ -26,12 +26,38 @@
 #define __OPENSPACE_MODULE_VOLUME___VOLUMEUTILS___H__
 
 #include <ghoul/glm.h>
+#include <cstddef>
+
+namespace openspace {
+    class Histogram;
+    class ThreadPool;
+} // namespace openspace
 
 namespace openspace::volume {
 
 size_t coordsToIndex(const glm::uvec3& coords, const glm::uvec3& dimensions);
 glm::uvec3 indexToCoords(size_t index, const glm::uvec3& dimensions);
 
+/**
+ * Normalizes the \p nValues values in \p data in place from the range [\p minValue,
+ * \p maxValue] into [0, 1], clamping values outside of the range, and adds the normalized
+ * values to the \p histogram in the same pass. The result is the same as normalizing each
+ * value and calling Histogram::add with it, except that NaN values are not counted. If a
+ * \p pool is provided, large arrays are processed in parallel chunks. The \p pool must
+ * not be the one that is executing the caller.
+ */
+void normalizeWithHistogram(float* data, size_t nValues, float minValue, float maxValue,
+    Histogram& histogram, ThreadPool* pool = nullptr);
+
+/**
+ * Adds the \p nValues values in \p data to the \p histogram. The result is the same as
+ * calling Histogram::add for each value, except that NaN values are not counted. If a
+ * \p pool is provided, large arrays are processed in parallel chunks. The \p pool must
+ * not be the one that is executing the caller.
+ */
+void addToHistogram(const float* data, size_t nValues, Histogram& histogram,
+    ThreadPool* pool = nullptr);
+
 } // namespace openspace::volume
 
 #endif // __OPENSPACE_MODULE_VOLUME___VOLUMEUTILS___H__
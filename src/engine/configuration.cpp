@@ -87,6 +87,7 @@ namespace {
     constexpr const char* KeyLogEachOpenGLCall = "LogEachOpenGLCall";
     constexpr const char* KeyUseMultithreadedInitialization =
                                                          "UseMultithreadedInitialization";
+    constexpr const char* KeyUseDeltaSynchronization = "UseDeltaSynchronization";
     constexpr const char* KeyLoadingScreen = "LoadingScreen";
     constexpr const char* KeyShowMessage = "ShowMessage";
     constexpr const char* KeyShowNodeNames = "ShowNodeNames";
@@ -277,6 +278,7 @@ void parseLuaState(Configuration& configuration) {
     getValue(s, KeyFonts, c.fonts);
     getValue(s, KeyScriptLog, c.scriptLog);
     getValue(s, KeyUseMultithreadedInitialization, c.useMultithreadedInitialization);
+    getValue(s, KeyUseDeltaSynchronization, c.useDeltaSynchronization);
     getValue(s, KeyCheckOpenGLState, c.isCheckingOpenGLState);
     getValue(s, KeyLogEachOpenGLCall, c.isLoggingOpenGLCalls);
     getValue(s, KeyShutdownCountdown, c.shutdownCountdown);
@@ -443,6 +443,16 @@ documentation::Documentation Configuration::Documentation = {
             "initialize in parallel. The only use for this value is to disable it for "
             "debugging support."
         },
+        {
+            KeyUseDeltaSynchronization,
+            new BoolVerifier,
+            Optional::Yes,
+            "If this value is 'true', only the values that have changed since the "
+            "previous frame are sent from the master to the other nodes of a cluster, "
+            "instead of all synchronized values. This reduces the amount of data that "
+            "has to be encoded and transmitted each frame. All nodes have to use the "
+            "same setting. This defaults to 'false'."
+        },
         {
             KeyLoadingScreen,
             new TableVerifier({
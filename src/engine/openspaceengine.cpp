@@ -60,6 +60,7 @@
 #include <openspace/util/factorymanager.h>
 #include <openspace/util/spicemanager.h>
 #include <openspace/util/task.h>
+#include <openspace/util/threadpool.h>
 #include <openspace/util/timemanager.h>
 #include <openspace/util/transformationmanager.h>
 #include <ghoul/ghoul.h>
@@ -78,6 +79,7 @@
 #include <ghoul/systemcapabilities/openglcapabilitiescomponent.h>
 #include <glbinding/callbacks.h>
 #include <numeric>
+#include <thread>
 
 #if defined(_MSC_VER) && defined(OPENSPACE_ENABLE_VLD)
 #include <vld.h>
@@ -164,6 +166,12 @@ OpenSpaceEngine::OpenSpaceEngine(std::string programName,
 {
     _rootPropertyOwner->addPropertySubOwner(_moduleEngine.get());
 
+    // The threads that use the compute pool take part in the work themselves
+    const unsigned int nThreads = std::thread::hardware_concurrency();
+    if (nThreads > 1) {
+        _computePool = std::make_unique<ThreadPool>(nThreads - 1);
+    }
+
     _navigationHandler->setPropertyOwner(_rootPropertyOwner.get());
     // New property subowners also have to be added to the ImGuiModule callback!
     _rootPropertyOwner->addPropertySubOwner(_navigationHandler.get());
@@ -348,6 +356,9 @@ void OpenSpaceEngine::create(int argc, char** argv,
         throw;
     }
 
+    _engine->_syncEngine->setDeltaEncoding(
+        _engine->_configuration->useDeltaSynchronization
+    );
 
     // Registering Path tokens. If the BASE path is set, it is the only one that will
     // overwrite the default path of the cfg directory
@@ -653,6 +664,7 @@ void OpenSpaceEngine::loadSingleAsset(const std::string& assetPath) {
     }
 
     _scene = std::make_unique<Scene>(std::move(sceneInitializer));
+    _scene->setUpdatePool(_computePool.get());
     _rootPropertyOwner->addPropertySubOwner(_scene.get());
     _scene->setCamera(std::make_unique<Camera>());
     Camera* camera = _scene->camera();
@@ -1719,4 +1731,8 @@ ScriptScheduler& OpenSpaceEngine::scriptScheduler() {
     return *_scriptScheduler;
 }
 
+ThreadPool* OpenSpaceEngine::computePool() {
+    return _computePool.get();
+}
+
 }  // namespace openspace
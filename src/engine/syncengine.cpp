@@ -27,6 +27,7 @@
 #include <openspace/util/syncdata.h>
 #include <ghoul/misc/assert.h>
 #include <algorithm>
+#include <limits>
 
 namespace openspace {
 
@@ -38,17 +39,45 @@ SyncEngine::SyncEngine(unsigned int syncBufferSize)
 
 // should be called on sgct master
 void SyncEngine::encodeSyncables() {
-    for (Syncable* syncable : _syncables) {
-        syncable->encode(&_syncBuffer);
+    if (_useDeltaEncoding) {
+        _dirtySyncables.clear();
+        for (size_t i = 0; i < _syncables.size(); ++i) {
+            if (_syncables[i]->isDirty()) {
+                _dirtySyncables.push_back(static_cast<uint16_t>(i));
+            }
+        }
+
+        _syncBuffer.encode(static_cast<uint16_t>(_dirtySyncables.size()));
+        for (uint16_t i : _dirtySyncables) {
+            _syncBuffer.encode(i);
+            _syncables[i]->encode(&_syncBuffer);
+        }
+    }
+    else {
+        for (Syncable* syncable : _syncables) {
+            syncable->encode(&_syncBuffer);
+        }
     }
+    _encodedSize = _syncBuffer.encodedSize();
     _syncBuffer.write();
 }
 
 //should be called on sgct slaves
 void SyncEngine::decodeSyncables() {
     _syncBuffer.read();
-    for (Syncable* syncable : _syncables) {
-        syncable->decode(&_syncBuffer);
+    if (_useDeltaEncoding) {
+        // Syncables that are not part of the buffer keep their previously decoded value
+        const uint16_t nSyncables = _syncBuffer.decode<uint16_t>();
+        for (uint16_t i = 0; i < nSyncables; ++i) {
+            const uint16_t index = _syncBuffer.decode<uint16_t>();
+            ghoul_assert(index < _syncables.size(), "Invalid Syncable index");
+            _syncables[index]->decode(&_syncBuffer);
+        }
+    }
+    else {
+        for (Syncable* syncable : _syncables) {
+            syncable->decode(&_syncBuffer);
+        }
     }
 }
 
@@ -66,6 +95,10 @@ void SyncEngine::postSynchronization(IsMaster isMaster) {
 
 void SyncEngine::addSyncable(Syncable* syncable) {
     ghoul_assert(syncable, "synable must not be nullptr");
+    ghoul_assert(
+        _syncables.size() < std::numeric_limits<uint16_t>::max(),
+        "Too many Syncables"
+    );
 
     _syncables.push_back(syncable);
 }
@@ -90,4 +123,12 @@ void SyncEngine::removeSyncables(const std::vector<Syncable*>& syncables) {
     }
 }
 
+void SyncEngine::setDeltaEncoding(bool enabled) {
+    _useDeltaEncoding = enabled;
+}
+
+size_t SyncEngine::encodedSize() const {
+    return _encodedSize;
+}
+
 } // namespace openspace
@@ -31,12 +31,25 @@
 #include <openspace/util/camera.h>
 #include <openspace/util/time.h>
 #include <ghoul/logging/logmanager.h>
+#include <algorithm>
+
+namespace {
+    // The maximum number of keyframe intervals that the camera motion is extrapolated if
+    // the next keyframe is late. After that, the camera stays at the predicted pose
+    constexpr const double MaxPredictedIntervals = 2.0;
+
+    // The time in seconds over which the difference between a predicted camera and the
+    // camera defined by a newly arrived keyframe is blended out
+    constexpr const double CorrectionTime = 0.25;
+} // namespace
 
 namespace openspace::interaction {
 
 void KeyframeNavigator::updateCamera(Camera& camera) {
-    double now = OsEng.windowWrapper().applicationTime();
+    updateCamera(camera, OsEng.windowWrapper().applicationTime());
+}
 
+void KeyframeNavigator::updateCamera(Camera& camera, double now) {
     if (_cameraPoseTimeline.nKeyframes() == 0) {
         return;
     }
@@ -46,26 +59,57 @@ void KeyframeNavigator::updateCamera(Camera& camera) {
     const Keyframe<CameraPose>* prevKeyframe =
                                               _cameraPoseTimeline.lastKeyframeBefore(now);
 
+    bool isPredicting = false;
     double nextTime = 0.0;
+    double prevTime = 0.0;
+    double t = 0.0;
     if (nextKeyframe) {
         nextTime = nextKeyframe->timestamp;
-    } else {
-        return;
-    }
 
-    double prevTime = 0.0;
-    double t = 0.0;
-    if (prevKeyframe) {
-        prevTime = prevKeyframe->timestamp;
-        t = (now - prevTime) / (nextTime - prevTime);
-    } else {
-        // If there is no keyframe before: Only use the next keyframe.
-        prevTime = nextTime;
-        prevKeyframe = nextKeyframe;
-        t = 1;
+        if (prevKeyframe) {
+            prevTime = prevKeyframe->timestamp;
+            t = (now - prevTime) / (nextTime - prevTime);
+        } else {
+            // If there is no keyframe before: Only use the next keyframe.
+            prevTime = nextTime;
+            prevKeyframe = nextKeyframe;
+            t = 1;
+        }
+
+        _cameraPoseTimeline.removeKeyframesBefore(prevTime);
+    }
+    else {
+        if (!_isPredictionEnabled || !prevKeyframe) {
+            return;
+        }
+
+        // The next keyframe is late, so we extrapolate the motion between the last two
+        // keyframes. If there is only a single keyframe, we stay at that keyframe
+        nextKeyframe = prevKeyframe;
+        nextTime = nextKeyframe->timestamp;
+        prevKeyframe = _cameraPoseTimeline.lastKeyframeBefore(nextTime);
+        if (prevKeyframe) {
+            prevTime = prevKeyframe->timestamp;
+            t = std::min(
+                (now - prevTime) / (nextTime - prevTime),
+                1.0 + MaxPredictedIntervals
+            );
+        }
+        else {
+            prevTime = nextTime;
+            prevKeyframe = nextKeyframe;
+            t = 1;
+        }
+
+        // A change of the focus node or the reference frame cannot be extrapolated
+        if (prevKeyframe->data.focusNode != nextKeyframe->data.focusNode ||
+            prevKeyframe->data.followFocusNodeRotation !=
+            nextKeyframe->data.followFocusNodeRotation)
+        {
+            t = 1;
+        }
+        isPredicting = true;
     }
-
-    _cameraPoseTimeline.removeKeyframesBefore(prevTime);
 
     const CameraPose& prevPose = prevKeyframe->data;
     const CameraPose& nextPose = nextKeyframe->data;
@@ -106,13 +150,48 @@ void KeyframeNavigator::updateCamera(Camera& camera) {
     prevKeyframeCameraPosition += prevFocusNode->worldPosition();
     nextKeyframeCameraPosition += nextFocusNode->worldPosition();
 
-    // Linear interpolation
-    camera.setPositionVec3(
-        prevKeyframeCameraPosition * (1 - t) + nextKeyframeCameraPosition * t
-    );
-    camera.setRotation(
-        glm::slerp(prevKeyframeCameraRotation, nextKeyframeCameraRotation, t)
-    );
+    // Linear interpolation, which extrapolates the motion relative to the focus node for
+    // t > 1
+    glm::dvec3 position =
+        prevKeyframeCameraPosition * (1 - t) + nextKeyframeCameraPosition * t;
+    glm::dquat rotation =
+        glm::slerp(prevKeyframeCameraRotation, nextKeyframeCameraRotation, t);
+    if (isPredicting) {
+        // For very small angles slerp falls back to an unnormalized linear interpolation
+        rotation = glm::normalize(rotation);
+    }
+
+    // If a new keyframe arrived while extrapolating, the prediction was off by the
+    // difference to the actual camera, which is blended out over the CorrectionTime
+    if (_wasPredicting &&
+        (!isPredicting || _predictionKeyframeTimestamp != nextTime))
+    {
+        _isCorrecting = true;
+        _correctionStartTime = now;
+        _positionCorrection = _lastPosition - position;
+        _rotationCorrection = _lastRotation * glm::inverse(rotation);
+    }
+    _wasPredicting = isPredicting;
+    _predictionKeyframeTimestamp = nextTime;
+
+    if (_isCorrecting) {
+        const double w = 1.0 - (now - _correctionStartTime) / CorrectionTime;
+        if (w > 0.0) {
+            // Smoothstep, so that the correction starts and ends without a jerk
+            const double s = w * w * (3.0 - 2.0 * w);
+            position += _positionCorrection * s;
+            const glm::dquat identity = glm::dquat(1.0, 0.0, 0.0, 0.0);
+            rotation = glm::slerp(identity, _rotationCorrection, s) * rotation;
+        }
+        else {
+            _isCorrecting = false;
+        }
+    }
+
+    _lastPosition = position;
+    _lastRotation = rotation;
+    camera.setPositionVec3(position);
+    camera.setRotation(rotation);
 
     // We want to affect view scaling, such that we achieve
     // logarithmic interpolation of distance to an imagined focus node.
@@ -138,10 +217,20 @@ void KeyframeNavigator::removeKeyframesAfter(double timestamp, Inclusive inclusi
 
 void KeyframeNavigator::clearKeyframes() {
     timeline().clearKeyframes();
+    _wasPredicting = false;
+    _isCorrecting = false;
 }
 
 size_t KeyframeNavigator::nKeyframes() const {
     return _cameraPoseTimeline.nKeyframes();
 }
 
+void KeyframeNavigator::setPredictionEnabled(bool enabled) {
+    _isPredictionEnabled = enabled;
+}
+
+bool KeyframeNavigator::isPredictionEnabled() const {
+    return _isPredictionEnabled;
+}
+
 } // namespace openspace::interaction
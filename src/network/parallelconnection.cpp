@@ -30,14 +30,36 @@
 #include <ghoul/fmt.h>
 #include <ghoul/io/socket/tcpsocket.h>
 #include <ghoul/logging/logmanager.h>
+#include <array>
+#include <cstring>
 
 namespace {
     constexpr const char* _loggerCat = "ParallelConnection";
+
+    // Data message type and timestamp
+    constexpr const size_t DataHeaderSize = sizeof(uint32_t) + sizeof(double);
+
+    void writeHeader(char*& destination, openspace::ParallelConnection::MessageType type,
+                     size_t size)
+    {
+        const uint32_t protocolVersion = openspace::ParallelConnection::ProtocolVersion;
+        const uint32_t messageTypeOut = static_cast<uint32_t>(type);
+        const uint32_t messageSizeOut = static_cast<uint32_t>(size);
+
+        *destination++ = 'O';
+        *destination++ = 'S';
+        memcpy(destination, &protocolVersion, sizeof(uint32_t));
+        destination += sizeof(uint32_t);
+        memcpy(destination, &messageTypeOut, sizeof(uint32_t));
+        destination += sizeof(uint32_t);
+        memcpy(destination, &messageSizeOut, sizeof(uint32_t));
+        destination += sizeof(uint32_t);
+    }
 } // namespace
 
 namespace openspace {
 
-const unsigned int ParallelConnection::ProtocolVersion = 5;
+const unsigned int ParallelConnection::ProtocolVersion = 6;
 
 ParallelConnection::Message::Message(MessageType t, std::vector<char> c)
     : type(t)
@@ -65,53 +87,39 @@ bool ParallelConnection::isConnectedOrConnecting() const {
 }
 
 void ParallelConnection::sendDataMessage(const DataMessage& dataMessage) {
-    const uint32_t dataMessageTypeOut = static_cast<uint32_t>(dataMessage.type);
-    const double dataMessageTimestamp = dataMessage.timestamp;
-
-    std::vector<char> messageContent;
-    messageContent.insert(
-        messageContent.end(),
-        reinterpret_cast<const char*>(&dataMessageTypeOut),
-        reinterpret_cast<const char*>(&dataMessageTypeOut) + sizeof(uint32_t)
-    );
-
-    messageContent.insert(
-        messageContent.end(),
-        reinterpret_cast<const char*>(&dataMessageTimestamp),
-        reinterpret_cast<const char*>(&dataMessageTimestamp) + sizeof(double)
+    sendDataMessage(
+        dataMessage.type,
+        dataMessage.timestamp,
+        dataMessage.content.data(),
+        dataMessage.content.size()
     );
+}
 
-    messageContent.insert(messageContent.end(),
-        dataMessage.content.begin(),
-        dataMessage.content.end()
-    );
+void ParallelConnection::sendDataMessage(datamessagestructures::Type type,
+                                         double timestamp, const char* data,
+                                         size_t size)
+{
+    // The message header, the data message header, and the content are put into the
+    // socket one after another, so the content does not have to be copied
+    std::array<char, HeaderSize + DataHeaderSize> header;
+    char* p = header.data();
+    writeHeader(p, MessageType::Data, DataHeaderSize + size);
+
+    const uint32_t dataMessageTypeOut = static_cast<uint32_t>(type);
+    memcpy(p, &dataMessageTypeOut, sizeof(uint32_t));
+    p += sizeof(uint32_t);
+    memcpy(p, &timestamp, sizeof(double));
 
-    sendMessage(Message(MessageType::Data, messageContent));
+    if (!_socket->put<char>(header.data(), header.size())) {
+        return;
+    }
+    _socket->put<char>(data, size);
 }
 
 bool ParallelConnection::sendMessage(const Message& message) {
-    const uint32_t messageTypeOut = static_cast<uint32_t>(message.type);
-    const uint32_t messageSizeOut = static_cast<uint32_t>(message.content.size());
-    std::vector<char> header;
-
-    //insert header into buffer
-    header.push_back('O');
-    header.push_back('S');
-
-    header.insert(header.end(),
-        reinterpret_cast<const char*>(&ProtocolVersion),
-        reinterpret_cast<const char*>(&ProtocolVersion) + sizeof(uint32_t)
-    );
-
-    header.insert(header.end(),
-        reinterpret_cast<const char*>(&messageTypeOut),
-        reinterpret_cast<const char*>(&messageTypeOut) + sizeof(uint32_t)
-    );
-
-    header.insert(header.end(),
-        reinterpret_cast<const char*>(&messageSizeOut),
-        reinterpret_cast<const char*>(&messageSizeOut) + sizeof(uint32_t)
-    );
+    std::array<char, HeaderSize> header;
+    char* p = header.data();
+    writeHeader(p, message.type, message.content.size());
 
     if (!_socket->put<char>(header.data(), header.size())) {
         return false;
@@ -133,13 +141,8 @@ ghoul::io::TcpSocket* ParallelConnection::socket() {
 }
 
 ParallelConnection::Message ParallelConnection::receiveMessage() {
-    // Header consists of...
-    constexpr size_t HeaderSize =
-        2 * sizeof(char) + // OS
-        3 * sizeof(uint32_t); // Protocol version, message type and message size
-
     // Create basic buffer for receiving first part of messages
-    std::vector<char> headerBuffer(HeaderSize);
+    std::array<char, HeaderSize> headerBuffer;
     std::vector<char> messageBuffer;
 
     // Receive the header data
@@ -148,15 +151,33 @@ ParallelConnection::Message ParallelConnection::receiveMessage() {
         throw ConnectionLostError();
     }
 
+    const std::pair<MessageType, size_t> header = readHeader(headerBuffer.data());
+    const MessageType messageType = header.first;
+    const size_t messageSize = header.second;
+
+    // Receive the payload
+    messageBuffer.resize(messageSize);
+    if (!_socket->get(messageBuffer.data(), messageSize)) {
+        LERROR("Failed to read message from socket. Disconencting.");
+        throw ConnectionLostError();
+    }
+
+    // And delegate decoding depending on type
+    return Message(messageType, std::move(messageBuffer));
+}
+
+std::pair<ParallelConnection::MessageType, size_t> ParallelConnection::readHeader(
+                                                                        const char* header)
+{
     // Make sure that header matches this version of OpenSpace
-    if (!(headerBuffer[0] == 'O' && headerBuffer[1] && 'S')) {
+    if (!(header[0] == 'O' && header[1] == 'S')) {
         LERROR("Expected to read message header 'OS' from socket.");
         throw ConnectionLostError();
     }
 
     size_t offset = 2;
-    const uint32_t protocolVersionIn =
-        *reinterpret_cast<uint32_t*>(headerBuffer.data() + offset);
+    uint32_t protocolVersionIn;
+    memcpy(&protocolVersionIn, header + offset, sizeof(uint32_t));
     offset += sizeof(uint32_t);
 
     if (protocolVersionIn != ProtocolVersion) {
@@ -168,25 +189,14 @@ ParallelConnection::Message ParallelConnection::receiveMessage() {
         throw ConnectionLostError();
     }
 
-    const uint32_t messageTypeIn =
-        *reinterpret_cast<uint32_t*>(headerBuffer.data() + offset);
-    offset += sizeof(uint32_t);
-
-    const uint32_t messageSizeIn =
-        *reinterpret_cast<uint32_t*>(headerBuffer.data() + offset);
+    uint32_t messageTypeIn;
+    memcpy(&messageTypeIn, header + offset, sizeof(uint32_t));
     offset += sizeof(uint32_t);
 
-    const size_t messageSize = messageSizeIn;
+    uint32_t messageSizeIn;
+    memcpy(&messageSizeIn, header + offset, sizeof(uint32_t));
 
-    // Receive the payload
-    messageBuffer.resize(messageSize);
-    if (!_socket->get(messageBuffer.data(), messageSize)) {
-        LERROR("Failed to read message from socket. Disconencting.");
-        throw ConnectionLostError();
-    }
-
-    // And delegate decoding depending on type
-    return Message(static_cast<MessageType>(messageTypeIn), messageBuffer);
+    return { static_cast<MessageType>(messageTypeIn), messageSizeIn };
 }
 
 } // namespace openspace
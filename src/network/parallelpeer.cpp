@@ -40,7 +40,6 @@
 #include "parallelpeer_lua.inl"
 
 namespace {
-    constexpr const uint32_t ProtocolVersion = 3;
     constexpr const size_t MaxLatencyDiffs = 64;
     constexpr const char* _loggerCat = "ParallelPeer";
 
@@ -95,6 +94,15 @@ namespace {
         "Camera Keyframe interval",
         "" // @TODO Missing documentation
     };
+
+    constexpr openspace::properties::Property::PropertyInfo PredictCameraInfo = {
+        "PredictCameraKeyframes",
+        "Predict camera keyframes",
+        "If this value is enabled, the camera of a client keeps moving with its last "
+        "known velocity if a camera keyframe from the host arrives late, instead of "
+        "stopping until the keyframe arrives. This allows for a smaller buffer time and "
+        "a larger camera keyframe interval on the host without a stuttering camera."
+    };
 } // namespace
 
 namespace openspace {
@@ -109,6 +117,7 @@ ParallelPeer::ParallelPeer()
     , _bufferTime(BufferTimeInfo, 0.2f, 0.01f, 5.0f)
     , _timeKeyframeInterval(TimeKeyFrameInfo, 0.1f, 0.f, 1.f)
     , _cameraKeyframeInterval(CameraKeyFrameInfo, 0.1f, 0.f, 1.f)
+    , _predictCameraKeyframes(PredictCameraInfo, false)
     , _connectionEvent(std::make_shared<ghoul::Event<>>())
     , _connection(nullptr)
 {
@@ -122,6 +131,13 @@ ParallelPeer::ParallelPeer()
 
     addProperty(_timeKeyframeInterval);
     addProperty(_cameraKeyframeInterval);
+
+    _predictCameraKeyframes.onChange([this]() {
+        OsEng.navigationHandler().keyframeNavigator().setPredictionEnabled(
+            _predictCameraKeyframes
+        );
+    });
+    addProperty(_predictCameraKeyframes);
 }
 
 ParallelPeer::~ParallelPeer() {
@@ -202,9 +218,9 @@ void ParallelPeer::sendAuthentication() {
     ));
 }
 
-void ParallelPeer::queueInMessage(const ParallelConnection::Message& message) {
+void ParallelPeer::queueInMessage(ParallelConnection::Message message) {
     std::lock_guard<std::mutex> unqlock(_receiveBufferMutex);
-    _receiveBuffer.push_back(message);
+    _receiveBuffer.push_back(std::move(message));
 }
 
 void ParallelPeer::handleMessage(const ParallelConnection::Message& message) {
@@ -264,6 +280,10 @@ double ParallelPeer::latencyStandardDeviation() const {
 
 void ParallelPeer::dataMessageReceived(const std::vector<char>& message)
 {
+    if (message.size() < sizeof(uint32_t) + sizeof(double)) {
+        LERROR("Malformed data message.");
+        return;
+    }
     size_t offset = 0;
 
     // The type of data message received
@@ -275,11 +295,25 @@ void ParallelPeer::dataMessageReceived(const std::vector<char>& message)
 
     analyzeTimeDifference(timestamp);
 
-    std::vector<char> buffer(message.begin() + offset, message.end());
+    // The content is read in place from the received message
+    handleDataMessage(
+        static_cast<datamessagestructures::Type>(type),
+        timestamp,
+        message.data() + offset,
+        message.size() - offset
+    );
+}
 
-    switch (static_cast<datamessagestructures::Type>(type)) {
+void ParallelPeer::handleDataMessage(datamessagestructures::Type type, double timestamp,
+                                     const char* data, size_t size)
+{
+    switch (type) {
         case datamessagestructures::Type::CameraData: {
-            datamessagestructures::CameraKeyframe kf(buffer);
+            datamessagestructures::CameraKeyframe kf;
+            if (kf.deserialize(data, size) == 0) {
+                LERROR("Received a malformed camera keyframe");
+                break;
+            }
             const double convertedTimestamp = convertTimestamp(kf._timestamp);
 
             OsEng.navigationHandler().keyframeNavigator().removeKeyframesAfter(
@@ -299,7 +333,11 @@ void ParallelPeer::dataMessageReceived(const std::vector<char>& message)
         }
         case datamessagestructures::Type::TimelineData: {
             const double now = OsEng.windowWrapper().applicationTime();
-            datamessagestructures::TimeTimeline timelineMessage(buffer);
+            datamessagestructures::TimeTimeline timelineMessage;
+            if (timelineMessage.deserialize(data, size) == 0) {
+                LERROR("Received a malformed time timeline");
+                break;
+            }
 
             if (timelineMessage._clear) {
                 OsEng.timeManager().removeKeyframesAfter(
@@ -344,7 +382,7 @@ void ParallelPeer::dataMessageReceived(const std::vector<char>& message)
         }
         case datamessagestructures::Type::ScriptData: {
             datamessagestructures::ScriptMessage sm;
-            sm.deserialize(buffer);
+            sm.deserialize(data, size);
 
             OsEng.scriptEngine().queueScript(
                 sm._script,
@@ -352,10 +390,28 @@ void ParallelPeer::dataMessageReceived(const std::vector<char>& message)
             );
             break;
         }
+        case datamessagestructures::Type::Batch: {
+            const bool success = datamessagestructures::Batch::forEach(
+                data,
+                size,
+                [this, timestamp](datamessagestructures::Type messageType,
+                                  const char* messageData, size_t messageSize)
+                {
+                    handleDataMessage(messageType, timestamp, messageData, messageSize);
+                }
+            );
+            if (!success) {
+                LERROR(
+                    "Received a malformed message batch or a batch from an incompatible "
+                    "version of OpenSpace"
+                );
+            }
+            break;
+        }
         default: {
             LERROR(fmt::format(
                 "Unidentified message with identifier {} received in parallel connection",
-                type
+                static_cast<uint32_t>(type)
             ));
             break;
         }
@@ -424,7 +480,7 @@ void ParallelPeer::handleCommunication() {
     while (!_shouldDisconnect && _connection.isConnectedOrConnecting()) {
         try {
             ParallelConnection::Message m = _connection.receiveMessage();
-            queueInMessage(m);
+            queueInMessage(std::move(m));
         } catch (const ParallelConnection::ConnectionLostError&) {
             LERROR("Parallel connection lost");
         }
@@ -486,16 +542,8 @@ void ParallelPeer::sendScript(std::string script) {
     datamessagestructures::ScriptMessage sm;
     sm._script = std::move(script);
 
-    std::vector<char> buffer;
-    sm.serialize(buffer);
-
-    double timestamp = OsEng.windowWrapper().applicationTime();
-    ParallelConnection::DataMessage message(
-        datamessagestructures::Type::ScriptData,
-        timestamp,
-        buffer
-    );
-    _connection.sendDataMessage(message);
+    // The script is sent together with the keyframes in the next preSynchronization
+    _sendBatch.add(datamessagestructures::Type::ScriptData, sm);
 }
 
 void ParallelPeer::resetTimeOffset() {
@@ -529,6 +577,8 @@ void ParallelPeer::preSynchronization() {
             _timeTimelineChanged = false;
         }
     }
+    sendBatch();
+
     if (_shouldDisconnect) {
         disconnect();
     }
@@ -594,7 +644,7 @@ void ParallelPeer::sendCameraKeyframe() {
     }
 
     // Create a keyframe with current position and orientation of camera
-    datamessagestructures::CameraKeyframe kf;
+    datamessagestructures::CameraKeyframe& kf = _cameraKeyframe;
     kf._position = OsEng.navigationHandler().focusNodeToCameraVector();
 
     kf._followNodeRotation =
@@ -613,19 +663,7 @@ void ParallelPeer::sendCameraKeyframe() {
     // Timestamp as current runtime of OpenSpace instance
     kf._timestamp = OsEng.windowWrapper().applicationTime();
 
-    // Create a buffer for the keyframe
-    std::vector<char> buffer;
-
-    // Fill the keyframe buffer
-    kf.serialize(buffer);
-
-    const double timestamp = OsEng.windowWrapper().applicationTime();
-    // Send message
-    _connection.sendDataMessage(ParallelConnection::DataMessage(
-        datamessagestructures::Type::CameraData,
-        timestamp,
-        buffer
-    ));
+    _sendBatch.add(datamessagestructures::Type::CameraData, kf);
 }
 
 void ParallelPeer::sendTimeTimeline() {
@@ -633,9 +671,9 @@ void ParallelPeer::sendTimeTimeline() {
     const Timeline<TimeKeyframeData> timeline = OsEng.timeManager().timeline();
     std::deque<Keyframe<TimeKeyframeData>> keyframes = timeline.keyframes();
 
-    datamessagestructures::TimeTimeline timelineMessage;
+    datamessagestructures::TimeTimeline& timelineMessage = _timeline;
     timelineMessage._clear = true;
-    timelineMessage._keyframes.reserve(timeline.nKeyframes());
+    timelineMessage._keyframes.clear();
 
     // Case 1: Copy all keyframes from the native timeline
     for (size_t i = 0; i < timeline.nKeyframes(); ++i) {
@@ -662,19 +700,23 @@ void ParallelPeer::sendTimeTimeline() {
         kfMessage._requiresTimeJump = _timeJumped;
         timelineMessage._keyframes.push_back(kfMessage);
     }
-    // Create a buffer for the keyframe
-    std::vector<char> buffer;
 
-    // Fill the timeline buffer
-    timelineMessage.serialize(buffer);
+    _sendBatch.add(datamessagestructures::Type::TimelineData, timelineMessage);
+}
 
-    double timestamp = OsEng.windowWrapper().applicationTime();
-    // Send message
-    _connection.sendDataMessage(ParallelConnection::DataMessage(
-        datamessagestructures::Type::TimelineData,
-        timestamp,
-        buffer
-    ));
+void ParallelPeer::sendBatch() {
+    if (_sendBatch.empty()) {
+        return;
+    }
+
+    const std::vector<char>& buffer = _sendBatch.buffer();
+    _connection.sendDataMessage(
+        datamessagestructures::Type::Batch,
+        OsEng.windowWrapper().applicationTime(),
+        buffer.data(),
+        buffer.size()
+    );
+    _sendBatch.clear();
 }
 
 ghoul::Event<>& ParallelPeer::connectionEvent() {
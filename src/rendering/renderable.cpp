@@ -140,6 +140,10 @@ void Renderable::deinitializeGL() {}
 
 void Renderable::update(const UpdateData&) {}
 
+bool Renderable::supportsConcurrentUpdate() const {
+    return false;
+}
+
 void Renderable::render(const RenderData&, RendererTasks&) {}
 
 void Renderable::setBoundingSphere(float boundingSphere) {
@@ -84,6 +84,10 @@ bool Rotation::initialize() {
     return true;
 }
 
+bool Rotation::supportsConcurrentUpdate() const {
+    return false;
+}
+
 const glm::dmat3& Rotation::matrix() const {
     return _cachedMatrix;
 }
@@ -33,10 +33,14 @@
 #include <openspace/scene/sceneinitializer.h>
 #include <openspace/scripting/lualibrary.h>
 #include <openspace/util/camera.h>
+#include <openspace/util/threadpool.h>
 
 #include <ghoul/opengl/programobject.h>
 #include <ghoul/logging/logmanager.h>
 
+#include <algorithm>
+#include <exception>
+#include <mutex>
 #include <string>
 #include <stack>
 
@@ -46,6 +50,10 @@ namespace {
     constexpr const char* _loggerCat = "Scene";
     constexpr const char* KeyIdentifier = "Identifier";
     constexpr const char* KeyParent = "Parent";
+
+    // Updating a node is cheap, so a task has to update a reasonable number of nodes to
+    // amortize the overhead of scheduling it on the update pool
+    constexpr const size_t MinNodesPerTask = 8;
 } // namespace
 
 namespace openspace {
@@ -84,6 +92,10 @@ Camera* Scene::camera() const {
     return _camera.get();
 }
 
+void Scene::setUpdatePool(ThreadPool* pool) {
+    _updatePool = pool;
+}
+
 void Scene::registerNode(SceneGraphNode* node) {
     if (_nodesByIdentifier.count(node->identifier())) {
         throw Scene::InvalidSceneError(
@@ -142,6 +154,7 @@ void Scene::sortTopologically() {
         "Number of scene graph nodes is inconsistent"
     );
 
+    _updateLevels.clear();
     if (_topologicallySortedNodes.empty()) {
         return;
     }
@@ -200,6 +213,35 @@ void Scene::sortTopologically() {
     }
 
     _topologicallySortedNodes = nodes;
+
+    // A node's level is one more than the highest level of any node it depends on, so
+    // all nodes of a level can be updated independently once the previous levels are
+    // done. As the nodes are sorted topologically, all of these are already assigned
+    std::unordered_map<SceneGraphNode*, size_t> levels;
+    for (SceneGraphNode* node : _topologicallySortedNodes) {
+        size_t level = 0;
+        if (node->parent()) {
+            level = levels[node->parent()] + 1;
+        }
+        for (SceneGraphNode* dependency : node->dependencies()) {
+            level = std::max(level, levels[dependency] + 1);
+        }
+        levels[node] = level;
+
+        if (level >= _updateLevels.size()) {
+            _updateLevels.resize(level + 1);
+        }
+        UpdateLevel& l = _updateLevels[level];
+        if (!node->supportsConcurrentTransformUpdate()) {
+            l.serialNodes.push_back(node);
+        }
+        else if (!node->supportsConcurrentRenderableUpdate()) {
+            l.concurrentTransformNodes.push_back(node);
+        }
+        else {
+            l.concurrentNodes.push_back(node);
+        }
+    }
 }
 
 void Scene::initializeNode(SceneGraphNode* node) {
@@ -292,11 +334,117 @@ void Scene::update(const UpdateData& data) {
     if (_dirtyNodeRegistry) {
         updateNodeRegistry();
     }
-    for (SceneGraphNode* node : _topologicallySortedNodes) {
+
+    // The performance measurements synchronize with the GPU, which requires the updates
+    // to happen on this thread
+    _nRecomputedWorldTransforms = 0;
+    if (!_updatePool || data.doPerformanceMeasurement) {
+        size_t nRecomputed = 0;
+        for (SceneGraphNode* node : _topologicallySortedNodes) {
+            try {
+                LTRACE("Scene::update(begin '" + node->identifier() + "')");
+                node->update(data);
+                LTRACE("Scene::update(end '" + node->identifier() + "')");
+                if (node->hasRecomputedWorldTransform()) {
+                    ++nRecomputed;
+                }
+            }
+            catch (const ghoul::RuntimeError& e) {
+                LERRORC(e.component, e.what());
+            }
+        }
+        _nRecomputedWorldTransforms = nRecomputed;
+        return;
+    }
+
+    for (size_t level = 0; level < _updateLevels.size(); ++level) {
+        updateLevel(data, level);
+    }
+}
+
+void Scene::updateLevel(const UpdateData& data, size_t level) {
+    const UpdateLevel& l = _updateLevels[level];
+
+    const size_t nConcurrent = l.concurrentNodes.size();
+    const size_t nNodes = nConcurrent + l.concurrentTransformNodes.size();
+
+    // Any other exception than a RuntimeError aborts the serial update, so it is passed
+    // on to the calling thread instead of getting lost on a worker thread
+    std::exception_ptr exception;
+    std::mutex exceptionMutex;
+    auto update = [this, &l, &data, nConcurrent, &exception, &exceptionMutex]
+                  (size_t begin, size_t end)
+    {
+        size_t nRecomputed = 0;
+        for (size_t i = begin; i < end; ++i) {
+            SceneGraphNode* node = i < nConcurrent ?
+                l.concurrentNodes[i] :
+                l.concurrentTransformNodes[i - nConcurrent];
+            try {
+                if (i < nConcurrent) {
+                    node->update(data);
+                }
+                else {
+                    node->updateTransform(data);
+                }
+                if (node->hasRecomputedWorldTransform()) {
+                    ++nRecomputed;
+                }
+            }
+            catch (const ghoul::RuntimeError& e) {
+                LERRORC(e.component, e.what());
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(exceptionMutex);
+                if (!exception) {
+                    exception = std::current_exception();
+                }
+                break;
+            }
+        }
+        _nRecomputedWorldTransforms += nRecomputed;
+    };
+
+    if (!_updatePool || nNodes < 2 * MinNodesPerTask) {
+        update(0, nNodes);
+    }
+    else {
+        const size_t nTasks = std::min(
+            _updatePool->numThreads() + 1,
+            nNodes / MinNodesPerTask
+        );
+        const size_t nodesPerTask = (nNodes + nTasks - 1) / nTasks;
+        parallelFor(
+            _updatePool,
+            nTasks,
+            [&update, nodesPerTask, nNodes](size_t task) {
+                const size_t begin = task * nodesPerTask;
+                update(begin, std::min(begin + nodesPerTask, nNodes));
+            }
+        );
+    }
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+
+    // The remaining updates are not thread-safe, but only depend on previous levels and
+    // the transformations computed above
+    for (SceneGraphNode* node : l.concurrentTransformNodes) {
+        try {
+            node->updateRenderable(data);
+        }
+        catch (const ghoul::RuntimeError& e) {
+            LERRORC(e.component, e.what());
+        }
+    }
+    for (SceneGraphNode* node : l.serialNodes) {
         try {
             LTRACE("Scene::update(begin '" + node->identifier() + "')");
             node->update(data);
             LTRACE("Scene::update(end '" + node->identifier() + "')");
+            if (node->hasRecomputedWorldTransform()) {
+                ++_nRecomputedWorldTransforms;
+            }
         }
         catch (const ghoul::RuntimeError& e) {
             LERRORC(e.component, e.what());
@@ -304,6 +452,10 @@ void Scene::update(const UpdateData& data) {
     }
 }
 
+size_t Scene::nRecomputedWorldTransforms() const {
+    return _nRecomputedWorldTransforms;
+}
+
 void Scene::render(const RenderData& data, RendererTasks& tasks) {
     for (SceneGraphNode* node : _topologicallySortedNodes) {
         try {
@@ -277,11 +277,24 @@ void SceneGraphNode::traversePostOrder(const std::function<void(SceneGraphNode*)
 }
 
 void SceneGraphNode::update(const UpdateData& data) {
+    updateTransform(data);
+    updateRenderable(data);
+}
+
+bool SceneGraphNode::isUpdateActive(const UpdateData& data) const {
     State s = _state;
-    if (s != State::Initialized && _state != State::GLInitialized) {
-        return;
+    if (s != State::Initialized && s != State::GLInitialized) {
+        return false;
     }
-    if (!isTimeFrameActive(data.time)) {
+    return isTimeFrameActive(data.time);
+}
+
+void SceneGraphNode::updateTransform(const UpdateData& data) {
+    if (!isUpdateActive(data)) {
+        // The local transformation is not updated, but the children of this node build
+        // their world transformation from this node's cached one, which therefore has to
+        // follow the changes of the ancestors
+        _hasRecomputedWorldTransform = updateWorldTransform();
         return;
     }
 
@@ -332,34 +345,20 @@ void SceneGraphNode::update(const UpdateData& data) {
             _transform.scale->update(data);
         }
     }
-    UpdateData newUpdateData = data;
 
-    _worldRotationCached = calculateWorldRotation();
-    _worldScaleCached = calculateWorldScale();
-    // Assumes _worldRotationCached and _worldScaleCached have been calculated for parent
-    _worldPositionCached = calculateWorldPosition();
+    _hasRecomputedWorldTransform = updateWorldTransform();
+}
 
+void SceneGraphNode::updateRenderable(const UpdateData& data) {
+    if (!isUpdateActive(data)) {
+        return;
+    }
+
+    UpdateData newUpdateData = data;
     newUpdateData.modelTransform.translation = worldPosition();
     newUpdateData.modelTransform.rotation = worldRotationMatrix();
     newUpdateData.modelTransform.scale = worldScale();
 
-    glm::dmat4 translation = glm::translate(
-        glm::dmat4(1.0),
-        newUpdateData.modelTransform.translation
-    );
-    glm::dmat4 rotation = glm::dmat4(newUpdateData.modelTransform.rotation);
-    glm::dmat4 scaling = glm::scale(
-        glm::dmat4(1.0),
-        glm::dvec3(
-            newUpdateData.modelTransform.scale,
-            newUpdateData.modelTransform.scale,
-            newUpdateData.modelTransform.scale
-        )
-    );
-
-    _modelTransformCached = translation * rotation * scaling;
-    _inverseModelTransformCached = glm::inverse(_modelTransformCached);
-
     if (_renderable && _renderable->isReady()) {
         if (data.doPerformanceMeasurement) {
             glFinish();
@@ -377,6 +376,16 @@ void SceneGraphNode::update(const UpdateData& data) {
     }
 }
 
+bool SceneGraphNode::supportsConcurrentTransformUpdate() const {
+    return (!_transform.translation || _transform.translation->supportsConcurrentUpdate())
+        && (!_transform.rotation || _transform.rotation->supportsConcurrentUpdate())
+        && (!_transform.scale || _transform.scale->supportsConcurrentUpdate());
+}
+
+bool SceneGraphNode::supportsConcurrentRenderableUpdate() const {
+    return !_renderable || _renderable->supportsConcurrentUpdate();
+}
+
 void SceneGraphNode::render(const RenderData& data, RendererTasks& tasks) {
     if (_state != State::GLInitialized) {
         return;
@@ -437,6 +446,7 @@ void SceneGraphNode::attachChild(std::unique_ptr<SceneGraphNode> child) {
 
     // Create link between parent and child
     child->_parent = this;
+    child->_isWorldTransformDirty = true;
     SceneGraphNode* childRaw = child.get();
     _children.push_back(std::move(child));
 
@@ -618,19 +628,67 @@ bool SceneGraphNode::hasGuiHintHidden() const {
     return _guiHintHidden;
 }
 
-glm::dvec3 SceneGraphNode::calculateWorldPosition() const {
-    // recursive up the hierarchy if there are parents available
+bool SceneGraphNode::updateWorldTransform() {
+    const glm::dvec3& position = _transform.translation->position();
+    const glm::dmat3& rotation = _transform.rotation->matrix();
+    const double scale = _transform.scale->scaleValue();
+
+    // The world transformation only depends on the local transformation and the world
+    // transformation of the parent, which has already been updated at this point
+    const bool parentChanged = _parent &&
+        _parent->_worldTransformVersion != _parentWorldTransformVersion;
+    const bool localChanged = position != _localPositionCached ||
+        rotation != _localRotationCached || scale != _localScaleCached;
+    if (!_isWorldTransformDirty && !parentChanged && !localChanged) {
+        return false;
+    }
+    _isWorldTransformDirty = false;
+    _localPositionCached = position;
+    _localRotationCached = rotation;
+    _localScaleCached = scale;
+
+    glm::dvec3 worldPosition = position;
+    glm::dmat3 worldRotation = rotation;
+    double worldScale = scale;
     if (_parent) {
-        const glm::dvec3 wp = _parent->calculateWorldPosition();
-        const glm::dmat3 wrot = _parent->worldRotationMatrix();
-        const double ws = _parent->worldScale();
-        const glm::dvec3 p = position();
+        _parentWorldTransformVersion = _parent->_worldTransformVersion;
 
-        return wp + wrot * ws * p;
+        const glm::dvec3& wp = _parent->_worldPositionCached;
+        const glm::dmat3& wrot = _parent->_worldRotationCached;
+        const double ws = _parent->_worldScaleCached;
+
+        worldPosition = wp + wrot * ws * position;
+        worldRotation = rotation * wrot;
+        worldScale = ws * scale;
     }
-    else {
-        return position();
+
+    if (worldPosition == _worldPositionCached && worldRotation == _worldRotationCached &&
+        worldScale == _worldScaleCached && _worldTransformVersion != 0)
+    {
+        // Recomputing yielded the same world transformation, so the children do not
+        // need to be recomputed either
+        return true;
     }
+
+    _worldPositionCached = worldPosition;
+    _worldRotationCached = worldRotation;
+    _worldScaleCached = worldScale;
+    ++_worldTransformVersion;
+
+    glm::dmat4 translation = glm::translate(glm::dmat4(1.0), _worldPositionCached);
+    glm::dmat4 rotationMatrix = glm::dmat4(_worldRotationCached);
+    glm::dmat4 scaling = glm::scale(
+        glm::dmat4(1.0),
+        glm::dvec3(_worldScaleCached, _worldScaleCached, _worldScaleCached)
+    );
+
+    _modelTransformCached = translation * rotationMatrix * scaling;
+    _inverseModelTransformCached = glm::inverse(_modelTransformCached);
+    return true;
+}
+
+bool SceneGraphNode::hasRecomputedWorldTransform() const {
+    return _hasRecomputedWorldTransform;
 }
 
 bool SceneGraphNode::isTimeFrameActive(const Time& time) const {
@@ -647,26 +705,6 @@ bool SceneGraphNode::isTimeFrameActive(const Time& time) const {
     return !_timeFrame || _timeFrame->isActive(time);
 }
 
-glm::dmat3 SceneGraphNode::calculateWorldRotation() const {
-    // recursive up the hierarchy if there are parents available
-    if (_parent) {
-        return rotationMatrix() * _parent->calculateWorldRotation();
-    }
-    else {
-        return rotationMatrix();
-    }
-}
-
-double SceneGraphNode::calculateWorldScale() const {
-    // recursive up the hierarchy if there are parents available
-    if (_parent) {
-        return _parent->calculateWorldScale() * scale();
-    }
-    else {
-        return scale();
-    }
-}
-
 SceneGraphNode* SceneGraphNode::parent() const {
     return _parent;
 }
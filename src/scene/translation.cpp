@@ -77,6 +77,10 @@ bool Translation::initialize() {
     return true;
 }
 
+bool Translation::supportsConcurrentUpdate() const {
+    return false;
+}
+
 void Translation::update(const UpdateData& data) {
     if (!_needsUpdate && data.time.j2000Seconds() == _cachedTime) {
         return;
@@ -95,6 +99,14 @@ glm::dvec3 Translation::position() const {
     return _cachedPosition;
 }
 
+void Translation::positions(const double* times, size_t nTimes,
+                            glm::dvec3* positions) const
+{
+    for (size_t i = 0; i < nTimes; ++i) {
+        positions[i] = position({ {}, times[i], 0.0, false });
+    }
+}
+
 void Translation::notifyObservers() const {
     if (_onParameterChangeCallback) {
         _onParameterChangeCallback();
@@ -640,6 +640,11 @@ void ScriptEngine::preSync(bool isMaster) {
     _mutex.unlock();
 }
 
+bool ScriptEngine::isDirty() const {
+    // Every script has to be sent, even if it is identical to the previous one
+    return !_currentSyncedScript.empty();
+}
+
 void ScriptEngine::encode(SyncBuffer* syncBuffer) {
     syncBuffer->encode(_currentSyncedScript);
     _currentSyncedScript.clear();
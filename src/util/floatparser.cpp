@@ -0,0 +1,248 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2018                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <openspace/util/floatparser.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OPENSPACE_FLOATPARSER_SSE2
+#include <emmintrin.h>
+#ifdef WIN32
+#include <intrin.h>
+#endif // WIN32
+#endif
+
+namespace {
+    // All powers of ten that are exactly representable as a double
+    constexpr const std::array<double, 23> Powers = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14,
+        1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    // More digits than this do not fit into the 64 bit mantissa
+    constexpr const int MaxMantissaDigits = 19;
+
+    bool isDigit(char c) {
+        return static_cast<unsigned char>(c - '0') < 10;
+    }
+
+    bool isBlank(char c) {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+#ifdef OPENSPACE_FLOATPARSER_SSE2
+    int countTrailingZeros(unsigned int mask) {
+#ifdef WIN32
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return static_cast<int>(index);
+#else // WIN32
+        return __builtin_ctz(mask);
+#endif // WIN32
+    }
+#endif // OPENSPACE_FLOATPARSER_SSE2
+} // namespace
+
+namespace openspace {
+
+const char* skipBlanks(const char* first, const char* last) {
+    // Most numbers are separated by a single blank, so check the first two characters
+    // before setting up the vectorized search for long runs of blanks used for alignment
+    for (int i = 0; i < 2; ++i) {
+        if (first == last || !isBlank(*first)) {
+            return first;
+        }
+        ++first;
+    }
+
+#ifdef OPENSPACE_FLOATPARSER_SSE2
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i carriageReturn = _mm_set1_epi8('\r');
+    while (last - first >= 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+        const __m128i blanks = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, space), _mm_cmpeq_epi8(chunk, tab)),
+            _mm_cmpeq_epi8(chunk, carriageReturn)
+        );
+        const unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(blanks));
+        if (mask != 0xFFFF) {
+            return first + countTrailingZeros(~mask);
+        }
+        first += 16;
+    }
+#endif // OPENSPACE_FLOATPARSER_SSE2
+
+    while (first != last && isBlank(*first)) {
+        ++first;
+    }
+    return first;
+}
+
+const char* parseFloat(const char* first, const char* last, float& value) {
+    const char* p = first;
+
+    bool isNegative = false;
+    if (p != last && (*p == '-' || *p == '+')) {
+        isNegative = (*p == '-');
+        ++p;
+    }
+
+    // Accumulate the significant digits into an integer and keep track of the decimal
+    // exponent that has to be applied to it
+    uint64_t mantissa = 0;
+    int nMantissaDigits = 0;
+    int exponent = 0;
+    bool hasDigits = false;
+    bool isTruncated = false;
+
+    while (p != last && isDigit(*p)) {
+        hasDigits = true;
+        if (nMantissaDigits < MaxMantissaDigits) {
+            mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+            nMantissaDigits += (mantissa != 0) ? 1 : 0;
+        }
+        else {
+            ++exponent;
+            isTruncated = true;
+        }
+        ++p;
+    }
+
+    if (p != last && *p == '.') {
+        ++p;
+        while (p != last && isDigit(*p)) {
+            hasDigits = true;
+            if (nMantissaDigits < MaxMantissaDigits) {
+                mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+                nMantissaDigits += (mantissa != 0) ? 1 : 0;
+                --exponent;
+            }
+            else {
+                isTruncated = true;
+            }
+            ++p;
+        }
+    }
+
+    if (!hasDigits) {
+        return first;
+    }
+
+    if (p != last && (*p == 'e' || *p == 'E')) {
+        // The exponent is only consumed if it contains at least one digit, otherwise
+        // the 'e' belongs to whatever follows the number
+        const char* e = p + 1;
+        bool isNegativeExponent = false;
+        if (e != last && (*e == '-' || *e == '+')) {
+            isNegativeExponent = (*e == '-');
+            ++e;
+        }
+        if (e != last && isDigit(*e)) {
+            int explicitExponent = 0;
+            while (e != last && isDigit(*e)) {
+                if (explicitExponent < 100000) {
+                    explicitExponent = explicitExponent * 10 + (*e - '0');
+                }
+                ++e;
+            }
+            exponent += isNegativeExponent ? -explicitExponent : explicitExponent;
+            p = e;
+        }
+    }
+
+    double result = static_cast<double>(mantissa);
+    constexpr const uint64_t MaxExactMantissa = uint64_t(1) << 53;
+    constexpr const int MaxExactExponent = static_cast<int>(Powers.size()) - 1;
+    if (!isTruncated && mantissa < MaxExactMantissa &&
+        exponent >= -MaxExactExponent && exponent <= MaxExactExponent)
+    {
+        // Both the mantissa and the power of ten are exact, so a single rounding step
+        // produces the correctly rounded double
+        result = (exponent < 0) ? result / Powers[-exponent] : result * Powers[exponent];
+    }
+    else if (mantissa != 0) {
+        // Outside of the exact range the result is accurate to a few double ulps, which
+        // is far below the precision of the float that is returned
+        result *= std::pow(10.0, exponent);
+    }
+
+    value = static_cast<float>(isNegative ? -result : result);
+    return p;
+}
+
+size_t parseFloats(const char* first, const char* last, float* values, size_t nValues) {
+    size_t i = 0;
+    while (i < nValues) {
+        first = skipBlanks(first, last);
+        const char* next = parseFloat(first, last, values[i]);
+        if (next == first) {
+            break;
+        }
+        first = next;
+        ++i;
+    }
+    return i;
+}
+
+size_t parseFloatBlock(const char* first, const char* last, size_t nValuesPerLine,
+                       std::vector<float>& result)
+{
+    if (first == last) {
+        return 0;
+    }
+
+    // Reserve for the upper bound of records so that growing the result while parsing
+    // does not reallocate
+    const size_t nLines = std::count(first, last, '\n') + 1;
+    result.reserve(result.size() + nLines * nValuesPerLine);
+
+    size_t nRecords = 0;
+    while (first != last) {
+        const char* lineEnd = static_cast<const char*>(
+            std::memchr(first, '\n', static_cast<size_t>(last - first))
+        );
+        if (!lineEnd) {
+            lineEnd = last;
+        }
+
+        const char* p = skipBlanks(first, lineEnd);
+        if (p != lineEnd && *p != '#') {
+            const size_t offset = result.size();
+            result.resize(offset + nValuesPerLine, 0.f);
+            parseFloats(p, lineEnd, result.data() + offset, nValuesPerLine);
+            ++nRecords;
+        }
+
+        first = (lineEnd == last) ? last : lineEnd + 1;
+    }
+    return nRecords;
+}
+
+} // namespace openspace
@@ -85,6 +85,19 @@ bool Histogram::add(float value, float repeat) {
     return true;
 }
 
+bool Histogram::addToBin(int binIndex, uint64_t count) {
+    if (binIndex < 0 || binIndex >= _numBins) {
+        // Out of range
+        return false;
+    }
+
+    // A double holds every count up to 2^53 exactly, so only the result is rounded
+    _data[binIndex] = static_cast<float>(static_cast<double>(_data[binIndex]) + count);
+    _numValues = static_cast<int>(_numValues + count);
+
+    return true;
+}
+
 void Histogram::changeRange(float minValue, float maxValue){
     if (minValue > _minValue && maxValue < _maxValue) {
         return;
@@ -0,0 +1,191 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2018                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <openspace/util/memorymappedfile.h>
+
+#include <ghoul/misc/exception.h>
+#include <utility>
+
+#ifdef WIN32
+#include <Windows.h>
+#else // WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // WIN32
+
+namespace {
+    constexpr const char* _loggerCat = "MemoryMappedFile";
+} // namespace
+
+namespace openspace {
+
+MemoryMappedFile::MemoryMappedFile(const std::string& path) {
+    open(path);
+}
+
+MemoryMappedFile::~MemoryMappedFile() {
+    close();
+}
+
+MemoryMappedFile::MemoryMappedFile(MemoryMappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+MemoryMappedFile& MemoryMappedFile::operator=(MemoryMappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        _path = std::move(other._path);
+        _data = std::exchange(other._data, nullptr);
+        _size = std::exchange(other._size, 0);
+        _isOpen = std::exchange(other._isOpen, false);
+#ifdef WIN32
+        _fileHandle = std::exchange(other._fileHandle, nullptr);
+        _mappingHandle = std::exchange(other._mappingHandle, nullptr);
+#else // WIN32
+        _fileDescriptor = std::exchange(other._fileDescriptor, -1);
+#endif // WIN32
+    }
+    return *this;
+}
+
+void MemoryMappedFile::open(const std::string& path) {
+    close();
+
+#ifdef WIN32
+    HANDLE file = CreateFileA(
+        path.c_str(),
+        GENERIC_READ,
+        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr
+    );
+    if (file == INVALID_HANDLE_VALUE) {
+        throw ghoul::RuntimeError("Could not open file '" + path + "'", _loggerCat);
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        throw ghoul::RuntimeError("Could not query size of '" + path + "'", _loggerCat);
+    }
+
+    _fileHandle = file;
+    _size = static_cast<size_t>(size.QuadPart);
+    if (_size > 0) {
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) {
+            CloseHandle(file);
+            _fileHandle = nullptr;
+            throw ghoul::RuntimeError("Could not map file '" + path + "'", _loggerCat);
+        }
+        _mappingHandle = mapping;
+        _data = reinterpret_cast<const char*>(
+            MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)
+        );
+        if (!_data) {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            _mappingHandle = nullptr;
+            _fileHandle = nullptr;
+            throw ghoul::RuntimeError("Could not map file '" + path + "'", _loggerCat);
+        }
+    }
+#else // WIN32
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        throw ghoul::RuntimeError("Could not open file '" + path + "'", _loggerCat);
+    }
+
+    struct stat status;
+    if (fstat(fd, &status) == -1) {
+        ::close(fd);
+        throw ghoul::RuntimeError("Could not query size of '" + path + "'", _loggerCat);
+    }
+
+    _fileDescriptor = fd;
+    _size = static_cast<size_t>(status.st_size);
+    if (_size > 0) {
+        void* data = mmap(nullptr, _size, PROT_READ, MAP_SHARED, fd, 0);
+        if (data == MAP_FAILED) {
+            ::close(fd);
+            _fileDescriptor = -1;
+            throw ghoul::RuntimeError("Could not map file '" + path + "'", _loggerCat);
+        }
+        _data = reinterpret_cast<const char*>(data);
+    }
+#endif // WIN32
+
+    _path = path;
+    _isOpen = true;
+}
+
+void MemoryMappedFile::close() {
+    if (!_isOpen) {
+        return;
+    }
+
+#ifdef WIN32
+    if (_data) {
+        UnmapViewOfFile(_data);
+    }
+    if (_mappingHandle) {
+        CloseHandle(_mappingHandle);
+    }
+    CloseHandle(_fileHandle);
+    _mappingHandle = nullptr;
+    _fileHandle = nullptr;
+#else // WIN32
+    if (_data) {
+        munmap(const_cast<char*>(_data), _size);
+    }
+    ::close(_fileDescriptor);
+    _fileDescriptor = -1;
+#endif // WIN32
+
+    _data = nullptr;
+    _size = 0;
+    _isOpen = false;
+}
+
+bool MemoryMappedFile::isOpen() const {
+    return _isOpen;
+}
+
+const char* MemoryMappedFile::data() const {
+    return _data;
+}
+
+size_t MemoryMappedFile::size() const {
+    return _size;
+}
+
+const std::string& MemoryMappedFile::path() const {
+    return _path;
+}
+
+} // namespace openspace
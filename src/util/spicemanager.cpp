@@ -560,6 +560,82 @@ glm::dvec3 SpiceManager::targetPosition(const std::string& target,
     );
 }
 
+void SpiceManager::targetPositions(const std::string& target,
+                                   const std::string& observer,
+                                   const std::string& referenceFrame,
+                                   AberrationCorrection aberrationCorrection,
+                                   const double* ephemerisTimes, size_t nTimes,
+                                   glm::dvec3* positions) const
+{
+    ghoul_assert(!target.empty(), "Target is not empty");
+    ghoul_assert(!observer.empty(), "Observer is not empty");
+    ghoul_assert(!referenceFrame.empty(), "Reference frame is not empty");
+    ghoul_assert(nTimes == 0 || ephemerisTimes, "Times must not be nullptr");
+    ghoul_assert(nTimes == 0 || positions, "Positions must not be nullptr");
+
+    if (nTimes == 0) {
+        return;
+    }
+
+    // Resolving the names and looking up the coverage intervals is the expensive part of
+    // the single-time query, so we do it once for the entire batch
+    const int targetId = naifId(target);
+    const int observerId = naifId(observer);
+
+    using Intervals = std::vector<std::pair<double, double>>;
+    const auto intervals = [this](int id) -> const Intervals* {
+        const auto it = _spkIntervals.find(id);
+        return it != _spkIntervals.end() ? &it->second : nullptr;
+    };
+    const auto covers = [](const Intervals* intervals, double et) {
+        if (!intervals) {
+            return false;
+        }
+        for (const std::pair<double, double>& i : *intervals) {
+            if ((i.first < et) && (i.second > et)) {
+                return true;
+            }
+        }
+        return false;
+    };
+    const Intervals* targetIntervals = intervals(targetId);
+    const Intervals* observerIntervals = intervals(observerId);
+    const char* correction = aberrationCorrection;
+
+    for (size_t i = 0; i < nTimes; ++i) {
+        const double et = ephemerisTimes[i];
+        if (!covers(targetIntervals, et) || !covers(observerIntervals, et)) {
+            // The estimation for missing coverage is rare enough that we can defer to
+            // the single-time query, which also handles the error reporting
+            positions[i] = targetPosition(
+                target,
+                observer,
+                referenceFrame,
+                aberrationCorrection,
+                et
+            );
+            continue;
+        }
+
+        double lightTime = 0.0;
+        spkezp_c(
+            targetId,
+            et,
+            referenceFrame.c_str(),
+            correction,
+            observerId,
+            glm::value_ptr(positions[i]),
+            &lightTime
+        );
+        if (failed_c()) {
+            throwOnSpiceError(fmt::format(
+                "Error getting position from '{}' to '{}' in reference frame '{}' at "
+                "time {}", target, observer, referenceFrame, et
+            ));
+        }
+    }
+}
+
 glm::dmat3 SpiceManager::frameTransformationMatrix(const std::string& from,
                                                    const std::string& to,
                                                    double ephemerisTime) const
@@ -52,26 +52,27 @@ void SyncBuffer::encode(const std::string& s) {
 }
 
 std::string SyncBuffer::decode() {
+    std::string ret;
+    decode(ret);
+    return ret;
+}
+
+void SyncBuffer::decode(std::string& s) {
     int32_t length;
     memcpy(
         reinterpret_cast<char*>(&length),
         _dataStream.data() + _decodeOffset,
         sizeof(int32_t)
     );
-    std::vector<char> tmp(length + 1);
     _decodeOffset += sizeof(int32_t);
-    memcpy(tmp.data(), _dataStream.data() + _decodeOffset, length);
+    // Reuses the capacity of s, so decoding into the same string every frame does not
+    // allocate
+    s.assign(_dataStream.data() + _decodeOffset, length);
     _decodeOffset += length;
-    tmp[length] = '\0';
-    std::string ret(tmp.data());
-    return ret;
-}
-
-void SyncBuffer::decode(std::string& s) {
-    s = decode();
 }
 
 void SyncBuffer::write() {
+    // Shrinking and regrowing the vector keeps its capacity, so this does not allocate
     _dataStream.resize(_encodeOffset);
     _synchronizationBuffer->setVal(_dataStream);
     sgct::SharedData::instance()->writeVector(_synchronizationBuffer.get());
@@ -87,4 +88,8 @@ void SyncBuffer::read() {
     _decodeOffset = 0;
 }
 
+size_t SyncBuffer::encodedSize() const {
+    return _encodeOffset;
+}
+
 } // namespace openspace
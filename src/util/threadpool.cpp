@@ -24,79 +24,243 @@
 
 #include <openspace/util/threadpool.h>
 
-namespace openspace {
+namespace {
+    // Number of tasks each worker queue can hold before tasks are moved to the overflow
+    constexpr const size_t WorkerQueueCapacity = 1024;
+    constexpr const size_t PriorityQueueCapacity = 256;
 
-Worker::Worker(ThreadPool& p) : pool(p) {}
+    // The pool and index of the worker that is running on the current thread, if any.
+    // This is used to keep tasks that are enqueued from a worker on that worker
+    thread_local const openspace::ThreadPool* CurrentPool = nullptr;
+    thread_local size_t CurrentWorker = 0;
+} // namespace
 
-void Worker::operator()() {
-    std::function<void()> task;
-    while (true) {
-        // acquire lock
-        {
-            std::unique_lock<std::mutex> lock(pool.queue_mutex);
+namespace openspace {
 
-            // look for a work item
-            while (!pool.stop && pool.tasks.empty()) {
-                // if there are none wait for notification
-                pool.condition.wait(lock);
-            }
+ThreadPool::Task::Task(Task&& other) noexcept {
+    if (other._operations) {
+        other._operations->move(_storage, other._storage);
+        _operations = other._operations;
+        other._operations = nullptr;
+    }
+}
 
-            if (pool.stop) { // exit if the pool is stopped
-                return;
-            }
+ThreadPool::Task& ThreadPool::Task::operator=(Task&& other) noexcept {
+    if (this != &other) {
+        reset();
+        if (other._operations) {
+            other._operations->move(_storage, other._storage);
+            _operations = other._operations;
+            other._operations = nullptr;
+        }
+    }
+    return *this;
+}
 
-            // get the task from the queue
-            task = pool.tasks.front();
-            pool.tasks.pop_front();
+ThreadPool::Task::~Task() {
+    reset();
+}
 
-        } // release lock
+void ThreadPool::Task::operator()() {
+    if (_operations) {
+        _operations->invoke(_storage);
+    }
+}
 
-        // execute the task
-        task();
+ThreadPool::Task::operator bool() const {
+    return _operations != nullptr;
+}
+
+void ThreadPool::Task::reset() {
+    if (_operations) {
+        _operations->destroy(_storage);
+        _operations = nullptr;
     }
 }
 
-ThreadPool::ThreadPool(size_t numThreads) : stop(false) {
+ThreadPool::WorkerQueue::WorkerQueue() : tasks(WorkerQueueCapacity) {}
+
+ThreadPool::ThreadPool(size_t numThreads) : _priorityTasks(PriorityQueueCapacity) {
+    _queues.reserve(numThreads);
+    for (size_t i = 0; i < numThreads; ++i) {
+        _queues.push_back(std::make_unique<WorkerQueue>());
+    }
+
+    // The queues have to exist before the first worker starts looking for tasks
     for (size_t i = 0; i < numThreads; ++i) {
-        workers.emplace_back(std::thread(Worker(*this)));
+        _workers.emplace_back([this, i]() { workerLoop(i); });
     }
 }
 
-ThreadPool::ThreadPool(const ThreadPool& toCopy) : ThreadPool(toCopy.workers.size()) {}
+ThreadPool::ThreadPool(const ThreadPool& toCopy) : ThreadPool(toCopy._workers.size()) {}
 
 // the destructor joins all threads
 ThreadPool::~ThreadPool() {
-    // stop all threads
     {
-        std::unique_lock<std::mutex> lock(queue_mutex);
-        stop = true;
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _stop = true;
     }
-    condition.notify_all();
+    _condition.notify_all();
 
-    // join them
-    for (std::thread& w : workers) {
+    for (std::thread& w : _workers) {
         w.join();
     }
 }
 
-// add new work item to the pool
-void ThreadPool::enqueue(std::function<void()> f) {
-    { // acquire lock
-        std::unique_lock<std::mutex> lock(queue_mutex);
+void ThreadPool::enqueue(Task task, Priority priority) {
+    // Increase the counter before the task is visible to the workers, so that a worker
+    // that finds a task can always decrease it without the counter becoming negative
+    _nPendingTasks.fetch_add(1);
 
-        // add the task
-        tasks.push_back(std::move(f));
-    } // release lock
+    if (priority == Priority::High) {
+        // Once a high priority task has spilled over, later ones have to follow it into
+        // the overflow queue to keep their order
+        if (_nPriorityOverflowTasks.load() > 0 ||
+            !_priorityTasks.tryPush(std::move(task)))
+        {
+            pushOverflow(std::move(task), Priority::High);
+        }
+    }
+    else if (!_queues.empty()) {
+        WorkerQueue& queue = *_queues[targetQueue()];
+        if (!queue.tasks.tryPush(std::move(task))) {
+            pushOverflow(std::move(task), Priority::Normal);
+        }
+    }
+    else {
+        pushOverflow(std::move(task), Priority::Normal);
+    }
 
-    // wake up one thread
-    condition.notify_one();
+    notifyWorker();
 }
 
 void ThreadPool::clearTasks() {
-    { // acquire lock
-        std::unique_lock<std::mutex> lock(queue_mutex);
-        tasks.clear();
-    } // release lock
+    Task task;
+    int64_t nRemoved = 0;
+    while (_priorityTasks.tryPop(task)) {
+        ++nRemoved;
+    }
+    for (std::unique_ptr<WorkerQueue>& queue : _queues) {
+        while (queue->tasks.tryPop(task)) {
+            ++nRemoved;
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(_overflowMutex);
+        nRemoved += static_cast<int64_t>(_overflowTasks.size());
+        nRemoved += static_cast<int64_t>(_priorityOverflowTasks.size());
+        _overflowTasks.clear();
+        _priorityOverflowTasks.clear();
+        _nOverflowTasks = 0;
+        _nPriorityOverflowTasks = 0;
+    }
+    _nPendingTasks.fetch_sub(nRemoved);
+}
+
+size_t ThreadPool::numThreads() const {
+    return _workers.size();
+}
+
+bool ThreadPool::isWorkerThread() const {
+    return CurrentPool == this;
+}
+
+void ThreadPool::workerLoop(size_t workerIndex) {
+    CurrentPool = this;
+    CurrentWorker = workerIndex;
+
+    Task task;
+    while (true) {
+        if (_stop) {
+            return;
+        }
+
+        if (tryPopTask(workerIndex, task)) {
+            _nPendingTasks.fetch_sub(1);
+            task();
+            // Destroy the callable (and everything it captured) before going idle
+            task = Task();
+            continue;
+        }
+
+        if (_nPendingTasks.load() > 0) {
+            // A task has been announced but is not visible in any queue yet
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        // Registering as a sleeping worker before checking the pending tasks guarantees
+        // that either we see the new task or the producer sees us and wakes us up
+        _nSleepingWorkers.fetch_add(1);
+        _condition.wait(lock, [this]() { return _stop || _nPendingTasks.load() > 0; });
+        _nSleepingWorkers.fetch_sub(1);
+    }
+}
+
+bool ThreadPool::tryPopTask(size_t workerIndex, Task& task) {
+    if (_priorityTasks.tryPop(task) || tryPopOverflow(task, Priority::High)) {
+        return true;
+    }
+
+    // Look into our own queue first and then try to steal from the other workers
+    const size_t nQueues = _queues.size();
+    for (size_t i = 0; i < nQueues; ++i) {
+        WorkerQueue& queue = *_queues[(workerIndex + i) % nQueues];
+        if (queue.tasks.tryPop(task)) {
+            return true;
+        }
+    }
+
+    return tryPopOverflow(task, Priority::Normal);
+}
+
+size_t ThreadPool::targetQueue() {
+    if (CurrentPool == this) {
+        return CurrentWorker;
+    }
+    else {
+        return _nextQueue.fetch_add(1, std::memory_order_relaxed) % _queues.size();
+    }
+}
+
+void ThreadPool::notifyWorker() {
+    if (_nSleepingWorkers.load() > 0) {
+        // Taking the lock ensures that a worker that is about to sleep has entered the
+        // wait before we notify it
+        { std::lock_guard<std::mutex> lock(_sleepMutex); }
+        _condition.notify_one();
+    }
+}
+
+void ThreadPool::pushOverflow(Task task, Priority priority) {
+    std::lock_guard<std::mutex> lock(_overflowMutex);
+    if (priority == Priority::High) {
+        _priorityOverflowTasks.push_back(std::move(task));
+        ++_nPriorityOverflowTasks;
+    }
+    else {
+        _overflowTasks.push_back(std::move(task));
+        ++_nOverflowTasks;
+    }
+}
+
+bool ThreadPool::tryPopOverflow(Task& task, Priority priority) {
+    const bool isHigh = priority == Priority::High;
+    std::atomic<size_t>& nTasks = isHigh ? _nPriorityOverflowTasks : _nOverflowTasks;
+    if (nTasks.load() == 0) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(_overflowMutex);
+    std::deque<Task>& tasks = isHigh ? _priorityOverflowTasks : _overflowTasks;
+    if (tasks.empty()) {
+        return false;
+    }
+    task = std::move(tasks.front());
+    tasks.pop_front();
+    --nTasks;
+    return true;
 }
 
 } // namespace openspace
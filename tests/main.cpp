@@ -65,28 +65,55 @@
 #include <test_common.inl>
 #include <test_assetloader.inl>
 #include <test_documentation.inl>
+#include <test_floatparser.inl>
+#include <test_keyframenavigator.inl>
 #include <test_luaconversions.inl>
+#include <test_messagestructures.inl>
 #include <test_optionproperty.inl>
 #include <test_powerscalecoordinates.inl>
 #include <test_scriptscheduler.inl>
 #include <test_spicemanager.inl>
+#include <test_syncengine.inl>
+#include <test_threadpool.inl>
 #include <test_timeline.inl>
 
+#ifdef OPENSPACE_MODULE_BASE_ENABLED
+#include <test_adaptivesampling.inl>
+#include <test_scenegraphnode.inl>
+#endif
+
+#ifdef OPENSPACE_MODULE_DIGITALUNIVERSE_ENABLED
+#include <test_speckfile.inl>
+#endif
+
 #ifdef OPENSPACE_MODULE_GLOBEBROWSING_ENABLED
 #include <test_aabb.inl>
 #include <test_angle.inl>
+#include <test_chunknode.inl>
 #include <test_concurrentjobmanager.inl>
 #include <test_concurrentqueue.inl>
 #include <test_lrucache.inl>
 #include <test_gdalwms.inl>
+#include <test_rawtiledatareader.inl>
+#include <test_disktilecache.inl>
 #endif
 
 #ifdef OPENSPACE_MODULE_ISWA_ENABLED
 #include <test_screenspaceimage.inl>
 #endif
 
+#ifdef OPENSPACE_MODULE_MULTIRESVOLUME_ENABLED
+#include <test_tsp.inl>
+#endif
+
+#ifdef OPENSPACE_MODULE_SPACE_ENABLED
+#include <test_ephemeriscache.inl>
+#include <test_ephemerisfile.inl>
+#endif
+
 #ifdef OPENSPACE_MODULE_VOLUME_ENABLED
 #include <test_rawvolumeio.inl>
+#include <test_volumeutils.inl>
 #endif
 
 // Regression tests
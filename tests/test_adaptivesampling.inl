@@ -0,0 +1,157 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2018                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include <modules/base/rendering/adaptivesampling.h>
+
+#include <cmath>
+
+class AdaptiveSamplingTest : public testing::Test {};
+
+namespace {
+    constexpr const double Radius = 1.5e11;
+    constexpr const double Period = 365.25 * 24.0 * 60.0 * 60.0;
+    constexpr const double Omega = 2.0 * 3.14159265358979323846 / Period;
+
+    void circle(const double* times, size_t nTimes, glm::dvec3* positions) {
+        for (size_t i = 0; i < nTimes; ++i) {
+            positions[i] = Radius * glm::dvec3(
+                std::cos(Omega * times[i]),
+                std::sin(Omega * times[i]),
+                0.0
+            );
+        }
+    }
+
+    // The maximum distance between a circle and a chord that spans the time dt
+    double sagitta(double dt) {
+        return Radius * (1.0 - std::cos(Omega * dt / 2.0));
+    }
+} // namespace
+
+TEST_F(AdaptiveSamplingTest, StraightLineUsesInitialGrid) {
+    size_t nCalls = 0;
+    const openspace::AdaptiveSamples samples = openspace::sampleAdaptively(
+        0.0,
+        1000.0,
+        1.0,
+        100.0,
+        1e-3,
+        [&nCalls](const double* times, size_t nTimes, glm::dvec3* positions) {
+            ++nCalls;
+            for (size_t i = 0; i < nTimes; ++i) {
+                positions[i] = glm::dvec3(times[i], 2.0 * times[i], 0.0);
+            }
+        }
+    );
+
+    ASSERT_EQ(11, samples.times.size());
+    ASSERT_EQ(samples.times.size(), samples.positions.size());
+    EXPECT_EQ(0.0, samples.times.front());
+    EXPECT_EQ(1000.0, samples.times.back());
+    for (size_t i = 0; i < samples.times.size(); ++i) {
+        EXPECT_EQ(glm::dvec3(samples.times[i], 2.0 * samples.times[i], 0.0),
+            samples.positions[i]);
+    }
+    // The initial grid and one level of midpoints
+    EXPECT_EQ(2, nCalls);
+}
+
+TEST_F(AdaptiveSamplingTest, CircleStaysWithinTolerance) {
+    constexpr const double MinInterval = 60.0;
+    constexpr const double Tolerance = 1e6;
+    const openspace::AdaptiveSamples samples = openspace::sampleAdaptively(
+        0.0,
+        Period / 4.0,
+        MinInterval,
+        64.0 * 86400.0,
+        Tolerance,
+        circle
+    );
+
+    ASSERT_GE(samples.times.size(), 2u);
+    EXPECT_EQ(0.0, samples.times.front());
+    EXPECT_EQ(Period / 4.0, samples.times.back());
+    for (size_t i = 1; i < samples.times.size(); ++i) {
+        const double dt = samples.times[i] - samples.times[i - 1];
+        EXPECT_GE(dt, MinInterval);
+        EXPECT_LE(sagitta(dt), Tolerance);
+    }
+
+    // A uniform sampling with the same tolerance needs the smallest interval everywhere
+    const size_t nUniform = static_cast<size_t>((Period / 4.0) / MinInterval);
+    EXPECT_LT(samples.times.size() * 10, nUniform);
+}
+
+TEST_F(AdaptiveSamplingTest, MinimumIntervalLimitsSubdivision) {
+    constexpr const double MinInterval = 1000.0;
+    const openspace::AdaptiveSamples samples = openspace::sampleAdaptively(
+        0.0,
+        64000.0,
+        MinInterval,
+        64000.0,
+        0.0,
+        circle
+    );
+
+    // Every interval is subdivided until it reaches the minimum interval
+    ASSERT_EQ(65, samples.times.size());
+    for (size_t i = 1; i < samples.times.size(); ++i) {
+        EXPECT_DOUBLE_EQ(MinInterval, samples.times[i] - samples.times[i - 1]);
+    }
+}
+
+TEST_F(AdaptiveSamplingTest, FlybyIsSampledDensely) {
+    // A straight cruise with a sharp turn in the middle of the time range
+    auto flyby = [](const double* times, size_t nTimes, glm::dvec3* positions) {
+        for (size_t i = 0; i < nTimes; ++i) {
+            const double t = times[i];
+            positions[i] = glm::dvec3(t, std::sqrt(t * t + 1e4), 0.0);
+        }
+    };
+
+    const openspace::AdaptiveSamples samples = openspace::sampleAdaptively(
+        -1e5,
+        1e5,
+        1.0,
+        4096.0,
+        1.0,
+        flyby
+    );
+
+    size_t nCruise = 0;
+    size_t nFlyby = 0;
+    for (double t : samples.times) {
+        if (std::abs(t) < 1000.0) {
+            ++nFlyby;
+        }
+        else {
+            ++nCruise;
+        }
+    }
+    // The flyby covers 1% of the time range, but gets more than 10% of the samples
+    EXPECT_GT(nFlyby * 10, nFlyby + nCruise);
+    EXPECT_LT(samples.times.size() * 10, 2e5);
+}
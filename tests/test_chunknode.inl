@@ -22,62 +22,345 @@
  * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
  ****************************************************************************************/
 
-#include <openspace/scene/scenegraphnode.h>
-#include <modules/globebrowsing/globes/chunkedlodglobe.h>
-#include <modules/globebrowsing/globes/chunknode.h>
+#include "gtest/gtest.h"
 
-#include <fstream>
-#include <glm/glm.hpp>
+#include <modules/globebrowsing/chunk/chunktree.h>
+#include <modules/globebrowsing/tile/tileindex.h>
 
-using namespace openspace;
+#define _USE_MATH_DEFINES
+#include <math.h>
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <vector>
 
 class ChunkNodeTest : public testing::Test {};
 
-/*
-TEST_F(ChunkNodeTest, Split) {
-	
-	ghoul::Dictionary dict;
-	ChunkLodGlobe chunkLodNode(dict);
-	chunkLodNode.initialize();
+namespace {
+    using openspace::globebrowsing::Chunk;
+    using openspace::globebrowsing::ChunkTree;
+    using openspace::globebrowsing::Quad;
+    using openspace::globebrowsing::TileIndex;
+
+    using TileTree = ChunkTree<TileIndex>;
+
+    TileTree createTileTree() {
+        return TileTree({ TileIndex(0, 0, 1), TileIndex(1, 0, 1) });
+    }
+
+    TileIndex createChild(const TileIndex& parent, Quad quad) {
+        return parent.child(quad);
+    }
+
+    // Adapts a status function of the tile index of a node to the node index that is
+    // passed by ChunkTree::updateChunkTree
+    template <typename StatusFunc>
+    auto byNodeIndex(const TileTree& tree, StatusFunc& status) {
+        return [&tree, &status](TileTree::NodeIndex i) {
+            return status(tree.node(i).value());
+        };
+    }
+
+    // Determines the status of a tile in the same way as the distance based chunk level
+    // evaluator, using a unit sphere as the globe
+    Chunk::Status distanceStatus(const TileIndex& tile, const glm::dvec3& camera) {
+        const double size = glm::two_pi<double>() / (1 << tile.level);
+        const double lon = (tile.x + 0.5) * size - glm::pi<double>();
+        const double lat = glm::half_pi<double>() - (tile.y + 0.5) * size;
+        const glm::dvec3 center = glm::dvec3(
+            cos(lat) * cos(lon),
+            cos(lat) * sin(lon),
+            sin(lat)
+        );
+        const double distance = glm::max(
+            glm::length(center - camera) - size * glm::one_over_root_two<double>(),
+            1e-6
+        );
+        const int desiredLevel = glm::clamp(
+            static_cast<int>(ceil(log2(10.0 / distance))),
+            2,
+            22
+        );
+
+        if (desiredLevel < tile.level) {
+            return Chunk::Status::WantMerge;
+        }
+        else if (tile.level < desiredLevel) {
+            return Chunk::Status::WantSplit;
+        }
+        else {
+            return Chunk::Status::DoNothing;
+        }
+    }
+
+    // A camera that approaches the globe from far away, flies close over the surface
+    // for half an orbit and then leaves again
+    std::vector<glm::dvec3> recordCameraPath(int nFrames) {
+        std::vector<glm::dvec3> path;
+        path.reserve(nFrames);
+        for (int i = 0; i < nFrames; ++i) {
+            const double t = static_cast<double>(i) / (nFrames - 1);
+            const double altitude = 1e-4 + 10.0 * glm::pow(2.0 * t - 1.0, 4.0);
+            const double angle = t * glm::pi<double>();
+            path.push_back((1.0 + altitude) * glm::dvec3(cos(angle), sin(angle), 0.3));
+        }
+        return path;
+    }
 
-	BoundingRect bounds(Vec2(2, 2), Vec2(2, 2));
-	ChunkNode cn(chunkLodNode,bounds);
-	ASSERT_TRUE(cn.isRoot()) << "Chunk node is root";
-	ASSERT_TRUE(cn.isLeaf()) << "Chunk node is leaf";
+    // Reference implementation of the previous, pointer based quadtree that allocates
+    // every block of children separately and evaluates every inner node
+    struct PointerChunkNode {
+        explicit PointerChunkNode(TileIndex i) : index(i) {}
 
-	cn.split();
-	ASSERT_TRUE(cn.isRoot()) << "Chunk node is root";
-	ASSERT_FALSE(cn.isLeaf()) << "Chunk node is not leaf";
+        bool isLeaf() const { return children[0] == nullptr; }
 
-	ASSERT_EQ(cn.bounds.center.x, cn.child(Quad::NORTH_WEST).bounds.center.x * 2);
-	ASSERT_EQ(cn.bounds.center.x, cn.child(Quad::NORTH_EAST).bounds.center.x * 2/3);
+        template <typename StatusFunc>
+        bool updateChunkTree(StatusFunc& status, size_t& nEvaluated) {
+            if (isLeaf()) {
+                ++nEvaluated;
+                const Chunk::Status s = status(index);
+                if (s == Chunk::Status::WantSplit) {
+                    for (int q = 0; q < 4; ++q) {
+                        children[q] = std::make_unique<PointerChunkNode>(
+                            index.child(static_cast<Quad>(q))
+                        );
+                    }
+                }
+                return s == Chunk::Status::WantMerge;
+            }
+            char requestedMergeMask = 0;
+            for (int q = 0; q < 4; ++q) {
+                if (children[q]->updateChunkTree(status, nEvaluated)) {
+                    requestedMergeMask |= (1 << q);
+                }
+            }
+            ++nEvaluated;
+            const bool thisChunkWantsSplit = status(index) == Chunk::Status::WantSplit;
+            if (requestedMergeMask == 0xf && !thisChunkWantsSplit) {
+                for (std::unique_ptr<PointerChunkNode>& c : children) {
+                    c = nullptr;
+                }
+            }
+            return false;
+        }
 
-	ASSERT_EQ(cn.bounds.halfSize.x, cn.child(Quad::NORTH_WEST).bounds.halfSize.x * 2);
-	ASSERT_EQ(cn.bounds.halfSize.y, cn.child(Quad::NORTH_WEST).bounds.halfSize.y * 2);
+        TileIndex index;
+        std::array<std::unique_ptr<PointerChunkNode>, 4> children;
+    };
+} // namespace
 
-	chunkLodNode.deinitialize();
+TEST_F(ChunkNodeTest, Split) {
+    TileTree tree = createTileTree();
+    const TileTree::NodeIndex root = tree.root(0);
+    ASSERT_TRUE(tree.node(root).isRoot()) << "Chunk node is root";
+    ASSERT_TRUE(tree.node(root).isLeaf()) << "Chunk node is leaf";
+
+    tree.split(root, createChild);
+    ASSERT_TRUE(tree.node(root).isRoot()) << "Chunk node is root";
+    ASSERT_FALSE(tree.node(root).isLeaf()) << "Chunk node is not leaf";
+    EXPECT_EQ(tree.size(), 6u);
+
+    for (int q = 0; q < 4; ++q) {
+        const TileTree::NodeIndex c = tree.child(root, static_cast<Quad>(q));
+        EXPECT_EQ(tree.parent(c), root);
+        EXPECT_FALSE(tree.node(c).isRoot());
+        EXPECT_TRUE(tree.node(c).isLeaf());
+        EXPECT_EQ(tree.node(c).value(), TileIndex(0, 0, 1).child(static_cast<Quad>(q)));
+    }
 }
 
 TEST_F(ChunkNodeTest, Merge) {
-	ghoul::Dictionary dict;
-	ChunkLodGlobe chunkLodNode(dict);
-	chunkLodNode.initialize();
+    TileTree tree = createTileTree();
+    const TileTree::NodeIndex root = tree.root(1);
+
+    tree.split(root, createChild);
+    tree.split(tree.child(root, Quad::SOUTH_EAST), createChild);
+    EXPECT_EQ(tree.size(), 10u);
+    const size_t capacity = tree.capacity();
+
+    tree.merge(root);
+    ASSERT_TRUE(tree.node(root).isRoot()) << "Chunk node is root";
+    ASSERT_TRUE(tree.node(root).isLeaf()) << "Chunk node is leaf";
+    EXPECT_EQ(tree.size(), 2u);
+
+    // The merged blocks must be reused instead of growing the pool
+    tree.split(root, createChild);
+    tree.split(tree.child(root, Quad::NORTH_WEST), createChild);
+    EXPECT_EQ(tree.size(), 10u);
+    EXPECT_EQ(tree.capacity(), capacity);
+}
+
+TEST_F(ChunkNodeTest, TraversalOrder) {
+    TileTree tree = createTileTree();
+    tree.split(tree.root(0), createChild);
+    tree.split(tree.child(tree.root(0), Quad::NORTH_EAST), createChild);
+    tree.split(tree.root(1), createChild);
+
+    std::vector<TileIndex> depthFirst;
+    tree.depthFirst([&](const TileTree::Node& n) { depthFirst.push_back(n.value()); });
+    ASSERT_EQ(depthFirst.size(), tree.size());
 
+    std::vector<TileIndex> iterated;
+    for (const TileTree::Node& n : tree) {
+        iterated.push_back(n.value());
+    }
+    EXPECT_EQ(depthFirst, iterated);
+
+    // Depth first visits the whole subtree of a node before its next sibling
+    EXPECT_EQ(depthFirst[0], TileIndex(0, 0, 1));
+    EXPECT_EQ(depthFirst[2], TileIndex(1, 0, 2));
+    EXPECT_EQ(depthFirst[3], TileIndex(2, 0, 3));
+    EXPECT_EQ(depthFirst[7], TileIndex(0, 1, 2));
+    EXPECT_EQ(depthFirst[9], TileIndex(1, 0, 1));
+
+    std::vector<TileIndex> breadthFirst;
+    tree.breadthFirst([&](const TileTree::Node& n) {
+        breadthFirst.push_back(n.value());
+    });
+    ASSERT_EQ(breadthFirst.size(), tree.size());
+    for (size_t i = 1; i < breadthFirst.size(); ++i) {
+        EXPECT_LE(breadthFirst[i - 1].level, breadthFirst[i].level);
+    }
+
+    std::vector<TileIndex> reversed;
+    tree.reverseBreadthFirst([&](const TileTree::Node& n) {
+        reversed.push_back(n.value());
+    });
+    EXPECT_TRUE(std::equal(reversed.rbegin(), reversed.rend(), breadthFirst.begin()));
+}
+
+TEST_F(ChunkNodeTest, UpdateChunkTree) {
+    TileTree tree = createTileTree();
+    const glm::dvec3 camera = glm::dvec3(1.001, 0.0, 0.0);
+    auto status = [&camera](const TileIndex& t) { return distanceStatus(t, camera); };
+
+    // Every update splits each leaf at most once, so the tree converges after at most
+    // as many updates as there are levels
+    for (int i = 0; i < 25; ++i) {
+        tree.updateChunkTree(byNodeIndex(tree, status), createChild);
+    }
+    const size_t converged = tree.size();
+    tree.updateChunkTree(byNodeIndex(tree, status), createChild);
+    EXPECT_EQ(tree.size(), converged);
+    EXPECT_GT(converged, 2u);
+
+    const TileTree::NodeIndex leaf = tree.findLeaf(
+        tree.root(1),
+        [](const TileIndex&) { return Quad::SOUTH_WEST; }
+    );
+    EXPECT_TRUE(tree.node(leaf).isLeaf());
+
+    // Moving the camera far away merges the tree back to the minimum split depth
+    const glm::dvec3 farAway = glm::dvec3(1000.0, 0.0, 0.0);
+    auto farStatus = [&farAway](const TileIndex& t) {
+        return distanceStatus(t, farAway);
+    };
+    for (int i = 0; i < 25; ++i) {
+        tree.updateChunkTree(byNodeIndex(tree, farStatus), createChild);
+    }
+    EXPECT_EQ(tree.size(), 2 + 8);
+}
+
+TEST_F(ChunkNodeTest, UpdateEvaluatesEveryNode) {
+    // Evaluating a chunk requests its tiles and updates its visibility, so every node
+    // that exists before the update, inner nodes included, has to be evaluated once
+    TileTree tree = createTileTree();
+    for (const glm::dvec3& camera : recordCameraPath(200)) {
+        std::vector<TileTree::NodeIndex> expected;
+        for (TileTree::ConstIterator it = tree.begin(); it != tree.end(); ++it) {
+            expected.push_back(it.index());
+        }
+
+        std::vector<TileTree::NodeIndex> evaluated;
+        const size_t nEvaluated = tree.updateChunkTree(
+            [&](TileTree::NodeIndex i) {
+                evaluated.push_back(i);
+                return distanceStatus(tree.node(i).value(), camera);
+            },
+            createChild
+        );
+        EXPECT_EQ(nEvaluated, evaluated.size());
+
+        std::sort(expected.begin(), expected.end());
+        std::sort(evaluated.begin(), evaluated.end());
+        EXPECT_EQ(evaluated, expected);
+    }
+}
+
+TEST_F(ChunkNodeTest, EvaluateUpFront) {
+    // Evaluating the nodes before updating the tree, as is done when the chunks are
+    // evaluated concurrently, has to result in the same tree as evaluating them during
+    // the update
+    TileTree tree = createTileTree();
+    TileTree upFrontTree = createTileTree();
+    std::vector<TileTree::NodeIndex> nodes;
+    std::vector<Chunk::Status> statuses;
+
+    for (const glm::dvec3& camera : recordCameraPath(200)) {
+        auto status = [&camera](const TileIndex& t) { return distanceStatus(t, camera); };
+        tree.updateChunkTree(byNodeIndex(tree, status), createChild);
+
+        upFrontTree.nodesToEvaluate(nodes);
+        statuses.assign(upFrontTree.capacity(), Chunk::Status::DoNothing);
+        for (TileTree::NodeIndex i : nodes) {
+            statuses[i] = status(upFrontTree.node(i).value());
+        }
+        upFrontTree.updateChunkTree(
+            [&](TileTree::NodeIndex i) {
+                EXPECT_NE(std::find(nodes.begin(), nodes.end(), i), nodes.end());
+                return statuses[i];
+            },
+            createChild
+        );
+
+        ASSERT_EQ(tree.size(), upFrontTree.size());
+        EXPECT_TRUE(std::equal(
+            tree.begin(),
+            tree.end(),
+            upFrontTree.begin(),
+            [](const TileTree::Node& lhs, const TileTree::Node& rhs) {
+                return lhs.value() == rhs.value();
+            }
+        ));
+    }
+}
 
-	BoundingRect bounds(Vec2(2, 2), Vec2(2, 2));
-	ChunkNode cn(chunkLodNode,bounds);
-	ASSERT_TRUE(cn.isRoot()) << "Chunk node is root";
-	ASSERT_TRUE(cn.isLeaf()) << "Chunk node is leaf";
+TEST_F(ChunkNodeTest, DISABLED_Benchmark) {
+    const std::vector<glm::dvec3> path = recordCameraPath(5000);
 
-	cn.split();
-	ASSERT_TRUE(cn.isRoot()) << "Chunk node is root";
-	ASSERT_FALSE(cn.isLeaf()) << "Chunk node is not leaf";
+    auto replay = [&path](auto update) {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (const glm::dvec3& camera : path) {
+            auto status = [&camera](const TileIndex& t) {
+                return distanceStatus(t, camera);
+            };
+            update(status);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double>(end - start).count();
+    };
 
-	cn.merge();
-	ASSERT_TRUE(cn.isRoot()) << "Chunk node is root";
-	ASSERT_TRUE(cn.isLeaf()) << "Chunk node is leaf";
+    // Both trees make the same split and merge decisions and evaluate every node, so
+    // they do the same amount of work per frame
+    TileTree tree = createTileTree();
+    size_t nNodes = 0;
+    const double flatTime = replay([&tree, &nNodes](auto& status) {
+        nNodes += tree.updateChunkTree(byNodeIndex(tree, status), createChild);
+    });
 
-	chunkLodNode.deinitialize();
+    PointerChunkNode left(TileIndex(0, 0, 1));
+    PointerChunkNode right(TileIndex(1, 0, 1));
+    size_t nPointerNodes = 0;
+    const double pointerTime = replay([&left, &right, &nPointerNodes](auto& status) {
+        left.updateChunkTree(status, nPointerNodes);
+        right.updateChunkTree(status, nPointerNodes);
+    });
+    EXPECT_EQ(nNodes, nPointerNodes);
 
+    std::cout << path.size() << " frames, " << nNodes << " nodes: "
+              << "ChunkTree " << nNodes / flatTime << " nodes/s, "
+              << "pointer tree " << nNodes / pointerTime << " nodes/s" << std::endl;
 }
-*/
\ No newline at end of file
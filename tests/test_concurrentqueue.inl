@@ -29,9 +29,70 @@
 #define _USE_MATH_DEFINES
 #include <math.h>
 #include <glm/glm.hpp>
+#include <algorithm>
+#include <atomic>
+#include <thread>
 
 class ConcurrentQueueTest : public testing::Test {};
 
+namespace {
+    // Lets a number of producers push disjoint ranges of integers, some of them through
+    // pushBulk, while the main thread drains the queue with popAll. Every value must be
+    // received exactly once
+    template <typename Queue>
+    void stressTest(Queue& queue) {
+        constexpr const int NProducers = 16;
+        constexpr const int NItemsPerProducer = 20000;
+        constexpr const int BulkSize = 50;
+        constexpr const size_t NItems = static_cast<size_t>(NProducers) *
+                                        NItemsPerProducer;
+
+        std::vector<std::thread> producers;
+        for (int p = 0; p < NProducers; ++p) {
+            producers.emplace_back([&queue, p]() {
+                const int begin = p * NItemsPerProducer;
+                const int end = begin + NItemsPerProducer;
+                int i = begin;
+                if (p % 2 == 0) {
+                    for (; i < end; ++i) {
+                        queue.push(i);
+                    }
+                }
+                else {
+                    while (i < end) {
+                        std::vector<int> bulk;
+                        for (int j = 0; j < BulkSize && i < end; ++j, ++i) {
+                            bulk.push_back(i);
+                        }
+                        queue.pushBulk(std::move(bulk));
+                    }
+                }
+            });
+        }
+
+        std::vector<int> received;
+        received.reserve(NItems);
+        while (received.size() < NItems) {
+            if (queue.popAll(received) == 0) {
+                std::this_thread::yield();
+            }
+        }
+
+        for (std::thread& t : producers) {
+            t.join();
+        }
+
+        int item;
+        EXPECT_FALSE(queue.tryPop(item)) << "Queue should be empty";
+        ASSERT_EQ(received.size(), NItems);
+        std::sort(received.begin(), received.end());
+        for (size_t i = 0; i < NItems; ++i) {
+            ASSERT_EQ(received[i], static_cast<int>(i))
+                << "Every item should be received exactly once";
+        }
+    }
+} // namespace
+
 TEST_F(ConcurrentQueueTest, Basic) {
     using namespace openspace;
 
@@ -41,6 +102,56 @@ TEST_F(ConcurrentQueueTest, Basic) {
     std::cout << val << std::endl;
 }
 
+TEST_F(ConcurrentQueueTest, TryPopAndPopAll) {
+    using namespace openspace;
+
+    ConcurrentQueue<int, ConcurrentQueueType::LockFree> q(4);
+    int val = 0;
+    EXPECT_FALSE(q.tryPop(val));
+
+    q.pushBulk({ 1, 2, 3 });
+    EXPECT_EQ(q.size(), 3u);
+    ASSERT_TRUE(q.tryPop(val));
+    EXPECT_EQ(val, 1);
+
+    std::vector<int> items = { 0 };
+    EXPECT_EQ(q.popAll(items), 2u);
+    EXPECT_EQ(items, std::vector<int>({ 0, 2, 3 }));
+    EXPECT_TRUE(q.empty());
+}
+
+TEST_F(ConcurrentQueueTest, PushBeyondCapacity) {
+    using namespace openspace;
+
+    // Pushing more items than the ring buffer holds must not block without a consumer
+    ConcurrentQueue<int, ConcurrentQueueType::LockFree> q(4);
+    for (int i = 0; i < 10; ++i) {
+        q.push(i);
+    }
+    EXPECT_EQ(q.size(), 10u);
+
+    int val = 0;
+    ASSERT_TRUE(q.tryPop(val));
+    EXPECT_EQ(val, 0);
+    q.push(10);
+
+    std::vector<int> items;
+    EXPECT_EQ(q.popAll(items), 10u);
+    EXPECT_EQ(items, std::vector<int>({ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 }));
+    EXPECT_TRUE(q.empty());
+}
+
+TEST_F(ConcurrentQueueTest, StressLocking) {
+    openspace::ConcurrentQueue<int> q;
+    stressTest(q);
+}
+
+TEST_F(ConcurrentQueueTest, StressLockFree) {
+    // Use a small capacity so that producers regularly run into a full queue
+    openspace::ConcurrentQueue<int, openspace::ConcurrentQueueType::LockFree> q(64);
+    stressTest(q);
+}
+
 /*
 TEST_F(ConcurrentQueueTest, SharedPtr) {
     ConcurrentQueue<std::shared_ptr<int>> q1;
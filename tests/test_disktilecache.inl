@@ -0,0 +1,128 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2018                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+
+#include "gtest/gtest.h"
+
+#include <modules/globebrowsing/cache/disktilecache.h>
+#include <modules/globebrowsing/tile/tileindex.h>
+#include <modules/globebrowsing/tile/tilemetadata.h>
+#include <openspace/properties/property.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class DiskTileCacheTest : public testing::Test {};
+
+namespace {
+    using openspace::globebrowsing::TileIndex;
+    using openspace::globebrowsing::TileMetaData;
+    using openspace::globebrowsing::cache::DiskTileCache;
+    using openspace::globebrowsing::cache::ProviderTileKey;
+
+    void setEnabled(DiskTileCache& cache, bool enabled) {
+        cache.property("Enabled")->set(enabled);
+    }
+
+    std::vector<char> tileData(size_t nBytes, int seed) {
+        std::vector<char> data(nBytes);
+        for (size_t i = 0; i < nBytes; ++i) {
+            data[i] = static_cast<char>((i * 7 + seed) % 251);
+        }
+        return data;
+    }
+
+    // The providers only differ in the upper 32 bits of their identifiers, so they
+    // would share their tiles if the identifiers were truncated to 32 bits
+    const ProviderTileKey FirstKey = { TileIndex(3, 5, 4), 0x5eed00010000abcdull };
+    const ProviderTileKey SecondKey = { TileIndex(3, 5, 4), 0x5eed00020000abcdull };
+    constexpr const size_t TileSize = 64 * 64 * 4;
+} // namespace
+
+TEST_F(DiskTileCacheTest, RoundTrip) {
+    DiskTileCache cache;
+    setEnabled(cache, true);
+    ASSERT_TRUE(cache.isEnabled());
+
+    const std::vector<char> first = tileData(TileSize, 1);
+    const std::vector<char> second = tileData(TileSize, 2);
+
+    TileMetaData metaData;
+    metaData.maxValues = { 1.f, 2.f };
+    metaData.minValues = { -1.f, 0.f };
+    metaData.hasMissingData = { true, false };
+
+    cache.write(FirstKey, first.data(), first.size(), &metaData);
+    cache.write(SecondKey, second.data(), second.size(), nullptr);
+
+    auto expectStoredTiles = [&]() {
+        std::vector<char> result(TileSize);
+        std::shared_ptr<TileMetaData> resultMetaData;
+
+        ASSERT_TRUE(cache.read(FirstKey, result.data(), TileSize, resultMetaData));
+        EXPECT_EQ(result, first);
+        ASSERT_NE(resultMetaData, nullptr);
+        EXPECT_EQ(resultMetaData->maxValues, metaData.maxValues);
+        EXPECT_EQ(resultMetaData->minValues, metaData.minValues);
+        EXPECT_EQ(resultMetaData->hasMissingData, metaData.hasMissingData);
+
+        ASSERT_TRUE(cache.read(SecondKey, result.data(), TileSize, resultMetaData));
+        EXPECT_EQ(result, second);
+        EXPECT_EQ(resultMetaData, nullptr);
+    };
+
+    expectStoredTiles();
+
+    // The tiles are persisted in the pack file and are found again after reopening it
+    setEnabled(cache, false);
+    setEnabled(cache, true);
+    ASSERT_TRUE(cache.isEnabled());
+    expectStoredTiles();
+
+    setEnabled(cache, false);
+}
+
+TEST_F(DiskTileCacheTest, MismatchingRequestsAreMisses) {
+    DiskTileCache cache;
+    setEnabled(cache, true);
+    ASSERT_TRUE(cache.isEnabled());
+
+    const std::vector<char> data = tileData(TileSize, 3);
+    cache.write(FirstKey, data.data(), data.size(), nullptr);
+
+    std::vector<char> result(TileSize);
+    std::shared_ptr<TileMetaData> resultMetaData;
+
+    // A tile with a different size than requested belongs to a different format
+    EXPECT_FALSE(cache.read(FirstKey, result.data(), TileSize / 2, resultMetaData));
+
+    const ProviderTileKey otherTile = { TileIndex(4, 5, 4), FirstKey.providerID };
+    EXPECT_FALSE(cache.read(otherTile, result.data(), TileSize, resultMetaData));
+
+    const ProviderTileKey otherProvider = { FirstKey.tileIndex, 0x5eed00030000abcdull };
+    EXPECT_FALSE(cache.read(otherProvider, result.data(), TileSize, resultMetaData));
+
+    setEnabled(cache, false);
+}
@@ -0,0 +1,282 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2018                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include <modules/space/util/ephemeriscache.h>
+
+#include <openspace/util/spicemanager.h>
+
+#include <ghoul/filesystem/filesystem.h>
+#include <cmath>
+
+class EphemerisCacheTest : public testing::Test {};
+
+namespace {
+    constexpr const double Radius = 1.5e8;
+    constexpr const double Period = 365.25 * 24.0 * 60.0 * 60.0;
+    constexpr const double Omega = 2.0 * 3.14159265358979323846 / Period;
+
+    // Analytic circular orbit that acts as the exact ephemeris
+    glm::dvec3 circularPosition(double t) {
+        return Radius * glm::dvec3(std::cos(Omega * t), std::sin(Omega * t), 0.0);
+    }
+
+    glm::dvec3 circularVelocity(double t) {
+        const double speed = Radius * Omega;
+        return speed * glm::dvec3(-std::sin(Omega * t), std::cos(Omega * t), 0.0);
+    }
+
+    glm::dmat3 zRotation(double angle) {
+        glm::dmat3 m(1.0);
+        m[0][0] = std::cos(angle);
+        m[0][1] = std::sin(angle);
+        m[1][0] = -std::sin(angle);
+        m[1][1] = std::cos(angle);
+        return m;
+    }
+
+    glm::dmat3 zRotationDerivative(double angle, double rate) {
+        glm::dmat3 m(0.0);
+        m[0][0] = -std::sin(angle) * rate;
+        m[0][1] = std::cos(angle) * rate;
+        m[1][0] = -std::cos(angle) * rate;
+        m[1][1] = -std::sin(angle) * rate;
+        return m;
+    }
+} // namespace
+
+TEST_F(EphemerisCacheTest, CircularOrbit) {
+    using Cache = openspace::EphemerisCache<glm::dvec3>;
+    constexpr const double Tolerance = 1e-3;
+    Cache cache(Tolerance);
+
+    Cache::SampleFunction sample = [](double t) -> std::optional<Cache::Sample> {
+        return Cache::Sample{ circularPosition(t), circularVelocity(t) };
+    };
+
+    constexpr const int NSteps = 100000;
+    for (int i = 0; i < NSteps; ++i) {
+        const double t = Period * i / NSteps;
+        std::optional<glm::dvec3> p = cache.value(t, sample);
+        if (p) {
+            EXPECT_LE(glm::length(*p - circularPosition(t)), Tolerance) << "At " << t;
+        }
+    }
+
+    EXPECT_GT(cache.stepSize(), 0.0);
+    EXPECT_GT(cache.nHits(), cache.nMisses() * 10);
+}
+
+TEST_F(EphemerisCacheTest, Rotation) {
+    using Cache = openspace::EphemerisCache<glm::dmat3>;
+    constexpr const double Tolerance = 1e-9;
+    constexpr const double Rate = 7.292115e-5;
+    Cache cache(Tolerance);
+
+    Cache::SampleFunction sample = [](double t) -> std::optional<Cache::Sample> {
+        return Cache::Sample{ zRotation(Rate * t), zRotationDerivative(Rate * t, Rate) };
+    };
+
+    constexpr const int NSteps = 100000;
+    for (int i = 0; i < NSteps; ++i) {
+        const double t = 86400.0 * i / NSteps;
+        std::optional<glm::dmat3> m = cache.value(t, sample);
+        if (m) {
+            const glm::dmat3 exact = zRotation(Rate * t);
+            for (glm::length_t c = 0; c < 3; ++c) {
+                for (glm::length_t r = 0; r < 3; ++r) {
+                    EXPECT_NEAR(exact[c][r], (*m)[c][r], Tolerance);
+                }
+            }
+        }
+    }
+
+    EXPECT_GT(cache.nHits(), cache.nMisses() * 10);
+}
+
+TEST_F(EphemerisCacheTest, Unsampleable) {
+    using Cache = openspace::EphemerisCache<glm::dvec3>;
+    Cache cache(1.0);
+
+    Cache::SampleFunction sample = [](double) -> std::optional<Cache::Sample> {
+        return std::nullopt;
+    };
+
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_FALSE(cache.value(i * 60.0, sample).has_value());
+    }
+    EXPECT_EQ(cache.nHits(), 0u);
+    EXPECT_EQ(cache.nMisses(), 100u);
+}
+
+TEST_F(EphemerisCacheTest, Clear) {
+    using Cache = openspace::EphemerisCache<glm::dvec3>;
+    Cache cache(1e-3);
+
+    Cache::SampleFunction sample = [](double t) -> std::optional<Cache::Sample> {
+        return Cache::Sample{ circularPosition(t), circularVelocity(t) };
+    };
+
+    EXPECT_TRUE(cache.value(0.0, sample).has_value());
+    EXPECT_EQ(cache.nMisses(), 1u);
+    EXPECT_TRUE(cache.value(0.0, sample).has_value());
+    EXPECT_EQ(cache.nHits(), 1u);
+
+    cache.clear();
+    EXPECT_EQ(cache.stepSize(), 0.0);
+    EXPECT_TRUE(cache.value(0.0, sample).has_value());
+    EXPECT_EQ(cache.nMisses(), 2u);
+}
+
+TEST_F(EphemerisCacheTest, SampleCallsPerMiss) {
+    // Every call of the sample function is a call into SPICE, so a miss must not cost
+    // more than the three samples of the new interval; the value is interpolated from
+    // that interval instead of being computed exactly by the caller afterwards
+    using Cache = openspace::EphemerisCache<glm::dvec3>;
+    Cache cache(1e-3);
+
+    // The interpolation of a linear motion is exact, so no interval fails the validation
+    const glm::dvec3 start = glm::dvec3(1.5e8, 0.0, 0.0);
+    const glm::dvec3 velocity = glm::dvec3(0.0, 30.0, 0.0);
+    size_t nCalls = 0;
+    Cache::SampleFunction sample = [&](double t) -> std::optional<Cache::Sample> {
+        ++nCalls;
+        return Cache::Sample{ start + t * velocity, velocity };
+    };
+
+    for (int i = 0; i < 1000; ++i) {
+        // Skip through time faster than the grid step, as during fast playback
+        const double t = i * 7.0 * 24.0 * 60.0 * 60.0;
+        const size_t callsBefore = nCalls;
+        const size_t missesBefore = cache.nMisses();
+
+        std::optional<glm::dvec3> p = cache.value(t, sample);
+        ASSERT_TRUE(p.has_value()) << "At " << t;
+        EXPECT_LE(glm::length(*p - (start + t * velocity)), 1e-3) << "At " << t;
+
+        if (cache.nMisses() == missesBefore) {
+            EXPECT_EQ(nCalls, callsBefore);
+        }
+        else {
+            // The first miss additionally estimates the grid step from one sample
+            EXPECT_EQ(nCalls - callsBefore, i == 0 ? 4u : 3u) << "At " << t;
+        }
+    }
+    EXPECT_GT(cache.nMisses(), 1u);
+}
+
+TEST_F(EphemerisCacheTest, CoverageBoundary) {
+    // Near the end of the coverage of a kernel, the interval that contains the queried
+    // time reaches past the coverage. It has to be cached clamped to the coverage, as
+    // every query would otherwise sample it again
+    using Cache = openspace::EphemerisCache<glm::dvec3>;
+    Cache cache(1e-3);
+
+    const glm::dvec3 start = glm::dvec3(1.5e8, 0.0, 0.0);
+    const glm::dvec3 velocity = glm::dvec3(0.0, 30.0, 0.0);
+    // The end of the coverage is not aligned with any grid step
+    constexpr const double CoverageEnd = 12345678.9;
+    size_t nCalls = 0;
+    Cache::SampleFunction sample = [&](double t) -> std::optional<Cache::Sample> {
+        ++nCalls;
+        if (t < 0.0 || t > CoverageEnd) {
+            return std::nullopt;
+        }
+        return Cache::Sample{ start + t * velocity, velocity };
+    };
+
+    const double first = CoverageEnd - 1.0;
+    ASSERT_TRUE(cache.value(first, sample).has_value());
+    const double gridStart = std::floor(first / cache.stepSize()) * cache.stepSize();
+    const double gridEnd = gridStart + cache.stepSize();
+    ASSERT_GT(gridEnd, CoverageEnd);
+
+    // All other queries in the covered part of the interval are served from the cache
+    const size_t callsBefore = nCalls;
+    const size_t hitsBefore = cache.nHits();
+    for (int i = 0; i < 100; ++i) {
+        const double t = gridStart + (first - gridStart) * (i + 0.5) / 100.0;
+        std::optional<glm::dvec3> p = cache.value(t, sample);
+        ASSERT_TRUE(p.has_value()) << "At " << t;
+        EXPECT_LE(glm::length(*p - (start + t * velocity)), 1e-3) << "At " << t;
+    }
+    EXPECT_EQ(nCalls, callsBefore);
+    EXPECT_EQ(cache.nHits(), hitsBefore + 100);
+
+    // Times past the coverage are left to the caller without sampling the interval again
+    const double past = (CoverageEnd + gridEnd) / 2.0;
+    EXPECT_FALSE(cache.value(past, sample).has_value());
+    EXPECT_EQ(nCalls, callsBefore);
+}
+
+// Compares the cached positions against the exact values during June 2004, which is
+// covered by the Cassini kernels that are used in the SpiceManager tests
+TEST_F(EphemerisCacheTest, SpiceKernels) {
+    using namespace openspace;
+    using Cache = EphemerisCache<glm::dvec3>;
+
+    SpiceManager::initialize();
+    SpiceManager& spice = SpiceManager::ref();
+    spice.loadKernel(absPath("${TESTDIR}/SpiceTest/spicekernels/naif0008.tls"));
+    spice.loadKernel(
+        absPath("${TESTDIR}/SpiceTest/spicekernels/981005_PLTEPH-DE405S.bsp")
+    );
+    spice.loadKernel(absPath("${TESTDIR}/SpiceTest/spicekernels/020514_SE_SAT105.bsp"));
+    spice.loadKernel(
+        absPath("${TESTDIR}/SpiceTest/spicekernels/030201AP_SK_SM546_T45.bsp")
+    );
+
+    constexpr const double Tolerance = 1e-3;
+    Cache cache(Tolerance);
+    Cache::SampleFunction sample = [&spice](double t) -> std::optional<Cache::Sample> {
+        if (!spice.hasSpkCoverage("CASSINI", t) || !spice.hasSpkCoverage("SATURN", t)) {
+            return std::nullopt;
+        }
+        SpiceManager::TargetStateResult s = spice.targetState(
+            "CASSINI", "SATURN", "J2000", {}, t
+        );
+        return Cache::Sample{ s.position, s.velocity };
+    };
+
+    const double start = spice.ephemerisTimeFromDate("2004 jun 01 00:00:00");
+    const double end = spice.ephemerisTimeFromDate("2004 jul 01 00:00:00");
+    size_t nCompared = 0;
+    for (double t = start; t < end; t += 60.0) {
+        if (!sample(t)) {
+            continue;
+        }
+        std::optional<glm::dvec3> p = cache.value(t, sample);
+        if (p) {
+            const glm::dvec3 exact = spice.targetPosition(
+                "CASSINI", "SATURN", "J2000", {}, t
+            );
+            EXPECT_LE(glm::length(*p - exact), Tolerance) << "At " << t;
+            ++nCompared;
+        }
+    }
+    EXPECT_GT(nCompared, 0u);
+
+    SpiceManager::deinitialize();
+}
@@ -0,0 +1,229 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2018                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include <modules/space/util/ephemerisfile.h>
+
+#include <ghoul/filesystem/filesystem.h>
+#include <ghoul/misc/exception.h>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <string>
+
+class EphemerisFileTest : public testing::Test {};
+
+namespace {
+    constexpr const double Radius = 1.5e11;
+    constexpr const double Period = 365.25 * 24.0 * 60.0 * 60.0;
+    constexpr const double Omega = 2.0 * 3.14159265358979323846 / Period;
+
+    void circularOrbit(double t, double* result) {
+        result[0] = Radius * std::cos(Omega * t);
+        result[1] = Radius * std::sin(Omega * t);
+        result[2] = 0.0;
+    }
+
+    void zRotation(double t, double* result) {
+        const double a = 7.292115e-5 * t;
+        const double m[9] = {
+            std::cos(a), std::sin(a), 0.0,
+            -std::sin(a), std::cos(a), 0.0,
+            0.0, 0.0, 1.0
+        };
+        std::copy(std::begin(m), std::end(m), result);
+    }
+} // namespace
+
+TEST_F(EphemerisFileTest, Fit) {
+    using namespace openspace::ephemeris;
+
+    double error = 0.0;
+    const Series series = fitSeries(
+        "Orbit",
+        SeriesType::Translation,
+        3,
+        0.0,
+        Period,
+        86400.0,
+        12,
+        circularOrbit,
+        &error
+    );
+    EXPECT_EQ(series.nSegments(), 366u);
+    EXPECT_LT(error, 1.0);
+
+    // The last segment ends at the end of the time range rather than a full segment
+    // length after its start
+    ASSERT_EQ(series.boundaries.size(), 367u);
+    EXPECT_EQ(series.boundaries.front(), 0.0);
+    EXPECT_EQ(series.boundaries.back(), Period);
+    EXPECT_EQ(series.boundaries[365], 365.0 * 86400.0);
+
+    const Segments segments = series.segments();
+    for (double t = 0.0; t < Period; t += 997.0) {
+        double exact[3];
+        double fitted[3];
+        circularOrbit(t, exact);
+        segments.evaluate(t, fitted);
+        for (int i = 0; i < 3; ++i) {
+            EXPECT_NEAR(exact[i], fitted[i], 1.0) << "At " << t;
+        }
+    }
+}
+
+TEST_F(EphemerisFileTest, LocalSubdivision) {
+    using namespace openspace::ephemeris;
+
+    // A narrow bump in the middle of the orbit that day long segments cannot fit
+    constexpr const double BumpCenter = Period / 2.0 + 12345.0;
+    auto bumpedOrbit = [](double t, double* result) {
+        circularOrbit(t, result);
+        const double x = (t - BumpCenter) / 600.0;
+        result[2] = 1e4 * std::exp(-x * x);
+    };
+
+    double error = 0.0;
+    const Series series = fitSeries(
+        "Orbit",
+        SeriesType::Translation,
+        3,
+        0.0,
+        Period,
+        86400.0,
+        12,
+        bumpedOrbit,
+        &error,
+        1.0,
+        1.0
+    );
+    EXPECT_LE(error, 1.0);
+
+    // Only the segments around the bump are subdivided
+    const uint32_t nSegments = series.nSegments();
+    EXPECT_GT(nSegments, 366u);
+    EXPECT_LT(nSegments, 366u + 64u);
+    ASSERT_EQ(series.boundaries.size(), nSegments + 1);
+    EXPECT_EQ(series.boundaries.front(), 0.0);
+    EXPECT_EQ(series.boundaries.back(), Period);
+    for (uint32_t s = 0; s < nSegments; ++s) {
+        const double begin = series.boundaries[s];
+        const double end = series.boundaries[s + 1];
+        ASSERT_LT(begin, end);
+        const bool isLast = (s == nSegments - 1);
+        if (!isLast && (end < BumpCenter - 86400.0 || begin > BumpCenter + 86400.0)) {
+            EXPECT_EQ(end - begin, 86400.0) << "Segment " << s;
+        }
+    }
+
+    const Segments segments = series.segments();
+    for (double t = BumpCenter - 86400.0; t < BumpCenter + 86400.0; t += 97.0) {
+        double exact[3];
+        double fitted[3];
+        bumpedOrbit(t, exact);
+        segments.evaluate(t, fitted);
+        for (int i = 0; i < 3; ++i) {
+            EXPECT_NEAR(exact[i], fitted[i], 2.0) << "At " << t;
+        }
+    }
+}
+
+TEST_F(EphemerisFileTest, RoundTrip) {
+    using namespace openspace::ephemeris;
+
+    const std::vector<Series> series = {
+        fitSeries("Orbit", SeriesType::Translation, 3, 0.0, 1e6, 86400.0, 12,
+            circularOrbit),
+        fitSeries("Spin", SeriesType::Rotation, 9, 0.0, 1e6, 3600.0, 12, zRotation)
+    };
+
+    const std::string path = absPath("${TESTDIR}/ephemerisfile.osephem");
+    saveEphemerisFile(series, path);
+
+    EphemerisFile file(path);
+    ASSERT_EQ(file.names().size(), 2u);
+    EXPECT_EQ(file.names()[0], "Orbit");
+    EXPECT_EQ(file.names()[1], "Spin");
+
+    const Segments orbit = file.series("Orbit", SeriesType::Translation);
+    const Segments spin = file.series("Spin", SeriesType::Rotation);
+    EXPECT_EQ(orbit.nSegments, series[0].nSegments());
+    EXPECT_EQ(spin.nSegments, series[1].nSegments());
+
+    for (double t = -1000.0; t < 1e6 + 1000.0; t += 1234.5) {
+        double expected[9];
+        double actual[9];
+        series[0].segments().evaluate(t, expected);
+        orbit.evaluate(t, actual);
+        for (int i = 0; i < 3; ++i) {
+            EXPECT_EQ(expected[i], actual[i]);
+        }
+
+        series[1].segments().evaluate(t, expected);
+        spin.evaluate(t, actual);
+        for (int i = 0; i < 9; ++i) {
+            EXPECT_EQ(expected[i], actual[i]);
+        }
+    }
+
+    EXPECT_THROW(file.series("Orbit", SeriesType::Rotation), ghoul::RuntimeError);
+    EXPECT_THROW(file.series("Missing", SeriesType::Translation), ghoul::RuntimeError);
+}
+
+TEST_F(EphemerisFileTest, Clamping) {
+    using namespace openspace::ephemeris;
+
+    const Series series = fitSeries(
+        "Orbit", SeriesType::Translation, 3, 0.0, 1e6, 86400.0, 12, circularOrbit
+    );
+    const Segments segments = series.segments();
+
+    double before[3];
+    double start[3];
+    segments.evaluate(-1e6, before);
+    segments.evaluate(0.0, start);
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(before[i], start[i]);
+    }
+
+    double after[3];
+    double end[3];
+    segments.evaluate(segments.end() + 1e6, after);
+    segments.evaluate(segments.end(), end);
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(after[i], end[i]);
+    }
+}
+
+TEST_F(EphemerisFileTest, RejectsInvalidFile) {
+    using namespace openspace::ephemeris;
+
+    const std::string path = absPath("${TESTDIR}/ephemerisfile_invalid.osephem");
+    {
+        std::ofstream file(path, std::ofstream::binary);
+        file << "This is not an ephemeris file";
+    }
+    EXPECT_THROW(EphemerisFile file(path), ghoul::RuntimeError);
+}
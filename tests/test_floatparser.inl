@@ -0,0 +1,207 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2018                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include <openspace/util/floatparser.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+class FloatParserTest : public testing::Test {};
+
+namespace {
+    float parse(const std::string& s, size_t expectedLength) {
+        float value = -1.f;
+        const char* end = openspace::parseFloat(s.data(), s.data() + s.size(), value);
+        EXPECT_EQ(static_cast<size_t>(end - s.data()), expectedLength) << s;
+        return value;
+    }
+
+    int64_t ulpDistance(float a, float b) {
+        int32_t ia;
+        int32_t ib;
+        std::memcpy(&ia, &a, sizeof(float));
+        std::memcpy(&ib, &b, sizeof(float));
+        // Map the sign-magnitude representation onto a monotonic integer line
+        const int64_t la = ia < 0 ? -static_cast<int64_t>(ia & 0x7FFFFFFF) : ia;
+        const int64_t lb = ib < 0 ? -static_cast<int64_t>(ib & 0x7FFFFFFF) : ib;
+        return std::abs(la - lb);
+    }
+} // namespace
+
+TEST_F(FloatParserTest, ParseFloat) {
+    EXPECT_EQ(parse("0", 1), 0.f);
+    EXPECT_EQ(parse("42", 2), 42.f);
+    EXPECT_EQ(parse("-42", 3), -42.f);
+    EXPECT_EQ(parse("+1.5", 4), 1.5f);
+    EXPECT_EQ(parse(".25", 3), 0.25f);
+    EXPECT_EQ(parse("3.", 2), 3.f);
+    EXPECT_EQ(parse("1e3", 3), 1000.f);
+    EXPECT_EQ(parse("2.5E-2", 6), 0.025f);
+    EXPECT_EQ(parse("1e+2 ", 4), 100.f);
+    EXPECT_EQ(parse("7e", 1), 7.f);
+    EXPECT_EQ(parse("7e-x", 1), 7.f);
+    EXPECT_EQ(parse("12abc", 2), 12.f);
+    EXPECT_EQ(parse("0.000000000000000000000000000001", 32), 1e-30f);
+    EXPECT_EQ(parse("123456789012345678901234567890", 30), 1.2345679e29f);
+
+    EXPECT_EQ(parse("", 0), -1.f);
+    EXPECT_EQ(parse("-", 0), -1.f);
+    EXPECT_EQ(parse(".", 0), -1.f);
+    EXPECT_EQ(parse("abc", 0), -1.f);
+    EXPECT_EQ(parse("e5", 0), -1.f);
+}
+
+TEST_F(FloatParserTest, MatchesStrtof) {
+    std::mt19937 random(1337);
+    std::uniform_real_distribution<double> mantissa(-10.0, 10.0);
+    std::uniform_int_distribution<int> exponent(-40, 40);
+    std::uniform_int_distribution<int> precision(1, 12);
+
+    for (int i = 0; i < 100000; ++i) {
+        std::ostringstream stream;
+        stream.precision(precision(random));
+        if (i % 2 == 0) {
+            stream << mantissa(random) * std::pow(10.0, exponent(random));
+        }
+        else {
+            stream << std::fixed << mantissa(random) * 1000.0;
+        }
+        const std::string s = stream.str();
+
+        float value = 0.f;
+        const char* end = openspace::parseFloat(s.data(), s.data() + s.size(), value);
+        ASSERT_EQ(end, s.data() + s.size()) << s;
+        ASSERT_LE(ulpDistance(value, std::strtof(s.c_str(), nullptr)), 1) << s;
+    }
+}
+
+TEST_F(FloatParserTest, ParseFloats) {
+    const std::string line = "  1 2\t\t3    4 label 5";
+    std::vector<float> values(6, -1.f);
+    const size_t n = openspace::parseFloats(
+        line.data(),
+        line.data() + line.size(),
+        values.data(),
+        values.size()
+    );
+    ASSERT_EQ(n, 4u);
+    EXPECT_EQ(values[3], 4.f);
+    EXPECT_EQ(values[4], -1.f);
+}
+
+TEST_F(FloatParserTest, ParseFloatBlock) {
+    const std::string block =
+        "1 2 3\r\n"
+        "\r\n"
+        "# comment\n"
+        "   4 5 6 7 # trailing comment\n"
+        "8 9\n"
+        "                                        10 11 12";
+
+    std::vector<float> values;
+    const size_t n = openspace::parseFloatBlock(
+        block.data(),
+        block.data() + block.size(),
+        3,
+        values
+    );
+    ASSERT_EQ(n, 4u);
+    const std::vector<float> expected = {
+        1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 8.f, 9.f, 0.f, 10.f, 11.f, 12.f
+    };
+    EXPECT_EQ(values, expected);
+}
+
+TEST_F(FloatParserTest, DISABLED_Benchmark) {
+    // A star catalog like block with a position, color, luminosity, absolute magnitude,
+    // and a velocity per star
+    constexpr const int NStars = 2000000;
+    constexpr const int NValues = 10;
+
+    std::mt19937 random(1337);
+    std::uniform_real_distribution<float> dist(-10000.f, 10000.f);
+    std::string block;
+    {
+        std::ostringstream stream;
+        stream.precision(7);
+        for (int i = 0; i < NStars; ++i) {
+            for (int j = 0; j < NValues; ++j) {
+                stream << dist(random) << ' ';
+            }
+            stream << "# star " << i << '\n';
+        }
+        block = stream.str();
+    }
+
+    auto time = [](auto parse) {
+        auto start = std::chrono::high_resolution_clock::now();
+        std::vector<float> values = parse();
+        auto end = std::chrono::high_resolution_clock::now();
+        EXPECT_EQ(values.size(), static_cast<size_t>(NStars) * NValues);
+        return std::chrono::duration<double>(end - start).count();
+    };
+
+    const double streamTime = time([&block]() {
+        // The approach the speck loaders used before
+        std::vector<float> result;
+        std::istringstream file(block);
+        std::string line;
+        while (std::getline(file, line)) {
+            std::stringstream str(line);
+            std::vector<float> values(NValues);
+            for (int i = 0; i < NValues; ++i) {
+                str >> values[i];
+            }
+            result.insert(result.end(), values.begin(), values.end());
+        }
+        return result;
+    });
+
+    const double parserTime = time([&block]() {
+        std::vector<float> result;
+        openspace::parseFloatBlock(
+            block.data(),
+            block.data() + block.size(),
+            NValues,
+            result
+        );
+        return result;
+    });
+
+    const double megabytes = block.size() / (1024.0 * 1024.0);
+    std::cout << NStars << " stars (" << megabytes << " MB): stringstream "
+              << megabytes / streamTime << " MB/s, parseFloatBlock "
+              << megabytes / parserTime << " MB/s (" << streamTime / parserTime << "x)"
+              << std::endl;
+}
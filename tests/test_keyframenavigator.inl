@@ -0,0 +1,131 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2018                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+
+#include "gtest/gtest.h"
+
+#include <openspace/interaction/keyframenavigator.h>
+#include <openspace/scene/scene.h>
+#include <openspace/scene/scenegraphnode.h>
+#include <openspace/scene/sceneinitializer.h>
+#include <openspace/util/camera.h>
+#include <openspace/util/time.h>
+#include <openspace/util/updatestructures.h>
+
+#include <memory>
+
+class KeyframeNavigatorTest : public testing::Test {
+protected:
+    KeyframeNavigatorTest()
+        : scene(std::make_unique<openspace::SingleThreadedSceneInitializer>())
+    {
+        // The keyframes are relative to the root node, which stays at the origin
+        scene.update({ {}, openspace::Time(0.0), openspace::Time(0.0), false });
+        camera.setParent(scene.root());
+        navigator.setPredictionEnabled(true);
+    }
+
+    void addKeyframe(double timestamp, double x) {
+        openspace::interaction::KeyframeNavigator::CameraPose pose;
+        pose.position = glm::dvec3(x, 0.0, 0.0);
+        pose.rotation = glm::quat(1.f, 0.f, 0.f, 0.f);
+        pose.focusNode = openspace::SceneGraphNode::RootNodeIdentifier;
+        pose.scale = 1.f;
+        pose.followFocusNodeRotation = false;
+        navigator.addKeyframe(timestamp, pose);
+    }
+
+    double cameraAt(double now) {
+        navigator.updateCamera(camera, now);
+        return camera.positionVec3().x;
+    }
+
+    openspace::Scene scene;
+    openspace::Camera camera;
+    openspace::interaction::KeyframeNavigator navigator;
+};
+
+TEST_F(KeyframeNavigatorTest, InterpolatesBetweenKeyframes) {
+    addKeyframe(0.0, 10.0);
+    addKeyframe(1.0, 11.0);
+
+    EXPECT_NEAR(cameraAt(0.25), 10.25, 1e-9);
+    EXPECT_NEAR(cameraAt(0.5), 10.5, 1e-9);
+}
+
+TEST_F(KeyframeNavigatorTest, ExtrapolationIsCappedAtTwoIntervals) {
+    addKeyframe(0.0, 10.0);
+    addKeyframe(1.0, 11.0);
+
+    // Without a keyframe after the current time, the motion between the last two
+    // keyframes is continued
+    EXPECT_NEAR(cameraAt(1.5), 11.5, 1e-9);
+    EXPECT_NEAR(cameraAt(2.0), 12.0, 1e-9);
+    EXPECT_NEAR(cameraAt(3.0), 13.0, 1e-9);
+
+    // ... but for at most two keyframe intervals past the last keyframe
+    EXPECT_NEAR(cameraAt(3.5), 13.0, 1e-9);
+    EXPECT_NEAR(cameraAt(100.0), 13.0, 1e-9);
+}
+
+TEST_F(KeyframeNavigatorTest, NoExtrapolationWithoutPrediction) {
+    navigator.setPredictionEnabled(false);
+    addKeyframe(0.0, 10.0);
+    addKeyframe(1.0, 11.0);
+
+    EXPECT_NEAR(cameraAt(0.5), 10.5, 1e-9);
+    // The camera is not updated at all once the last keyframe has passed
+    EXPECT_NEAR(cameraAt(1.5), 10.5, 1e-9);
+}
+
+TEST_F(KeyframeNavigatorTest, CorrectionConvergesOntoLateKeyframe) {
+    addKeyframe(0.0, 10.0);
+    addKeyframe(1.0, 11.0);
+
+    const double predicted = cameraAt(1.5);
+    EXPECT_NEAR(predicted, 11.5, 1e-9);
+
+    // The keyframe for the time 2 arrives late and does not continue the motion, so the
+    // prediction overshot the actual camera
+    addKeyframe(2.0, 11.2);
+    auto actualAt = [](double now) { return 11.0 + (now - 1.0) * 0.2; };
+
+    // The camera does not jump when the keyframe arrives ...
+    const double start = 1.6;
+    EXPECT_NEAR(cameraAt(start), predicted, 1e-9);
+
+    // ... but approaches the actual camera monotonically ...
+    double previousError = predicted - actualAt(start);
+    for (int i = 1; i < 10; ++i) {
+        const double now = start + i * 0.025;
+        const double error = cameraAt(now) - actualAt(now);
+        EXPECT_GT(error, 0.0) << "At " << now;
+        EXPECT_LT(error, previousError) << "At " << now;
+        previousError = error;
+    }
+
+    // ... and matches it once the correction time of 0.25 seconds has passed
+    EXPECT_NEAR(cameraAt(start + 0.25), actualAt(start + 0.25), 1e-9);
+    EXPECT_NEAR(cameraAt(1.95), actualAt(1.95), 1e-9);
+}
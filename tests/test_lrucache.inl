@@ -23,10 +23,19 @@
  ****************************************************************************************/
 
 #include <modules/globebrowsing/cache/lrucache.h>
+#include <modules/globebrowsing/cache/memoryawaretilecache.h>
+#include <modules/globebrowsing/cache/shardedlrucache.h>
 
 #define _USE_MATH_DEFINES
 #include <math.h>
 #include <glm/glm.hpp>
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <thread>
 
 class LRUCacheTest : public testing::Test {};
 
@@ -95,3 +104,251 @@ TEST_F(LRUCacheTest, StructKey) {
     ASSERT_EQ(lru.get(key1), val2);
     ASSERT_EQ(lru.get(key2), val2);
 }
+
+TEST_F(LRUCacheTest, ShardedByteBudget) {
+    openspace::globebrowsing::cache::ShardedLRUCache<int, double, DefaultHasher> lru(10);
+    lru.put(1, 1.2, 4);
+    lru.put(2, 2.3, 4);
+    ASSERT_EQ(lru.usedBytes(), 8u);
+    lru.get(1);
+    lru.put(3, 3.4, 4);
+    ASSERT_TRUE(lru.exist(1)) << "Recently used element should remain in cache";
+    ASSERT_FALSE(lru.exist(2)) << "Element should have been cleaned out of cache";
+    ASSERT_EQ(lru.usedBytes(), 8u);
+
+    // Replacing a value has to update its cost
+    lru.put(3, 4.5, 2);
+    ASSERT_EQ(lru.size(), 2u);
+    ASSERT_EQ(lru.usedBytes(), 6u);
+    ASSERT_EQ(lru.get(3), 4.5);
+
+    // An item that is larger than the budget cannot be stored
+    std::vector<std::pair<int, double>> popped = lru.putAndFetchPopped(4, 5.6, 11);
+    ASSERT_EQ(popped.size(), 3u);
+    ASSERT_EQ(popped.back().first, 4);
+    ASSERT_TRUE(lru.isEmpty());
+}
+
+TEST_F(LRUCacheTest, ShardedPopLRU) {
+    using namespace openspace::globebrowsing::cache;
+    ShardedLRUCache<int, int, DefaultHasher> lru(std::numeric_limits<size_t>::max(), 8);
+    ASSERT_EQ(lru.numShards(), 8u);
+
+    for (int i = 0; i < 100; ++i) {
+        lru.put(i, i, 1);
+    }
+    ASSERT_TRUE(lru.touch(0));
+    int value = 0;
+    ASSERT_TRUE(lru.tryGet(1, value));
+    ASSERT_EQ(value, 1);
+    ASSERT_FALSE(lru.tryGet(100, value));
+
+    // The items have to be popped in the global LRU order regardless of their shard
+    for (int i = 2; i < 100; ++i) {
+        ASSERT_EQ(lru.popLRU().first, i);
+    }
+    ASSERT_EQ(lru.popLRU().first, 0);
+    ASSERT_EQ(lru.popLRU().first, 1);
+    ASSERT_TRUE(lru.isEmpty());
+    ASSERT_EQ(lru.usedBytes(), 0u);
+}
+
+TEST_F(LRUCacheTest, ShardedPutReturnsReplacedValue) {
+    using namespace openspace::globebrowsing::cache;
+    ShardedLRUCache<int, int, DefaultHasher> lru(3, 1);
+
+    ASSERT_TRUE(lru.putAndFetchPopped(1, 10, 1).empty());
+    ASSERT_TRUE(lru.putAndFetchPopped(2, 20, 1).empty());
+
+    // The replaced value is returned so that its resources can be released
+    std::vector<std::pair<int, int>> popped = lru.putAndFetchPopped(1, 11, 1);
+    ASSERT_EQ(popped.size(), 1u);
+    ASSERT_EQ(popped[0].first, 1);
+    ASSERT_EQ(popped[0].second, 10);
+    ASSERT_EQ(lru.get(1), 11);
+    ASSERT_EQ(lru.usedBytes(), 2u);
+
+    popped = lru.putAndFetchPopped(3, 30, 2);
+    ASSERT_EQ(popped.size(), 1u);
+    ASSERT_EQ(popped[0].first, 2);
+}
+
+TEST_F(LRUCacheTest, ShardedItems) {
+    using namespace openspace::globebrowsing::cache;
+    ShardedLRUCache<int, int, DefaultHasher> lru(std::numeric_limits<size_t>::max(), 4);
+
+    for (int i = 0; i < 20; ++i) {
+        lru.put(i, 2 * i, 1);
+    }
+    ASSERT_TRUE(lru.touch(3));
+
+    // The snapshot is in global LRU order and does not change the cache
+    std::vector<std::pair<int, int>> items = lru.items();
+    ASSERT_EQ(items.size(), 20u);
+    ASSERT_EQ(items.back().first, 3);
+    ASSERT_EQ(items.front().first, 0);
+    for (const std::pair<int, int>& item : items) {
+        ASSERT_EQ(item.second, 2 * item.first);
+    }
+    ASSERT_EQ(lru.size(), 20u);
+    ASSERT_EQ(lru.popLRU().first, 0);
+}
+
+TEST_F(LRUCacheTest, ShardedConcurrentAccess) {
+    using namespace openspace::globebrowsing::cache;
+    ShardedLRUCache<int, int, DefaultHasher> lru(1000, 16);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&lru, t]() {
+            for (int i = 0; i < 10000; ++i) {
+                const int key = (t * 10000 + i) % 3000;
+                int value = 0;
+                if (lru.tryGet(key, value)) {
+                    EXPECT_EQ(value, key);
+                }
+                else {
+                    lru.put(key, key, 1);
+                }
+            }
+        });
+    }
+    for (std::thread& t : threads) {
+        t.join();
+    }
+    ASSERT_LE(lru.usedBytes(), lru.byteBudget());
+    ASSERT_EQ(lru.usedBytes(), lru.size());
+}
+
+namespace {
+    using openspace::globebrowsing::cache::ProviderTileKey;
+    using openspace::globebrowsing::cache::ProviderTileHasher;
+
+    // Generates the tile requests a globe would issue while the camera moves over the
+    // surface: for every layer and every level, the tiles in a window around the point
+    // below the camera are requested, with more tiles at the finer levels
+    std::vector<std::vector<ProviderTileKey>> generateTileRequests(int nFrames) {
+        constexpr const unsigned int NumLayers = 4;
+        constexpr const int MinLevel = 2;
+        constexpr const int MaxLevel = 18;
+
+        std::mt19937 rng(1337);
+        std::normal_distribution<double> step(0.0, 0.0005);
+        double lon = 0.3;
+        double lat = 0.6;
+
+        std::vector<std::vector<ProviderTileKey>> frames(nFrames);
+        for (std::vector<ProviderTileKey>& frame : frames) {
+            lon = glm::fract(lon + step(rng));
+            lat = glm::clamp(lat + step(rng), 0.0, 1.0);
+            for (unsigned int layer = 0; layer < NumLayers; ++layer) {
+                for (int level = MinLevel; level <= MaxLevel; ++level) {
+                    const int nX = 1 << (level + 1);
+                    const int nY = 1 << level;
+                    const int cx = static_cast<int>(lon * nX);
+                    const int cy = static_cast<int>(lat * (nY - 1));
+                    const int radius = level > 10 ? 3 : 1;
+                    for (int y = cy - radius; y <= cy + radius; ++y) {
+                        for (int x = cx - radius; x <= cx + radius; ++x) {
+                            if (y < 0 || y >= nY) {
+                                continue;
+                            }
+                            ProviderTileKey key;
+                            key.tileIndex = { (x + nX) % nX, y, level };
+                            key.providerID = layer;
+                            frame.push_back(key);
+                        }
+                    }
+                }
+            }
+        }
+        return frames;
+    }
+
+    // Simulates the tile cache of the tile providers: every request that misses is
+    // loaded and put into the cache
+    template <typename Cache>
+    void runTileRequests(Cache& cache, const std::vector<ProviderTileKey>& keys,
+                         size_t tileSize, int& nMisses)
+    {
+        for (const ProviderTileKey& key : keys) {
+            if (cache.exist(key)) {
+                cache.touch(key);
+            }
+            else {
+                ++nMisses;
+                cache.put(key, tileSize, tileSize);
+            }
+        }
+    }
+
+    // LRUCache wrapped with a single mutex and the same interface as the ShardedLRUCache
+    struct LockedLRUCache {
+        LockedLRUCache(size_t size) : cache(size) {}
+
+        bool exist(const ProviderTileKey& key) {
+            std::lock_guard<std::mutex> lock(mutex);
+            return cache.exist(key);
+        }
+        bool touch(const ProviderTileKey& key) {
+            std::lock_guard<std::mutex> lock(mutex);
+            return cache.touch(key);
+        }
+        void put(const ProviderTileKey& key, size_t value, size_t) {
+            std::lock_guard<std::mutex> lock(mutex);
+            cache.put(key, value);
+        }
+
+        std::mutex mutex;
+        openspace::globebrowsing::cache::LRUCache<
+            ProviderTileKey, size_t, ProviderTileHasher
+        > cache;
+    };
+} // namespace
+
+TEST_F(LRUCacheTest, DISABLED_Benchmark) {
+    using openspace::globebrowsing::cache::ShardedLRUCache;
+
+    constexpr const size_t TileSize = 260 * 260 * 4;
+    constexpr const size_t NumTiles = 4096;
+    const std::vector<std::vector<ProviderTileKey>> frames = generateTileRequests(2000);
+
+    for (int nThreads : { 1, 4, 16 }) {
+        const size_t nShards = nThreads == 1 ? 1 : 16;
+
+        LockedLRUCache lru(NumTiles);
+        ShardedLRUCache<ProviderTileKey, size_t, ProviderTileHasher> sharded(
+            NumTiles * TileSize,
+            nShards
+        );
+
+        auto run = [&](auto& cache, int& nMisses) {
+            std::vector<std::thread> threads;
+            std::vector<int> misses(nThreads, 0);
+            auto start = std::chrono::high_resolution_clock::now();
+            for (int t = 0; t < nThreads; ++t) {
+                threads.emplace_back([&, t]() {
+                    for (size_t f = t; f < frames.size(); f += nThreads) {
+                        runTileRequests(cache, frames[f], TileSize, misses[t]);
+                    }
+                });
+            }
+            for (std::thread& t : threads) {
+                t.join();
+            }
+            auto end = std::chrono::high_resolution_clock::now();
+            nMisses = std::accumulate(misses.begin(), misses.end(), 0);
+            return std::chrono::duration<double, std::milli>(end - start).count();
+        };
+
+        int lruMisses = 0;
+        const double lruTime = run(lru, lruMisses);
+        int shardedMisses = 0;
+        const double shardedTime = run(sharded, shardedMisses);
+
+        std::cout << nThreads << " threads, " << frames.size() << " frames: "
+                  << "LRUCache " << lruTime << " ms (" << lruMisses << " misses), "
+                  << "ShardedLRUCache (" << nShards << " shards) " << shardedTime
+                  << " ms (" << shardedMisses << " misses)" << std::endl;
+    }
+}
@@ -0,0 +1,226 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2018                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include <openspace/network/messagestructures.h>
+#include <openspace/network/parallelconnection.h>
+
+#include <array>
+#include <cstring>
+#include <vector>
+
+class MessageStructuresTest : public testing::Test {};
+
+TEST_F(MessageStructuresTest, CameraKeyframeRoundTrip) {
+    using namespace openspace::datamessagestructures;
+
+    CameraKeyframe kf;
+    kf._position = glm::dvec3(1.0, 2.0, 3.0);
+    kf._rotation = glm::dquat(0.5, 0.5, 0.5, 0.5);
+    kf._followNodeRotation = true;
+    kf._focusNode = "Earth";
+    kf._scale = 2.f;
+    kf._timestamp = 42.0;
+
+    std::vector<char> buffer;
+    kf.serialize(buffer);
+    ASSERT_EQ(kf.serializedSize(), buffer.size());
+
+    CameraKeyframe res;
+    EXPECT_EQ(buffer.size(), res.deserialize(buffer));
+    EXPECT_EQ(kf._position, res._position);
+    EXPECT_EQ(kf._rotation, res._rotation);
+    EXPECT_EQ(kf._followNodeRotation, res._followNodeRotation);
+    EXPECT_EQ(kf._focusNode, res._focusNode);
+    EXPECT_EQ(kf._scale, res._scale);
+    EXPECT_EQ(kf._timestamp, res._timestamp);
+}
+
+TEST_F(MessageStructuresTest, TimeTimelineRoundTrip) {
+    using namespace openspace::datamessagestructures;
+
+    TimeTimeline timeline;
+    timeline._clear = false;
+    for (int i = 0; i < 3; ++i) {
+        TimeKeyframe kf;
+        kf._time = 100.0 * i;
+        kf._dt = 10.0 * i;
+        kf._paused = (i == 1);
+        kf._requiresTimeJump = (i == 2);
+        kf._timestamp = static_cast<double>(i);
+        timeline._keyframes.push_back(kf);
+    }
+
+    std::vector<char> buffer;
+    timeline.serialize(buffer);
+    ASSERT_EQ(timeline.serializedSize(), buffer.size());
+
+    TimeTimeline res;
+    EXPECT_EQ(buffer.size(), res.deserialize(buffer));
+    EXPECT_EQ(timeline._clear, res._clear);
+    ASSERT_EQ(timeline._keyframes.size(), res._keyframes.size());
+    for (size_t i = 0; i < res._keyframes.size(); ++i) {
+        EXPECT_EQ(timeline._keyframes[i]._time, res._keyframes[i]._time);
+        EXPECT_EQ(timeline._keyframes[i]._dt, res._keyframes[i]._dt);
+        EXPECT_EQ(timeline._keyframes[i]._paused, res._keyframes[i]._paused);
+        EXPECT_EQ(
+            timeline._keyframes[i]._requiresTimeJump,
+            res._keyframes[i]._requiresTimeJump
+        );
+        EXPECT_EQ(timeline._keyframes[i]._timestamp, res._keyframes[i]._timestamp);
+    }
+}
+
+TEST_F(MessageStructuresTest, TruncatedMessages) {
+    using namespace openspace::datamessagestructures;
+
+    CameraKeyframe kf;
+    kf._focusNode = "Earth";
+    std::vector<char> buffer;
+    kf.serialize(buffer);
+
+    CameraKeyframe res;
+    EXPECT_EQ(0u, res.deserialize(buffer.data(), buffer.size() - 1));
+
+    // A node name length that exceeds the message must not be read
+    const size_t nameLengthOffset = sizeof(kf._position) + sizeof(kf._rotation) +
+        sizeof(kf._followNodeRotation);
+    const int32_t nameLength = 1 << 30;
+    std::memcpy(buffer.data() + nameLengthOffset, &nameLength, sizeof(int32_t));
+    EXPECT_EQ(0u, res.deserialize(buffer));
+
+    TimeTimeline timeline;
+    timeline._keyframes.resize(2);
+    buffer.clear();
+    timeline.serialize(buffer);
+
+    TimeTimeline timelineRes;
+    EXPECT_EQ(0u, timelineRes.deserialize(buffer.data(), buffer.size() - 1));
+
+    // The number of keyframes has to be checked before any of them is allocated
+    const int64_t nKeyframes = int64_t(1) << 40;
+    std::memcpy(buffer.data() + sizeof(bool), &nKeyframes, sizeof(int64_t));
+    EXPECT_EQ(0u, timelineRes.deserialize(buffer));
+    EXPECT_TRUE(timelineRes._keyframes.empty());
+}
+
+TEST_F(MessageStructuresTest, Batch) {
+    using namespace openspace::datamessagestructures;
+
+    CameraKeyframe kf;
+    kf._position = glm::dvec3(1.0, 2.0, 3.0);
+    kf._rotation = glm::dquat(1.0, 0.0, 0.0, 0.0);
+    kf._followNodeRotation = false;
+    kf._focusNode = "Mars";
+    kf._scale = 1.f;
+    kf._timestamp = 1.0;
+
+    ScriptMessage sm;
+    sm._script = "openspace.time.setPause(true)";
+
+    Batch batch;
+    EXPECT_TRUE(batch.empty());
+    batch.add(Type::CameraData, kf);
+    batch.add(Type::ScriptData, sm);
+    EXPECT_FALSE(batch.empty());
+
+    const std::vector<char>& buffer = batch.buffer();
+    std::vector<Type> types;
+    const bool success = Batch::forEach(
+        buffer.data(),
+        buffer.size(),
+        [&](Type type, const char* data, size_t size) {
+            types.push_back(type);
+            if (type == Type::CameraData) {
+                CameraKeyframe res;
+                EXPECT_EQ(size, res.deserialize(data, size));
+                EXPECT_EQ(kf._focusNode, res._focusNode);
+            }
+            else if (type == Type::ScriptData) {
+                ScriptMessage res;
+                res.deserialize(data, size);
+                EXPECT_EQ(sm._script, res._script);
+            }
+        }
+    );
+    EXPECT_TRUE(success);
+    EXPECT_EQ(std::vector<Type>({ Type::CameraData, Type::ScriptData }), types);
+
+    // A truncated batch must be detected instead of reading out of bounds
+    EXPECT_FALSE(Batch::forEach(
+        buffer.data(),
+        buffer.size() - 1,
+        [](Type, const char*, size_t) {}
+    ));
+
+    batch.clear();
+    EXPECT_TRUE(batch.empty());
+    EXPECT_TRUE(Batch::forEach(
+        batch.buffer().data(),
+        batch.buffer().size(),
+        [](Type, const char*, size_t) { FAIL(); }
+    ));
+}
+
+TEST_F(MessageStructuresTest, ProtocolVersionMismatchIsRefused) {
+    using openspace::ParallelConnection;
+
+    auto header = [](char o, uint32_t version, uint32_t size) {
+        std::array<char, ParallelConnection::HeaderSize> result;
+        const uint32_t type = static_cast<uint32_t>(
+            ParallelConnection::MessageType::Data
+        );
+        result[0] = o;
+        result[1] = 'S';
+        std::memcpy(result.data() + 2, &version, sizeof(uint32_t));
+        std::memcpy(result.data() + 6, &type, sizeof(uint32_t));
+        std::memcpy(result.data() + 10, &size, sizeof(uint32_t));
+        return result;
+    };
+
+    const auto valid = header('O', ParallelConnection::ProtocolVersion, 26);
+    const std::pair<ParallelConnection::MessageType, size_t> res =
+        ParallelConnection::readHeader(valid.data());
+    EXPECT_EQ(res.first, ParallelConnection::MessageType::Data);
+    EXPECT_EQ(res.second, 26u);
+
+    // Peers with the old TimeKeyframe layout and without batches use version 5
+    const auto old = header('O', 5, 40);
+    EXPECT_THROW(
+        ParallelConnection::readHeader(old.data()),
+        ParallelConnection::ConnectionLostError
+    );
+    const auto newer = header('O', ParallelConnection::ProtocolVersion + 1, 26);
+    EXPECT_THROW(
+        ParallelConnection::readHeader(newer.data()),
+        ParallelConnection::ConnectionLostError
+    );
+
+    const auto malformed = header('X', ParallelConnection::ProtocolVersion, 26);
+    EXPECT_THROW(
+        ParallelConnection::readHeader(malformed.data()),
+        ParallelConnection::ConnectionLostError
+    );
+}
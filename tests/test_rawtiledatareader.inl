@@ -0,0 +1,256 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2018                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include <modules/globebrowsing/tile/rawtiledatareader/iodescription.h>
+#include <modules/globebrowsing/tile/rawtiledatareader/rawtiledatareader.h>
+#include <modules/globebrowsing/tile/tileindex.h>
+#include <modules/globebrowsing/tile/tiletextureinitdata.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+class RawTileDataReaderTest : public testing::Test {};
+
+namespace {
+    using openspace::globebrowsing::IODescription;
+    using openspace::globebrowsing::PixelRegion;
+    using openspace::globebrowsing::RawTile;
+    using openspace::globebrowsing::RawTileDataReader;
+    using openspace::globebrowsing::TileIndex;
+    using openspace::globebrowsing::TileTextureInitData;
+
+    /**
+     * Reads from a generated dataset in which every byte depends on the band and the
+     * pixel position. Like the GDAL reader, the lines of the write region are stored
+     * bottom to top and the read region is resampled with the nearest neighbor.
+     */
+    class MockRawTileDataReader : public RawTileDataReader {
+    public:
+        MockRawTileDataReader(const TileTextureInitData& initData, int rasterX,
+                              int rasterY, int nRasters, bool supportsBatches)
+            : RawTileDataReader(initData)
+            , _rasterX(rasterX)
+            , _rasterY(rasterY)
+            , _nRasters(nRasters)
+            , _supportsBatches(supportsBatches)
+        {}
+
+        int maxChunkLevel() const override { return 10; }
+        void reset() override {}
+        float noDataValueAsFloat() const override { return 0.f; }
+        int rasterXSize() const override { return _rasterX; }
+        int rasterYSize() const override { return _rasterY; }
+        int dataSourceNumRasters() const override { return _nRasters; }
+        const std::string& datasetFilePath() const override { return _path; }
+
+        int nRasterReads() const { return _nRasterReads; }
+
+    protected:
+        void initialize() override {}
+
+        bool supportsBatchedReads() const override { return _supportsBatches; }
+
+        RawTile::ReadError rasterRead(int rasterBand, const IODescription& io,
+                                      char* dst) const override
+        {
+            ++_nRasterReads;
+
+            const ptrdiff_t bytesPerPixel = _initData.bytesPerPixel();
+            const ptrdiff_t bytesPerLine = io.write.bytesPerLine;
+            char* lastLine = dst + io.write.totalNumBytes - bytesPerLine -
+                             io.write.region.start.y * bytesPerLine +
+                             io.write.region.start.x * bytesPerPixel;
+
+            const PixelRegion& read = io.read.region;
+            const PixelRegion& write = io.write.region;
+            for (int y = 0; y < write.numPixels.y; ++y) {
+                const int srcY = read.start.y +
+                    ((2 * y + 1) * read.numPixels.y) / (2 * write.numPixels.y);
+                for (int x = 0; x < write.numPixels.x; ++x) {
+                    const int srcX = read.start.x +
+                        ((2 * x + 1) * read.numPixels.x) / (2 * write.numPixels.x);
+                    char* pixel = lastLine - y * bytesPerLine + x * bytesPerPixel;
+                    for (size_t b = 0; b < _initData.bytesPerDatum(); ++b) {
+                        pixel[b] = static_cast<char>(
+                            (srcX * 7 + srcY * 13 + rasterBand * 31 + b * 59) & 0xFF
+                        );
+                    }
+                }
+            }
+            return RawTile::ReadError::None;
+        }
+
+    private:
+        const int _rasterX;
+        const int _rasterY;
+        const int _nRasters;
+        const bool _supportsBatches;
+        const std::string _path = "mock";
+        mutable int _nRasterReads = 0;
+    };
+
+    std::vector<TileIndex> tilesOfLevel(int level) {
+        std::vector<TileIndex> tiles;
+        for (int y = 0; y < (1 << (level - 1)); ++y) {
+            for (int x = 0; x < (1 << level); ++x) {
+                tiles.emplace_back(x, y, level);
+            }
+        }
+        return tiles;
+    }
+
+    std::vector<char> readTile(const MockRawTileDataReader& reader, const TileIndex& t,
+                               RawTile::ReadError& error)
+    {
+        std::vector<char> data(reader.tileTextureInitData().totalNumBytes());
+        std::shared_ptr<RawTile> rawTile = reader.readTileData(t, data.data(), nullptr);
+        error = rawTile->error;
+        return data;
+    }
+
+    /**
+     * Reads all tiles of the level one by one and with all of them registered as
+     * pending, and expects the same bytes for every tile.
+     *
+     * \return The number of raster reads that were saved by the batched reads
+     */
+    size_t expectIdenticalTiles(const TileTextureInitData& initData, int rasterX,
+                                int rasterY, int nRasters, int level)
+    {
+        MockRawTileDataReader single(initData, rasterX, rasterY, nRasters, false);
+        MockRawTileDataReader batched(initData, rasterX, rasterY, nRasters, true);
+
+        const std::vector<TileIndex> tiles = tilesOfLevel(level);
+        for (const TileIndex& t : tiles) {
+            batched.beginTileRead(t.hashKey());
+        }
+
+        for (const TileIndex& t : tiles) {
+            RawTile::ReadError singleError;
+            RawTile::ReadError batchedError;
+            const std::vector<char> expected = readTile(single, t, singleError);
+            const std::vector<char> actual = readTile(batched, t, batchedError);
+            EXPECT_EQ(singleError, batchedError);
+            EXPECT_TRUE(expected == actual) <<
+                "Tile " << t.x << ", " << t.y << " at level " << level << " differs";
+            batched.endTileRead(t.hashKey());
+        }
+
+        EXPECT_EQ(
+            static_cast<size_t>(single.nRasterReads() - batched.nRasterReads()),
+            batched.numSavedRasterReads()
+        );
+        return batched.numSavedRasterReads();
+    }
+} // namespace
+
+TEST_F(RawTileDataReaderTest, BatchedReadsMatchSingleReads) {
+    const TileTextureInitData initData(
+        64,
+        64,
+        GL_UNSIGNED_BYTE,
+        TileTextureInitData::Format::RGB,
+        TileTextureInitData::PadTiles::No
+    );
+
+    // The tiles are 128 by 128 pixels in the dataset on level 3, so siblings are
+    // batched
+    for (int level = 2; level <= 4; ++level) {
+        EXPECT_GT(expectIdenticalTiles(initData, 1024, 512, 3, level), 0u);
+    }
+}
+
+TEST_F(RawTileDataReaderTest, BatchedReadsMatchSingleReadsOddSizes) {
+    const TileTextureInitData byteData(
+        37,
+        37,
+        GL_UNSIGNED_BYTE,
+        TileTextureInitData::Format::RGBA,
+        TileTextureInitData::PadTiles::No
+    );
+    const TileTextureInitData floatData(
+        37,
+        37,
+        GL_FLOAT,
+        TileTextureInitData::Format::Red,
+        TileTextureInitData::PadTiles::No
+    );
+
+    // Whether these tiles are batched depends on the rounding of their read regions,
+    // but the result has to be the same either way
+    for (int level = 2; level <= 5; ++level) {
+        expectIdenticalTiles(byteData, 999, 501, 4, level);
+        expectIdenticalTiles(byteData, 1000, 500, 2, level);
+        expectIdenticalTiles(floatData, 999, 501, 1, level);
+        expectIdenticalTiles(floatData, 74, 37, 1, level);
+    }
+}
+
+TEST_F(RawTileDataReaderTest, BatchedReadsMatchSingleReadsEdgeTiles) {
+    // The padding makes the read regions of the tiles along the dataset border wrap
+    // around the edges
+    const TileTextureInitData initData(
+        68,
+        68,
+        GL_UNSIGNED_BYTE,
+        TileTextureInitData::Format::RGB,
+        TileTextureInitData::PadTiles::Yes
+    );
+
+    for (int level = 1; level <= 4; ++level) {
+        expectIdenticalTiles(initData, 1024, 512, 3, level);
+        expectIdenticalTiles(initData, 1088, 544, 1, level);
+    }
+}
+
+TEST_F(RawTileDataReaderTest, CancelledSiblingIsReadOnItsOwn) {
+    const TileTextureInitData initData(
+        64,
+        64,
+        GL_UNSIGNED_BYTE,
+        TileTextureInitData::Format::RGB,
+        TileTextureInitData::PadTiles::No
+    );
+    MockRawTileDataReader single(initData, 1024, 512, 3, false);
+    MockRawTileDataReader batched(initData, 1024, 512, 3, true);
+
+    const TileIndex tile(2, 2, 3);
+    const TileIndex sibling(3, 2, 3);
+    batched.beginTileRead(tile.hashKey());
+    batched.beginTileRead(sibling.hashKey());
+
+    RawTile::ReadError error;
+    EXPECT_TRUE(readTile(single, tile, error) == readTile(batched, tile, error));
+    EXPECT_EQ(batched.numSavedRasterReads(), 3u);
+
+    // Cancelling the sibling drops its slice, so it has to be read again
+    batched.endTileRead(sibling.hashKey());
+    const int nRasterReads = batched.nRasterReads();
+    EXPECT_TRUE(readTile(single, sibling, error) == readTile(batched, sibling, error));
+    EXPECT_EQ(batched.nRasterReads(), nRasterReads + 3);
+}
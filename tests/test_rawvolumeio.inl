@@ -85,3 +85,90 @@ TEST_F(RawVolumeIoTest, BasicInputOutput) {
         ASSERT_EQ(v, value(x));
     });
 }
+
+namespace {
+    // Writes a volume with a unique value per voxel and returns its path
+    std::string writeIndexVolume(const glm::uvec3& dims, const std::string& name) {
+        using namespace openspace::volume;
+
+        RawVolume<float> vol(dims);
+        for (size_t i = 0; i < vol.nCells(); ++i) {
+            vol.set(i, static_cast<float>(i));
+        }
+
+        std::string volumePath = absPath("${TESTDIR}/" + name + ".rawvolume");
+        RawVolumeWriter<float> writer(volumePath);
+        writer.write(vol);
+        return volumePath;
+    }
+} // namespace
+
+TEST_F(RawVolumeIoTest, RandomAccess) {
+    using namespace openspace::volume;
+
+    glm::uvec3 dims{ 3, 5, 7 };
+    std::string volumePath = writeIndexVolume(dims, "randomaccessvolume");
+
+    RawVolumeReader<float> reader(volumePath, dims);
+    EXPECT_EQ(0.f, reader.get(glm::uvec3(0, 0, 0)));
+    EXPECT_EQ(1.f, reader.get(glm::uvec3(1, 0, 0)));
+    EXPECT_EQ(3.f, reader.get(glm::uvec3(0, 1, 0)));
+    EXPECT_EQ(15.f, reader.get(glm::uvec3(0, 0, 1)));
+    EXPECT_EQ(104.f, reader.get(glm::uvec3(2, 4, 6)));
+    EXPECT_EQ(42.f, reader.get(size_t(42)));
+
+    EXPECT_THROW(reader.get(glm::uvec3(3, 0, 0)), ghoul::RuntimeError);
+    EXPECT_THROW(reader.get(size_t(105)), ghoul::RuntimeError);
+}
+
+TEST_F(RawVolumeIoTest, SubvolumeRead) {
+    using namespace openspace::volume;
+
+    glm::uvec3 dims{ 4, 5, 6 };
+    std::string volumePath = writeIndexVolume(dims, "subvolume");
+
+    RawVolumeReader<float> reader(volumePath, dims);
+    const glm::uvec3 offset{ 1, 2, 3 };
+    std::unique_ptr<RawVolume<float>> sub = reader.readSubvolume(
+        offset,
+        glm::uvec3(3, 2, 3)
+    );
+    ASSERT_EQ(glm::uvec3(3, 2, 3), sub->dimensions());
+    for (size_t i = 0; i < sub->nCells(); ++i) {
+        const glm::uvec3 c = sub->indexToCoords(i);
+        EXPECT_EQ(static_cast<float>(coordsToIndex(offset + c, dims)), sub->get(i));
+    }
+
+    EXPECT_THROW(
+        reader.readSubvolume(glm::uvec3(2, 0, 0), glm::uvec3(3, 1, 1)),
+        ghoul::RuntimeError
+    );
+}
+
+TEST_F(RawVolumeIoTest, DownsampledRead) {
+    using namespace openspace::volume;
+
+    glm::uvec3 dims{ 5, 4, 3 };
+    std::string volumePath = writeIndexVolume(dims, "downsampledvolume");
+
+    RawVolumeReader<float> reader(volumePath, dims);
+    const glm::uvec3 stride{ 2, 3, 1 };
+    std::unique_ptr<RawVolume<float>> down = reader.readDownsampled(stride);
+    ASSERT_EQ(glm::uvec3(3, 2, 3), down->dimensions());
+    for (size_t i = 0; i < down->nCells(); ++i) {
+        const glm::uvec3 c = down->indexToCoords(i);
+        EXPECT_EQ(static_cast<float>(coordsToIndex(c * stride, dims)), down->get(i));
+    }
+
+    EXPECT_THROW(reader.readDownsampled(glm::uvec3(1, 0, 1)), ghoul::RuntimeError);
+}
+
+TEST_F(RawVolumeIoTest, TooSmallFile) {
+    using namespace openspace::volume;
+
+    glm::uvec3 dims{ 2, 2, 2 };
+    std::string volumePath = writeIndexVolume(dims, "toosmallvolume");
+
+    RawVolumeReader<float> reader(volumePath, glm::uvec3(2, 2, 3));
+    EXPECT_THROW(reader.get(size_t(0)), ghoul::RuntimeError);
+}
@@ -0,0 +1,249 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2018                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+
+#include "gtest/gtest.h"
+
+#include <openspace/scene/scene.h>
+#include <openspace/scene/scenegraphnode.h>
+#include <openspace/scene/sceneinitializer.h>
+#include <openspace/util/threadpool.h>
+#include <openspace/util/updatestructures.h>
+
+#include <ghoul/misc/dictionary.h>
+#include <memory>
+#include <string>
+
+class SceneGraphNodeTest : public testing::Test {};
+
+namespace {
+    std::unique_ptr<openspace::SceneGraphNode> createNode(const std::string& identifier,
+                                                          const glm::dvec3& position)
+    {
+        const ghoul::Dictionary translation = {
+            { "Type", std::string("StaticTranslation") },
+            { "Position", position }
+        };
+        const ghoul::Dictionary transform = { { "Translation", translation } };
+        const ghoul::Dictionary dictionary = {
+            { "Identifier", identifier },
+            { "Transform", transform }
+        };
+        return openspace::SceneGraphNode::createFromDictionary(dictionary);
+    }
+
+    std::unique_ptr<openspace::SceneGraphNode> createNode(const std::string& identifier,
+                                                          const glm::dvec3& position,
+                                                          const glm::dvec3& rotation,
+                                                          double scale)
+    {
+        const ghoul::Dictionary transform = {
+            {
+                "Translation",
+                ghoul::Dictionary{
+                    { "Type", std::string("StaticTranslation") },
+                    { "Position", position }
+                }
+            },
+            {
+                "Rotation",
+                ghoul::Dictionary{
+                    { "Type", std::string("StaticRotation") },
+                    { "Rotation", rotation }
+                }
+            },
+            {
+                "Scale",
+                ghoul::Dictionary{
+                    { "Type", std::string("StaticScale") },
+                    { "Scale", scale }
+                }
+            }
+        };
+        const ghoul::Dictionary dictionary = {
+            { "Identifier", identifier },
+            { "Transform", transform }
+        };
+        return openspace::SceneGraphNode::createFromDictionary(dictionary);
+    }
+
+    void setPosition(openspace::SceneGraphNode& node, const glm::dvec3& position) {
+        node.property("Translation.Position")->set(position);
+    }
+
+    openspace::UpdateData updateData(double time) {
+        return { {}, openspace::Time(time), openspace::Time(time), false };
+    }
+} // namespace
+
+TEST_F(SceneGraphNodeTest, RecomputedWorldTransforms) {
+    using namespace openspace;
+
+    Scene scene(std::make_unique<SingleThreadedSceneInitializer>());
+    std::unique_ptr<SceneGraphNode> parent = createNode("Parent", glm::dvec3(1, 0, 0));
+    std::unique_ptr<SceneGraphNode> child = createNode("Child", glm::dvec3(0, 1, 0));
+    std::unique_ptr<SceneGraphNode> sibling = createNode("Sibling", glm::dvec3(0, 0, 1));
+    SceneGraphNode* p = parent.get();
+    SceneGraphNode* c = child.get();
+    parent->attachChild(std::move(child));
+    scene.attachNode(std::move(parent));
+    scene.attachNode(std::move(sibling));
+    for (SceneGraphNode* node : scene.allSceneGraphNodes()) {
+        if (node != scene.root()) {
+            scene.initializeNode(node);
+        }
+    }
+
+    // Every node, including the root, is computed once
+    scene.update(updateData(0.0));
+    EXPECT_EQ(scene.nRecomputedWorldTransforms(), 4u);
+    EXPECT_EQ(c->worldPosition(), glm::dvec3(1, 1, 0));
+
+    // Nothing has changed, so all cached world transformations are reused, even though
+    // the time has changed
+    scene.update(updateData(0.0));
+    EXPECT_EQ(scene.nRecomputedWorldTransforms(), 0u);
+    scene.update(updateData(60.0));
+    EXPECT_EQ(scene.nRecomputedWorldTransforms(), 0u);
+
+    // A change of the parent has to be propagated to its child, but not to the sibling
+    setPosition(*p, glm::dvec3(2, 0, 0));
+    scene.update(updateData(60.0));
+    EXPECT_EQ(scene.nRecomputedWorldTransforms(), 2u);
+    EXPECT_EQ(c->worldPosition(), glm::dvec3(2, 1, 0));
+
+    // A change of the child does not affect its parent
+    setPosition(*c, glm::dvec3(0, 2, 0));
+    scene.update(updateData(60.0));
+    EXPECT_EQ(scene.nRecomputedWorldTransforms(), 1u);
+    EXPECT_EQ(c->worldPosition(), glm::dvec3(2, 2, 0));
+}
+
+TEST_F(SceneGraphNodeTest, InactiveParent) {
+    using namespace openspace;
+
+    // The child is initialized before its parent, as can happen with the multithreaded
+    // scene initializer, so only the child is updated
+    Scene scene(std::make_unique<SingleThreadedSceneInitializer>());
+    std::unique_ptr<SceneGraphNode> parent = createNode("Parent", glm::dvec3(1, 0, 0));
+    std::unique_ptr<SceneGraphNode> child = createNode("Child", glm::dvec3(0, 1, 0));
+    SceneGraphNode* p = parent.get();
+    SceneGraphNode* c = child.get();
+    parent->attachChild(std::move(child));
+    scene.attachNode(std::move(parent));
+    scene.initializeNode(c);
+
+    scene.update(updateData(0.0));
+    EXPECT_EQ(p->worldPosition(), glm::dvec3(1, 0, 0));
+    EXPECT_EQ(c->worldPosition(), glm::dvec3(1, 1, 0));
+
+    // A change of the inactive parent's local transformation still has to reach the
+    // child
+    setPosition(*p, glm::dvec3(3, 0, 0));
+    scene.update(updateData(0.0));
+    EXPECT_EQ(c->worldPosition(), glm::dvec3(3, 1, 0));
+
+    scene.initializeNode(p);
+    scene.update(updateData(0.0));
+    EXPECT_EQ(p->worldPosition(), glm::dvec3(3, 0, 0));
+    EXPECT_EQ(c->worldPosition(), glm::dvec3(3, 1, 0));
+}
+
+TEST_F(SceneGraphNodeTest, ParallelUpdateMatchesSerialUpdate) {
+    using namespace openspace;
+
+    // Each level has enough nodes to be split into several tasks
+    auto populate = [](Scene& scene) {
+        for (int i = 0; i < 64; ++i) {
+            std::unique_ptr<SceneGraphNode> node = createNode(
+                "Node" + std::to_string(i),
+                glm::dvec3(1e8 * i, -3.7e6 * i, 0.5),
+                glm::dvec3(0.1 * i, 0.2, -0.03 * i),
+                1.0 + 0.01 * i
+            );
+            for (int j = 0; j < 4; ++j) {
+                node->attachChild(createNode(
+                    "Node" + std::to_string(i) + "_" + std::to_string(j),
+                    glm::dvec3(1e3 * j, 7.1 * i, -2.3e4),
+                    glm::dvec3(-0.7 * j, 0.011 * i, 1.3),
+                    0.5 + 0.1 * j
+                ));
+            }
+            scene.attachNode(std::move(node));
+        }
+        for (SceneGraphNode* node : scene.allSceneGraphNodes()) {
+            if (node != scene.root()) {
+                scene.initializeNode(node);
+            }
+        }
+    };
+
+    // The pool has to outlive the scene that uses it
+    ThreadPool pool(4);
+    Scene serialScene(std::make_unique<SingleThreadedSceneInitializer>());
+    Scene parallelScene(std::make_unique<SingleThreadedSceneInitializer>());
+    parallelScene.setUpdatePool(&pool);
+    populate(serialScene);
+    populate(parallelScene);
+
+    auto expectEqualScenes = [&serialScene, &parallelScene]() {
+        EXPECT_EQ(
+            serialScene.nRecomputedWorldTransforms(),
+            parallelScene.nRecomputedWorldTransforms()
+        );
+        for (const SceneGraphNode* serial : serialScene.allSceneGraphNodes()) {
+            const SceneGraphNode* parallel = parallelScene.sceneGraphNode(
+                serial->identifier()
+            );
+            ASSERT_NE(parallel, nullptr) << serial->identifier();
+            // The results have to be bit-identical, not just close
+            EXPECT_EQ(serial->worldPosition(), parallel->worldPosition());
+            EXPECT_EQ(serial->worldRotationMatrix(), parallel->worldRotationMatrix());
+            EXPECT_EQ(serial->worldScale(), parallel->worldScale());
+            EXPECT_EQ(serial->modelTransform(), parallel->modelTransform());
+        }
+    };
+
+    serialScene.update(updateData(0.0));
+    parallelScene.update(updateData(0.0));
+    expectEqualScenes();
+
+    for (int frame = 1; frame < 10; ++frame) {
+        // Move some of the nodes on both levels between the updates
+        for (Scene* scene : { &serialScene, &parallelScene }) {
+            setPosition(
+                *scene->sceneGraphNode("Node" + std::to_string(frame * 5)),
+                glm::dvec3(1.5e7 * frame, 0.25, -1e9)
+            );
+            setPosition(
+                *scene->sceneGraphNode("Node" + std::to_string(frame) + "_2"),
+                glm::dvec3(-3.0 * frame, 1e-3, 42.0)
+            );
+        }
+
+        serialScene.update(updateData(frame * 60.0));
+        parallelScene.update(updateData(frame * 60.0));
+        expectEqualScenes();
+    }
+}
@@ -0,0 +1,186 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2018                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include <modules/digitaluniverse/speckfile.h>
+
+#include <ghoul/filesystem/filesystem.h>
+#include <ghoul/misc/exception.h>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+
+class SpeckFileTest : public testing::Test {};
+
+namespace {
+    std::string writeTextSpeckFile(const std::string& path, int nObjects) {
+        std::ofstream file(path);
+        file << "# A generated speck file\n";
+        file << "datavar 0 colorb_v\n";
+        file << "datavar 1 lum\n";
+        file << "texturevar 2\n";
+
+        std::mt19937 random(1337);
+        std::uniform_real_distribution<float> dist(-1000.f, 1000.f);
+        for (int i = 0; i < nObjects; ++i) {
+            file << dist(random) << " " << dist(random) << " " << dist(random) << " "
+                 << dist(random) << " " << dist(random) << "\n";
+        }
+        return path;
+    }
+} // namespace
+
+TEST_F(SpeckFileTest, ReadText) {
+    using namespace openspace::speck;
+
+    const std::string path = absPath("${TESTDIR}/speckfile.speck");
+    {
+        std::ofstream file(path);
+        file << "# comment\r\n";
+        file << "datavar 0 colorb_v\r\n";
+        file << "datavar 1 lum\r\n";
+        file << "\r\n";
+        file << "1 2 3 4 5\r\n";
+        file << "-1 -2 -3 -4 -5 # trailing comment\r\n";
+        file << "\r\n";
+    }
+
+    SpeckData data = readSpeckFile(path);
+    ASSERT_EQ(data.nValuesPerObject(), 5u);
+    ASSERT_EQ(data.nObjects(), 2u);
+    EXPECT_EQ(data.columns[0].name, "x");
+    EXPECT_EQ(data.columns[3].name, "colorb_v");
+    EXPECT_EQ(data.columns[4].name, "lum");
+    EXPECT_EQ(data.columns[4].minimum, -5.f);
+    EXPECT_EQ(data.columns[4].maximum, 5.f);
+    EXPECT_EQ(data.values[6], -2.f);
+    EXPECT_EQ(data.dataVariables().at("lum"), 1);
+}
+
+TEST_F(SpeckFileTest, RejectsInvalidDataVariable) {
+    using namespace openspace::speck;
+
+    const std::string path = absPath("${TESTDIR}/speckinvaliddatavar.speck");
+    {
+        std::ofstream file(path);
+        file << "datavar 0 colorb_v\n";
+        file << "datavar -1 lum\n";
+        file << "1 2 3 4 5\n";
+    }
+    EXPECT_THROW(readSpeckFile(path), ghoul::RuntimeError);
+
+    {
+        std::ofstream file(path);
+        file << "datavar lum\n";
+        file << "1 2 3 4\n";
+    }
+    EXPECT_THROW(readSpeckFile(path), ghoul::RuntimeError);
+}
+
+TEST_F(SpeckFileTest, BinaryRoundTrip) {
+    using namespace openspace::speck;
+
+    const std::string textPath = writeTextSpeckFile(
+        absPath("${TESTDIR}/speckroundtrip.speck"),
+        100
+    );
+    const std::string binaryPath = absPath("${TESTDIR}/speckroundtrip.bin");
+
+    const SpeckData text = readSpeckFile(textPath);
+    saveBinarySpeckFile(text, binaryPath);
+    ASSERT_TRUE(isBinarySpeckFile(binaryPath));
+    ASSERT_FALSE(isBinarySpeckFile(textPath));
+
+    BinarySpeckFile binary(binaryPath);
+    ASSERT_EQ(binary.nObjects(), text.nObjects());
+    ASSERT_EQ(binary.columns().size(), text.columns.size());
+    for (size_t i = 0; i < text.columns.size(); ++i) {
+        EXPECT_EQ(binary.columns()[i].name, text.columns[i].name);
+        EXPECT_EQ(binary.columns()[i].minimum, text.columns[i].minimum);
+        EXPECT_EQ(binary.columns()[i].maximum, text.columns[i].maximum);
+    }
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(binary.values()) % alignof(float), 0u);
+    for (size_t i = 0; i < text.values.size(); ++i) {
+        ASSERT_EQ(binary.values()[i], text.values[i]);
+    }
+}
+
+TEST_F(SpeckFileTest, RejectsInvalidBinary) {
+    using namespace openspace::speck;
+
+    const std::string textPath = writeTextSpeckFile(
+        absPath("${TESTDIR}/speckinvalid.speck"),
+        10
+    );
+    EXPECT_THROW(BinarySpeckFile file(textPath), ghoul::RuntimeError);
+
+    // A file that is cut off in the middle of the records
+    const std::string binaryPath = absPath("${TESTDIR}/speckinvalid.bin");
+    saveBinarySpeckFile(readSpeckFile(textPath), binaryPath);
+    std::string contents;
+    {
+        std::ifstream file(binaryPath, std::ifstream::binary);
+        contents.assign(std::istreambuf_iterator<char>(file), {});
+    }
+    {
+        std::ofstream file(binaryPath, std::ofstream::binary);
+        file.write(contents.data(), contents.size() - sizeof(float));
+    }
+    EXPECT_THROW(BinarySpeckFile file(binaryPath), ghoul::RuntimeError);
+}
+
+TEST_F(SpeckFileTest, DISABLED_Benchmark) {
+    using namespace openspace::speck;
+
+    constexpr const int NObjects = 500000;
+    const std::string textPath = writeTextSpeckFile(
+        absPath("${TESTDIR}/speckbenchmark.speck"),
+        NObjects
+    );
+    const std::string binaryPath = absPath("${TESTDIR}/speckbenchmark.bin");
+    saveBinarySpeckFile(readSpeckFile(textPath), binaryPath);
+
+    auto time = [](auto load) {
+        auto start = std::chrono::high_resolution_clock::now();
+        const size_t n = load();
+        auto end = std::chrono::high_resolution_clock::now();
+        EXPECT_EQ(n, static_cast<size_t>(NObjects));
+        return std::chrono::duration<double>(end - start).count();
+    };
+
+    const double textTime = time([&textPath]() {
+        return readSpeckFile(textPath).nObjects();
+    });
+    const double binaryTime = time([&binaryPath]() {
+        // Copy the records out of the mapping as the renderables do
+        return BinarySpeckFile(binaryPath).data().nObjects();
+    });
+
+    std::cout << NObjects << " objects: text " << textTime * 1000.0 << " ms, binary "
+              << binaryTime * 1000.0 << " ms (" << textTime / binaryTime << "x)"
+              << std::endl;
+}
@@ -26,6 +26,10 @@
 
 #include <ghoul/filesystem/filesystem.h>
 
+#include <chrono>
+#include <iostream>
+#include <vector>
+
 #include "SpiceUsr.h"
 #include "SpiceZpr.h"
 
@@ -325,6 +329,77 @@ TEST_F(SpiceManagerTest, getTargetPosition) {
     EXPECT_DOUBLE_EQ(pos[2], targetPosition[2]) << "Position not found or differs from expected return";
 }
 
+// The batched positions have to be identical to the single-time query
+TEST_F(SpiceManagerTest, getTargetPositions) {
+    using openspace::SpiceManager;
+    loadMetaKernel();
+
+    double et;
+    char utctime[SRCLEN] = "2004 jun 11 19:32:00";
+    str2et_c(utctime, &et);
+
+    SpiceManager::AberrationCorrection corr = {
+        SpiceManager::AberrationCorrection::Type::LightTimeStellar,
+        SpiceManager::AberrationCorrection::Direction::Reception
+    };
+
+    std::vector<double> times(64);
+    for (size_t i = 0; i < times.size(); ++i) {
+        times[i] = et + i * 60.0;
+    }
+    std::vector<glm::dvec3> positions(times.size());
+    ASSERT_NO_THROW(SpiceManager::ref().targetPositions(
+        "EARTH", "CASSINI", "J2000", corr, times.data(), times.size(), positions.data()
+    ));
+
+    for (size_t i = 0; i < times.size(); ++i) {
+        const glm::dvec3 p = SpiceManager::ref().targetPosition(
+            "EARTH", "CASSINI", "J2000", corr, times[i]
+        );
+        EXPECT_DOUBLE_EQ(p.x, positions[i].x) << "Batched position differs at " << i;
+        EXPECT_DOUBLE_EQ(p.y, positions[i].y) << "Batched position differs at " << i;
+        EXPECT_DOUBLE_EQ(p.z, positions[i].z) << "Batched position differs at " << i;
+    }
+}
+
+TEST_F(SpiceManagerTest, DISABLED_BenchmarkTargetPositions) {
+    using openspace::SpiceManager;
+    using namespace std::chrono;
+    loadMetaKernel();
+
+    double et;
+    char utctime[SRCLEN] = "2004 jun 11 19:32:00";
+    str2et_c(utctime, &et);
+
+    constexpr const size_t NSamples = 100000;
+    std::vector<double> times(NSamples);
+    for (size_t i = 0; i < NSamples; ++i) {
+        times[i] = et + i * 1.0;
+    }
+    std::vector<glm::dvec3> positions(NSamples);
+
+    auto start = high_resolution_clock::now();
+    for (size_t i = 0; i < NSamples; ++i) {
+        positions[i] = SpiceManager::ref().targetPosition(
+            "EARTH", "CASSINI", "J2000", {}, times[i]
+        );
+    }
+    const double single = duration<double, std::milli>(
+        high_resolution_clock::now() - start
+    ).count();
+
+    start = high_resolution_clock::now();
+    SpiceManager::ref().targetPositions(
+        "EARTH", "CASSINI", "J2000", {}, times.data(), NSamples, positions.data()
+    );
+    const double batched = duration<double, std::milli>(
+        high_resolution_clock::now() - start
+    ).count();
+
+    std::cout << NSamples << " positions: single " << single << " ms, batched "
+              << batched << " ms" << std::endl;
+}
+
 // Try getting position & velocity vectors of target
 TEST_F(SpiceManagerTest, getTargetState) {
     using openspace::SpiceManager;
@@ -0,0 +1,78 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2018                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include <openspace/engine/syncengine.h>
+#include <openspace/util/syncdata.h>
+
+#include <ghoul/glm.h>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+class SyncEngineTest : public testing::Test {};
+
+TEST_F(SyncEngineTest, DISABLED_BenchmarkDeltaEncoding) {
+    using namespace openspace;
+    using namespace std::chrono;
+
+    // Mimics a typical frame in which the camera moves and the time advances, but all
+    // other synchronized values stay the same
+    constexpr const int NFrames = 100000;
+    constexpr const int NOtherSyncables = 64;
+
+    for (bool delta : { false, true }) {
+        SyncEngine engine(4096);
+        engine.setDeltaEncoding(delta);
+
+        SyncData<glm::dvec3> position = glm::dvec3(1.0);
+        SyncData<glm::dquat> rotation = glm::dquat(1.0, 0.0, 0.0, 0.0);
+        SyncData<double> time = 0.0;
+        engine.addSyncables({ &position, &rotation, &time });
+
+        std::vector<std::unique_ptr<SyncData<double>>> others;
+        for (int i = 0; i < NOtherSyncables; ++i) {
+            others.push_back(std::make_unique<SyncData<double>>(static_cast<double>(i)));
+            engine.addSyncable(others.back().get());
+        }
+
+        size_t nBytes = 0;
+        const auto start = high_resolution_clock::now();
+        for (int i = 0; i < NFrames; ++i) {
+            position = glm::dvec3(i, 1.0, 1.0);
+            time = i / 60.0;
+            engine.encodeSyncables();
+            nBytes += engine.encodedSize();
+        }
+        const double ms = duration<double, std::milli>(
+            high_resolution_clock::now() - start
+        ).count();
+
+        std::cout << (delta ? "Delta" : "Full") << " encoding: "
+                  << static_cast<double>(nBytes) / NFrames << " bytes/frame, "
+                  << 1000.0 * ms / NFrames << " us/frame" << std::endl;
+    }
+}
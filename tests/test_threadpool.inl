@@ -0,0 +1,360 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2018                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include <openspace/util/threadpool.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+
+class ThreadPoolTest : public testing::Test {};
+
+namespace {
+    // Reference implementation of the previous ThreadPool (a single std::deque guarded by
+    // one mutex) that is used as the baseline in the benchmark below
+    class MutexThreadPool {
+    public:
+        MutexThreadPool(size_t numThreads) {
+            for (size_t i = 0; i < numThreads; ++i) {
+                _workers.emplace_back([this]() {
+                    std::function<void()> task;
+                    while (true) {
+                        {
+                            std::unique_lock<std::mutex> lock(_mutex);
+                            _condition.wait(
+                                lock,
+                                [this]() { return _stop || !_tasks.empty(); }
+                            );
+                            if (_stop) {
+                                return;
+                            }
+                            task = std::move(_tasks.front());
+                            _tasks.pop_front();
+                        }
+                        task();
+                    }
+                });
+            }
+        }
+
+        ~MutexThreadPool() {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stop = true;
+            }
+            _condition.notify_all();
+            for (std::thread& w : _workers) {
+                w.join();
+            }
+        }
+
+        void enqueue(std::function<void()> f) {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _tasks.push_back(std::move(f));
+            }
+            _condition.notify_one();
+        }
+
+    private:
+        std::vector<std::thread> _workers;
+        std::deque<std::function<void()>> _tasks;
+        std::mutex _mutex;
+        std::condition_variable _condition;
+        bool _stop = false;
+    };
+
+    void waitFor(const std::atomic<int>& counter, int value) {
+        while (counter.load() < value) {
+            std::this_thread::yield();
+        }
+    }
+
+    template <typename Pool>
+    double runProducers(Pool& pool, int nProducers, int nTasksPerProducer) {
+        std::atomic<int> counter = { 0 };
+
+        auto start = std::chrono::high_resolution_clock::now();
+        std::vector<std::thread> producers;
+        for (int i = 0; i < nProducers; ++i) {
+            producers.emplace_back([&pool, &counter, nTasksPerProducer]() {
+                for (int j = 0; j < nTasksPerProducer; ++j) {
+                    pool.enqueue([&counter]() { ++counter; });
+                }
+            });
+        }
+        for (std::thread& p : producers) {
+            p.join();
+        }
+        waitFor(counter, nProducers * nTasksPerProducer);
+        auto end = std::chrono::high_resolution_clock::now();
+
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+} // namespace
+
+TEST_F(ThreadPoolTest, ExecutesAllTasks) {
+    std::atomic<int> counter = { 0 };
+    openspace::ThreadPool pool(4);
+
+    // More tasks than fit into the lock-free queues to exercise the overflow path
+    const int nTasks = 10000;
+    for (int i = 0; i < nTasks; ++i) {
+        pool.enqueue([&counter]() { ++counter; });
+    }
+    waitFor(counter, nTasks);
+    EXPECT_EQ(counter.load(), nTasks);
+}
+
+TEST_F(ThreadPoolTest, LargeCallable) {
+    std::atomic<int> counter = { 0 };
+    openspace::ThreadPool pool(1);
+
+    // This callable does not fit into the small buffer of the Task
+    std::array<int, 64> payload;
+    payload.fill(1);
+    pool.enqueue([payload, &counter]() { counter += payload[63]; });
+
+    std::function<void()> function = [&counter]() { ++counter; };
+    pool.enqueue(function);
+
+    waitFor(counter, 2);
+    EXPECT_EQ(counter.load(), 2);
+}
+
+TEST_F(ThreadPoolTest, HighPriorityFirst) {
+    using namespace openspace;
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool blocked = true;
+    std::vector<int> order;
+    std::atomic<int> counter = { 0 };
+
+    ThreadPool pool(1);
+    // Block the only worker until all other tasks are enqueued
+    pool.enqueue([&]() {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [&]() { return !blocked; });
+        ++counter;
+    });
+    auto record = [&](int value) {
+        return [&, value]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(value);
+            ++counter;
+        };
+    };
+    pool.enqueue(record(0));
+    pool.enqueue(record(1), ThreadPool::Priority::High);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        blocked = false;
+    }
+    condition.notify_one();
+
+    waitFor(counter, 3);
+    ASSERT_EQ(order.size(), 2u);
+    EXPECT_EQ(order[0], 1) << "High priority task should be executed first";
+    EXPECT_EQ(order[1], 0);
+}
+
+TEST_F(ThreadPoolTest, HighPriorityOverflowFirst) {
+    using namespace openspace;
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool blocked = true;
+    std::vector<int> order;
+    std::atomic<int> counter = { 0 };
+
+    ThreadPool pool(1);
+    pool.enqueue([&]() {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [&]() { return !blocked; });
+        ++counter;
+    });
+    // Give the worker time to pick up the blocking task
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    auto record = [&](int value) {
+        return [&, value]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(value);
+            ++counter;
+        };
+    };
+    // Enqueue more high priority tasks than fit into the priority queue, so that some of
+    // them end up in the overflow queue, and a normal task before all of them
+    constexpr const int nHighTasks = 1000;
+    pool.enqueue(record(-1));
+    for (int i = 0; i < nHighTasks; ++i) {
+        pool.enqueue(record(i), ThreadPool::Priority::High);
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        blocked = false;
+    }
+    condition.notify_one();
+
+    waitFor(counter, nHighTasks + 2);
+    ASSERT_EQ(order.size(), static_cast<size_t>(nHighTasks + 1));
+    for (int i = 0; i < nHighTasks; ++i) {
+        EXPECT_EQ(order[i], i) << "High priority tasks should keep their order";
+    }
+    EXPECT_EQ(order.back(), -1) << "Normal task should be executed last";
+}
+
+TEST_F(ThreadPoolTest, ClearTasks) {
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool blocked = true;
+    std::atomic<int> counter = { 0 };
+
+    openspace::ThreadPool pool(1);
+    pool.enqueue([&]() {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [&]() { return !blocked; });
+        ++counter;
+    });
+    // Give the worker time to pick up the blocking task
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    for (int i = 0; i < 10; ++i) {
+        pool.enqueue([&counter]() { counter += 100; });
+    }
+    pool.clearTasks();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        blocked = false;
+    }
+    condition.notify_one();
+
+    pool.enqueue([&counter]() { ++counter; });
+    waitFor(counter, 2);
+    EXPECT_EQ(counter.load(), 2) << "Cleared tasks should not be executed";
+}
+
+TEST_F(ThreadPoolTest, ParallelFor) {
+    constexpr const size_t N = 1000;
+    openspace::ThreadPool pool(4);
+
+    std::vector<std::atomic<int>> calls(N);
+    std::thread::id firstCaller;
+    openspace::parallelFor(&pool, N, [&](size_t i) {
+        ++calls[i];
+        if (i == 0) {
+            firstCaller = std::this_thread::get_id();
+        }
+    });
+    for (size_t i = 0; i < N; ++i) {
+        EXPECT_EQ(calls[i].load(), 1) << "Every index has to be called exactly once";
+    }
+    EXPECT_EQ(firstCaller, std::this_thread::get_id());
+
+    // Without a pool, the calls are made in order on the calling thread
+    std::vector<size_t> order;
+    openspace::parallelFor(nullptr, 5, [&order](size_t i) { order.push_back(i); });
+    EXPECT_EQ(order, std::vector<size_t>({ 0, 1, 2, 3, 4 }));
+}
+
+TEST_F(ThreadPoolTest, ParallelForExceptions) {
+    constexpr const size_t N = 64;
+    openspace::ThreadPool pool(4);
+
+    // An exception on a worker is rethrown on the calling thread after all calls
+    std::atomic<int> nCalls = { 0 };
+    EXPECT_THROW(
+        openspace::parallelFor(&pool, N, [&nCalls](size_t i) {
+            ++nCalls;
+            if (i == N - 1) {
+                throw std::runtime_error("worker");
+            }
+        }),
+        std::runtime_error
+    );
+    EXPECT_EQ(nCalls.load(), static_cast<int>(N));
+
+    // An exception on the calling thread still waits for the enqueued calls, which
+    // reference state of the parallelFor call
+    nCalls = 0;
+    EXPECT_THROW(
+        openspace::parallelFor(&pool, N, [&nCalls](size_t i) {
+            if (i == 0) {
+                throw std::logic_error("caller");
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            ++nCalls;
+        }),
+        std::logic_error
+    );
+    EXPECT_EQ(nCalls.load(), static_cast<int>(N - 1));
+
+    // The pool keeps working afterwards
+    nCalls = 0;
+    openspace::parallelFor(&pool, N, [&nCalls](size_t) { ++nCalls; });
+    EXPECT_EQ(nCalls.load(), static_cast<int>(N));
+}
+
+TEST_F(ThreadPoolTest, NestedParallelFor) {
+    constexpr const size_t N = 16;
+    openspace::ThreadPool pool(2);
+
+    // Every worker blocking in a nested call would deadlock if the nested calls waited
+    // for tasks of the same pool
+    std::atomic<int> nCalls = { 0 };
+    openspace::parallelFor(&pool, N, [&pool, &nCalls](size_t) {
+        openspace::parallelFor(&pool, N, [&nCalls](size_t) { ++nCalls; });
+    });
+    EXPECT_EQ(nCalls.load(), static_cast<int>(N * N));
+}
+
+// Run with --gtest_also_run_disabled_tests
+TEST_F(ThreadPoolTest, DISABLED_Benchmark) {
+    const size_t nThreads = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+    const int nTasks = 1 << 20;
+
+    for (int nProducers : { 1, 8, 32 }) {
+        double mutexTime;
+        {
+            MutexThreadPool pool(nThreads);
+            mutexTime = runProducers(pool, nProducers, nTasks / nProducers);
+        }
+        double workStealingTime;
+        {
+            openspace::ThreadPool pool(nThreads);
+            workStealingTime = runProducers(pool, nProducers, nTasks / nProducers);
+        }
+
+        std::cout << nProducers << " producers, " << nThreads << " workers, "
+                  << nTasks << " tasks: mutex pool " << mutexTime << " ms, "
+                  << "work-stealing pool " << workStealingTime << " ms" << std::endl;
+    }
+}
@@ -0,0 +1,216 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2018                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include <modules/multiresvolume/rendering/tsp.h>
+
+#include <openspace/util/threadpool.h>
+#include <ghoul/filesystem/cachemanager.h>
+#include <ghoul/filesystem/file.h>
+#include <ghoul/filesystem/filesystem.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+class TspTest : public testing::Test {};
+
+namespace {
+    // Writes a TSP file with random voxel values. The number of bricks per axis and
+    // the number of timesteps have to be powers of two
+    void writeTspFile(const std::string& path, unsigned int brickDim,
+                      unsigned int nBricksPerAxis, unsigned int nTimesteps)
+    {
+        openspace::TSP::Header header = {
+            0,
+            nTimesteps,
+            nTimesteps,
+            brickDim,
+            brickDim,
+            brickDim,
+            nBricksPerAxis,
+            nBricksPerAxis,
+            nBricksPerAxis
+        };
+
+        unsigned int nOctreeNodes = 0;
+        for (unsigned int n = 1; n <= nBricksPerAxis; n *= 2) {
+            nOctreeNodes += n * n * n;
+        }
+        const size_t nBricks = static_cast<size_t>(nOctreeNodes) * (2 * nTimesteps - 1);
+        const size_t paddedBrickDim = brickDim + 2;
+        const size_t nBrickValues = paddedBrickDim * paddedBrickDim * paddedBrickDim;
+
+        std::mt19937 generator(1337);
+        std::uniform_real_distribution<float> distribution(0.f, 1.f);
+        std::vector<float> brick(nBrickValues);
+
+        std::ofstream file(path, std::ios::out | std::ios::binary);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        for (size_t i = 0; i < nBricks; ++i) {
+            for (float& v : brick) {
+                v = distribution(generator);
+            }
+            file.write(
+                reinterpret_cast<const char*>(brick.data()),
+                brick.size() * sizeof(float)
+            );
+        }
+    }
+
+    // Removes the TSP file and its cache when the test ends, even if an assertion failed.
+    // It has to be declared before any TSP that uses the file
+    struct TemporaryTspFile {
+        explicit TemporaryTspFile(std::string p) : path(absPath(std::move(p))) {}
+        ~TemporaryTspFile() {
+            ghoul::filesystem::File f = path;
+            FileSys.cacheManager()->removeCacheFile(f.baseName(), "");
+            std::remove(path.c_str());
+        }
+
+        const std::string path;
+    };
+
+    // Builds the tree and error metrics of the TSP file, writes the cache, and returns
+    // the contents of the cache file
+    std::vector<char> buildCache(const std::string& path, openspace::ThreadPool* pool) {
+        openspace::TSP tsp(path);
+        EXPECT_TRUE(tsp.readHeader());
+        EXPECT_TRUE(tsp.construct(pool));
+        EXPECT_TRUE(tsp.calculateSpatialError(pool));
+        EXPECT_TRUE(tsp.calculateTemporalError(pool));
+        EXPECT_TRUE(tsp.writeCache());
+
+        ghoul::filesystem::File f = path;
+        std::string cacheFilename = FileSys.cacheManager()->cachedFilename(
+            f.baseName(),
+            "",
+            ghoul::filesystem::CacheManager::Persistent::Yes
+        );
+        std::ifstream cache(cacheFilename, std::ios::in | std::ios::binary);
+        return std::vector<char>(
+            std::istreambuf_iterator<char>(cache),
+            std::istreambuf_iterator<char>()
+        );
+    }
+} // namespace
+
+TEST_F(TspTest, ParallelConstructionMatchesSerial) {
+    const TemporaryTspFile tspFile("${TESTDIR}/paralleltsp.tsp");
+    const std::string& path = tspFile.path;
+    writeTspFile(path, 6, 4, 8);
+
+    const std::vector<char> serialCache = buildCache(path, nullptr);
+    ASSERT_FALSE(serialCache.empty());
+
+    openspace::ThreadPool pool(3);
+    const std::vector<char> parallelCache = buildCache(path, &pool);
+
+    // The cache files have to be byte-identical
+    EXPECT_EQ(serialCache, parallelCache);
+}
+
+TEST_F(TspTest, ErrorMetricsOfLeaves) {
+    const TemporaryTspFile tspFile("${TESTDIR}/leaftsp.tsp");
+    const std::string& path = tspFile.path;
+    writeTspFile(path, 4, 2, 2);
+
+    openspace::ThreadPool pool(2);
+    openspace::TSP tsp(path);
+    ASSERT_TRUE(tsp.readHeader());
+    ASSERT_TRUE(tsp.construct(&pool));
+    ASSERT_TRUE(tsp.calculateSpatialError(&pool));
+    ASSERT_TRUE(tsp.calculateTemporalError(&pool));
+
+    for (unsigned int brick = 0; brick < tsp.numTotalNodes(); ++brick) {
+        // Leaves are marked with a negative error, all other nodes have a positive one
+        if (tsp.isOctreeLeaf(brick)) {
+            EXPECT_LT(tsp.spatialError(brick), 0.f) << "Brick " << brick;
+        }
+        else {
+            EXPECT_GT(tsp.spatialError(brick), 0.f) << "Brick " << brick;
+        }
+        if (tsp.isBstLeaf(brick)) {
+            EXPECT_LT(tsp.temporalError(brick), 0.f) << "Brick " << brick;
+        }
+        else {
+            EXPECT_GT(tsp.temporalError(brick), 0.f) << "Brick " << brick;
+        }
+    }
+}
+
+TEST_F(TspTest, TruncatedFileFails) {
+    const TemporaryTspFile tspFile("${TESTDIR}/truncatedtsp.tsp");
+    const std::string& path = tspFile.path;
+    writeTspFile(path, 4, 2, 2);
+    {
+        // Overwrite the file with only its header
+        std::ifstream file(path, std::ios::in | std::ios::binary);
+        std::vector<char> header(sizeof(openspace::TSP::Header));
+        file.read(header.data(), header.size());
+        file.close();
+
+        std::ofstream truncated(path, std::ios::out | std::ios::binary);
+        truncated.write(header.data(), header.size());
+    }
+
+    openspace::TSP tsp(path);
+    ASSERT_TRUE(tsp.readHeader());
+    ASSERT_TRUE(tsp.construct());
+    EXPECT_FALSE(tsp.calculateSpatialError());
+    EXPECT_FALSE(tsp.calculateTemporalError());
+}
+
+TEST_F(TspTest, DISABLED_BenchmarkConstruction) {
+    using Clock = std::chrono::high_resolution_clock;
+
+    const TemporaryTspFile tspFile("${TESTDIR}/benchmarktsp.tsp");
+    const std::string& path = tspFile.path;
+    writeTspFile(path, 14, 8, 16);
+
+    auto build = [&path](openspace::ThreadPool* pool) {
+        openspace::TSP tsp(path);
+        tsp.readHeader();
+        Clock::time_point begin = Clock::now();
+        tsp.construct(pool);
+        tsp.calculateSpatialError(pool);
+        tsp.calculateTemporalError(pool);
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            Clock::now() - begin
+        ).count();
+    };
+
+    std::cout << "Serial: " << build(nullptr) << "ms\n";
+
+    const unsigned int nThreads = std::max(std::thread::hardware_concurrency(), 2u);
+    openspace::ThreadPool pool(nThreads - 1);
+    std::cout << nThreads << " threads: " << build(&pool) << "ms\n";
+}
@@ -0,0 +1,204 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2018                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include <modules/volume/volumeutils.h>
+
+#include <openspace/util/histogram.h>
+#include <openspace/util/threadpool.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <thread>
+#include <vector>
+
+class VolumeUtilsTest : public testing::Test {};
+
+namespace {
+    std::vector<float> randomValues(size_t n, float minValue, float maxValue) {
+        std::mt19937 generator(1337);
+        std::uniform_real_distribution<float> distribution(minValue, maxValue);
+        std::vector<float> values(n);
+        for (float& v : values) {
+            v = distribution(generator);
+        }
+        return values;
+    }
+
+    // The unfused normalization and histogram that is used as the reference
+    void referenceNormalizeWithHistogram(std::vector<float>& values, float minValue,
+                                         float maxValue, openspace::Histogram& histogram)
+    {
+        for (float& v : values) {
+            v = glm::clamp((v - minValue) / (maxValue - minValue), 0.f, 1.f);
+        }
+        for (float v : values) {
+            histogram.add(v);
+        }
+    }
+
+    void expectEqualHistograms(const openspace::Histogram& expected,
+                               const openspace::Histogram& actual)
+    {
+        ASSERT_EQ(expected.numBins(), actual.numBins());
+        for (int i = 0; i < expected.numBins(); ++i) {
+            EXPECT_EQ(expected.data()[i], actual.data()[i]) << "Bin " << i;
+        }
+    }
+} // namespace
+
+TEST_F(VolumeUtilsTest, NormalizeWithHistogramMatchesReference) {
+    // An odd number of values to cover the remainder after the vectorized part
+    const std::vector<float> values = randomValues(10007, -5.f, 15.f);
+
+    std::vector<float> expected = values;
+    openspace::Histogram expectedHistogram(0.f, 1.f, 100);
+    referenceNormalizeWithHistogram(expected, 0.f, 10.f, expectedHistogram);
+
+    std::vector<float> actual = values;
+    openspace::Histogram actualHistogram(0.f, 1.f, 100);
+    openspace::volume::normalizeWithHistogram(
+        actual.data(),
+        actual.size(),
+        0.f,
+        10.f,
+        actualHistogram
+    );
+
+    for (size_t i = 0; i < values.size(); ++i) {
+        ASSERT_EQ(expected[i], actual[i]) << "Value " << i;
+    }
+    expectEqualHistograms(expectedHistogram, actualHistogram);
+}
+
+TEST_F(VolumeUtilsTest, AddToHistogramSkipsValuesOutsideRange) {
+    std::vector<float> values = randomValues(4099, -2.f, 3.f);
+    values[7] = std::numeric_limits<float>::quiet_NaN();
+    values[8] = -1.f;
+    values[9] = 2.f;
+
+    openspace::Histogram expected(-1.f, 2.f, 37);
+    for (float v : values) {
+        if (!std::isnan(v)) {
+            expected.add(v);
+        }
+    }
+
+    openspace::Histogram actual(-1.f, 2.f, 37);
+    openspace::volume::addToHistogram(values.data(), values.size(), actual);
+
+    expectEqualHistograms(expected, actual);
+}
+
+TEST_F(VolumeUtilsTest, ParallelMatchesSerial) {
+    const std::vector<float> values = randomValues(3 * (1 << 20) + 5, -1.f, 2.f);
+    openspace::ThreadPool pool(3);
+
+    std::vector<float> serial = values;
+    openspace::Histogram serialHistogram(0.f, 1.f, 64);
+    openspace::volume::normalizeWithHistogram(
+        serial.data(),
+        serial.size(),
+        -1.f,
+        2.f,
+        serialHistogram
+    );
+
+    std::vector<float> parallel = values;
+    openspace::Histogram parallelHistogram(0.f, 1.f, 64);
+    openspace::volume::normalizeWithHistogram(
+        parallel.data(),
+        parallel.size(),
+        -1.f,
+        2.f,
+        parallelHistogram,
+        &pool
+    );
+
+    EXPECT_EQ(serial, parallel);
+    expectEqualHistograms(serialHistogram, parallelHistogram);
+}
+
+TEST_F(VolumeUtilsTest, LargeBinCountsKeepTheirPrecision) {
+    // 2^24 + 2 can be stored in a float, but 2^24 + 1 can not, so converting the count
+    // to float before adding it would lose the value that is already in the bin
+    constexpr const uint64_t Count = (1 << 24) + 1;
+    openspace::Histogram histogram(0.f, 1.f, 4);
+    histogram.add(0.6f);
+    ASSERT_TRUE(histogram.addToBin(2, Count));
+    EXPECT_EQ(histogram.sample(2), 16777218.f);
+
+    EXPECT_FALSE(histogram.addToBin(4, 1));
+    EXPECT_FALSE(histogram.addToBin(-1, 1));
+}
+
+TEST_F(VolumeUtilsTest, DISABLED_BenchmarkNormalizeWithHistogram) {
+    using Clock = std::chrono::high_resolution_clock;
+    constexpr const size_t Size = 512;
+    const std::vector<float> values = randomValues(Size * Size * Size, -1.f, 2.f);
+
+    auto milliseconds = [](Clock::time_point begin) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            Clock::now() - begin
+        ).count();
+    };
+
+    std::vector<float> data = values;
+    openspace::Histogram histogram(0.f, 1.f, 100);
+    Clock::time_point begin = Clock::now();
+    referenceNormalizeWithHistogram(data, -1.f, 2.f, histogram);
+    std::cout << "Scalar normalization and histogram: " << milliseconds(begin) << "ms\n";
+
+    data = values;
+    openspace::Histogram serialHistogram(0.f, 1.f, 100);
+    begin = Clock::now();
+    openspace::volume::normalizeWithHistogram(
+        data.data(),
+        data.size(),
+        -1.f,
+        2.f,
+        serialHistogram
+    );
+    std::cout << "Fused, single thread: " << milliseconds(begin) << "ms\n";
+
+    const unsigned int nThreads = std::max(std::thread::hardware_concurrency(), 2u);
+    openspace::ThreadPool pool(nThreads - 1);
+    data = values;
+    openspace::Histogram parallelHistogram(0.f, 1.f, 100);
+    begin = Clock::now();
+    openspace::volume::normalizeWithHistogram(
+        data.data(),
+        data.size(),
+        -1.f,
+        2.f,
+        parallelHistogram,
+        &pool
+    );
+    std::cout << "Fused, " << nThreads << " threads: " << milliseconds(begin) << "ms\n";
+}